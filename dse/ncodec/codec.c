@@ -101,7 +101,9 @@ ncodec_config
 
 Set an additional parameter on a Network Codec. If the parameter is already
 specified in the MIMEtype of the codex, the value being set will take
-priority over the value originally specified in the MIMEtype.
+priority over the value originally specified in the MIMEtype. A background
+decode operation (see `ncodec_step_begin`) is completed before the parameter
+is set.
 
 Parameters
 ----------
@@ -115,6 +117,7 @@ inline void ncodec_config(NCODEC* nc, NCodecConfigItem item)
 {
     NCodecInstance* _nc = (NCodecInstance*)nc;
     if (_nc && _nc->codec.config) {
+        if (_nc->codec.step_wait) _nc->codec.step_wait(nc);
         _nc->codec.config(nc, item);
     }
 }
@@ -124,6 +127,9 @@ inline void ncodec_config(NCODEC* nc, NCodecConfigItem item)
 ncodec_stat
 ===========
 
+Return the config items of a Network Codec. A background decode operation
+(see `ncodec_step_begin`) is completed before the config item is returned.
+
 Parameters
 ----------
 nc (NCODEC*)
@@ -143,6 +149,7 @@ inline NCodecConfigItem ncodec_stat(NCODEC* nc, int32_t* index)
 {
     NCodecInstance* _nc = (NCodecInstance*)nc;
     if (_nc && _nc->codec.stat) {
+        if (_nc->codec.step_wait) _nc->codec.step_wait(nc);
         return _nc->codec.stat(nc, index);
     } else {
         NCodecConfigItem _ = {};
@@ -181,6 +188,10 @@ Returns
 
 -EINVAL (-22)
 : Bad `msg` argument.
+
+-ENOMEM (-12)
+: A chunk (chunked flush) could not be held by the codec, the messages of
+  that chunk were not written.
 */
 inline int32_t ncodec_write(NCODEC* nc, NCodecMessage* msg)
 {
@@ -269,6 +280,10 @@ Returns
 
 -ENOSR
 : No stream resource has been configured.
+
+-ENOMEM (-12)
+: The pending messages could not be held (chunked flush), the chunks held
+  by the codec were written.
 */
 inline int32_t ncodec_flush(NCODEC* nc)
 {
@@ -316,6 +331,9 @@ inline int32_t ncodec_truncate(NCODEC* nc)
 ncodec_seek
 ===========
 
+Set the position of the underlying stream object. A background decode
+operation (see `ncodec_step_begin`) is completed before the seek.
+
 Parameters
 ----------
 nc (NCODEC*)
@@ -343,6 +361,7 @@ inline int64_t ncodec_seek(NCODEC* nc, size_t pos, int32_t op)
     NCodecInstance* _nc = (NCodecInstance*)nc;
     NCodecStreamVTable* stream = _nc ? (NCodecStreamVTable*)_nc->stream : NULL;
     if (_nc && stream && stream->seek) {
+        if (_nc->codec.step_wait) _nc->codec.step_wait(nc);
         return stream->seek(nc, pos, op);
     } else {
         return -ENOSTR;
@@ -354,6 +373,10 @@ inline int64_t ncodec_seek(NCODEC* nc, size_t pos, int32_t op)
 ncodec_tell
 ===========
 
+Return the position of the underlying stream object. A background decode
+operation (see `ncodec_step_begin`) is completed before the position is
+returned.
+
 Parameters
 ----------
 nc (NCODEC*)
@@ -375,6 +398,7 @@ inline int64_t ncodec_tell(NCODEC* nc)
     NCodecInstance* _nc = (NCodecInstance*)nc;
     NCodecStreamVTable* stream = _nc ? (NCodecStreamVTable*)_nc->stream : NULL;
     if (_nc && stream && stream->tell) {
+        if (_nc->codec.step_wait) _nc->codec.step_wait(nc);
         return stream->tell(nc);
     } else {
         return -ENOSTR;
@@ -446,3 +470,324 @@ inline void ncodec_close(NCODEC* nc)
         _nc->codec.close(nc);
     }
 }
+
+
+/**
+ncodec_step_begin
+=================
+
+Begin decoding the stream of a Network Codec, in the background, so that the
+decoded messages are ready when the model calls `ncodec_read`. Call after the
+stream content for the current step has been delivered (i.e. after the
+exchange with other Model/Devices). Any Bus Model configured on the codec is
+also progressed as part of the background operation.
+
+Messages are then read with `ncodec_read` as normal (which will wait, if
+required, for the background operation to complete). The ownership rules of
+`ncodec_read` are unchanged; message buffers remain valid until the next call
+to `ncodec_truncate`. Messages of a pipelined step cannot be read with
+`ncodec_read_ref` (the transport metadata is already decoded).
+
+Parameters
+----------
+nc (NCODEC*)
+: Network Codec object.
+
+Returns
+-------
+0
+: The background decode operation was started.
+
+-EBUSY (-16)
+: A background decode operation is already in progress.
+
+-ENOSYS (-38)
+: This function is not implemented by the codec. Messages should be read
+  with `ncodec_read`.
+
+-ENOSTR (-60)
+: The object represented by `nc` does not represent a valid stream.
+
+-ENOSR (-63)
+: No stream resource has been configured.
+*/
+inline int32_t ncodec_step_begin(NCODEC* nc)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc) {
+        if (_nc->codec.step_begin) {
+            return _nc->codec.step_begin(nc);
+        } else {
+            return -ENOSYS;
+        }
+    } else {
+        return -ENOSTR;
+    }
+}
+
+
+/**
+ncodec_step_wait
+================
+
+Wait for a background decode operation, started by `ncodec_step_begin`, to
+complete.
+
+Parameters
+----------
+nc (NCODEC*)
+: Network Codec object.
+
+Returns
+-------
+0
+: The background decode operation is complete (or was not started).
+
+-ENOSYS (-38)
+: This function is not implemented by the codec.
+
+-ENOSTR (-60)
+: The object represented by `nc` does not represent a valid stream.
+*/
+inline int32_t ncodec_step_wait(NCODEC* nc)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc) {
+        if (_nc->codec.step_wait) {
+            return _nc->codec.step_wait(nc);
+        } else {
+            return -ENOSYS;
+        }
+    } else {
+        return -ENOSTR;
+    }
+}
+
+
+/**
+ncodec_write_ref
+================
+
+Write a message, represented by a compact message descriptor (e.g.
+`NCodecPduRef`), to the Network Codec. The transport metadata of the message
+is represented by an opaque handle (obtained from `ncodec_read_ref`) and is
+copied to the Network Codec without being decoded, which is useful when
+forwarding messages. Any trace hook (`trace.write`) is called with the compact
+message descriptor. The message is written as is, codec transformations of
+`ncodec_write` (e.g. SOME/IP-TP segmentation) are not applied.
+
+Parameters
+----------
+nc (NCODEC*)
+: Network Codec object.
+
+ref (NCodecMessage*)
+: The compact message descriptor to write to the Network Codec. Caller owns
+  the message buffer/memory. Descriptor type is defined by the codec
+  implementation.
+
+Returns
+-------
+<int32_t>
+: The number of bytes written to the Network Codec.
+
+-ENOSYS (-38)
+: This function is not implemented by the codec.
+
+-ENOSTR (-60)
+: The object represented by `nc` does not represent a valid stream.
+
+-ENOSR (-63)
+: No stream resource has been configured.
+
+-EINVAL (-22)
+: Bad `ref` argument.
+*/
+inline int32_t ncodec_write_ref(NCODEC* nc, NCodecMessage* ref)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc) {
+        if (_nc->codec.write_ref) {
+            int32_t rc = _nc->codec.write_ref(nc, ref);
+            if (_nc->trace.write && (rc >= 0)) _nc->trace.write(nc, ref);
+            return rc;
+        } else {
+            return -ENOSYS;
+        }
+    } else {
+        return -ENOSTR;
+    }
+}
+
+
+/**
+ncodec_read_ref
+===============
+
+Read messages from a Network Codec, as compact message descriptors (e.g.
+`NCodecPduRef`), until the stream represented by the codec is fully consumed
+(i.e. no more messages). The transport metadata of a message is not decoded,
+instead an opaque handle to the metadata is returned. Use `ncodec_read` when
+the decoded transport metadata is required. Any trace hook (`trace.read`) is
+called with the compact message descriptor.
+
+The codec owns the message buffer/memory (including the metadata handle)
+returned by this function, and they remain valid until the next call to
+`ncodec_truncate`.
+
+Parameters
+----------
+nc (NCODEC*)
+: Network Codec object.
+
+ref (NCodecMessage*)
+: (out) The compact message descriptor. Descriptor type is defined by the
+  codec implementation.
+
+Returns
+-------
+<int32_t>
+: The number of bytes read from the Network Codec.
+  Additional messages may remain on the Network Codec, after processing this
+  message, repeat calls to `ncodec_read_ref` until -ENOMSG is returned.
+
+-ENOMSG (-42)
+: No message is available from the Network Codec.
+
+-EBUSY (-16)
+: A pipelined step is in progress (see `ncodec_step_begin`), the messages
+  were already decoded and should be read with `ncodec_read`.
+
+-ENOSYS (-38)
+: This function is not implemented by the codec.
+
+-ENOSTR (-60)
+: The object represented by `nc` does not represent a valid stream.
+
+-ENOSR (-63)
+: No stream resource has been configured.
+
+-EINVAL (-22)
+: Bad `ref` argument.
+*/
+inline int32_t ncodec_read_ref(NCODEC* nc, NCodecMessage* ref)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc) {
+        if (_nc->codec.read_ref) {
+            int32_t rc = _nc->codec.read_ref(nc, ref);
+            if (_nc->trace.read && (rc >= 0)) _nc->trace.read(nc, ref);
+            return rc;
+        } else {
+            return -ENOSYS;
+        }
+    } else {
+        return -ENOSTR;
+    }
+}
+
+
+/**
+ncodec_snapshot
+===============
+
+Take a snapshot of the internal state of a Network Codec, including the state
+of any Bus Model operated by the codec. The snapshot can later be applied to
+this (or another identically configured) Network Codec with `ncodec_restore`.
+
+A snapshot is only possible at a step boundary, that is, after all messages
+have been read from the Network Codec (or after a call to `ncodec_truncate`)
+and before any messages are written. The content of the stream is not part
+of the snapshot.
+
+Parameters
+----------
+nc (NCODEC*)
+: Network Codec object.
+
+data (void**)
+: (out) The snapshot data. Caller owns the buffer and should call `free`.
+
+len (size_t*)
+: (out) The length of the snapshot data.
+
+Returns
+-------
+0
+: The snapshot was taken.
+
+-ENOSYS (-38)
+: This function is not implemented by the codec (or the Bus Model).
+
+-ENOSTR (-60)
+: The object represented by `nc` does not represent a valid stream.
+
+-EBUSY (-16)
+: The Network Codec is not at a step boundary.
+
+-EINVAL (-22)
+: Bad `data` or `len` argument.
+*/
+inline int32_t ncodec_snapshot(NCODEC* nc, void** data, size_t* len)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc) {
+        if (_nc->codec.snapshot) {
+            return _nc->codec.snapshot(nc, data, len);
+        } else {
+            return -ENOSYS;
+        }
+    } else {
+        return -ENOSTR;
+    }
+}
+
+
+/**
+ncodec_restore
+==============
+
+Restore the internal state of a Network Codec from a snapshot previously
+taken with `ncodec_snapshot`. The Network Codec should be configured with
+the same MIME type as the Network Codec from which the snapshot was taken.
+Any messages pending in the Network Codec are discarded.
+
+Parameters
+----------
+nc (NCODEC*)
+: Network Codec object.
+
+data (const void*)
+: The snapshot data. Caller owns the buffer.
+
+len (size_t)
+: The length of the snapshot data.
+
+Returns
+-------
+0
+: The snapshot was restored.
+
+-ENOSYS (-38)
+: This function is not implemented by the codec (or the Bus Model).
+
+-ENOSTR (-60)
+: The object represented by `nc` does not represent a valid stream.
+
+-EINVAL (-22)
+: The snapshot data is not valid for this Network Codec (the state of the
+  Network Codec is not changed).
+*/
+inline int32_t ncodec_restore(NCODEC* nc, const void* data, size_t len)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc) {
+        if (_nc->codec.restore) {
+            return _nc->codec.restore(nc, data, len);
+        } else {
+            return -ENOSYS;
+        }
+    } else {
+        return -ENOSTR;
+    }
+}
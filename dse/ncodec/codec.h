@@ -172,6 +172,12 @@ typedef int32_t (*NCodecFlush)(NCODEC* nc);
 typedef int32_t (*NCodecTruncate)(NCODEC* nc);
 typedef int32_t (*NCodecUtime)(NCODEC* nc, NCodecUtimeOperation op);
 typedef void (*NCodecClose)(NCODEC* nc);
+typedef int32_t (*NCodecStepBegin)(NCODEC* nc);
+typedef int32_t (*NCodecStepWait)(NCODEC* nc);
+typedef int32_t (*NCodecWriteRef)(NCODEC* nc, NCodecMessage* ref);
+typedef int32_t (*NCodecReadRef)(NCODEC* nc, NCodecMessage* ref);
+typedef int32_t (*NCodecSnapshot)(NCODEC* nc, void** data, size_t* len);
+typedef int32_t (*NCodecRestore)(NCODEC* nc, const void* data, size_t len);
 
 typedef struct NCodecVTable {
     NCodecConfig   config;
@@ -182,6 +188,18 @@ typedef struct NCodecVTable {
     NCodecTruncate truncate;
     NCodecUtime    utime;
     NCodecClose    close;
+
+    /* Pipelined step (optional). */
+    NCodecStepBegin step_begin;
+    NCodecStepWait  step_wait;
+
+    /* Compact message descriptor (optional). */
+    NCodecWriteRef write_ref;
+    NCodecReadRef  read_ref;
+
+    /* Snapshot and restore of codec state (optional). */
+    NCodecSnapshot snapshot;
+    NCodecRestore  restore;
 } NCodecVTable;
 
 
@@ -237,5 +255,12 @@ DLL_PUBLIC void             ncodec_close(NCODEC* nc);
 DLL_PUBLIC int64_t          ncodec_seek(NCODEC* nc, size_t pos, int32_t op);
 DLL_PUBLIC int64_t          ncodec_tell(NCODEC* nc);
 DLL_PUBLIC int32_t          ncodec_utime(NCODEC* nc, NCodecUtimeOperation op);
+DLL_PUBLIC int32_t          ncodec_step_begin(NCODEC* nc);
+DLL_PUBLIC int32_t          ncodec_step_wait(NCODEC* nc);
+DLL_PUBLIC int32_t          ncodec_write_ref(NCODEC* nc, NCodecMessage* ref);
+DLL_PUBLIC int32_t          ncodec_read_ref(NCODEC* nc, NCodecMessage* ref);
+
+DLL_PUBLIC int32_t ncodec_snapshot(NCODEC* nc, void** data, size_t* len);
+DLL_PUBLIC int32_t ncodec_restore(NCODEC* nc, const void* data, size_t len);
 
 #endif  // DSE_NCODEC_CODEC_H_
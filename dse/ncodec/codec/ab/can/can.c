@@ -0,0 +1,340 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/codec/ab/can/can.h>
+
+
+#define NSEC_PER_SEC 1000000000.0
+
+
+/* Arbitration priority of a frame (lowest key wins). The key follows the
+order of bits on the bus: base identifier, RTR/SRR, IDE, extended identifier
+and (extended) RTR. A base frame wins against an extended frame with the same
+base identifier, and a data frame wins against a remote frame. */
+uint64_t can_frame_key(uint32_t id, NCodecPduCanFrameFormat frame_format,
+    NCodecPduCanFrameType frame_type)
+{
+    bool ext = (frame_format == NCodecPduCanFrameFormatExtended ||
+                frame_format == NCodecPduCanFrameFormatFdExtended);
+    bool rtr = (frame_type == NCodecPduCanFrameTypeRemote);
+
+    if (ext) {
+        uint64_t base = (id >> 18) & 0x7ff;
+        return (base << 21) | (1ull << 20) | (1ull << 19) |
+               ((uint64_t)(id & 0x3ffff) << 1) | rtr;
+    } else {
+        uint64_t base = id & 0x7ff;
+        return (base << 21) | ((uint64_t)rtr << 20);
+    }
+}
+
+
+static size_t _fd_payload_length(size_t len)
+{
+    static const size_t dlc_len[] = { 8, 12, 16, 20, 24, 32, 48, 64 };
+    if (len <= 8) return len;
+    for (size_t i = 0; i < sizeof(dlc_len) / sizeof(dlc_len[0]); i++) {
+        if (len <= dlc_len[i]) return dlc_len[i];
+    }
+    return CAN_FD_MAX_PAYLOAD;
+}
+
+
+/* Bits of a frame on the bus, including worst-case stuff bits. Returns the
+bits sent at the nominal bit rate, data_bits (optional) is set to the bits
+sent at the data bit rate (CAN FD with bit rate switch).
+
+    CAN:    g + 8s + 13 + floor((g + 8s - 1) / 4)  g = 34 (base), 54 (ext)
+    CAN FD: arbitration phase (nominal) + data phase (data bit rate)
+*/
+uint32_t can_frame_bits(NCodecPduCanFrameFormat frame_format,
+    NCodecPduCanFrameType frame_type, size_t payload_len, uint32_t* data_bits)
+{
+    bool ext = (frame_format == NCodecPduCanFrameFormatExtended ||
+                frame_format == NCodecPduCanFrameFormatFdExtended);
+    bool fd = (frame_format == NCodecPduCanFrameFormatFdBase ||
+               frame_format == NCodecPduCanFrameFormatFdExtended);
+    if (data_bits) *data_bits = 0;
+
+    if (fd == false) {
+        uint32_t s = (payload_len > 8) ? 8 : (uint32_t)payload_len;
+        if (frame_type == NCodecPduCanFrameTypeRemote) s = 0;
+        uint32_t g = ext ? 54 : 34;
+        return g + 8 * s + 13 + (g + 8 * s - 1) / 4;
+    }
+
+    /* Arbitration phase: SOF, ID, (SRR, IDE, ID ext), RRS, IDE, FDF, res,
+    BRS, then CRC delimiter, ACK, EOF and IFS. */
+    uint32_t arb = ext ? 36 : 17;
+    uint32_t nominal = arb + (arb - 1) / 4 + 13;
+    /* Data phase: ESI, DLC, data, stuff count and CRC (with fixed stuff
+    bits). */
+    uint32_t s = (uint32_t)_fd_payload_length(payload_len);
+    uint32_t crc = (s <= 16) ? 17 : 21;
+    uint32_t fsb = (s <= 16) ? 6 : 7;
+    uint32_t ctrl = 1 + 4 + 8 * s;
+    if (data_bits) *data_bits = ctrl + ctrl / 4 + 4 + crc + fsb;
+    return nominal;
+}
+
+
+uint64_t can_frame_duration_ns(CanBusModel* m,
+    NCodecPduCanFrameFormat frame_format, NCodecPduCanFrameType frame_type,
+    size_t payload_len)
+{
+    uint32_t data_bits = 0;
+    uint32_t bits =
+        can_frame_bits(frame_format, frame_type, payload_len, &data_bits);
+    uint32_t fd_bitrate = m->fd_bitrate ? m->fd_bitrate : m->bitrate;
+    double   ns = (bits * NSEC_PER_SEC) / m->bitrate +
+                (data_bits * NSEC_PER_SEC) / fd_bitrate;
+    return (uint64_t)llround(ns);
+}
+
+
+/* Arbitration queue (binary min-heap), O(log n) push and pop. */
+static inline bool _frame_less(CanFrame* a, CanFrame* b)
+{
+    if (a->key != b->key) return a->key < b->key;
+    return a->seq < b->seq;
+}
+
+static inline void _frame_swap(CanFrame* a, CanFrame* b)
+{
+    CanFrame t = *a;
+    *a = *b;
+    *b = t;
+}
+
+int can_queue_push(CanBusModel* m, CanFrame* frame)
+{
+    frame->seq = m->seq++;
+    if (vector_push(&m->queue, frame)) return -ENOMEM;
+
+    size_t i = vector_len(&m->queue) - 1;
+    while (i > 0) {
+        size_t    parent = (i - 1) / 2;
+        CanFrame* f = vector_at(&m->queue, i, NULL);
+        CanFrame* p = vector_at(&m->queue, parent, NULL);
+        if (!_frame_less(f, p)) break;
+        _frame_swap(f, p);
+        i = parent;
+    }
+    return 0;
+}
+
+int can_queue_pop(CanBusModel* m, CanFrame* frame)
+{
+    size_t len = vector_len(&m->queue);
+    if (len == 0) return -ENOMSG;
+
+    vector_at(&m->queue, 0, frame);
+    CanFrame last;
+    vector_pop(&m->queue, &last);
+    if (--len == 0) return 0;
+
+    CanFrame* root = vector_at(&m->queue, 0, NULL);
+    *root = last;
+    size_t i = 0;
+    for (;;) {
+        size_t    l = 2 * i + 1;
+        size_t    r = l + 1;
+        size_t    min = i;
+        CanFrame* f_min = vector_at(&m->queue, min, NULL);
+        if (l < len && _frame_less(vector_at(&m->queue, l, NULL), f_min)) {
+            min = l;
+            f_min = vector_at(&m->queue, min, NULL);
+        }
+        if (r < len && _frame_less(vector_at(&m->queue, r, NULL), f_min)) {
+            min = r;
+        }
+        if (min == i) break;
+        _frame_swap(vector_at(&m->queue, i, NULL),
+            vector_at(&m->queue, min, NULL));
+        i = min;
+    }
+    return 0;
+}
+
+
+bool can_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu)
+{
+    if (pdu->transport_type != NCodecPduTransportTypeCan) return false;
+
+    CanBusModel* m = (CanBusModel*)bm->model;
+    NCodecPduCanMessageMetadata* can_message = &pdu->transport.can_message;
+    CanFrame                     frame = {
+                            .key = can_frame_key(
+                pdu->id, can_message->frame_format, can_message->frame_type),
+                            .duration_ns = can_frame_duration_ns(m,
+                can_message->frame_format, can_message->frame_type,
+                pdu->payload_len),
+                            .id = pdu->id,
+                            .swc_id = pdu->swc_id,
+                            .ecu_id = pdu->ecu_id,
+                            .can_message = *can_message,
+    };
+    frame.payload_len = (pdu->payload_len > CAN_FD_MAX_PAYLOAD)
+                            ? CAN_FD_MAX_PAYLOAD
+                            : (uint8_t)pdu->payload_len;
+    if (pdu->payload && frame.payload_len) {
+        memcpy(frame.payload, pdu->payload, frame.payload_len);
+    }
+    if (can_queue_push(m, &frame)) {
+        log_error(bm->log_nc, "CAN: Consume: queue push failed (id=%x)",
+            pdu->id);
+    }
+    log_trace(bm->log_nc, "CAN: Consume: id=%x len=%u duration=%luns",
+        pdu->id, frame.payload_len, (unsigned long)frame.duration_ns);
+
+    return true;
+}
+
+static void _deliver(ABCodecBusModel* bm, CanFrame* frame)
+{
+    CanBusModel* m = (CanBusModel*)bm->model;
+    m->stats.frame_count++;
+
+    /* Filter: sender==receiver (the frame still occupies the bus). */
+    ABCodecInstance* nc = bm->log_nc;
+    if (nc->swc_id && nc->swc_id == frame->swc_id && nc->loopback == false) {
+        return;
+    }
+    ncodec_write((NCODEC*)bm->nc,
+        &(NCodecPdu){ .id = frame->id,
+            .payload = frame->payload,
+            .payload_len = frame->payload_len,
+            .swc_id = frame->swc_id,
+            .ecu_id = frame->ecu_id,
+            .transport_type = NCodecPduTransportTypeCan,
+            .transport.can_message = frame->can_message });
+}
+
+/* Transmit frames, in arbitration order, until the step is complete. A frame
+which does not complete within the step remains on the bus (in transmission)
+and is delivered in a following step; it can not be overtaken by a frame
+which arrives later with a higher priority. */
+void can_bus_model_progress(ABCodecBusModel* bm)
+{
+    CanBusModel* m = (CanBusModel*)bm->model;
+    uint64_t     step_ns = (uint64_t)llround(bm->step_size * NSEC_PER_SEC);
+    uint64_t     step_end = m->bus.time_ns + step_ns;
+    uint64_t     cursor = m->bus.cursor_ns;
+    if (cursor < m->bus.time_ns) cursor = m->bus.time_ns; /* Bus idle. */
+
+    if (m->bus.active && cursor <= step_end) {
+        _deliver(bm, &m->bus.tx);
+        m->bus.active = false;
+    }
+    CanFrame frame;
+    while (m->bus.active == false && cursor < step_end &&
+           can_queue_pop(m, &frame) == 0) {
+        cursor += frame.duration_ns;
+        if (cursor <= step_end) {
+            _deliver(bm, &frame);
+        } else {
+            m->bus.tx = frame;
+            m->bus.active = true;
+        }
+    }
+
+    /* Bus load. */
+    uint64_t busy_ns = ((cursor < step_end) ? cursor : step_end) -
+                       m->bus.time_ns;
+    m->stats.busy_ns += busy_ns;
+    m->stats.elapsed_ns += step_ns;
+    m->stats.step_load = step_ns ? (double)busy_ns / step_ns : 0.0;
+    log_trace(bm->log_nc, "CAN: Progress: load=%.2f queue=%u", m->stats.step_load,
+        vector_len(&m->queue));
+
+    m->bus.cursor_ns = cursor;
+    m->bus.time_ns = step_end;
+}
+
+void can_bus_model_close(ABCodecBusModel* bm)
+{
+    CanBusModel* m = (CanBusModel*)bm->model;
+    vector_reset(&m->queue);
+}
+
+int can_bus_model_snapshot(ABCodecBusModel* bm, ABCodecSnapshot* s)
+{
+    CanBusModel* m = (CanBusModel*)bm->model;
+    int          rc = 0;
+    rc |= snapshot_write(s, &m->seq, sizeof(m->seq));
+    rc |= snapshot_write(s, &m->bus, sizeof(m->bus));
+    rc |= snapshot_write(s, &m->stats, sizeof(m->stats));
+    rc |= snapshot_write_vector(s, &m->queue, sizeof(CanFrame));
+    return rc;
+}
+
+int can_bus_model_restore(ABCodecBusModel* bm, ABCodecSnapshot* s)
+{
+    CanBusModel* m = (CanBusModel*)bm->model;
+    CanBusModel  restored = { 0 };
+    if (snapshot_read(s, &restored.seq, sizeof(restored.seq)) ||
+        snapshot_read(s, &restored.bus, sizeof(restored.bus)) ||
+        snapshot_read(s, &restored.stats, sizeof(restored.stats)) ||
+        snapshot_read_vector(s, &restored.queue, sizeof(CanFrame), NULL)) {
+        return -EINVAL;
+    }
+    /* The queue is a heap, items are restored in their original order. */
+    vector_reset(&m->queue);
+    m->queue = restored.queue;
+    m->seq = restored.seq;
+    m->bus = restored.bus;
+    m->stats = restored.stats;
+    return 0;
+}
+
+static void _bus_model_init(
+    ABCodecInstance* nc, ABCodecBusModel* bm, uint32_t network_id)
+{
+    /* Install the logging interface. */
+    bm->log_nc = nc;
+
+    /* Set the step_size (initial value, may change in operation). */
+    bm->step_size = nc->simulation_time.step_size;
+
+    /* Install the Bus Model object. */
+    CanBusModel* m = calloc(1, sizeof(CanBusModel));
+    m->bitrate = nc->bitrate ? nc->bitrate : CAN_DEFAULT_BITRATE;
+    m->fd_bitrate = nc->fd_bitrate ? nc->fd_bitrate : CAN_DEFAULT_FD_BITRATE;
+    m->network_id = network_id;
+    m->queue = vector_make(sizeof(CanFrame), 0, NULL);
+    bm->model = m;
+    bm->network_id = network_id;
+
+    /* Configure the Bus Model VTable. */
+    bm->vtable.consume = can_bus_model_consume;
+    bm->vtable.progress = can_bus_model_progress;
+    bm->vtable.close = can_bus_model_close;
+    bm->vtable.snapshot = can_bus_model_snapshot;
+    bm->vtable.restore = can_bus_model_restore;
+}
+
+void can_bus_model_create(ABCodecInstance* nc)
+{
+    /* Install the duplicated NC object. */
+    nc->reader.bus_model.nc = _ab_nc_copy(nc);
+
+    _bus_model_init(nc, &nc->reader.bus_model, nc->bus_id);
+}
+
+void can_bus_model_create_network(
+    ABCodecInstance* nc, ABCodecBusModel* bm, uint32_t network_id)
+{
+    /* Multi-bus, one Bus Model per CAN network (network_id). All networks
+    share the NC object (Stream) of the primary Bus Model. */
+    bm->nc = nc->reader.bus_model.nc;
+
+    _bus_model_init(nc, bm, network_id);
+}
@@ -0,0 +1,75 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DSE_NCODEC_CODEC_AB_CAN_CAN_H_
+#define DSE_NCODEC_CODEC_AB_CAN_CAN_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <dse/clib/collections/vector.h>
+#include <dse/ncodec/interface/pdu.h>
+
+#define CAN_DEFAULT_BITRATE    500000  /* Nominal (arbitration) bit rate. */
+#define CAN_DEFAULT_FD_BITRATE 2000000 /* CAN FD data phase bit rate. */
+#define CAN_FD_MAX_PAYLOAD     64
+
+
+/* A frame pending arbitration (or in transmission) on the bus. */
+typedef struct CanFrame {
+    uint64_t key; /* Arbitration priority, lowest wins (see can_frame_key). */
+    uint64_t seq; /* Queue order, equal keys are sent in FIFO order. */
+    uint64_t duration_ns; /* Transmission time on the bus. */
+
+    /* PDU content. */
+    uint32_t                    id;
+    uint32_t                    swc_id;
+    uint32_t                    ecu_id;
+    NCodecPduCanMessageMetadata can_message;
+    uint8_t                     payload_len;
+    uint8_t                     payload[CAN_FD_MAX_PAYLOAD];
+} CanFrame;
+
+
+typedef struct CanBusModel {
+    /* Configuration. */
+    uint32_t bitrate;
+    uint32_t fd_bitrate;
+    uint32_t network_id;
+
+    /* Arbitration queue, binary min-heap of CanFrame (on key, seq). */
+    Vector   queue;
+    uint64_t seq;
+
+    /* Bus position. */
+    struct {
+        uint64_t time_ns;   /* Start of the current step. */
+        uint64_t cursor_ns; /* End of the last (or current) transmission. */
+        bool     active;    /* A frame is in transmission (tx). */
+        CanFrame tx;
+    } bus;
+
+    /* Bus load. */
+    struct {
+        uint64_t frame_count; /* Frames transmitted. */
+        uint64_t busy_ns;     /* Time the bus was occupied. */
+        uint64_t elapsed_ns;  /* Time simulated. */
+        double   step_load;   /* Bus load (0..1) of the last step. */
+    } stats;
+} CanBusModel;
+
+
+/* can.c */
+uint64_t can_frame_key(uint32_t id, NCodecPduCanFrameFormat frame_format,
+    NCodecPduCanFrameType frame_type);
+uint32_t can_frame_bits(NCodecPduCanFrameFormat frame_format,
+    NCodecPduCanFrameType frame_type, size_t payload_len, uint32_t* data_bits);
+uint64_t can_frame_duration_ns(CanBusModel* m,
+    NCodecPduCanFrameFormat frame_format, NCodecPduCanFrameType frame_type,
+    size_t payload_len);
+int      can_queue_push(CanBusModel* m, CanFrame* frame);
+int      can_queue_pop(CanBusModel* m, CanFrame* frame);
+
+
+#endif  // DSE_NCODEC_CODEC_AB_CAN_CAN_H_
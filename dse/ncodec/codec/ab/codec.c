@@ -7,8 +7,10 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdio.h>
+#include <errno.h>
 #include <dse/ncodec/codec.h>
 #include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
 
 
 #define UNUSED(x)             ((void)x)
@@ -28,9 +30,35 @@ extern int32_t pdu_read(NCODEC* nc, NCodecMessage* msg);
 extern int32_t pdu_flush(NCODEC* nc);
 extern int32_t pdu_truncate(NCODEC* nc);
 extern int32_t pdu_utime(NCODEC* nc, NCodecUtimeOperation op);
+extern int32_t pdu_write_ref(NCODEC* nc, NCodecMessage* ref);
+extern int32_t pdu_read_ref(NCODEC* nc, NCodecMessage* ref);
+extern int32_t pdu_step_begin(NCODEC* nc);
+extern int32_t pdu_step_wait(NCODEC* nc);
+extern void    pdu_step_destroy(ABCodecInstance* nc);
+extern void    some_ip_tp_destroy(ABCodecInstance* nc);
+extern int32_t pdu_snapshot(NCODEC* nc, void** data, size_t* len);
+extern int32_t pdu_restore(NCODEC* nc, const void* data, size_t len);
+
+/* interface=stream; type=register; bus=can|flexray|ethernet; schema=fbs */
+extern int32_t register_write(NCODEC* nc, NCodecMessage* msg);
+extern int32_t register_read(NCODEC* nc, NCodecMessage* msg);
+extern int32_t register_flush(NCODEC* nc);
+extern int32_t register_truncate(NCODEC* nc);
+
+/* interface=stream; type=signal; schema=fbs */
+extern int32_t signal_write(NCODEC* nc, NCodecMessage* msg);
+extern int32_t signal_read(NCODEC* nc, NCodecMessage* msg);
+extern int32_t signal_flush(NCODEC* nc);
+extern int32_t signal_truncate(NCODEC* nc);
 
 extern void flexray_bus_model_create(ABCodecInstance* nc);
+extern void flexray_bus_model_create_network(
+    ABCodecInstance* nc, ABCodecBusModel* bm, uint32_t network_id);
 extern void flexray_pop_bus_model_create(ABCodecInstance* nc);
+extern void can_bus_model_create(ABCodecInstance* nc);
+extern void can_bus_model_create_network(
+    ABCodecInstance* nc, ABCodecBusModel* bm, uint32_t network_id);
+extern void ethernet_bus_model_create(ABCodecInstance* nc);
 
 
 char* trim(char* s)
@@ -64,6 +92,75 @@ void destroy_free_list(ABCodecInstance* _nc)
     vector_reset(&_nc->free_list);
 }
 
+/* Copy the finalized Stream (from the builder) to the flush buffer. The flush
+buffer is retained, and only grows, to avoid an allocation on each flush. */
+uint8_t* copy_stream_buffer(ABCodecInstance* nc, size_t* length)
+{
+    flatcc_builder_t* B = &nc->fbs_builder;
+    size_t            size = flatcc_builder_get_buffer_size(B);
+    if (size > nc->fbs_buffer_size) {
+        uint8_t* buffer = realloc(nc->fbs_buffer, size);
+        if (buffer == NULL) {
+            log_error(nc, "Flush buffer allocation failed (size=%zu)", size);
+            *length = 0;
+            return NULL;
+        }
+        nc->fbs_buffer = buffer;
+        nc->fbs_buffer_size = size;
+    }
+    if (flatcc_builder_copy_buffer(B, nc->fbs_buffer, size) == NULL) {
+        *length = 0;
+        return NULL;
+    }
+    *length = size;
+    return nc->fbs_buffer;
+}
+
+/* Create an NC object for a Bus Model (or trace), with its own Stream. */
+ABCodecInstance* _ab_nc_copy(ABCodecInstance* nc)
+{
+    /* Shallow copy the nc object. */
+    ABCodecInstance* nc_copy = calloc(1, sizeof(ABCodecInstance));
+    *nc_copy = *nc;
+    nc_copy->c.stream = NULL;
+    nc_copy->c.trace = (NCodecTraceVTable){ 0 };
+    nc_copy->c.private = NULL;
+    nc_copy->model = NULL;
+    nc_copy->fbs_builder = (flatcc_builder_t){ 0 };
+    nc_copy->fbs_builder_initalized = false;
+    nc_copy->fbs_stream_initalized = false;
+    nc_copy->fbs_buffer = NULL;
+    nc_copy->fbs_buffer_size = 0;
+    nc_copy->chunk_bytes = 0;
+    nc_copy->chunk_pdus = 0;
+    nc_copy->chunk_bytes_str = NULL;
+    nc_copy->chunk_pdus_str = NULL;
+    nc_copy->chunk.pdu_count = 0;
+    nc_copy->chunk.buffer = NULL;
+    nc_copy->chunk.size = 0;
+    nc_copy->chunk.length = 0;
+    nc_copy->reader = (ABCodecReader){ 0 };
+    nc_copy->step = (ABCodecStep){ 0 };
+    nc_copy->free_list = (Vector){ 0 };
+    nc_copy->register_list = (Vector){ 0 };
+    nc_copy->signal.uid = NULL;
+    nc_copy->signal.value = NULL;
+    nc_copy->signal.capacity = 0;
+    nc_copy->tp.slots = (Vector){ 0 };
+    nc_copy->trace.filename = NULL;
+    nc_copy->trace.file = NULL;
+
+    /* Rebuild various objects in the model NC. */
+    enum { BUFFER_LEN = 1024 };
+    flatcc_builder_init(&nc_copy->fbs_builder);
+    nc_copy->fbs_builder.buffer_flags |= flatcc_builder_with_size;
+    nc_copy->fbs_stream_initalized = false;
+    nc_copy->fbs_builder_initalized = true;
+    nc_copy->c.stream = ncodec_buffer_stream_create(BUFFER_LEN);
+
+    return nc_copy;
+}
+
 void free_codec(ABCodecInstance* _nc)
 {
     if (_nc == NULL) return;
@@ -86,8 +183,29 @@ void free_codec(ABCodecInstance* _nc)
     if (_nc->poc_state_cha_str) free(_nc->poc_state_cha_str);
     if (_nc->poc_state_chb_str) free(_nc->poc_state_chb_str);
     if (_nc->loopback_str) free(_nc->loopback_str);
+    if (_nc->chunk_bytes_str) free(_nc->chunk_bytes_str);
+    if (_nc->chunk_pdus_str) free(_nc->chunk_pdus_str);
+    if (_nc->networks_str) free(_nc->networks_str);
+    if (_nc->model_uid_str) free(_nc->model_uid_str);
+    if (_nc->bitrate_str) free(_nc->bitrate_str);
+    if (_nc->fd_bitrate_str) free(_nc->fd_bitrate_str);
+    if (_nc->tp_segment_size_str) free(_nc->tp_segment_size_str);
+    if (_nc->cluster) free(_nc->cluster);
+    if (_nc->tp_slots_str) free(_nc->tp_slots_str);
+    if (_nc->tp_timeout_str) free(_nc->tp_timeout_str);
+
+    /* Stop the step worker before releasing any resources it may use. */
+    pdu_step_destroy(_nc);
 
     if (_nc->fbs_builder_initalized) flatcc_builder_clear(&_nc->fbs_builder);
+    free(_nc->fbs_buffer);
+    free(_nc->chunk.buffer);
+    vector_reset(&_nc->register_list);
+    free(_nc->signal.uid);
+    free(_nc->signal.value);
+#if NCODEC_AB_TRANSPORT_IP
+    some_ip_tp_destroy(_nc);
+#endif
 
     /* The Bus Model NCodec object is a shallow copy, only free the
     specifically allocated resources. */
@@ -96,6 +214,7 @@ void free_codec(ABCodecInstance* _nc)
         if (_nc->reader.bus_model.nc->fbs_builder_initalized) {
             flatcc_builder_clear(&_nc->reader.bus_model.nc->fbs_builder);
         }
+        free(_nc->reader.bus_model.nc->fbs_buffer);
         NCodecStreamVTable* stream =
             (NCodecStreamVTable*)_nc->reader.bus_model.nc->c.stream;
         stream->close((NCODEC*)_nc->reader.bus_model.nc);
@@ -106,11 +225,23 @@ void free_codec(ABCodecInstance* _nc)
         if (_nc->reader.bus_model.trace.nc->fbs_builder_initalized) {
             flatcc_builder_clear(&_nc->reader.bus_model.trace.nc->fbs_builder);
         }
+        free(_nc->reader.bus_model.trace.nc->fbs_buffer);
         NCodecStreamVTable* stream =
             (NCodecStreamVTable*)_nc->reader.bus_model.trace.nc->c.stream;
         stream->close((NCODEC*)_nc->reader.bus_model.trace.nc);
         free(_nc->reader.bus_model.trace.nc);
     }
+    /* Multi-bus, the network Bus Models share the Bus Model NCodec objects
+    (already released). */
+    for (size_t i = 0; i < _nc->reader.network_count; i++) {
+        ABCodecBusModel* bm = &_nc->reader.networks[i];
+        if (bm->model == NULL) continue;
+        if (bm->vtable.close) bm->vtable.close(bm);
+        free(bm->model);
+    }
+    free(_nc->reader.networks);
+    _nc->reader.networks = NULL;
+    _nc->reader.network_count = 0;
     if (_nc->reader.bus_model.model != NULL) {
         if (_nc->reader.bus_model.vtable.close) {
             _nc->reader.bus_model.vtable.close(&_nc->reader.bus_model);
@@ -120,21 +251,101 @@ void free_codec(ABCodecInstance* _nc)
     destroy_free_list(_nc);
 }
 
+/* Multi-bus: create an additional Bus Model for each network listed by the
+`networks` parameter (e.g. networks=2,3). The range of a network id depends
+on the Bus Model (max_network_id). */
+static void create_networks(ABCodecInstance* nc,
+    void (*create)(ABCodecInstance*, ABCodecBusModel*, uint32_t),
+    uint32_t max_network_id)
+{
+    if (nc->networks_str == NULL) return;
+    if (nc->reader.bus_model.model == NULL) return;
+
+    /* Validate the list, each item is a network (decimal). Invalid items and
+    duplicates (including the primary network) are logged and ignored. */
+    size_t count = 1;
+    for (const char* p = nc->networks_str; *p; p++) {
+        if (*p == ',') count++;
+    }
+    uint32_t* network_ids = calloc(count, sizeof(uint32_t));
+    char*     _buf = strdup(nc->networks_str);
+    size_t    network_count = 0;
+    for (char* _item = _buf; _item;) {
+        char* _next = strchr(_item, ',');
+        if (_next) *_next++ = '\0';
+        char* s = trim(_item);
+        _item = _next;
+
+        char*         end = NULL;
+        unsigned long network_id = 0;
+        errno = 0;
+        if (isdigit((unsigned char)*s)) network_id = strtoul(s, &end, 10);
+        if (end == NULL || *end != '\0' || errno != 0 ||
+            network_id > max_network_id) {
+            log_error(nc, "Multi-bus: invalid network (%s)", s);
+            continue;
+        }
+        bool duplicate = (network_id == nc->reader.bus_model.network_id);
+        for (size_t i = 0; i < network_count; i++) {
+            if (network_ids[i] == network_id) duplicate = true;
+        }
+        if (duplicate) {
+            log_error(nc, "Multi-bus: duplicate network (%lu)", network_id);
+            continue;
+        }
+        network_ids[network_count++] = (uint32_t)network_id;
+    }
+    free(_buf);
+
+    /* Create the additional networks (the primary network is the reader
+    Bus Model). */
+    if (network_count) {
+        nc->reader.networks = calloc(network_count, sizeof(ABCodecBusModel));
+        for (size_t i = 0; i < network_count; i++) {
+            create(nc, &nc->reader.networks[nc->reader.network_count++],
+                network_ids[i]);
+        }
+    }
+    free(network_ids);
+}
+
 void create_bus_model(ABCodecInstance* nc)
 {
     if (strcmp(nc->type, "pdu") == 0) {
+#if NCODEC_AB_TRANSPORT_FLEXRAY
         if (nc->model && strcmp(nc->model, "flexray") == 0) {
             if (nc->mode) {
                 if (strcmp(nc->mode, "pop") == 0) {
                     flexray_pop_bus_model_create(nc);
+                    if (nc->networks_str) {
+                        log_error(nc, "Multi-bus not supported (mode=pop)");
+                    }
                 } else {
                     log_fatal(
                         nc, "Unknown FlexRay bus model mode: %s", nc->mode);
                 }
             } else {
                 flexray_bus_model_create(nc);
+                /* Networks are keyed by cc_id (node_ident). */
+                create_networks(
+                    nc, flexray_bus_model_create_network, UINT16_MAX);
             }
         }
+#endif
+#if NCODEC_AB_TRANSPORT_CAN
+        if (nc->model && strcmp(nc->model, "can") == 0) {
+            can_bus_model_create(nc);
+            create_networks(nc, can_bus_model_create_network, UINT32_MAX);
+        }
+#endif
+#if NCODEC_AB_TRANSPORT_IP
+        if (nc->model && strcmp(nc->model, "ethernet") == 0) {
+            ethernet_bus_model_create(nc);
+            if (nc->networks_str) {
+                log_error(nc, "Multi-bus not supported (model=ethernet)");
+            }
+        }
+#endif
     }
 }
 
@@ -247,6 +458,64 @@ int32_t codec_config(NCODEC* nc, NCodecConfigItem item)
         _nc->loopback = strtoul(item.value, NULL, 10);
         return 0;
     }
+    if (strcmp(item.name, "chunk_bytes") == 0) {
+        if (_nc->chunk_bytes_str) free(_nc->chunk_bytes_str);
+        _nc->chunk_bytes_str = strdup(item.value);
+        _nc->chunk_bytes = strtoul(item.value, NULL, 10);
+        return 0;
+    }
+    if (strcmp(item.name, "chunk_pdus") == 0) {
+        if (_nc->chunk_pdus_str) free(_nc->chunk_pdus_str);
+        _nc->chunk_pdus_str = strdup(item.value);
+        _nc->chunk_pdus = strtoul(item.value, NULL, 10);
+        return 0;
+    }
+    if (strcmp(item.name, "networks") == 0) {
+        if (_nc->networks_str) free(_nc->networks_str);
+        _nc->networks_str = strdup(item.value);
+        return 0;
+    }
+    if (strcmp(item.name, "model_uid") == 0) {
+        if (_nc->model_uid_str) free(_nc->model_uid_str);
+        _nc->model_uid_str = strdup(item.value);
+        _nc->model_uid = strtoul(item.value, NULL, 10);
+        return 0;
+    }
+    if (strcmp(item.name, "bitrate") == 0) {
+        if (_nc->bitrate_str) free(_nc->bitrate_str);
+        _nc->bitrate_str = strdup(item.value);
+        _nc->bitrate = strtoul(item.value, NULL, 10);
+        return 0;
+    }
+    if (strcmp(item.name, "fd_bitrate") == 0) {
+        if (_nc->fd_bitrate_str) free(_nc->fd_bitrate_str);
+        _nc->fd_bitrate_str = strdup(item.value);
+        _nc->fd_bitrate = strtoul(item.value, NULL, 10);
+        return 0;
+    }
+    if (strcmp(item.name, "tp_segment_size") == 0) {
+        if (_nc->tp_segment_size_str) free(_nc->tp_segment_size_str);
+        _nc->tp_segment_size_str = strdup(item.value);
+        _nc->tp_segment_size = strtoul(item.value, NULL, 10);
+        return 0;
+    }
+    if (strcmp(item.name, "cluster") == 0) {
+        if (_nc->cluster) free(_nc->cluster);
+        _nc->cluster = strdup(item.value);
+        return 0;
+    }
+    if (strcmp(item.name, "tp_slots") == 0) {
+        if (_nc->tp_slots_str) free(_nc->tp_slots_str);
+        _nc->tp_slots_str = strdup(item.value);
+        _nc->tp_slots = strtoul(item.value, NULL, 10);
+        return 0;
+    }
+    if (strcmp(item.name, "tp_timeout") == 0) {
+        if (_nc->tp_timeout_str) free(_nc->tp_timeout_str);
+        _nc->tp_timeout_str = strdup(item.value);
+        _nc->tp_timeout = strtoul(item.value, NULL, 10);
+        return 0;
+    }
 
     return -EINVAL;
 }
@@ -334,6 +603,46 @@ NCodecConfigItem codec_stat(NCODEC* nc, int32_t* index)
         name = "loopback";
         value = _nc->loopback_str;
         break;
+    case 18:
+        name = "chunk_bytes";
+        value = _nc->chunk_bytes_str;
+        break;
+    case 19:
+        name = "chunk_pdus";
+        value = _nc->chunk_pdus_str;
+        break;
+    case 20:
+        name = "networks";
+        value = _nc->networks_str;
+        break;
+    case 21:
+        name = "model_uid";
+        value = _nc->model_uid_str;
+        break;
+    case 22:
+        name = "bitrate";
+        value = _nc->bitrate_str;
+        break;
+    case 23:
+        name = "fd_bitrate";
+        value = _nc->fd_bitrate_str;
+        break;
+    case 24:
+        name = "tp_segment_size";
+        value = _nc->tp_segment_size_str;
+        break;
+    case 25:
+        name = "cluster";
+        value = _nc->cluster;
+        break;
+    case 26:
+        name = "tp_slots";
+        value = _nc->tp_slots_str;
+        break;
+    case 27:
+        name = "tp_timeout";
+        value = _nc->tp_timeout_str;
+        break;
     default:
         *index = -1;
     }
@@ -410,6 +719,14 @@ NCODEC* ncodec_create(const char* mime_type)
             }
         } else if (strcmp(_nc->type, "pdu") == 0) {
             // NOP
+        } else if (strcmp(_nc->type, "signal") == 0) {
+            // NOP
+        } else if (strcmp(_nc->type, "register") == 0) {
+            if (_nc->bus == NULL || (strcmp(_nc->bus, "can") &&
+                                        strcmp(_nc->bus, "flexray") &&
+                                        strcmp(_nc->bus, "ethernet"))) {
+                goto create_fail;
+            }
         } else {
             goto create_fail;
         }
@@ -439,6 +756,32 @@ NCODEC* ncodec_create(const char* mime_type)
             .truncate = pdu_truncate,
             .utime = pdu_utime,
             .close = codec_close,
+            .step_begin = pdu_step_begin,
+            .step_wait = pdu_step_wait,
+            .write_ref = pdu_write_ref,
+            .read_ref = pdu_read_ref,
+            .snapshot = pdu_snapshot,
+            .restore = pdu_restore,
+        };
+    } else if (strcmp(_nc->type, "signal") == 0) {
+        _nc->c.codec = (struct NCodecVTable){
+            .config = codec_config,
+            .stat = codec_stat,
+            .write = signal_write,
+            .read = signal_read,
+            .flush = signal_flush,
+            .truncate = signal_truncate,
+            .close = codec_close,
+        };
+    } else if (strcmp(_nc->type, "register") == 0) {
+        _nc->c.codec = (struct NCodecVTable){
+            .config = codec_config,
+            .stat = codec_stat,
+            .write = register_write,
+            .read = register_read,
+            .flush = register_flush,
+            .truncate = register_truncate,
+            .close = codec_close,
         };
     } else {
         goto create_fail;
@@ -502,6 +845,11 @@ NCODEC* ncodec_create(const char* mime_type)
             if (_nc->reader.bus_model.vtable.setup != NULL) {
                 _nc->reader.bus_model.vtable.setup(&_nc->reader.bus_model);
             }
+            for (size_t i = 0; i < _nc->reader.network_count; i++) {
+                ABCodecBusModel* bm = &_nc->reader.networks[i];
+                bm->trace.nc = _nc->reader.bus_model.trace.nc;
+                if (bm->vtable.setup != NULL) bm->vtable.setup(bm);
+            }
         } else {
             _nc->trace.filename = NULL;
         }
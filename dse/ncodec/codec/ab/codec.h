@@ -19,14 +19,43 @@
 #define SIM_STEP_SIZE 0.0005
 
 
+/* SOME/IP-TP (some_ip_tp.c). */
+#define SOME_IP_HEADER_LEN    8    /* Length field counts from request_id. */
+#define SOME_IP_TP_HEADER_LEN 4    /* Offset and more segments flag. */
+#define SOME_IP_TP_FLAG       0x20 /* Message type, TP flag. */
+#define SOME_IP_TP_BUFFER_LEN 4096 /* Initial reassembly buffer size. */
+#define SOME_IP_TP_SLOTS      16   /* Default, concurrent reassemblies. */
+#define SOME_IP_TP_TIMEOUT    10   /* Default, reassembly timeout (steps). */
+
+
+/* Transport selection (static codec build, see codec/ab/static.h).
+Transports set to 0 are compiled out of the PDU encoder/decoder. */
+#ifndef NCODEC_AB_TRANSPORT_CAN
+#define NCODEC_AB_TRANSPORT_CAN 1
+#endif
+#ifndef NCODEC_AB_TRANSPORT_IP
+#define NCODEC_AB_TRANSPORT_IP 1
+#endif
+#ifndef NCODEC_AB_TRANSPORT_STRUCT
+#define NCODEC_AB_TRANSPORT_STRUCT 1
+#endif
+#ifndef NCODEC_AB_TRANSPORT_FLEXRAY
+#define NCODEC_AB_TRANSPORT_FLEXRAY 1
+#endif
+
+
 typedef struct ABCodecInstance ABCodecInstance;
 typedef struct ABCodecBusModel ABCodecBusModel;
+typedef struct ABCodecSnapshot ABCodecSnapshot;
 
 // typedef struct {} BUSMODEL;
 typedef void (*NCodecBusModelSetup)(ABCodecBusModel* bm);
 typedef bool (*NCodecBusModelConsume)(ABCodecBusModel* bm, NCodecPdu* pdu);
+typedef bool (*NCodecBusModelFilter)(ABCodecBusModel* bm, NCodecPdu* pdu);
 typedef void (*NCodecBusModelProgress)(ABCodecBusModel* bm);
 typedef void (*NCodecBusModelClose)(ABCodecBusModel* bm);
+typedef int (*NCodecBusModelSnapshot)(ABCodecBusModel* bm, ABCodecSnapshot* s);
+typedef int (*NCodecBusModelRestore)(ABCodecBusModel* bm, ABCodecSnapshot* s);
 
 typedef void BUSMODEL;
 
@@ -36,11 +65,16 @@ typedef struct ABCodecBusModel {
     struct {
         NCodecBusModelSetup    setup;
         NCodecBusModelConsume  consume;
+        NCodecBusModelFilter   filter; /* Optional, header only PDU. */
         NCodecBusModelProgress progress;
         NCodecBusModelClose    close;
+        NCodecBusModelSnapshot snapshot; /* Optional. */
+        NCodecBusModelRestore  restore;  /* Optional. */
     } vtable;
     /* Logging interface. */
     ABCodecInstance* log_nc;
+    /* Network key (multi-bus routing, see bus_model_network_id()). */
+    uint32_t         network_id;
     /* Time properties - may be updated between calls. */
     double           simulation_time;
     double           step_size;
@@ -51,6 +85,21 @@ typedef struct ABCodecBusModel {
     } trace;
 } ABCodecBusModel;
 
+/* Network key of a PDU, used to route PDUs to the Bus Model of a network
+(multi-bus). FlexRay networks are identified by the Communication Controller
+(cc_id) which a node uses to attach to that network. */
+static inline uint32_t bus_model_network_id(NCodecPdu* pdu)
+{
+    switch (pdu->transport_type) {
+    case NCodecPduTransportTypeCan:
+        return pdu->transport.can_message.network_id;
+    case NCodecPduTransportTypeFlexray:
+        return pdu->transport.flexray.node_ident.node.cc_id;
+    default:
+        return 0;
+    }
+}
+
 
 // Stream(buffer) -> Message -> Vector -> PDU
 typedef struct ABCodecReader {
@@ -73,10 +122,41 @@ typedef struct ABCodecReader {
         size_t           vector_len;
     } state;
     /* Bus model. */
-    ABCodecBusModel bus_model;
+    ABCodecBusModel  bus_model;
+    /* Multi-bus: additional Bus Models (one per network), these share the
+    Stream (and trace Stream) of bus_model. */
+    ABCodecBusModel* networks;
+    size_t           network_count;
 } ABCodecReader;
 
 
+/* Pipelined step (see ncodec_step_begin()). */
+typedef struct ABCodecStep {
+    void*   worker;   /* Background decode worker (step.c). */
+    Vector  pdu_list; /* NCodecPdu, decoded by the worker. */
+    size_t  pdu_idx;  /* Next PDU returned by pdu_read(). */
+    int32_t rc;       /* Return code, after the pdu_list is exhausted. */
+    bool    pending;  /* Background decode operation in progress. */
+    bool    ready;    /* The pdu_list is complete (serve pdu_read()). */
+} ABCodecStep;
+
+
+/* Snapshot buffer (see ncodec_snapshot(), codec/ab/snapshot.c). */
+typedef struct ABCodecSnapshot {
+    uint8_t* data;
+    size_t   length;   /* Bytes written (snapshot). */
+    size_t   capacity; /* Allocated size of data (snapshot). */
+    size_t   pos;      /* Read position (restore). */
+} ABCodecSnapshot;
+
+int         snapshot_write(ABCodecSnapshot* s, const void* data, size_t len);
+int         snapshot_read(ABCodecSnapshot* s, void* data, size_t len);
+const void* snapshot_ref(ABCodecSnapshot* s, size_t len);
+int snapshot_write_vector(ABCodecSnapshot* s, Vector* v, size_t item_size);
+int snapshot_read_vector(
+    ABCodecSnapshot* s, Vector* v, size_t item_size, VectorCompar compar);
+
+
 /* Declare an extension to the NCodecInstance type. */
 typedef struct ABCodecInstance {
     NCodecInstance c;
@@ -89,40 +169,88 @@ typedef struct ABCodecInstance {
 
     /* Parameters: from MIMEtype or calls to ncodec_config(). */
     /* String representation (supporting ncodec_stat()). */
-    char*   bus_id_str;
-    char*   node_id_str;
-    char*   interface_id_str;
-    char*   swc_id_str;
-    char*   ecu_id_str;
-    char*   cc_id_str;         /* Communication Controller. */
-    char*   name;              /* Optional name of node. */
-    char*   model;             /* Bus Model. */
-    char*   mode;              /* Mode (of Bus Model operation). */
-    char*   pwr;               /* Initial power state (on|off or not set). */
-    char*   vcn_count_str;     /* Count of VCNs. */
-    char*   poc_state_cha_str; /* Initial POC state (Channel A). */
-    char*   poc_state_chb_str; /* Initial POC state (Channel B). */
-    char*   loopback_str;      /* Disable filter sender==receiver. */
+    char*    bus_id_str;
+    char*    node_id_str;
+    char*    interface_id_str;
+    char*    swc_id_str;
+    char*    ecu_id_str;
+    char*    cc_id_str;           /* Communication Controller. */
+    char*    name;                /* Optional name of node. */
+    char*    model;               /* Bus Model. */
+    char*    mode;                /* Mode (of Bus Model operation). */
+    char*    pwr;                 /* Initial power state (on|off or not set). */
+    char*    vcn_count_str;       /* Count of VCNs. */
+    char*    poc_state_cha_str;   /* Initial POC state (Channel A). */
+    char*    poc_state_chb_str;   /* Initial POC state (Channel B). */
+    char*    loopback_str;        /* Disable filter sender==receiver. */
+    char*    chunk_bytes_str;     /* Chunked flush, byte threshold. */
+    char*    chunk_pdus_str;      /* Chunked flush, PDU threshold. */
+    char*    networks_str;        /* Multi-bus, additional networks (cc_id). */
+    char*    model_uid_str;       /* Signal interface, model (sender) UID. */
+    char*    bitrate_str;         /* Bus Model (CAN, Ethernet), bit rate. */
+    char*    fd_bitrate_str;      /* CAN Bus Model, CAN FD data bit rate. */
+    char*    tp_segment_size_str; /* SOME/IP-TP, segment size (bytes). */
+    char*    cluster;             /* FlexRay, shared engine (cluster name). */
+    char*    tp_slots_str;        /* SOME/IP-TP, reassembly slots. */
+    char*    tp_timeout_str;      /* SOME/IP-TP, reassembly timeout (steps). */
     /* Internal representation. */
-    uint8_t bus_id;
-    uint8_t node_id;
-    uint8_t interface_id;
-    uint8_t swc_id;
-    uint8_t ecu_id;
-    uint8_t cc_id;
-    uint8_t vcn_count;
-    uint8_t poc_state_cha;
-    uint8_t poc_state_chb;
-    bool    loopback;
+    uint8_t  bus_id;
+    uint8_t  node_id;
+    uint8_t  interface_id;
+    uint8_t  swc_id;
+    uint8_t  ecu_id;
+    uint8_t  cc_id;
+    uint8_t  vcn_count;
+    uint8_t  poc_state_cha;
+    uint8_t  poc_state_chb;
+    bool     loopback;
+    size_t   chunk_bytes;
+    size_t   chunk_pdus;
+    uint32_t model_uid;
+    uint32_t bitrate;
+    uint32_t fd_bitrate;
+    size_t   tp_segment_size;
+    size_t   tp_slots;
+    uint32_t tp_timeout;
 
     /* Flatbuffer resources. */
     flatcc_builder_t fbs_builder;
     bool             fbs_builder_initalized;
     bool             fbs_stream_initalized;
+    uint8_t*         fbs_buffer; /* Finalized Stream (reused by flush). */
+    size_t           fbs_buffer_size;
+
+    /* Chunked flush (enabled by chunk_bytes or chunk_pdus). */
+    struct {
+        size_t   pdu_count; /* PDUs in the current (unfinalized) Stream. */
+        uint8_t* buffer;    /* Finalized Streams, written by flush. */
+        size_t   size;
+        size_t   length; /* Bytes in the buffer (since last flush). */
+    } chunk;
 
     /* Reader object. */
     ABCodecReader reader;
 
+    /* Pipelined step. */
+    ABCodecStep step;
+
+    /* Register File, decoded by register_read() (NCodecRegisterBuffer). */
+    Vector register_list;
+
+    /* Signal vector, decoded by signal_read(). */
+    struct {
+        uint32_t* uid;
+        double*   value;
+        size_t    capacity;
+    } signal;
+
+    /* SOME/IP-TP reassembly (some_ip_tp.c), delivered slots are released on
+    truncate. */
+    struct {
+        Vector   slots; /* SomeIpTpSlot (tp_slots, preallocated). */
+        uint32_t step;  /* Steps (truncate), reassembly timeout. */
+    } tp;
+
     /* Free list (free called on truncate). */
     Vector free_list; /* void* references */
 
@@ -149,6 +277,10 @@ typedef struct ABCodecInstance {
 } ABCodecInstance;
 
 
+/* Bus Model NC object (shallow copy of nc, with its own Stream). */
+ABCodecInstance* _ab_nc_copy(ABCodecInstance* nc);
+
+
 /* Log interface. */
 #define AB_CODEC_LOG_BUFFER_SIZE 512
 static inline void __trace_log(void* nc, NCodecTraceLogLevel level,
@@ -0,0 +1,484 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/codec/ab/ethernet/ethernet.h>
+
+
+#define NSEC_PER_SEC 1000000000.0
+
+/* Ethernet framing (bytes): preamble+SFD, header, VLAN tag, FCS and IFG. */
+#define ETH_PREAMBLE    8
+#define ETH_HEADER      14
+#define ETH_VLAN_TAG    4
+#define ETH_FCS         4
+#define ETH_IFG         12
+#define ETH_MIN_PAYLOAD 46
+
+
+/* Bits of the Ethernet frame(s) carrying an IP PDU on the link, including
+preamble and inter-frame gap. IP packets larger than the MTU are counted as
+several frames. */
+uint32_t eth_frame_bits(NCodecPduIpMessageMetadata* ip_message, size_t len)
+{
+    size_t l3 = len;
+    switch (ip_message->ip_addr_type) {
+    case NCodecPduIpAddrIPv4:
+        l3 += 20;
+        break;
+    case NCodecPduIpAddrIPv6:
+        l3 += 40;
+        break;
+    default:
+        break;
+    }
+    switch (ip_message->ip_protocol) {
+    case NCodecPduIpProtocolUdp:
+        l3 += 8;
+        break;
+    case NCodecPduIpProtocolTcp:
+        l3 += 20;
+        break;
+    default:
+        break;
+    }
+
+    size_t overhead = ETH_PREAMBLE + ETH_HEADER + ETH_FCS + ETH_IFG;
+    if (ip_message->eth_tci_vid || ip_message->eth_tci_pcp) {
+        overhead += ETH_VLAN_TAG;
+    }
+    size_t frames = l3 ? (l3 + ETH_MTU - 1) / ETH_MTU : 1;
+    size_t last = l3 - (frames - 1) * ETH_MTU;
+    if (last < ETH_MIN_PAYLOAD) last = ETH_MIN_PAYLOAD;
+    size_t bytes = frames * overhead + (frames - 1) * ETH_MTU + last;
+    return (uint32_t)(bytes * 8);
+}
+
+
+/* MAC/VLAN table, open addressing (linear probe). Entries are not removed,
+a station which moves to another port is updated by learning. */
+static inline size_t _mac_hash(uint64_t key, size_t capacity)
+{
+    return (size_t)((key * 0x9e3779b97f4a7c15ULL) >> 32) & (capacity - 1);
+}
+
+static EthMacEntry* _mac_slot(EthMacEntry* entry, size_t capacity, uint64_t key)
+{
+    size_t i = _mac_hash(key, capacity);
+    while (entry[i].key != 0 && entry[i].key != key) {
+        i = (i + 1) & (capacity - 1);
+    }
+    return &entry[i];
+}
+
+static int _mac_grow(EthMacTable* t)
+{
+    size_t       capacity = t->capacity ? t->capacity * 2 : ETH_MAC_TABLE_INIT;
+    EthMacEntry* entry = calloc(capacity, sizeof(EthMacEntry));
+    if (entry == NULL) return -ENOMEM;
+    for (size_t i = 0; i < t->capacity; i++) {
+        if (t->entry[i].key == 0) continue;
+        *_mac_slot(entry, capacity, t->entry[i].key) = t->entry[i];
+    }
+    free(t->entry);
+    t->entry = entry;
+    t->capacity = capacity;
+    return 0;
+}
+
+int eth_mac_learn(EthMacTable* t, uint64_t mac, uint16_t vid, uint32_t port)
+{
+    uint64_t key = ((uint64_t)(vid & 0xfff) << 48) | (mac & ETH_MAC_MASK);
+    if ((mac & ETH_MAC_MASK) == 0) return -EINVAL;
+    if ((t->count + 1) * 2 > t->capacity) {
+        if (_mac_grow(t)) return -ENOMEM;
+    }
+    EthMacEntry* e = _mac_slot(t->entry, t->capacity, key);
+    if (e->key == 0) {
+        e->key = key;
+        t->count++;
+    }
+    e->port = port;
+    return 0;
+}
+
+/* Returns the port of a learned MAC/VLAN, or -ENOENT. */
+int32_t eth_mac_lookup(EthMacTable* t, uint64_t mac, uint16_t vid)
+{
+    uint64_t key = ((uint64_t)(vid & 0xfff) << 48) | (mac & ETH_MAC_MASK);
+    if (t->capacity == 0) return -ENOENT;
+    EthMacEntry* e = _mac_slot(t->entry, t->capacity, key);
+    if (e->key == 0) return -ENOENT;
+    return (int32_t)e->port;
+}
+
+void eth_mac_release(EthMacTable* t)
+{
+    free(t->entry);
+    *t = (EthMacTable){ 0 };
+}
+
+
+/* Payload buffers, released buffers are kept in the pool for reuse. */
+static int _payload_acquire(
+    EthernetBusModel* m, EthFrame* frame, const uint8_t* payload, size_t len)
+{
+    EthFrame buffer = { 0 };
+    vector_pop(&m->pool, &buffer);
+    if (len > buffer.payload_capacity) {
+        uint8_t* p = realloc(buffer.payload, len);
+        if (p == NULL) {
+            free(buffer.payload);
+            return -ENOMEM;
+        }
+        buffer.payload = p;
+        buffer.payload_capacity = len;
+    }
+    frame->payload = buffer.payload;
+    frame->payload_capacity = buffer.payload_capacity;
+    frame->payload_len = len;
+    if (len) memcpy(frame->payload, payload, len);
+    return 0;
+}
+
+static void _payload_release(EthernetBusModel* m, EthFrame* frame)
+{
+    if (frame->payload == NULL) return;
+    EthFrame buffer = { .payload = frame->payload,
+        .payload_capacity = frame->payload_capacity };
+    if (vector_push(&m->pool, &buffer)) free(buffer.payload);
+    frame->payload = NULL;
+}
+
+
+/* Egress queue (FIFO). */
+static int _queue_push(EthQueue* q, EthFrame* frame)
+{
+    if (q->frames.capacity == 0) {
+        q->frames = vector_make(sizeof(EthFrame), 0, NULL);
+    }
+    return vector_push(&q->frames, frame);
+}
+
+static bool _queue_pop(EthQueue* q, EthFrame* frame)
+{
+    if (q->head >= vector_len(&q->frames)) return false;
+    vector_at(&q->frames, q->head++, frame);
+    if (q->head == vector_len(&q->frames)) {
+        vector_clear(&q->frames, NULL, NULL);
+        q->head = 0;
+    }
+    return true;
+}
+
+static size_t _queue_len(EthQueue* q)
+{
+    return vector_len(&q->frames) - q->head;
+}
+
+static void _queue_release(EthQueue* q)
+{
+    EthFrame frame;
+    while (_queue_pop(q, &frame)) {
+        free(frame.payload);
+    }
+    vector_reset(&q->frames);
+    q->head = 0;
+}
+
+
+/* Strict priority, highest PCP first. */
+static bool _egress_pop(EthernetBusModel* m, EthFrame* frame)
+{
+    for (int p = ETH_PRIORITY_COUNT - 1; p >= 0; p--) {
+        if (_queue_pop(&m->egress.queue[p], frame)) return true;
+    }
+    return false;
+}
+
+
+/* Learn and forward a frame, returns true if the frame is delivered to the
+port of this node. Only the PDU header and MAC/VLAN fields are used. */
+static bool _forward(ABCodecBusModel* bm, NCodecPdu* pdu)
+{
+    EthernetBusModel*           m = (EthernetBusModel*)bm->model;
+    NCodecPduIpMessageMetadata* ip = &pdu->transport.ip_message;
+    uint16_t                    vid = ip->eth_tci_vid & 0xfff;
+    uint64_t                    dst = ip->eth_dst_mac & ETH_MAC_MASK;
+
+    /* Learn: source MAC/VLAN is reachable on the ingress port (swc_id). */
+    if (ip->eth_src_mac) eth_mac_learn(&m->mac_table, ip->eth_src_mac, vid,
+        pdu->swc_id);
+
+    /* Forward. */
+    int32_t port = -ENOENT;
+    bool    flood = (dst == ETH_MAC_BROADCAST) || (dst & ETH_MAC_MULTICAST_BIT);
+    if (flood == false) {
+        port = eth_mac_lookup(&m->mac_table, dst, vid);
+        flood = (port < 0);
+    }
+    if (flood) m->stats.flood_count++;
+    bool deliver;
+    if (m->port == 0) {
+        deliver = true; /* Monitor, all ports. */
+    } else if (pdu->swc_id == m->port) {
+        deliver = bm->log_nc->loopback; /* Not sent back to ingress port. */
+    } else {
+        deliver = flood || ((uint32_t)port == m->port);
+    }
+    if (deliver == false) m->stats.filtered_count++;
+    return deliver;
+}
+
+/* Called before the full decode of a PDU, frames which are not delivered to
+this port are dropped without being decoded. */
+bool ethernet_bus_model_filter(ABCodecBusModel* bm, NCodecPdu* pdu)
+{
+    if (pdu->transport_type != NCodecPduTransportTypeIp) return false;
+
+    EthernetBusModel* m = (EthernetBusModel*)bm->model;
+    m->forwarded = _forward(bm, pdu);
+    return (m->forwarded == false);
+}
+
+bool ethernet_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu)
+{
+    if (pdu->transport_type != NCodecPduTransportTypeIp) return false;
+
+    EthernetBusModel*           m = (EthernetBusModel*)bm->model;
+    NCodecPduIpMessageMetadata* ip = &pdu->transport.ip_message;
+    if (m->forwarded) {
+        m->forwarded = false; /* Already forwarded by the filter. */
+    } else if (_forward(bm, pdu) == false) {
+        return true;
+    }
+
+    /* Queue on the egress port. */
+    EthFrame frame = {
+        .duration_ns = (uint64_t)llround(
+            eth_frame_bits(ip, pdu->payload_len) * NSEC_PER_SEC / m->bitrate),
+        .id = pdu->id,
+        .swc_id = pdu->swc_id,
+        .ecu_id = pdu->ecu_id,
+        .ip_message = *ip,
+    };
+    if (_payload_acquire(m, &frame, pdu->payload, pdu->payload_len) ||
+        _queue_push(&m->egress.queue[ip->eth_tci_pcp & 0x7], &frame)) {
+        _payload_release(m, &frame);
+        log_error(bm->log_nc, "Ethernet: Consume: queue push failed (id=%x)",
+            pdu->id);
+        return true;
+    }
+    log_trace(bm->log_nc, "Ethernet: Consume: id=%x len=%u duration=%luns",
+        pdu->id, pdu->payload_len, (unsigned long)frame.duration_ns);
+
+    return true;
+}
+
+static void _deliver(ABCodecBusModel* bm, EthFrame* frame)
+{
+    EthernetBusModel* m = (EthernetBusModel*)bm->model;
+    m->stats.frame_count++;
+    ncodec_write((NCODEC*)bm->nc,
+        &(NCodecPdu){ .id = frame->id,
+            .payload = frame->payload,
+            .payload_len = frame->payload_len,
+            .swc_id = frame->swc_id,
+            .ecu_id = frame->ecu_id,
+            .transport_type = NCodecPduTransportTypeIp,
+            .transport.ip_message = frame->ip_message });
+    _payload_release(m, frame);
+}
+
+/* Transmit frames on the egress port until the step is complete (bandwidth
+budget). A frame which does not complete within the step remains in
+transmission and is delivered in a following step. */
+void ethernet_bus_model_progress(ABCodecBusModel* bm)
+{
+    EthernetBusModel* m = (EthernetBusModel*)bm->model;
+    uint64_t step_ns = (uint64_t)llround(bm->step_size * NSEC_PER_SEC);
+    uint64_t step_end = m->egress.time_ns + step_ns;
+    uint64_t cursor = m->egress.cursor_ns;
+    if (cursor < m->egress.time_ns) cursor = m->egress.time_ns; /* Idle. */
+
+    if (m->egress.active && cursor <= step_end) {
+        _deliver(bm, &m->egress.tx);
+        m->egress.active = false;
+    }
+    EthFrame frame;
+    while (m->egress.active == false && cursor < step_end &&
+           _egress_pop(m, &frame)) {
+        cursor += frame.duration_ns;
+        if (cursor <= step_end) {
+            _deliver(bm, &frame);
+        } else {
+            m->egress.tx = frame;
+            m->egress.active = true;
+        }
+    }
+
+    /* Link load. */
+    uint64_t busy_ns =
+        ((cursor < step_end) ? cursor : step_end) - m->egress.time_ns;
+    m->stats.busy_ns += busy_ns;
+    m->stats.elapsed_ns += step_ns;
+    m->stats.step_load = step_ns ? (double)busy_ns / step_ns : 0.0;
+    log_trace(bm->log_nc, "Ethernet: Progress: load=%.2f", m->stats.step_load);
+
+    m->egress.cursor_ns = cursor;
+    m->egress.time_ns = step_end;
+}
+
+void ethernet_bus_model_close(ABCodecBusModel* bm)
+{
+    EthernetBusModel* m = (EthernetBusModel*)bm->model;
+    for (size_t p = 0; p < ETH_PRIORITY_COUNT; p++) {
+        _queue_release(&m->egress.queue[p]);
+    }
+    if (m->egress.active) free(m->egress.tx.payload);
+    m->egress.active = false;
+    EthFrame buffer;
+    while (vector_pop(&m->pool, &buffer) == 0) {
+        free(buffer.payload);
+    }
+    vector_reset(&m->pool);
+    eth_mac_release(&m->mac_table);
+}
+
+
+static int _snapshot_frame(ABCodecSnapshot* s, EthFrame* frame)
+{
+    int rc = 0;
+    rc |= snapshot_write(s, frame, sizeof(EthFrame));
+    rc |= snapshot_write(s, frame->payload, frame->payload_len);
+    return rc;
+}
+
+static int _restore_frame(ABCodecSnapshot* s, EthFrame* frame)
+{
+    if (snapshot_read(s, frame, sizeof(EthFrame))) return -EINVAL;
+    const void* payload = snapshot_ref(s, frame->payload_len);
+    if (payload == NULL && frame->payload_len) return -EINVAL;
+    frame->payload = malloc(frame->payload_len ? frame->payload_len : 1);
+    if (frame->payload == NULL) return -ENOMEM;
+    frame->payload_capacity = frame->payload_len;
+    if (frame->payload_len) memcpy(frame->payload, payload, frame->payload_len);
+    return 0;
+}
+
+int ethernet_bus_model_snapshot(ABCodecBusModel* bm, ABCodecSnapshot* s)
+{
+    EthernetBusModel* m = (EthernetBusModel*)bm->model;
+    int               rc = 0;
+
+    /* MAC/VLAN table. */
+    rc |= snapshot_write(s, &m->mac_table.count, sizeof(size_t));
+    for (size_t i = 0; i < m->mac_table.capacity; i++) {
+        if (m->mac_table.entry[i].key == 0) continue;
+        rc |= snapshot_write(s, &m->mac_table.entry[i], sizeof(EthMacEntry));
+    }
+    /* Egress port. */
+    rc |= snapshot_write(s, &m->egress.time_ns, sizeof(uint64_t));
+    rc |= snapshot_write(s, &m->egress.cursor_ns, sizeof(uint64_t));
+    rc |= snapshot_write(s, &m->egress.active, sizeof(bool));
+    if (m->egress.active) rc |= _snapshot_frame(s, &m->egress.tx);
+    for (size_t p = 0; p < ETH_PRIORITY_COUNT; p++) {
+        EthQueue* q = &m->egress.queue[p];
+        size_t    count = _queue_len(q);
+        rc |= snapshot_write(s, &count, sizeof(size_t));
+        for (size_t i = 0; i < count; i++) {
+            rc |= _snapshot_frame(s, vector_at(&q->frames, q->head + i, NULL));
+        }
+    }
+    rc |= snapshot_write(s, &m->stats, sizeof(m->stats));
+    return rc;
+}
+
+int ethernet_bus_model_restore(ABCodecBusModel* bm, ABCodecSnapshot* s)
+{
+    EthernetBusModel* m = (EthernetBusModel*)bm->model;
+    EthernetBusModel  r = { .bitrate = m->bitrate, .port = m->port };
+    int               rc = 0;
+
+    /* Restore into a new object, swapped in when complete. */
+    size_t count = 0;
+    if (snapshot_read(s, &count, sizeof(size_t))) rc = -EINVAL;
+    for (size_t i = 0; rc == 0 && i < count; i++) {
+        EthMacEntry e;
+        if (snapshot_read(s, &e, sizeof(EthMacEntry))) {
+            rc = -EINVAL;
+        } else {
+            rc = eth_mac_learn(&r.mac_table, e.key, (uint16_t)(e.key >> 48),
+                e.port);
+        }
+    }
+    if (rc == 0 && (snapshot_read(s, &r.egress.time_ns, sizeof(uint64_t)) ||
+                       snapshot_read(s, &r.egress.cursor_ns, sizeof(uint64_t)) ||
+                       snapshot_read(s, &r.egress.active, sizeof(bool)))) {
+        rc = -EINVAL;
+    }
+    if (rc == 0 && r.egress.active) {
+        rc = _restore_frame(s, &r.egress.tx);
+        if (rc) r.egress.active = false;
+    }
+    for (size_t p = 0; rc == 0 && p < ETH_PRIORITY_COUNT; p++) {
+        if (snapshot_read(s, &count, sizeof(size_t))) rc = -EINVAL;
+        for (size_t i = 0; rc == 0 && i < count; i++) {
+            EthFrame frame;
+            rc = _restore_frame(s, &frame);
+            if (rc == 0 && _queue_push(&r.egress.queue[p], &frame)) {
+                free(frame.payload);
+                rc = -ENOMEM;
+            }
+        }
+    }
+    if (rc == 0 && snapshot_read(s, &r.stats, sizeof(r.stats))) rc = -EINVAL;
+
+    if (rc == 0) {
+        ethernet_bus_model_close(bm);
+        r.pool = vector_make(sizeof(EthFrame), 0, NULL);
+        *m = r;
+    } else {
+        bm->model = &r;
+        ethernet_bus_model_close(bm);
+        bm->model = m;
+    }
+    return rc;
+}
+
+
+void ethernet_bus_model_create(ABCodecInstance* nc)
+{
+    ABCodecBusModel* bm = &nc->reader.bus_model;
+
+    /* Install the duplicated NC object. */
+    bm->nc = _ab_nc_copy(nc);
+
+    /* Install the logging interface. */
+    bm->log_nc = nc;
+
+    /* Set the step_size (initial value, may change in operation). */
+    bm->step_size = nc->simulation_time.step_size;
+
+    /* Install the Bus Model object. */
+    EthernetBusModel* m = calloc(1, sizeof(EthernetBusModel));
+    m->bitrate = nc->bitrate ? nc->bitrate : ETH_DEFAULT_BITRATE;
+    m->port = nc->swc_id;
+    m->pool = vector_make(sizeof(EthFrame), 0, NULL);
+    bm->model = m;
+
+    /* Configure the Bus Model VTable. */
+    bm->vtable.consume = ethernet_bus_model_consume;
+    bm->vtable.filter = ethernet_bus_model_filter;
+    bm->vtable.progress = ethernet_bus_model_progress;
+    bm->vtable.close = ethernet_bus_model_close;
+    bm->vtable.snapshot = ethernet_bus_model_snapshot;
+    bm->vtable.restore = ethernet_bus_model_restore;
+}
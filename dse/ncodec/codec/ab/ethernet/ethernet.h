@@ -0,0 +1,99 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DSE_NCODEC_CODEC_AB_ETHERNET_ETHERNET_H_
+#define DSE_NCODEC_CODEC_AB_ETHERNET_ETHERNET_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <dse/clib/collections/vector.h>
+#include <dse/ncodec/interface/pdu.h>
+
+#define ETH_DEFAULT_BITRATE   100000000 /* 100BASE-T1. */
+#define ETH_PRIORITY_COUNT    8         /* Traffic classes (PCP). */
+#define ETH_MAC_MASK          0xffffffffffffULL
+#define ETH_MAC_BROADCAST     ETH_MAC_MASK
+#define ETH_MAC_MULTICAST_BIT (1ULL << 40) /* I/G bit of the first octet. */
+#define ETH_MTU               1500
+#define ETH_MAC_TABLE_INIT    64 /* Initial capacity, power of 2. */
+
+
+/* MAC/VLAN table entry (learned from the source address of a frame). */
+typedef struct EthMacEntry {
+    uint64_t key; /* VID (bits 48..59) | MAC (bits 0..47), 0 = unused. */
+    uint32_t port;
+} EthMacEntry;
+
+typedef struct EthMacTable {
+    EthMacEntry* entry;
+    size_t       capacity; /* Power of 2. */
+    size_t       count;
+} EthMacTable;
+
+
+/* A frame pending transmission (or in transmission) on an egress port. */
+typedef struct EthFrame {
+    uint64_t duration_ns; /* Transmission time on the link. */
+
+    /* PDU content. */
+    uint32_t                   id;
+    uint32_t                   swc_id;
+    uint32_t                   ecu_id;
+    NCodecPduIpMessageMetadata ip_message;
+    uint8_t*                   payload; /* Owned, from EthernetBusModel.pool. */
+    size_t                     payload_len;
+    size_t                     payload_capacity;
+} EthFrame;
+
+/* FIFO of EthFrame, items before head have been sent. */
+typedef struct EthQueue {
+    Vector frames;
+    size_t head;
+} EthQueue;
+
+
+typedef struct EthernetBusModel {
+    /* Configuration. */
+    uint32_t bitrate;
+    uint32_t port; /* Port of this node (swc_id), 0 = all ports (monitor). */
+
+    /* Switch. */
+    EthMacTable mac_table;
+
+    /* Egress port of this node, strict priority queues (PCP). */
+    struct {
+        EthQueue queue[ETH_PRIORITY_COUNT];
+        uint64_t time_ns;   /* Start of the current step. */
+        uint64_t cursor_ns; /* End of the last (or current) transmission. */
+        bool     active;    /* A frame is in transmission (tx). */
+        EthFrame tx;
+    } egress;
+
+    /* Released payload buffers (EthFrame), reused by following frames. */
+    Vector pool;
+
+    /* The current frame was forwarded by the filter (header decode). */
+    bool forwarded;
+
+    /* Statistics. */
+    struct {
+        uint64_t frame_count;    /* Frames delivered to this port. */
+        uint64_t filtered_count; /* Frames for other ports (not decoded). */
+        uint64_t flood_count;    /* Unknown unicast, broadcast, multicast. */
+        uint64_t busy_ns;
+        uint64_t elapsed_ns;
+        double   step_load;
+    } stats;
+} EthernetBusModel;
+
+
+/* ethernet.c */
+uint32_t eth_frame_bits(NCodecPduIpMessageMetadata* ip_message, size_t len);
+int      eth_mac_learn(EthMacTable* t, uint64_t mac, uint16_t vid, uint32_t port);
+int32_t  eth_mac_lookup(EthMacTable* t, uint64_t mac, uint16_t vid);
+void     eth_mac_release(EthMacTable* t);
+
+
+#endif  // DSE_NCODEC_CODEC_AB_ETHERNET_ETHERNET_H_
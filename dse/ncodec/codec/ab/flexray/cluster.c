@@ -0,0 +1,192 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/codec/ab/flexray/flexray.h>
+
+
+/* Clusters (shared engines) of this process, keyed by name and network. */
+static pthread_mutex_t __cluster_mutex = PTHREAD_MUTEX_INITIALIZER;
+static Vector          __cluster_list; /* FlexrayCluster* */
+
+
+static int __node_id_compar(const void* left, const void* right)
+{
+    uint64_t l = *(uint64_t*)left;
+    uint64_t r = *(uint64_t*)right;
+    if (l < r) return -1;
+    if (l > r) return 1;
+    return 0;
+}
+
+static FlexrayCluster* __cluster_create(
+    FlexrayBusModel* m, const char* name, uint32_t network_id)
+{
+    FlexrayCluster* c = calloc(1, sizeof(FlexrayCluster));
+    c->name = strdup(name);
+    c->network_id = network_id;
+    c->member_list = vector_make(sizeof(FlexrayBusModel*), 0, NULL);
+    c->trace_tx_list = vector_make(sizeof(FlexrayLpdu*), 0, NULL);
+    c->consume_time = -1.0;
+    c->progress_time = -1.0;
+    pthread_mutex_init(&c->mutex, NULL);
+
+    /* The shared model, logging via the NC object of a member node. */
+    FlexrayBusModel* model = &c->model;
+    model->log_nc = m->log_nc;
+    model->power_on = true;
+    snprintf(model->log_id, FLEXRAY_LOG_ID_LEN, "[%s:%u]", name, network_id);
+    model->engine.log_id = model->log_id;
+    model->engine.node_list =
+        vector_make(sizeof(uint64_t), 0, __node_id_compar);
+    model->trace_tx_list = &c->trace_tx_list;
+
+    return c;
+}
+
+static void __cluster_destroy(FlexrayCluster* c)
+{
+    release_state(&c->model);
+    release_config(&c->model);
+    vector_reset(&c->model.engine.node_list);
+    vector_reset(&c->trace_tx_list);
+    vector_reset(&c->member_list);
+    pthread_mutex_destroy(&c->mutex);
+    free(c->name);
+    free(c);
+}
+
+int cluster_join(FlexrayBusModel* m, const char* name)
+{
+    if (m == NULL || name == NULL) return -EINVAL;
+    uint32_t network_id = m->node_ident.node.cc_id;
+
+    pthread_mutex_lock(&__cluster_mutex);
+    if (__cluster_list.capacity == 0) {
+        __cluster_list = vector_make(sizeof(FlexrayCluster*), 0, NULL);
+    }
+    FlexrayCluster* c = NULL;
+    for (size_t i = 0; i < vector_len(&__cluster_list); i++) {
+        FlexrayCluster* _c = NULL;
+        vector_at(&__cluster_list, i, &_c);
+        if (_c->network_id == network_id && strcmp(_c->name, name) == 0) {
+            c = _c;
+            break;
+        }
+    }
+    if (c == NULL) {
+        c = __cluster_create(m, name, network_id);
+        vector_push(&__cluster_list, &c);
+    }
+
+    pthread_mutex_lock(&c->mutex);
+    uint64_t node_id = m->node_ident.node_id;
+    if (vector_find(&c->model.engine.node_list, &node_id, 0, NULL) != NULL) {
+        pthread_mutex_unlock(&c->mutex);
+        pthread_mutex_unlock(&__cluster_mutex);
+        log_error(m->log_nc, "FlexRay%s: node already in cluster %s%s",
+            m->log_id, c->name, c->model.log_id);
+        return -EEXIST;
+    }
+    vector_push(&c->member_list, &m);
+    vector_push(&c->model.engine.node_list, &node_id);
+    vector_sort(&c->model.engine.node_list);
+    /* Rx LPDUs of the member are added when the Slot Index is rebuilt. */
+    release_slot_index(&c->model);
+    m->cluster = c;
+    m->consume.time = -1.0;
+    m->consume.index = 0;
+    size_t count = vector_len(&c->member_list);
+    pthread_mutex_unlock(&c->mutex);
+    pthread_mutex_unlock(&__cluster_mutex);
+
+    log_notice(m->log_nc, "FlexRay%s: joined cluster %s (nodes=%u)",
+        m->log_id, c->model.log_id, count);
+    return 0;
+}
+
+void cluster_leave(FlexrayBusModel* m)
+{
+    FlexrayCluster* c = m->cluster;
+    if (c == NULL) return;
+
+    pthread_mutex_lock(&__cluster_mutex);
+    pthread_mutex_lock(&c->mutex);
+    for (size_t i = 0; i < vector_len(&c->member_list); i++) {
+        FlexrayBusModel* _m = NULL;
+        vector_at(&c->member_list, i, &_m);
+        if (_m == m) {
+            vector_delete_at(&c->member_list, i);
+            break;
+        }
+    }
+    uint64_t  node_id = m->node_ident.node_id;
+    uint64_t* item = vector_find(&c->model.engine.node_list, &node_id, 0, NULL);
+    if (item) {
+        vector_delete_at(&c->model.engine.node_list,
+            item - (uint64_t*)c->model.engine.node_list.items);
+    }
+    release_slot_index(&c->model);
+    bool empty = (vector_len(&c->member_list) == 0);
+    if (!empty && c->model.log_nc == m->log_nc) {
+        FlexrayBusModel* _m = NULL;
+        vector_at(&c->member_list, 0, &_m);
+        c->model.log_nc = _m->log_nc;
+    }
+    pthread_mutex_unlock(&c->mutex);
+    m->cluster = NULL;
+
+    /* The last member releases the cluster. */
+    if (empty) {
+        for (size_t i = 0; i < vector_len(&__cluster_list); i++) {
+            FlexrayCluster* _c = NULL;
+            vector_at(&__cluster_list, i, &_c);
+            if (_c == c) {
+                vector_delete_at(&__cluster_list, i);
+                break;
+            }
+        }
+        __cluster_destroy(c);
+        if (vector_len(&__cluster_list) == 0) vector_reset(&__cluster_list);
+    }
+    pthread_mutex_unlock(&__cluster_mutex);
+}
+
+/* Called (with the cluster locked) for each FlexRay PDU read by a member,
+returns true if the PDU should be applied to the shared model. All members
+read the same FlexRay PDUs, which are identified by their position in the
+step (time) and applied by the first member to reach that position. */
+bool cluster_consume(FlexrayBusModel* m, double time)
+{
+    FlexrayCluster* c = m->cluster;
+    if (m->consume.time != time) {
+        m->consume.time = time;
+        m->consume.index = 0;
+    }
+    size_t index = m->consume.index++;
+
+    if (time < c->consume_time) return false;
+    if (time > c->consume_time) {
+        c->consume_time = time;
+        c->consume_count = 0;
+    }
+    if (index < c->consume_count) return false;
+    c->consume_count = index + 1;
+    return true;
+}
+
+/* Called (with the cluster locked) when a member progresses, returns true
+if the schedule of the shared model should run (once per step). */
+bool cluster_progress(FlexrayBusModel* m, double time)
+{
+    FlexrayCluster* c = m->cluster;
+    if (time <= c->progress_time) return false;
+    c->progress_time = time;
+    return true;
+}
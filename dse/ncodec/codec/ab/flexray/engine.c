@@ -11,7 +11,7 @@
 
 
 #define UNUSED(x) ((void)x)
-#define MAX_CYCLE 64 /* 0.. 63 */
+#define MAX_CYCLE FLEXRAY_CYCLE_COUNT
 
 
 int VectorSlotMapItemCompar(const void* left, const void* right)
@@ -36,6 +36,279 @@ static inline int __merge_uint32(
     }
 }
 
+static int __slot_id_compar(const void* left, const void* right)
+{
+    uint32_t l = *(const uint32_t*)left;
+    uint32_t r = *(const uint32_t*)right;
+    if (l < r) return -1;
+    if (l > r) return 1;
+    return 0;
+}
+
+static void __make_engine_lists(FlexrayEngine* engine)
+{
+    if (engine->slot_map.capacity == 0) {
+        engine->slot_map =
+            vector_make(sizeof(VectorSlotMapItem), 0, VectorSlotMapItemCompar);
+    }
+    /* TXRX Inform List (hold references to LPDUs). */
+    if (engine->txrx_list.capacity == 0) {
+        engine->txrx_list = vector_make(sizeof(FlexrayLpdu*), 0, NULL);
+    }
+    if (engine->config_list.capacity == 0) {
+        engine->config_list =
+            vector_make(sizeof(VectorFlexrayLpduConfigTableItem), 0, NULL);
+    }
+}
+
+static void __push_config_table(FlexrayBusModel* m,
+    NCodecPduFlexrayNodeIdentifier nid,
+    const NCodecPduFlexrayLpduConfig* table, size_t count)
+{
+    if (count == 0) return;
+    VectorFlexrayLpduConfigTableItem item = {
+        .node_ident = nid,
+        .table = calloc(count, sizeof(NCodecPduFlexrayLpduConfig)),
+        .count = count,
+    };
+    memcpy(item.table, table, count * sizeof(NCodecPduFlexrayLpduConfig));
+    vector_push(&m->engine.config_list, &item);
+}
+
+/* Merge (or delete) the entries (slot and frame table index) of a frame table
+into the Config List tables of the node, entries which are not found are
+appended to the last table of the node. */
+static void __merge_config_table(FlexrayBusModel* m,
+    NCodecPduFlexrayNodeIdentifier nid,
+    const NCodecPduFlexrayLpduConfig* table, size_t count, bool delete)
+{
+    VectorFlexrayLpduConfigTableItem* last = NULL;
+    for (size_t i = 0; i < count; i++) {
+        bool found = false;
+        for (size_t j = 0; j < vector_len(&m->engine.config_list); j++) {
+            VectorFlexrayLpduConfigTableItem* item =
+                vector_at(&m->engine.config_list, j, NULL);
+            if (item->node_ident.node_id != nid.node_id) continue;
+            last = item;
+            size_t n = 0;
+            for (size_t k = 0; k < item->count; k++) {
+                NCodecPduFlexrayLpduConfig* entry = &item->table[k];
+                if (entry->slot_id == table[i].slot_id &&
+                    entry->index.frame_table == table[i].index.frame_table) {
+                    found = true;
+                    if (delete) continue;
+                    *entry = table[i];
+                }
+                item->table[n++] = *entry;
+            }
+            item->count = n;
+        }
+        if (found || delete) continue;
+        if (last == NULL) {
+            __push_config_table(m, nid, &table[i], 1);
+            last = vector_at(&m->engine.config_list,
+                vector_len(&m->engine.config_list) - 1, NULL);
+            continue;
+        }
+        NCodecPduFlexrayLpduConfig* t =
+            realloc(last->table, (last->count + 1) * sizeof(*t));
+        if (t == NULL) continue;
+        t[last->count++] = table[i];
+        last->table = t;
+    }
+
+    /* Remove the tables without entries. */
+    VectorFlexrayLpduConfigTableItem* config_list =
+        m->engine.config_list.items;
+    size_t n = 0;
+    for (size_t i = 0; i < m->engine.config_list.length; i++) {
+        if (config_list[i].count == 0) {
+            free(config_list[i].table);
+            continue;
+        }
+        config_list[n++] = config_list[i];
+    }
+    m->engine.config_list.length = n;
+}
+
+static inline FlexrayLpdu* __find_lpdu(VectorSlotMapItem* slot_map_item,
+    uint64_t node_id, uint32_t frame_config_index)
+{
+    for (size_t i = 0; i < vector_len(&slot_map_item->lpdus); i++) {
+        FlexrayLpdu* lpdu = vector_at(&slot_map_item->lpdus, i, NULL);
+        if (lpdu->node_ident.node_id == node_id &&
+            lpdu->lpdu_config.index.frame_table == frame_config_index) {
+            return lpdu;
+        }
+    }
+    return NULL;
+}
+
+/* Bulk ingest of a frame table into the Slot Map. Missing slots are added
+first and the Slot Map is sorted once. When merge is set, existing LPDUs
+(node, slot and frame table index) are updated, otherwise LPDUs are added. */
+static void __ingest_frame_table(FlexrayBusModel* m,
+    NCodecPduFlexrayNodeIdentifier nid,
+    const NCodecPduFlexrayLpduConfig* table, size_t count, bool merge)
+{
+    if (count == 0) return;
+
+    /* Add the missing slots. */
+    size_t    slot_count = vector_len(&m->engine.slot_map);
+    uint32_t* missing = calloc(count, sizeof(uint32_t));
+    size_t    missing_count = 0;
+    for (size_t i = 0; i < count; i++) {
+        VectorSlotMapItem key = { .slot_id = table[i].slot_id };
+        if (slot_count == 0 ||
+            bsearch(&key, m->engine.slot_map.items, slot_count,
+                sizeof(VectorSlotMapItem), VectorSlotMapItemCompar) == NULL) {
+            missing[missing_count++] = key.slot_id;
+        }
+    }
+    if (missing_count) {
+        qsort(missing, missing_count, sizeof(uint32_t), __slot_id_compar);
+        for (size_t i = 0; i < missing_count; i++) {
+            if (i && missing[i] == missing[i - 1]) continue;
+            vector_push(&m->engine.slot_map,
+                &(VectorSlotMapItem){ .slot_id = missing[i],
+                    .lpdus = vector_make(sizeof(FlexrayLpdu), 0, NULL) });
+        }
+        vector_sort(&m->engine.slot_map);
+    }
+    free(missing);
+
+    /* Add (or merge) the LPDUs, in frame table order. */
+    for (size_t i = 0; i < count; i++) {
+        VectorSlotMapItem* slot_map_item = vector_find(&m->engine.slot_map,
+            &(VectorSlotMapItem){ .slot_id = table[i].slot_id }, 0, NULL);
+        if (slot_map_item == NULL) continue;
+        if (merge) {
+            FlexrayLpdu* lpdu = __find_lpdu(
+                slot_map_item, nid.node_id, table[i].index.frame_table);
+            if (lpdu) {
+                if (lpdu->lpdu_config.payload_length !=
+                    table[i].payload_length) {
+                    free(lpdu->payload);
+                    lpdu->payload = NULL;
+                }
+                lpdu->lpdu_config = table[i];
+                continue;
+            }
+        }
+        vector_push(&slot_map_item->lpdus,
+            &(FlexrayLpdu){ .node_ident = nid, .lpdu_config = table[i] });
+    }
+}
+
+/* Delete the LPDUs (node, slot and frame table index) of a frame table. */
+static void __delete_frame_table(FlexrayBusModel* m,
+    NCodecPduFlexrayNodeIdentifier nid,
+    const NCodecPduFlexrayLpduConfig* table, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        VectorSlotMapItem* slot_map_item = vector_find(&m->engine.slot_map,
+            &(VectorSlotMapItem){ .slot_id = table[i].slot_id }, 0, NULL);
+        if (slot_map_item == NULL) continue;
+        FlexrayLpdu* lpdu = __find_lpdu(
+            slot_map_item, nid.node_id, table[i].index.frame_table);
+        if (lpdu == NULL) continue;
+        free(lpdu->payload);
+        vector_delete_at(&slot_map_item->lpdus,
+            lpdu - (FlexrayLpdu*)slot_map_item->lpdus.items);
+    }
+}
+
+static inline bool __node_match(NCodecPduFlexrayNodeIdentifier a,
+    NCodecPduFlexrayNodeIdentifier b, bool ecu)
+{
+    if (ecu) return a.node.ecu_id == b.node.ecu_id;
+    return a.node_id == b.node_id;
+}
+
+/* Delete the LPDUs and frame tables of a node (or of all nodes of the ECU
+when ecu is set), single pass over the Slot Map. */
+void delete_node_config(
+    FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid, bool ecu)
+{
+    /* The Slot Index is rebuilt on demand. */
+    release_slot_index(m);
+
+    for (size_t i = 0; i < vector_len(&m->engine.slot_map); i++) {
+        VectorSlotMapItem* slot_item = vector_at(&m->engine.slot_map, i, NULL);
+        FlexrayLpdu*       lpdu_list = slot_item->lpdus.items;
+        size_t             n = 0;
+        for (size_t j = 0; j < slot_item->lpdus.length; j++) {
+            if (__node_match(lpdu_list[j].node_ident, nid, ecu)) {
+                free(lpdu_list[j].payload);
+                continue;
+            }
+            lpdu_list[n++] = lpdu_list[j];
+        }
+        slot_item->lpdus.length = n;
+    }
+
+    VectorFlexrayLpduConfigTableItem* config_list =
+        m->engine.config_list.items;
+    size_t n = 0;
+    for (size_t i = 0; i < m->engine.config_list.length; i++) {
+        if (__node_match(config_list[i].node_ident, nid, ecu)) {
+            free(config_list[i].table);
+            continue;
+        }
+        config_list[n++] = config_list[i];
+    }
+    m->engine.config_list.length = n;
+}
+
+/* Frame table update of a node (config operation), the communication cycle
+parameters of the config are not used. */
+static int process_frame_table(
+    FlexrayBusModel* m, NCodecPduFlexrayConfig* config)
+{
+    NCodecPduFlexrayNodeIdentifier    nid = config->node_ident;
+    const NCodecPduFlexrayLpduConfig* table = config->frame_config.table;
+    size_t                            count = config->frame_config.count;
+    if (count && table == NULL) return -EINVAL;
+
+    __make_engine_lists(&m->engine);
+    switch (config->operation) {
+    case NCodecPduFlexrayLpduConfigFrameTableSet:
+        delete_node_config(m, nid, false);
+        __ingest_frame_table(m, nid, table, count, false);
+        __push_config_table(m, nid, table, count);
+        break;
+    case NCodecPduFlexrayLpduConfigFrameTableMerge:
+        __ingest_frame_table(m, nid, table, count, true);
+        __merge_config_table(m, nid, table, count, false);
+        break;
+    case NCodecPduFlexrayLpduConfigFrameTableDelete:
+        __delete_frame_table(m, nid, table, count);
+        __merge_config_table(m, nid, table, count, true);
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    /* The Slot Index references LPDUs of the (modified) Slot Map, the slots
+    of a merge or delete are patched, otherwise the index is rebuilt. */
+    vector_clear(&m->engine.txrx_list, NULL, NULL);
+    if (m->trace_tx_list != NULL) vector_clear(m->trace_tx_list, NULL, NULL);
+    if (config->operation == NCodecPduFlexrayLpduConfigFrameTableSet) {
+        release_slot_index(m);
+    }
+    for (size_t i = 0; i < count && m->engine.slot_index; i++) {
+        if (patch_slot_index(m, table[i].slot_id) == false) {
+            release_slot_index(m);
+        }
+    }
+
+    log_info(m->log_nc,
+        "FlexRay%s: Engine: Frame Table: op=%u, node (%d:%d:%d), count=%u",
+        m->engine.log_id, config->operation, nid.node.ecu_id, nid.node.cc_id,
+        nid.node.swc_id, count);
+    return 0;
+}
+
 int process_config(FlexrayBusModel* m, NCodecPdu* pdu)
 {
     if (pdu == NULL && m == NULL) return -EINVAL;
@@ -43,6 +316,9 @@ int process_config(FlexrayBusModel* m, NCodecPdu* pdu)
     assert(pdu->transport.flexray.metadata_type ==
            NCodecPduFlexrayMetadataTypeConfig);
     NCodecPduFlexrayConfig* config = &pdu->transport.flexray.metadata.config;
+    if (config->operation != NCodecPduFlexrayLpduConfigSet) {
+        return process_frame_table(m, config);
+    }
     if (config->bit_rate == NCodecPduFlexrayBitrateNone) {
         log_error(m->log_nc, "FlexRay%s: Config: no bitrate", m->engine.log_id);
         return -EINVAL;
@@ -88,57 +364,15 @@ int process_config(FlexrayBusModel* m, NCodecPdu* pdu)
                                   m->engine.macrotick_ns /
                                   flexray_bittime_ns[config->bit_rate];
 
-    /* Configure the Slot Map. */
-    VectorFlexrayLpduConfigTableItem frame_config_table = {
-        .node_ident = config->node_ident,
-    };
-    if (config->frame_config.count) {
-        frame_config_table.table = calloc(
-            config->frame_config.count, sizeof(NCodecPduFlexrayLpduConfig));
-        memcpy(frame_config_table.table, config->frame_config.table,
-            config->frame_config.count * sizeof(NCodecPduFlexrayLpduConfig));
-    }
-    if (m->engine.slot_map.capacity == 0) {
-        m->engine.slot_map =
-            vector_make(sizeof(VectorSlotMapItem), 0, VectorSlotMapItemCompar);
-    }
-    for (size_t i = 0; i < config->frame_config.count; i++) {
-        uint16_t           slot_id = frame_config_table.table[i].slot_id;
-        /* Find the Slot Map entry. */
-        VectorSlotMapItem* slot_map_item = NULL;
-        slot_map_item = vector_find(&m->engine.slot_map,
-            &(VectorSlotMapItem){ .slot_id = slot_id }, 0, NULL);
-        if (slot_map_item == NULL) {
-            vector_push(&m->engine.slot_map,
-                &(VectorSlotMapItem){ .slot_id = slot_id,
-                    .lpdus = vector_make(sizeof(FlexrayLpdu), 0, NULL) });
-            vector_sort(&m->engine.slot_map);
-            slot_map_item = vector_find(&m->engine.slot_map,
-                &(VectorSlotMapItem){ .slot_id = slot_id }, 0, NULL);
-
-            /* Continue if vector operations failed. */
-            if (slot_map_item == NULL) continue;
-        }
-
-        /* Add the LPDU config to the Slot Map. */
-        vector_push(&slot_map_item->lpdus,
-            &(FlexrayLpdu){ .node_ident = config->node_ident,
-                .lpdu_config = frame_config_table.table[i] });
-    }
-
-    /* Configure TXRX Inform List (hold references to LPDUs). */
-    if (m->engine.txrx_list.capacity == 0) {
-        m->engine.txrx_list = vector_make(sizeof(FlexrayLpdu*), 0, NULL);
-    }
+    /* Configure the Slot Map (bulk ingest) and the Config List. */
+    __make_engine_lists(&m->engine);
+    __ingest_frame_table(m, config->node_ident, config->frame_config.table,
+        config->frame_config.count, false);
+    __push_config_table(m, config->node_ident, config->frame_config.table,
+        config->frame_config.count);
 
-    /* Configure Config List. */
-    if (m->engine.config_list.capacity == 0) {
-        m->engine.config_list =
-            vector_make(sizeof(VectorFlexrayLpduConfigTableItem), 0, NULL);
-    }
-    if (frame_config_table.table != NULL) {
-        vector_push(&m->engine.config_list, &frame_config_table);
-    }
+    /* The Slot Index references LPDUs of the (modified) Slot Map. */
+    release_slot_index(m);
 
     /* Additional options. */
     m->engine.inhibit_null_frames = config->inhibit_null_frames;
@@ -223,6 +457,8 @@ int calculate_budget(FlexrayBusModel* m, double step_size)
     m->engine.step_budget_ut +=
         (step_size * 1000000000) / m->engine.microtick_ns;
     m->engine.step_budget_mt = m->engine.step_budget_ut / m->engine.macro2micro;
+    m->engine.stats.step_budget_ut = m->engine.step_budget_ut;
+    m->engine.stats.step_used_ut = 0;
 
     /* Clear the TxRx list from previous step. */
     vector_clear(&m->engine.txrx_list, NULL, NULL);
@@ -234,66 +470,302 @@ int calculate_budget(FlexrayBusModel* m, double step_size)
     return 0;
 }
 
-static void process_slot(FlexrayBusModel* m)
+/* Node of the engine, or a member node of a shared engine (cluster). */
+static inline bool __engine_node(FlexrayBusModel* m, uint64_t node_id)
 {
+    if (m->engine.node_list.length == 0) {
+        return node_id == m->engine.node_ident.node_id;
+    }
+    return vector_find(&m->engine.node_list, &node_id, 0, NULL) != NULL;
+}
+
+static inline bool __cycle_match(
+    NCodecPduFlexrayLpduConfig* config, uint8_t cycle)
+{
+    if (config->cycle_repetition == 0) return false;
+    return (cycle % config->cycle_repetition) == config->base_cycle;
+}
+
+/* LPDU of a Slot Index range: Tx LPDUs of the slot (cycle < 0), or Tx/Rx
+LPDUs of a cycle (Rx only for the nodes of this engine). */
+static bool __slot_lpdu_match(FlexrayBusModel* m, FlexrayLpdu* lpdu,
+    NCodecPduFlexrayDirection direction, int cycle)
+{
+    if (lpdu->lpdu_config.direction != direction) return false;
+    if (cycle < 0) return true;
+    if (direction == NCodecPduFlexrayDirectionRx &&
+        __engine_node(m, lpdu->node_ident.node_id) == false) {
+        return false;
+    }
+    return __cycle_match(&lpdu->lpdu_config, cycle);
+}
+
+static inline void __slot_index_push(
+    FlexraySlotIndex* index, FlexraySlotRange* range, FlexrayLpdu* lpdu)
+{
+    /* Ranges are pushed consecutively. */
+    if (range->count == 0) range->offset = vector_len(&index->lpdu_list);
+    vector_push(&index->lpdu_list, &lpdu);
+    range->count++;
+}
+
+static inline void __schedule_push(
+    FlexraySlotIndex* index, FlexraySlotRange* range, uint32_t slot_id)
+{
+    if (range->count == 0) range->offset = vector_len(&index->schedule_list);
+    vector_push(
+        &index->schedule_list, &(FlexrayScheduleItem){ .slot_id = slot_id });
+    range->count++;
+}
+
+static void compile_schedule(FlexrayBusModel* m, FlexraySlotIndex* index)
+{
+    size_t slot_map_len = vector_len(&m->engine.slot_map);
+
+    /* Static segment, slots with a Tx LPDU in each cycle. */
+    for (uint8_t c = 0; c < MAX_CYCLE; c++) {
+        for (size_t i = 0; i < slot_map_len; i++) {
+            VectorSlotMapItem* slot_map_item =
+                vector_at(&m->engine.slot_map, i, NULL);
+            uint32_t slot_id = slot_map_item->slot_id;
+            if (slot_id == 0) continue;
+            if (slot_id > m->engine.static_slot_count) break;
+            FlexraySlot* slot = &index->slot[slot_id];
+            if (slot->cycle == NULL || slot->cycle[c].tx.count == 0) continue;
+            __schedule_push(index, &index->schedule[c], slot_id);
+        }
+    }
+    /* Dynamic segment, slots with a Tx LPDU (pending Tx is evaluated when
+    the slot is reached, the position depends on prior transmissions). */
+    for (size_t i = 0; i < slot_map_len; i++) {
+        VectorSlotMapItem* slot_map_item =
+            vector_at(&m->engine.slot_map, i, NULL);
+        FlexraySlot* slot = &index->slot[slot_map_item->slot_id];
+        if (slot->tx.count == 0) continue;
+        __schedule_push(index, &index->dynamic, slot_map_item->slot_id);
+    }
+}
+
+static FlexraySlotIndex* build_slot_index(FlexrayBusModel* m)
+{
+    FlexraySlotIndex* index = calloc(1, sizeof(FlexraySlotIndex));
+    index->lpdu_list = vector_make(sizeof(FlexrayLpdu*), 0, NULL);
+    index->schedule_list = vector_make(sizeof(FlexrayScheduleItem), 0, NULL);
+    size_t slot_map_len = vector_len(&m->engine.slot_map);
+    if (slot_map_len == 0) return index;
+
+    /* The Slot Map is sorted, the last item has the highest slot_id. */
+    VectorSlotMapItem* last =
+        vector_at(&m->engine.slot_map, slot_map_len - 1, NULL);
+    index->slot_count = last->slot_id + 1;
+    index->slot = calloc(index->slot_count, sizeof(FlexraySlot));
+    index->cycle_list =
+        calloc(slot_map_len * MAX_CYCLE, sizeof(FlexraySlotCycle));
+    for (size_t i = 0; i < slot_map_len; i++) {
+        VectorSlotMapItem* slot_map_item =
+            vector_at(&m->engine.slot_map, i, NULL);
+        size_t lpdu_count = vector_len(&slot_map_item->lpdus);
+        if (lpdu_count == 0) continue;
+        FlexraySlot* slot = &index->slot[slot_map_item->slot_id];
+        slot->cycle = &index->cycle_list[i * MAX_CYCLE];
+
+        /* Tx LPDUs of the slot (dynamic part, pending Tx). */
+        for (size_t j = 0; j < lpdu_count; j++) {
+            FlexrayLpdu* lpdu = vector_at(&slot_map_item->lpdus, j, NULL);
+            if (__slot_lpdu_match(m, lpdu, NCodecPduFlexrayDirectionTx, -1)) {
+                __slot_index_push(index, &slot->tx, lpdu);
+            }
+        }
+        /* Tx and Rx LPDUs of each cycle, in configuration order. */
+        for (uint8_t c = 0; c < MAX_CYCLE; c++) {
+            FlexraySlotCycle* cycle = &slot->cycle[c];
+            for (size_t j = 0; j < lpdu_count; j++) {
+                FlexrayLpdu* lpdu = vector_at(&slot_map_item->lpdus, j, NULL);
+                if (__slot_lpdu_match(
+                        m, lpdu, NCodecPduFlexrayDirectionTx, c)) {
+                    __slot_index_push(index, &cycle->tx, lpdu);
+                }
+            }
+            for (size_t j = 0; j < lpdu_count; j++) {
+                FlexrayLpdu* lpdu = vector_at(&slot_map_item->lpdus, j, NULL);
+                if (__slot_lpdu_match(
+                        m, lpdu, NCodecPduFlexrayDirectionRx, c)) {
+                    __slot_index_push(index, &cycle->rx, lpdu);
+                }
+            }
+        }
+    }
+    compile_schedule(m, index);
+
+    return index;
+}
+
+void release_slot_index(FlexrayBusModel* m)
+{
+    /* The TxRx and Trace lists reference LPDUs (and payloads) of the Slot
+    Map, which is being modified. */
+    vector_clear(&m->engine.txrx_list, NULL, NULL);
+    if (m->trace_tx_list != NULL) vector_clear(m->trace_tx_list, NULL, NULL);
+
+    FlexraySlotIndex* index = m->engine.slot_index;
+    if (index == NULL) return;
+
+    vector_reset(&index->lpdu_list);
+    vector_reset(&index->schedule_list);
+    free(index->cycle_list);
+    free(index->slot);
+    free(index);
+    m->engine.slot_index = NULL;
+}
+
+static inline FlexraySlotIndex* get_slot_index(FlexrayBusModel* m)
+{
+    if (m->engine.slot_index == NULL) {
+        m->engine.slot_index = build_slot_index(m);
+    }
+    return m->engine.slot_index;
+}
+
+static uint32_t __patch_range(FlexrayBusModel* m, FlexraySlotRange* range,
+    VectorSlotMapItem* slot_map_item, NCodecPduFlexrayDirection direction,
+    int cycle, bool write)
+{
+    FlexrayLpdu** lpdu_list = m->engine.slot_index->lpdu_list.items;
+    uint32_t      count = 0;
+    for (size_t i = 0; i < vector_len(&slot_map_item->lpdus); i++) {
+        FlexrayLpdu* lpdu = vector_at(&slot_map_item->lpdus, i, NULL);
+        if (__slot_lpdu_match(m, lpdu, direction, cycle) == false) continue;
+        if (write) lpdu_list[range->offset + count] = lpdu;
+        count++;
+    }
+    if (write) range->count = count;
+    return count;
+}
+
+static void __schedule_remove(
+    FlexraySlotIndex* index, FlexraySlotRange* range, uint32_t slot_id)
+{
+    FlexrayScheduleItem* list = index->schedule_list.items;
+    for (uint32_t i = 0; i < range->count; i++) {
+        if (list[range->offset + i].slot_id != slot_id) continue;
+        memmove(&list[range->offset + i], &list[range->offset + i + 1],
+            (range->count - i - 1) * sizeof(FlexrayScheduleItem));
+        range->count--;
+        return;
+    }
+}
+
+/* Patch the Slot Index entries of a slot, in place, after its LPDUs were
+modified (frame table merge or delete). The ranges of the slot are rewritten
+from the Slot Map and the slot is removed from the schedule of cycles where it
+no longer has a Tx LPDU. Returns false if a range would grow (or the slot is
+not indexed), the Slot Index must then be released (and rebuilt). */
+bool patch_slot_index(FlexrayBusModel* m, uint32_t slot_id)
+{
+    FlexraySlotIndex* index = m->engine.slot_index;
+    if (index == NULL) return true;
     VectorSlotMapItem* slot_map_item = vector_find(&m->engine.slot_map,
-        &(VectorSlotMapItem){ .slot_id = m->engine.pos_slot }, 0, NULL);
-    if (slot_map_item == NULL) {
+        &(VectorSlotMapItem){ .slot_id = slot_id }, 0, NULL);
+    if (slot_map_item == NULL || slot_id >= index->slot_count) return false;
+    FlexraySlot* slot = &index->slot[slot_id];
+    if (slot->cycle == NULL) return vector_len(&slot_map_item->lpdus) == 0;
+
+    /* Check, the ranges of the slot may only shrink. */
+    NCodecPduFlexrayDirection tx = NCodecPduFlexrayDirectionTx;
+    NCodecPduFlexrayDirection rx = NCodecPduFlexrayDirectionRx;
+    if (__patch_range(m, &slot->tx, slot_map_item, tx, -1, false) >
+        slot->tx.count) {
+        return false;
+    }
+    for (uint8_t c = 0; c < MAX_CYCLE; c++) {
+        FlexraySlotCycle* cycle = &slot->cycle[c];
+        if (__patch_range(m, &cycle->tx, slot_map_item, tx, c, false) >
+                cycle->tx.count ||
+            __patch_range(m, &cycle->rx, slot_map_item, rx, c, false) >
+                cycle->rx.count) {
+            return false;
+        }
+    }
+
+    /* Patch the ranges and the schedule. */
+    __patch_range(m, &slot->tx, slot_map_item, tx, -1, true);
+    if (slot->tx.count == 0) __schedule_remove(index, &index->dynamic, slot_id);
+    for (uint8_t c = 0; c < MAX_CYCLE; c++) {
+        FlexraySlotCycle* cycle = &slot->cycle[c];
+        __patch_range(m, &cycle->tx, slot_map_item, tx, c, true);
+        __patch_range(m, &cycle->rx, slot_map_item, rx, c, true);
+        if (cycle->tx.count == 0) {
+            __schedule_remove(index, &index->schedule[c], slot_id);
+        }
+    }
+    if (vector_len(&slot_map_item->lpdus) == 0) slot->cycle = NULL;
+    return true;
+}
+
+static inline FlexraySlot* get_slot(FlexrayBusModel* m, uint32_t slot_id)
+{
+    FlexraySlotIndex* index = get_slot_index(m);
+    if (slot_id >= index->slot_count) return NULL;
+    FlexraySlot* slot = &index->slot[slot_id];
+    if (slot->cycle == NULL) return NULL;
+    return slot;
+}
+
+/* Returns true if a frame was transmitted in the slot (not a null frame). */
+static bool process_slot(FlexrayBusModel* m)
+{
+    FlexraySlot* slot = get_slot(m, m->engine.pos_slot);
+    if (slot == NULL) {
         /* No configured slot. */
-        return;
+        return false;
     }
+    if (m->engine.pos_mt >= m->engine.offset_network_mt) return false;
+    FlexraySlotCycle* cycle = &slot->cycle[m->engine.pos_cycle];
+    FlexrayLpdu**     lpdu_list = m->engine.slot_index->lpdu_list.items;
 
-    log_debug(m->log_nc, "FlexRay%s: Process slot: %u (cycle=%u, mt=%u) len=%u",
+    log_debug(m->log_nc,
+        "FlexRay%s: Process slot: %u (cycle=%u, mt=%u) tx=%u, rx=%u",
         m->engine.log_id, m->engine.pos_slot, m->engine.pos_cycle,
-        m->engine.pos_mt, vector_len(&slot_map_item->lpdus));
+        m->engine.pos_mt, cycle->tx.count, cycle->rx.count);
 
-    /* Search for Tx and Rx LPDUs in this slot. */
+    /* Tx LPDU of this cycle (Static Part / Dynamic Part). */
     FlexrayLpdu* tx_lpdu = NULL;
-    FlexrayLpdu* rx_lpdu = NULL;
     bool         tx_null_frame = false;
-    for (size_t i = 0; i < vector_len(&slot_map_item->lpdus); i++) {
-        FlexrayLpdu* lpdu_item = vector_at(&slot_map_item->lpdus, i, NULL);
-        if (lpdu_item->lpdu_config.direction == NCodecPduFlexrayDirectionTx) {
-            /* TX LPDU. */
-            if (m->engine.pos_mt < m->engine.offset_network_mt) {
-                /* Static Part / Dynamic Part. */
-                if (lpdu_item->lpdu_config.cycle_repetition == 0) continue;
-                if (m->engine.pos_cycle %
-                        lpdu_item->lpdu_config.cycle_repetition !=
-                    lpdu_item->lpdu_config.base_cycle)
-                    continue;
-                /* Tx identified. */
-                tx_lpdu = lpdu_item;
-                log_debug(m->log_nc,
-                    "FlexRay%s:   Tx LPDU Identified (%s): "
-                    "index=%u, base=%u, repeat=%u, status=%u",
-                    m->engine.log_id,
-                    (m->engine.pos_mt < m->engine.offset_dynamic_mt)
-                        ? "static"
-                        : "dynamic",
-                    lpdu_item->lpdu_config.index.frame_table,
-                    lpdu_item->lpdu_config.base_cycle,
-                    lpdu_item->lpdu_config.cycle_repetition,
-                    lpdu_item->lpdu_config.status);
-                if (m->engine.pos_mt < m->engine.offset_dynamic_mt) {
-                    /* Determine if the Tx will represent a NULL Frame. */
-                    if (tx_lpdu->lpdu_config.status ==
-                            NCodecPduFlexrayLpduStatusNone ||
-                        tx_lpdu->lpdu_config.status ==
-                            NCodecPduFlexrayLpduStatusTransmitted) {
-                        tx_null_frame = true;
-                    }
-                }
+    for (size_t i = 0; i < cycle->tx.count; i++) {
+        FlexrayLpdu* lpdu_item = lpdu_list[cycle->tx.offset + i];
+        /* Tx identified. */
+        tx_lpdu = lpdu_item;
+        log_debug(m->log_nc,
+            "FlexRay%s:   Tx LPDU Identified (%s): "
+            "index=%u, base=%u, repeat=%u, status=%u",
+            m->engine.log_id,
+            (m->engine.pos_mt < m->engine.offset_dynamic_mt) ? "static"
+                                                              : "dynamic",
+            lpdu_item->lpdu_config.index.frame_table,
+            lpdu_item->lpdu_config.base_cycle,
+            lpdu_item->lpdu_config.cycle_repetition,
+            lpdu_item->lpdu_config.status);
+        if (m->engine.pos_mt < m->engine.offset_dynamic_mt) {
+            /* Determine if the Tx will represent a NULL Frame. */
+            if (tx_lpdu->lpdu_config.status ==
+                    NCodecPduFlexrayLpduStatusNone ||
+                tx_lpdu->lpdu_config.status ==
+                    NCodecPduFlexrayLpduStatusTransmitted) {
+                tx_null_frame = true;
             }
         }
     }
-    if (tx_lpdu == NULL) return;
+    if (tx_lpdu == NULL) return false;
+    m->engine.stats.null_frame_count += tx_null_frame;
 
     /* Perform the Tx (-> Rx). */
+    bool tx_frame = false;
     if (tx_lpdu->lpdu_config.status ==
             NCodecPduFlexrayLpduStatusNotTransmitted &&
         tx_null_frame == false) {
         /* Process the TX. */
+        tx_frame = true;
+        tx_lpdu->tx_count++;
         if (tx_lpdu->lpdu_config.transmit_mode !=
             NCodecPduFlexrayTransmitModeContinuous) {
             tx_lpdu->lpdu_config.status = NCodecPduFlexrayLpduStatusTransmitted;
@@ -306,7 +778,7 @@ static void process_slot(FlexrayBusModel* m)
         }
         tx_lpdu->cycle = m->engine.pos_cycle;
         tx_lpdu->macrotick = m->engine.pos_mt;
-        if (tx_lpdu->node_ident.node_id == m->engine.node_ident.node_id) {
+        if (__engine_node(m, tx_lpdu->node_ident.node_id)) {
             vector_push(&m->engine.txrx_list, &tx_lpdu);
         }
 
@@ -316,68 +788,57 @@ static void process_slot(FlexrayBusModel* m)
         }
     }
 
-    /* And the associated RX, if identified. */
-    for (size_t i = 0; i < vector_len(&slot_map_item->lpdus); i++) {
-        FlexrayLpdu* rx_lpdu = NULL;
-        FlexrayLpdu* lpdu_item = vector_at(&slot_map_item->lpdus, i, NULL);
-        /* Identify Rx LPDU, only for this node. */
-        if (lpdu_item->lpdu_config.direction == NCodecPduFlexrayDirectionRx) {
-            /* Check configured LPDU status. */
-            if (lpdu_item->lpdu_config.status !=
-                    NCodecPduFlexrayLpduStatusNotReceived &&
-                lpdu_item->lpdu_config.status !=
-                    NCodecPduFlexrayLpduStatusReceived) {
-                continue;
-            }
-            /* Check configured on the NCodec for this node.*/
-            if (lpdu_item->node_ident.node_id == m->engine.node_ident.node_id) {
-                if (m->engine.pos_mt < m->engine.offset_network_mt) {
-                    /* Static / Dynamic Part. */
-                    if (lpdu_item->lpdu_config.cycle_repetition == 0) continue;
-                    if (m->engine.pos_cycle %
-                            lpdu_item->lpdu_config.cycle_repetition !=
-                        lpdu_item->lpdu_config.base_cycle)
-                        continue;
-                    /* Rx identified. */
-                    rx_lpdu = lpdu_item;
-                    log_debug(m->log_nc,
-                        "FlexRay%s:   Rx LPDU Identified (%s): "
-                        "index=%u, base=%u, repeat=%u, status=%u",
-                        m->engine.log_id,
-                        (m->engine.pos_mt < m->engine.offset_dynamic_mt)
-                            ? "static"
-                            : "dynamic",
-                        lpdu_item->lpdu_config.index.frame_table,
-                        lpdu_item->lpdu_config.base_cycle,
-                        lpdu_item->lpdu_config.cycle_repetition,
-                        lpdu_item->lpdu_config.status);
-                }
-            }
+    /* And the associated RX (this node), if identified. */
+    for (size_t i = 0; i < cycle->rx.count; i++) {
+        FlexrayLpdu* rx_lpdu = lpdu_list[cycle->rx.offset + i];
+        /* Check configured LPDU status. */
+        if (rx_lpdu->lpdu_config.status !=
+                NCodecPduFlexrayLpduStatusNotReceived &&
+            rx_lpdu->lpdu_config.status != NCodecPduFlexrayLpduStatusReceived) {
+            rx_lpdu->drop_count++;
+            continue;
         }
+        log_debug(m->log_nc,
+            "FlexRay%s:   Rx LPDU Identified (%s): "
+            "index=%u, base=%u, repeat=%u, status=%u",
+            m->engine.log_id,
+            (m->engine.pos_mt < m->engine.offset_dynamic_mt) ? "static"
+                                                              : "dynamic",
+            rx_lpdu->lpdu_config.index.frame_table,
+            rx_lpdu->lpdu_config.base_cycle,
+            rx_lpdu->lpdu_config.cycle_repetition,
+            rx_lpdu->lpdu_config.status);
         /* Perform the Rx for this LPDU (on this node). */
-        if (rx_lpdu != NULL) {
-            if (tx_null_frame) {
-                if (rx_lpdu->lpdu_config.inhibit_null == false &&
-                    m->engine.inhibit_null_frames == false) {
-                    rx_lpdu->cycle = m->engine.pos_cycle;
-                    rx_lpdu->macrotick = m->engine.pos_mt;
-                    rx_lpdu->null_frame = true;
-                    log_debug(m->log_nc, "FlexRay%s:   LPDU %04x: Rx <- NULL",
-                        m->engine.log_id, rx_lpdu->lpdu_config.slot_id);
-                    vector_push(&m->engine.txrx_list, &rx_lpdu);
-                }
+        if (tx_null_frame) {
+            if (rx_lpdu->lpdu_config.inhibit_null == false &&
+                m->engine.inhibit_null_frames == false) {
+                rx_lpdu->cycle = m->engine.pos_cycle;
+                rx_lpdu->macrotick = m->engine.pos_mt;
+                rx_lpdu->null_frame = true;
+                rx_lpdu->rx_payload = NULL;
+                log_debug(m->log_nc, "FlexRay%s:   LPDU %04x: Rx <- NULL",
+                    m->engine.log_id, rx_lpdu->lpdu_config.slot_id);
+                vector_push(&m->engine.txrx_list, &rx_lpdu);
+            }
+        } else {
+            rx_lpdu->lpdu_config.status = NCodecPduFlexrayLpduStatusReceived;
+            rx_lpdu->rx_count++;
+            size_t len = rx_lpdu->lpdu_config.payload_length;
+            if (tx_lpdu->payload &&
+                tx_lpdu->lpdu_config.payload_length >= len) {
+                /* Deliver by reference, the Tx payload is not modified
+                before the Rx is written (progress). */
+                log_debug(m->log_nc,
+                    "FlexRay%s:   LPDU %04x: Rx <- Tx: payload_length=%u",
+                    m->engine.log_id, tx_lpdu->lpdu_config.slot_id, len);
+                rx_lpdu->rx_payload = tx_lpdu->payload;
             } else {
-                rx_lpdu->lpdu_config.status =
-                    NCodecPduFlexrayLpduStatusReceived;
+                /* Shorter Tx payload (padded), or no Tx payload. */
                 if (rx_lpdu->payload == NULL) {
-                    rx_lpdu->payload = calloc(
-                        rx_lpdu->lpdu_config.payload_length, sizeof(uint8_t));
+                    rx_lpdu->payload = calloc(len, sizeof(uint8_t));
                 }
                 if (tx_lpdu->payload) {
-                    size_t len = rx_lpdu->lpdu_config.payload_length;
-                    if (len > tx_lpdu->lpdu_config.payload_length) {
-                        len = tx_lpdu->lpdu_config.payload_length;
-                    }
+                    len = tx_lpdu->lpdu_config.payload_length;
                     log_debug(m->log_nc,
                         "FlexRay%s:   LPDU %04x: Rx <- Tx: payload_length=%u",
                         m->engine.log_id, tx_lpdu->lpdu_config.slot_id, len);
@@ -385,13 +846,64 @@ static void process_slot(FlexrayBusModel* m)
                         rx_lpdu->lpdu_config.payload_length - len);
                     memcpy(rx_lpdu->payload, tx_lpdu->payload, len);
                 }
-                rx_lpdu->cycle = m->engine.pos_cycle;
-                rx_lpdu->macrotick = m->engine.pos_mt;
-                rx_lpdu->null_frame = false;
-                vector_push(&m->engine.txrx_list, &rx_lpdu);
+                rx_lpdu->rx_payload = rx_lpdu->payload;
             }
+            rx_lpdu->cycle = m->engine.pos_cycle;
+            rx_lpdu->macrotick = m->engine.pos_mt;
+            rx_lpdu->null_frame = false;
+            vector_push(&m->engine.txrx_list, &rx_lpdu);
+        }
+    }
+    return tx_frame;
+}
+
+/* Next scheduled slot (slot_id >= from), UINT32_MAX if none. */
+static uint32_t next_scheduled_slot(
+    FlexraySlotIndex* index, FlexraySlotRange* range, uint32_t from)
+{
+    FlexrayScheduleItem* list = index->schedule_list.items;
+    size_t               lo = range->offset;
+    size_t               hi = range->offset + range->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (list[mid].slot_id < from) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
         }
     }
+    if (lo < range->offset + range->count) return list[lo].slot_id;
+    return UINT32_MAX;
+}
+
+/* Consume the empty slots (of need_mt each) before next_slot, as far as the
+budget allows. Only slots starting before end_mt and ending before max_mt
+are consumed. The result is identical to consuming each slot individually.
+Returns the number of consumed slots. */
+static uint32_t skip_slots(FlexrayBusModel* m, uint32_t next_slot,
+    uint32_t need_mt, uint32_t end_mt, uint32_t max_mt)
+{
+    if (need_mt == 0 || next_slot <= m->engine.pos_slot) return 0;
+    if (m->engine.pos_mt >= end_mt || m->engine.pos_mt > max_mt) return 0;
+    uint32_t need_ut = need_mt * m->engine.macro2micro;
+    if (need_ut == 0) return 0;
+
+    uint32_t count = next_slot - m->engine.pos_slot;
+    uint32_t limit = m->engine.step_budget_ut / need_ut;
+    if (count > limit) count = limit;
+    limit = (end_mt - m->engine.pos_mt + need_mt - 1) / need_mt;
+    if (count > limit) count = limit;
+    limit = (max_mt - m->engine.pos_mt) / need_mt;
+    if (count > limit) count = limit;
+    if (count == 0) return 0;
+
+    m->engine.step_budget_ut -= count * need_ut;
+    m->engine.step_budget_mt -= count * need_mt;
+    m->engine.stats.used_ut += count * need_ut;
+    m->engine.stats.step_used_ut += count * need_ut;
+    m->engine.pos_slot += count;
+    m->engine.pos_mt += count * need_mt;
+    return count;
 }
 
 int consume_slot(FlexrayBusModel* m)
@@ -403,29 +915,37 @@ int consume_slot(FlexrayBusModel* m)
         if (need_ut > m->engine.step_budget_ut) {
             /* Not enough budget. */
             return 1;
-        } else {
-            /* Consume the slot. */
-            process_slot(m);
-            m->engine.step_budget_ut -= need_ut;
-            m->engine.step_budget_mt -= need_mt;
-            m->engine.pos_slot += 1;
-            m->engine.pos_mt += need_mt;
-            return 0;
         }
+        /* Fast-forward to the next scheduled slot of this cycle. */
+        FlexraySlotIndex* index = get_slot_index(m);
+        uint32_t          next_slot = next_scheduled_slot(index,
+                     &index->schedule[m->engine.pos_cycle], m->engine.pos_slot);
+        uint32_t          skip_count = skip_slots(
+            m, next_slot, need_mt, m->engine.offset_dynamic_mt, UINT32_MAX);
+        m->engine.stats.static_slot_count += skip_count;
+        if (skip_count) return 0;
+        /* Consume the slot. */
+        m->engine.stats.static_frame_count += process_slot(m);
+        m->engine.stats.static_slot_count++;
+        m->engine.stats.used_ut += need_ut;
+        m->engine.stats.step_used_ut += need_ut;
+        m->engine.step_budget_ut -= need_ut;
+        m->engine.step_budget_mt -= need_mt;
+        m->engine.pos_slot += 1;
+        m->engine.pos_mt += need_mt;
+        return 0;
     } else if (m->engine.pos_mt < m->engine.offset_network_mt) {
         /* In dynamic part of cycle. */
-        uint32_t           need_mt = m->engine.minislot_length_mt;
-        bool               pending_tx = false;
-        VectorSlotMapItem* slot_map_item = vector_find(&m->engine.slot_map,
-            &(VectorSlotMapItem){ .slot_id = m->engine.pos_slot }, 0, NULL);
-        if (slot_map_item != NULL) {
-            for (size_t i = 0; i < vector_len(&slot_map_item->lpdus); i++) {
-                FlexrayLpdu* lpdu_item =
-                    vector_at(&slot_map_item->lpdus, i, NULL);
-                if (lpdu_item->lpdu_config.direction ==
-                        NCodecPduFlexrayDirectionTx &&
-                    lpdu_item->lpdu_config.status ==
-                        NCodecPduFlexrayLpduStatusNotTransmitted) {
+        uint32_t     need_mt = m->engine.minislot_length_mt;
+        uint32_t     minislot_count = 1;
+        bool         pending_tx = false;
+        FlexraySlot* slot = get_slot(m, m->engine.pos_slot);
+        if (slot != NULL) {
+            FlexrayLpdu** lpdu_list = m->engine.slot_index->lpdu_list.items;
+            for (size_t i = 0; i < slot->tx.count; i++) {
+                FlexrayLpdu* lpdu_item = lpdu_list[slot->tx.offset + i];
+                if (lpdu_item->lpdu_config.status ==
+                    NCodecPduFlexrayLpduStatusNotTransmitted) {
                     /* Pending TX LPDU, calculate transmission MT (round up). */
                     pending_tx = true;
                     unsigned int mini_slot_count =
@@ -433,15 +953,30 @@ int consume_slot(FlexrayBusModel* m)
                             m->engine.bits_per_minislot - 1) /
                         m->engine.bits_per_minislot;
                     need_mt = mini_slot_count * m->engine.minislot_length_mt;
+                    minislot_count = mini_slot_count;
                 }
             }
         }
+        if (pending_tx == false) {
+            /* Fast-forward to the next slot with a Tx LPDU. */
+            FlexraySlotIndex* index = get_slot_index(m);
+            uint32_t          next_slot = next_scheduled_slot(
+                index, &index->dynamic, m->engine.pos_slot + 1);
+            uint32_t          skip_count = skip_slots(m, next_slot, need_mt,
+                         m->engine.offset_network_mt,
+                         m->engine.macrotick_per_cycle);
+            m->engine.stats.minislot_count += skip_count;
+            if (skip_count) return 0;
+        }
         if (need_mt + m->engine.pos_mt > m->engine.macrotick_per_cycle) {
             log_info(m->log_nc,
                 "FlexRay engine configuration exceeds cycle length: "
                 "need_mt=%u, pos_mt=%u, cycle_mt=%u",
                 need_mt, m->engine.pos_mt, m->engine.macrotick_per_cycle);
             need_mt = m->engine.macrotick_per_cycle - m->engine.pos_mt;
+            if (m->engine.minislot_length_mt) {
+                minislot_count = need_mt / m->engine.minislot_length_mt;
+            }
         }
         uint32_t need_ut = need_mt * m->engine.macro2micro;
         if (need_ut > m->engine.step_budget_ut) {
@@ -450,8 +985,14 @@ int consume_slot(FlexrayBusModel* m)
         } else {
             /* Consume the slot. */
             if (pending_tx) {
-                process_slot(m);
+                bool tx_frame = process_slot(m);
+                m->engine.stats.dynamic_frame_count += tx_frame;
+                m->engine.stats.frame_minislot_count +=
+                    tx_frame * minislot_count;
             }
+            m->engine.stats.minislot_count += minislot_count;
+            m->engine.stats.used_ut += need_ut;
+            m->engine.stats.step_used_ut += need_ut;
             m->engine.step_budget_ut -= need_ut;
             m->engine.step_budget_mt -= need_mt;
             m->engine.pos_slot += 1;
@@ -477,6 +1018,9 @@ int consume_slot(FlexrayBusModel* m)
         } else {
             /* Consume the slot remainder. */
             m->engine.step_budget_ut -= remaining_ut;
+            m->engine.stats.used_ut += remaining_ut;
+            m->engine.stats.step_used_ut += remaining_ut;
+            m->engine.stats.cycle_count++;
             /* Cycle complete, reset the pos markers. */
             m->engine.pos_slot = 1;
             m->engine.pos_mt = 0;
@@ -514,11 +1058,123 @@ void release_config(FlexrayBusModel* m)
         }
     }
     vector_reset(&m->engine.slot_map);
+    release_slot_index(m);
     vector_reset(&m->engine.txrx_list);
     vector_clear(&m->engine.config_list, __flexray_config_destroy, NULL);
     vector_reset(&m->engine.config_list);
 }
 
+int snapshot_config(FlexrayBusModel* m, ABCodecSnapshot* s)
+{
+    /* Engine (scalars), references are rebuilt on restore. */
+    FlexrayEngine engine = m->engine;
+    engine.slot_map = (Vector){ 0 };
+    engine.slot_index = NULL;
+    engine.txrx_list = (Vector){ 0 };
+    engine.config_list = (Vector){ 0 };
+    engine.node_list = (Vector){ 0 };
+    engine.log_id = NULL;
+    int rc = snapshot_write(s, &engine, sizeof(FlexrayEngine));
+
+    /* Slot Map, including the LPDU payloads. */
+    uint32_t slot_count = vector_len(&m->engine.slot_map);
+    rc |= snapshot_write(s, &slot_count, sizeof(slot_count));
+    for (size_t i = 0; i < slot_count; i++) {
+        VectorSlotMapItem* slot_item = vector_at(&m->engine.slot_map, i, NULL);
+        uint32_t           lpdu_count = vector_len(&slot_item->lpdus);
+        rc |= snapshot_write(s, &slot_item->slot_id, sizeof(uint32_t));
+        rc |= snapshot_write(s, &lpdu_count, sizeof(lpdu_count));
+        for (size_t j = 0; j < lpdu_count; j++) {
+            FlexrayLpdu lpdu;
+            vector_at(&slot_item->lpdus, j, &lpdu);
+            uint8_t* payload = lpdu.payload;
+            /* The payload field indicates that payload data follows. */
+            lpdu.payload = (uint8_t*)(uintptr_t)(payload != NULL);
+            lpdu.rx_payload = NULL;
+            rc |= snapshot_write(s, &lpdu, sizeof(FlexrayLpdu));
+            if (payload) {
+                rc |= snapshot_write(
+                    s, payload, lpdu.lpdu_config.payload_length);
+            }
+        }
+    }
+
+    /* Config List. */
+    uint32_t config_count = vector_len(&m->engine.config_list);
+    rc |= snapshot_write(s, &config_count, sizeof(config_count));
+    for (size_t i = 0; i < config_count; i++) {
+        VectorFlexrayLpduConfigTableItem* config =
+            vector_at(&m->engine.config_list, i, NULL);
+        rc |= snapshot_write(
+            s, config, sizeof(VectorFlexrayLpduConfigTableItem));
+        rc |= snapshot_write(s, config->table,
+            config->count * sizeof(NCodecPduFlexrayLpduConfig));
+    }
+
+    return rc;
+}
+
+int restore_config(FlexrayBusModel* m, ABCodecSnapshot* s)
+{
+    /* Restore into the (released) engine object of the model. */
+    FlexrayEngine engine;
+    if (snapshot_read(s, &engine, sizeof(FlexrayEngine))) return -EINVAL;
+    engine.log_id = m->engine.log_id;
+    engine.slot_map =
+        vector_make(sizeof(VectorSlotMapItem), 0, VectorSlotMapItemCompar);
+    engine.slot_index = NULL;
+    engine.node_list = (Vector){ 0 };
+    engine.txrx_list = vector_make(sizeof(FlexrayLpdu*), 0, NULL);
+    engine.config_list =
+        vector_make(sizeof(VectorFlexrayLpduConfigTableItem), 0, NULL);
+    m->engine = engine;
+
+    /* Slot Map (already sorted), including the LPDU payloads. */
+    uint32_t slot_count;
+    if (snapshot_read(s, &slot_count, sizeof(slot_count))) return -EINVAL;
+    for (size_t i = 0; i < slot_count; i++) {
+        VectorSlotMapItem slot_item = { 0 };
+        uint32_t          lpdu_count;
+        if (snapshot_read(s, &slot_item.slot_id, sizeof(uint32_t)) ||
+            snapshot_read(s, &lpdu_count, sizeof(lpdu_count))) {
+            return -EINVAL;
+        }
+        slot_item.lpdus = vector_make(sizeof(FlexrayLpdu), lpdu_count, NULL);
+        for (size_t j = 0; j < lpdu_count; j++) {
+            FlexrayLpdu lpdu;
+            if (snapshot_read(s, &lpdu, sizeof(FlexrayLpdu))) break;
+            lpdu.rx_payload = NULL;
+            if (lpdu.payload) {
+                size_t      len = lpdu.lpdu_config.payload_length;
+                const void* payload = snapshot_ref(s, len);
+                if (payload == NULL) break;
+                lpdu.payload = calloc(len, sizeof(uint8_t));
+                memcpy(lpdu.payload, payload, len);
+            }
+            vector_push(&slot_item.lpdus, &lpdu);
+        }
+        /* Push before checking, so that release_config() frees the LPDUs. */
+        vector_push(&m->engine.slot_map, &slot_item);
+        if (vector_len(&slot_item.lpdus) != lpdu_count) return -EINVAL;
+    }
+
+    /* Config List. */
+    uint32_t config_count;
+    if (snapshot_read(s, &config_count, sizeof(config_count))) return -EINVAL;
+    for (size_t i = 0; i < config_count; i++) {
+        VectorFlexrayLpduConfigTableItem config;
+        if (snapshot_read(s, &config, sizeof(config))) return -EINVAL;
+        size_t      len = config.count * sizeof(NCodecPduFlexrayLpduConfig);
+        const void* table = snapshot_ref(s, len);
+        if (table == NULL) return -EINVAL;
+        config.table = calloc(config.count, sizeof(NCodecPduFlexrayLpduConfig));
+        memcpy(config.table, table, len);
+        vector_push(&m->engine.config_list, &config);
+    }
+
+    return 0;
+}
+
 int shift_cycle(FlexrayBusModel* m, uint32_t mt, uint8_t cycle, bool force)
 {
     if (mt < m->engine.offset_dynamic_mt) {
@@ -580,6 +1236,14 @@ int set_lpdu(FlexrayBusModel* m, uint64_t node_id, uint32_t slot_id,
         return -EINVAL;
     }
 
+    /* A pending (single shot) Tx frame is replaced, count as dropped. */
+    if (lpdu->lpdu_config.direction == NCodecPduFlexrayDirectionTx &&
+        lpdu->lpdu_config.transmit_mode !=
+            NCodecPduFlexrayTransmitModeContinuous &&
+        lpdu->lpdu_config.status == NCodecPduFlexrayLpduStatusNotTransmitted &&
+        lpdu->payload != NULL) {
+        lpdu->drop_count++;
+    }
     lpdu->lpdu_config.status = status;
 
     if (lpdu->lpdu_config.direction == NCodecPduFlexrayDirectionTx) {
@@ -598,3 +1262,19 @@ int set_lpdu(FlexrayBusModel* m, uint64_t node_id, uint32_t slot_id,
 
     return 0;
 }
+
+FlexrayNodeStats get_node_stats(FlexrayBusModel* m, uint64_t node_id)
+{
+    FlexrayNodeStats stats = { 0 };
+    for (size_t i = 0; i < vector_len(&m->engine.slot_map); i++) {
+        VectorSlotMapItem* slot_item = vector_at(&m->engine.slot_map, i, NULL);
+        FlexrayLpdu*       lpdu_list = slot_item->lpdus.items;
+        for (size_t j = 0; j < slot_item->lpdus.length; j++) {
+            if (lpdu_list[j].node_ident.node_id != node_id) continue;
+            stats.tx_count += lpdu_list[j].tx_count;
+            stats.rx_count += lpdu_list[j].rx_count;
+            stats.drop_count += lpdu_list[j].drop_count;
+        }
+    }
+    return stats;
+}
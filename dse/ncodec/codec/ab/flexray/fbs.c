@@ -50,6 +50,7 @@ static void _decode_flexray_config(
     c->static_slot_payload_length =
         ns(FlexrayConfig_static_slot_payload_length(fc_msg));
 
+    c->operation = ns(FlexrayConfig_config_op(fc_msg));
     c->bit_rate = ns(FlexrayConfig_bit_rate(fc_msg));
     c->channel_enable = ns(FlexrayConfig_channel_enable(fc_msg));
 
@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <errno.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <dse/ncodec/stream/stream.h>
@@ -9,35 +10,6 @@
 #include <dse/ncodec/codec/ab/flexray/flexray.h>
 
 
-ABCodecInstance* _ab_nc_copy(ABCodecInstance* nc)
-{
-    /* Shallow copy the nc object. */
-    ABCodecInstance* nc_copy = calloc(1, sizeof(ABCodecInstance));
-    *nc_copy = *nc;
-    nc_copy->c.stream = NULL;
-    nc_copy->c.trace = (NCodecTraceVTable){ 0 };
-    nc_copy->c.private = NULL;
-    nc_copy->model = NULL;
-    nc_copy->fbs_builder = (flatcc_builder_t){ 0 };
-    nc_copy->fbs_builder_initalized = false;
-    nc_copy->fbs_stream_initalized = false;
-    nc_copy->reader = (ABCodecReader){ 0 };
-    nc_copy->free_list = (Vector){ 0 };
-    nc_copy->trace.filename = NULL;
-    nc_copy->trace.file = NULL;
-
-    /* Rebuild various objects in the model NC. */
-    enum { BUFFER_LEN = 1024 };
-    flatcc_builder_init(&nc_copy->fbs_builder);
-    nc_copy->fbs_builder.buffer_flags |= flatcc_builder_with_size;
-    nc_copy->fbs_stream_initalized = false;
-    nc_copy->fbs_builder_initalized = true;
-    nc_copy->c.stream = ncodec_buffer_stream_create(BUFFER_LEN);
-
-    return nc_copy;
-}
-
-
 void flexray_bus_model_setup(ABCodecBusModel* bm)
 {
     /* Tx trace stream, shallow copy of NC. */
@@ -55,11 +27,8 @@ void flexray_bus_model_setup(ABCodecBusModel* bm)
     }
 }
 
-bool flexray_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu)
+static void _consume(ABCodecBusModel* bm, FlexrayBusModel* m, NCodecPdu* pdu)
 {
-    if (pdu->transport_type != NCodecPduTransportTypeFlexray) return false;
-
-    FlexrayBusModel*               m = (FlexrayBusModel*)bm->model;
     NCodecPduFlexrayNodeIdentifier node_ident =
         pdu->transport.flexray.node_ident;
 
@@ -74,6 +43,11 @@ bool flexray_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu)
         /* Ensure the Config has the node_ident of the PDU. */
         pdu->transport.flexray.metadata.config.node_ident = node_ident;
         process_config(m, pdu);
+        /* Frame table updates do not (re)configure the node. */
+        if (pdu->transport.flexray.metadata.config.operation !=
+            NCodecPduFlexrayLpduConfigSet) {
+            break;
+        }
         log_debug(bm->log_nc, "Configure %d VCN (nid (%d:%d:%d))",
             pdu->transport.flexray.metadata.config.vcn_count,
             node_ident.node.ecu_id, node_ident.node.cc_id,
@@ -119,15 +93,31 @@ bool flexray_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu)
         log_error(bm->log_nc, "Unexpected FlexRay metadata type (%d)",
             pdu->transport.flexray.metadata_type);
     }
+}
+
+bool flexray_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu)
+{
+    if (pdu->transport_type != NCodecPduTransportTypeFlexray) return false;
+
+    FlexrayBusModel* m = (FlexrayBusModel*)bm->model;
+    FlexrayCluster*  c = m->cluster;
+    if (c == NULL) {
+        _consume(bm, m, pdu);
+        return true;
+    }
 
+    /* Shared engine, the PDU is applied once (by the first member). */
+    pthread_mutex_lock(&c->mutex);
+    if (cluster_consume(m, bm->log_nc->simulation_time.value)) {
+        _consume(bm, &c->model, pdu);
+    }
+    pthread_mutex_unlock(&c->mutex);
     return true;
 }
 
-void flexray_bus_model_progress(ABCodecBusModel* bm)
+/* Run the schedule of the engine (model m) for one step. */
+static void _progress_engine(ABCodecBusModel* bm, FlexrayBusModel* m)
 {
-    FlexrayBusModel*               m = (FlexrayBusModel*)bm->model;
-    NCodecPduFlexrayNodeIdentifier node_ident = m->node_ident;
-
     calculate_bus_condition(m);
     log_trace(bm->log_nc, "FlexRay%s: Progress: Bus Condition=%s", m->log_id,
         tcvr_state_string(m->state.bus_condition));
@@ -149,20 +139,33 @@ void flexray_bus_model_progress(ABCodecBusModel* bm)
                     m->engine.pos_mt, m->engine.step_budget_mt,
                     m->engine.step_budget_ut);
             }
+            log_trace(bm->log_nc,
+                "FlexRay%s: Progress: Used (ut=%u of %u), cycles=%lu",
+                m->log_id, m->engine.stats.step_used_ut,
+                m->engine.stats.step_budget_ut,
+                (unsigned long)m->engine.stats.cycle_count);
         } else {
             log_error(bm->log_nc, "Call to calculate_budget() returned %d", rc);
         }
     }
+}
+
+/* Write the status and LPDUs of the node (model m) from the engine (model e,
+which is m or the shared model of a cluster). */
+static void _progress_node(
+    ABCodecBusModel* bm, FlexrayBusModel* m, FlexrayBusModel* e)
+{
+    NCodecPduFlexrayNodeIdentifier node_ident = m->node_ident;
 
-    FlexrayNodeState ns = get_node_state(m, node_ident);
+    FlexrayNodeState ns = get_node_state(e, node_ident);
     log_trace(bm->log_nc,
         "FlexRay%s: Progress (%u:%u:%u): poc=%u, tcvr=%u, cycle=%u, "
         "slot=%u, mt=%u (MT=%u, UT=%u, LPDU=%u)",
         m->log_id, node_ident.node.ecu_id, node_ident.node.cc_id,
         node_ident.node.swc_id, ns.poc_state, ns.tcvr_state,
-        m->engine.pos_cycle, m->engine.pos_slot, m->engine.pos_mt,
-        m->engine.step_budget_mt, m->engine.step_budget_ut,
-        vector_len(&m->engine.txrx_list));
+        e->engine.pos_cycle, e->engine.pos_slot, e->engine.pos_mt,
+        e->engine.step_budget_mt, e->engine.step_budget_ut,
+        vector_len(&e->engine.txrx_list));
     log_trace(bm->log_nc,
         "FlexRay%s: Progress (%u:%u:%u): Status : poc_state=%s(%u), "
         "tcvr_state=%s(%u)",
@@ -177,22 +180,23 @@ void flexray_bus_model_progress(ABCodecBusModel* bm)
         .transport.flexray = { .node_ident = m->node_ident,
             .metadata_type = NCodecPduFlexrayMetadataTypeStatus,
             .metadata.status = {
-                .cycle = m->engine.pos_cycle,
-                .macrotick = m->engine.pos_mt,
+                .cycle = e->engine.pos_cycle,
+                .macrotick = e->engine.pos_mt,
                 .channel[0].poc_state = ns.poc_state,
                 .channel[0].tcvr_state = ns.tcvr_state,
             } } };
     ncodec_write((NCODEC*)bm->nc, &status_pdu);
 
     /* Write the TX PDUs. */
-    for (size_t i = 0; i < vector_len(&m->engine.txrx_list); i++) {
+    for (size_t i = 0; i < vector_len(&e->engine.txrx_list); i++) {
         FlexrayLpdu* lpdu = NULL;
-        vector_at(&m->engine.txrx_list, i, &lpdu);
+        vector_at(&e->engine.txrx_list, i, &lpdu);
+        if (e != m && lpdu->node_ident.node_id != node_ident.node_id) continue;
         const uint8_t* payload = NULL;
         uint8_t        payload_len = 0;
         if (lpdu->lpdu_config.direction == NCodecPduFlexrayDirectionRx &&
             lpdu->null_frame == false) {
-            payload = lpdu->payload;
+            payload = lpdu->rx_payload;
             payload_len = lpdu->lpdu_config.payload_length;
         }
         NCodecPduFlexrayLpduStatus status = NCodecPduFlexrayLpduStatusNone;
@@ -236,10 +240,10 @@ void flexray_bus_model_progress(ABCodecBusModel* bm)
                         .null_frame = lpdu->null_frame,
                     } } });
     }
-    if (bm->trace.nc != NULL) {
-        for (size_t i = 0; i < vector_len(&bm->trace.tx_list); i++) {
+    if (bm->trace.nc != NULL && e->trace_tx_list != NULL) {
+        for (size_t i = 0; i < vector_len(e->trace_tx_list); i++) {
             FlexrayLpdu* lpdu = NULL;
-            vector_at(&bm->trace.tx_list, i, &lpdu);
+            vector_at(e->trace_tx_list, i, &lpdu);
             const uint8_t* payload = NULL;
             uint8_t        payload_len = 0;
             /* All PDUs on the trace are Tx PDUs. */
@@ -270,30 +274,108 @@ void flexray_bus_model_progress(ABCodecBusModel* bm)
     }
 }
 
+void flexray_bus_model_progress(ABCodecBusModel* bm)
+{
+    FlexrayBusModel* m = (FlexrayBusModel*)bm->model;
+    FlexrayCluster*  c = m->cluster;
+    if (c == NULL) {
+        _progress_engine(bm, m);
+        _progress_node(bm, m, m);
+        return;
+    }
+
+    /* Shared engine, the schedule runs once per step (first member). */
+    pthread_mutex_lock(&c->mutex);
+    if (cluster_progress(m, bm->log_nc->simulation_time.value)) {
+        _progress_engine(bm, &c->model);
+    }
+    _progress_node(bm, m, &c->model);
+    pthread_mutex_unlock(&c->mutex);
+}
+
 void flexray_bus_model_close(ABCodecBusModel* bm)
 {
     FlexrayBusModel* m = (FlexrayBusModel*)bm->model;
+    cluster_leave(m);
     release_state(m);
     release_config(m);
     vector_reset(&bm->trace.tx_list);
 }
 
-void flexray_bus_model_create(ABCodecInstance* nc)
+int flexray_bus_model_snapshot(ABCodecBusModel* bm, ABCodecSnapshot* s)
+{
+    FlexrayBusModel* m = (FlexrayBusModel*)bm->model;
+    int              rc = 0;
+    if (m->cluster) {
+        log_error(bm->log_nc, "FlexRay%s: Snapshot: not supported (cluster)",
+            m->log_id);
+        return -ENOSYS;
+    }
+    rc |= snapshot_write(s, &m->node_ident, sizeof(m->node_ident));
+    rc |= snapshot_write(s, &m->power_on, sizeof(m->power_on));
+    rc |= snapshot_config(m, s);
+    rc |= snapshot_state(m, s);
+    return rc;
+}
+
+int flexray_bus_model_restore(ABCodecBusModel* bm, ABCodecSnapshot* s)
+{
+    FlexrayBusModel*               m = (FlexrayBusModel*)bm->model;
+    NCodecPduFlexrayNodeIdentifier node_ident;
+    bool                           power_on;
+    if (m->cluster) {
+        log_error(bm->log_nc, "FlexRay%s: Restore: not supported (cluster)",
+            m->log_id);
+        return -ENOSYS;
+    }
+    if (snapshot_read(s, &node_ident, sizeof(node_ident)) ||
+        snapshot_read(s, &power_on, sizeof(power_on))) {
+        return -EINVAL;
+    }
+    if (node_ident.node_id != m->node_ident.node_id) {
+        log_error(bm->log_nc, "FlexRay%s: Snapshot: node mismatch (%u:%u:%u)",
+            m->log_id, node_ident.node.ecu_id, node_ident.node.cc_id,
+            node_ident.node.swc_id);
+        return -EINVAL;
+    }
+
+    /* Restore to a temporary object, the model is only updated when the
+    snapshot is complete. */
+    FlexrayBusModel restored = *m;
+    restored.engine = (FlexrayEngine){ .log_id = m->log_id };
+    restored.state = (FlexrayState){ 0 };
+    int rc = restore_config(&restored, s);
+    if (rc == 0) rc = restore_state(&restored, s);
+    if (rc != 0) {
+        release_state(&restored);
+        release_config(&restored);
+        return rc;
+    }
+    release_state(m);
+    release_config(m);
+    m->power_on = power_on;
+    m->engine = restored.engine;
+    m->state = restored.state;
+
+    /* The Tx trace holds references to LPDUs of the released Slot Map. */
+    vector_clear(&bm->trace.tx_list, NULL, NULL);
+    return 0;
+}
+
+static void _bus_model_init(
+    ABCodecInstance* nc, ABCodecBusModel* bm, uint16_t cc_id)
 {
     /* Install the logging interface. */
-    nc->reader.bus_model.log_nc = nc;
+    bm->log_nc = nc;
 
     /* Set the step_size (initial value, may change in operation). */
-    nc->reader.bus_model.step_size = nc->simulation_time.step_size;
-
-    /* Install the duplicated NC object. */
-    nc->reader.bus_model.nc = _ab_nc_copy(nc);
+    bm->step_size = nc->simulation_time.step_size;
 
     /* Install the Bus Model object. */
     FlexrayBusModel* m = calloc(1, sizeof(FlexrayBusModel));
-    m->log_nc = nc->reader.bus_model.log_nc;
+    m->log_nc = bm->log_nc;
     m->node_ident.node.ecu_id = nc->ecu_id;
-    m->node_ident.node.cc_id = nc->cc_id;
+    m->node_ident.node.cc_id = cc_id;
     m->node_ident.node.swc_id = nc->swc_id;
     m->engine.node_ident = m->node_ident;
     snprintf(m->log_id, FLEXRAY_LOG_ID_LEN, "(%u:%u:%u)",
@@ -305,11 +387,36 @@ void flexray_bus_model_create(ABCodecInstance* nc)
     if (nc->pwr && strcmp(nc->pwr, "off")) {
         m->power_on = false;
     }
-    nc->reader.bus_model.model = m;
+    bm->model = m;
+    bm->network_id = cc_id;
+
+    /* Shared engine, join the cluster (the engine of m is not used). */
+    if (nc->cluster) cluster_join(m, nc->cluster);
 
     /* Configure the Bus Model VTable. */
-    nc->reader.bus_model.vtable.setup = flexray_bus_model_setup;
-    nc->reader.bus_model.vtable.consume = flexray_bus_model_consume;
-    nc->reader.bus_model.vtable.progress = flexray_bus_model_progress;
-    nc->reader.bus_model.vtable.close = flexray_bus_model_close;
+    bm->vtable.setup = flexray_bus_model_setup;
+    bm->vtable.consume = flexray_bus_model_consume;
+    bm->vtable.progress = flexray_bus_model_progress;
+    bm->vtable.close = flexray_bus_model_close;
+    bm->vtable.snapshot = flexray_bus_model_snapshot;
+    bm->vtable.restore = flexray_bus_model_restore;
+}
+
+void flexray_bus_model_create(ABCodecInstance* nc)
+{
+    /* Install the duplicated NC object. */
+    nc->reader.bus_model.nc = _ab_nc_copy(nc);
+
+    _bus_model_init(nc, &nc->reader.bus_model, nc->cc_id);
+}
+
+void flexray_bus_model_create_network(
+    ABCodecInstance* nc, ABCodecBusModel* bm, uint32_t network_id)
+{
+    /* Multi-bus, the node attaches to the network with its Communication
+    Controller (cc_id == network_id). All networks share the NC object
+    (Stream) of the primary Bus Model. */
+    bm->nc = nc->reader.bus_model.nc;
+
+    _bus_model_init(nc, bm, (uint16_t)network_id);
 }
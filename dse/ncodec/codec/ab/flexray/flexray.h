@@ -5,6 +5,7 @@
 #ifndef DSE_NCODEC_CODEC_AB_FLEXRAY_FLEXRAY_H_
 #define DSE_NCODEC_CODEC_AB_FLEXRAY_FLEXRAY_H_
 
+#include <pthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -12,7 +13,8 @@
 #include <dse/ncodec/interface/pdu.h>
 #include <dse/ncodec/schema/abs/stream/pdu_builder.h>
 
-#define FLEXRAY_LOG_ID_LEN 20
+#define FLEXRAY_LOG_ID_LEN  20
+#define FLEXRAY_CYCLE_COUNT 64 /* 0..63 */
 
 typedef struct FlexrayNodeState {
     NCodecPduFlexrayNodeIdentifier node_ident;
@@ -27,11 +29,52 @@ typedef struct FlexrayState {
     Vector node_state; /* FlexrayNodeState objects. */
     Vector vcs_node;   /* Virtual coldstart nodes. */
 
+    /* Node State index, hash of node_id (open addressing). */
+    struct {
+        uint32_t* slot; /* Index + 1 of the Node State, 0 when empty. */
+        size_t    size; /* Power of 2. */
+    } index;
+
+    /* Counters, updated on each state transition (all nodes). */
+    struct {
+        uint32_t poc[NCodecPduFlexrayPocStateUndefined + 1];
+        uint32_t tcvr[NCodecPduFlexrayTransceiverStateFrameError + 1];
+        uint32_t coldstart; /* Virtual coldstart nodes. */
+    } count;
+
     /* The resultant bus_condition. */
     NCodecPduFlexrayTransceiverState bus_condition;
 } FlexrayState;
 
 
+/* Engine telemetry (channel A, the engine models a single channel). */
+typedef struct FlexrayEngineStats {
+    uint64_t cycle_count; /* Completed cycles. */
+
+    /* Static segment. */
+    uint64_t static_slot_count;  /* Slots consumed. */
+    uint64_t static_frame_count; /* Slots with a frame. */
+    uint64_t null_frame_count;   /* Slots with a null frame. */
+
+    /* Dynamic segment. */
+    uint64_t minislot_count;       /* Minislots consumed. */
+    uint64_t dynamic_frame_count;  /* Frames. */
+    uint64_t frame_minislot_count; /* Minislots consumed by frames. */
+
+    /* Budget. */
+    uint64_t used_ut;        /* Microticks consumed (all steps). */
+    uint32_t step_budget_ut; /* Budget of the last step. */
+    uint32_t step_used_ut;   /* Microticks consumed in the last step. */
+} FlexrayEngineStats;
+
+
+typedef struct FlexrayNodeStats {
+    uint64_t tx_count;
+    uint64_t rx_count;
+    uint64_t drop_count;
+} FlexrayNodeStats;
+
+
 typedef struct FlexrayEngine {
     NCodecPduFlexrayNodeIdentifier node_ident;
     bool                           inhibit_null_frames;
@@ -61,9 +104,13 @@ typedef struct FlexrayEngine {
     uint32_t step_budget_mt;
     uint32_t bits_per_minislot;
 
-    Vector slot_map;
-    Vector txrx_list;
+    Vector                   slot_map;
+    struct FlexraySlotIndex* slot_index; /* Built from slot_map, on demand. */
+    Vector                   txrx_list;
     Vector config_list; /* Storage for NCodecPduFlexrayLpduConfig tables. */
+    Vector node_list;   /* Shared engine, node_id (uint64_t) of members. */
+
+    FlexrayEngineStats stats;
 
     const char* log_id;
 } FlexrayEngine;
@@ -76,6 +123,9 @@ typedef struct FlexrayLpdu {
 
     /* Payload associated with this LPDU. */
     uint8_t* payload;
+    /* Rx payload of the step, references the payload of the Tx LPDU (or the
+    payload of this LPDU). Valid until the Slot Map is modified. */
+    const uint8_t* rx_payload;
 
     /* Cycle of the last Tx/Rx for this LPDU. */
     uint8_t  cycle;
@@ -83,6 +133,12 @@ typedef struct FlexrayLpdu {
 
     /* Indicate if this LPDU represents a NULL frame. */
     bool null_frame;
+
+    /* Telemetry, frames transmitted/received and dropped (Tx frames replaced
+    before transmission, Rx frames not accepted by the LPDU status). */
+    uint32_t tx_count;
+    uint32_t rx_count;
+    uint32_t drop_count;
 } FlexrayLpdu;
 
 
@@ -101,9 +157,34 @@ typedef struct FlexrayBusModel {
 
     /* Trace interface, duplicated from ABCodecBusModel. */
     Vector* trace_tx_list;
+
+    /* Shared engine, when set the engine and state of the cluster are used. */
+    struct FlexrayCluster* cluster;
+    struct {
+        double time;  /* Simulation time of the consumed PDUs. */
+        size_t index; /* Position of the next FlexRay PDU (at time). */
+    } consume;
 } FlexrayBusModel;
 
 
+typedef struct FlexrayCluster {
+    char*    name;
+    uint32_t network_id; /* cc_id of the member nodes. */
+
+    /* Shared engine and state (node_ident not set). */
+    FlexrayBusModel model;
+    Vector          member_list;   /* FlexrayBusModel* */
+    Vector          trace_tx_list; /* FlexrayLpdu* */
+
+    /* Each FlexRay PDU of a step is consumed once, by position. */
+    double consume_time;
+    size_t consume_count;
+    double progress_time;
+
+    pthread_mutex_t mutex;
+} FlexrayCluster;
+
+
 typedef struct VectorSlotMapItem {
     uint32_t slot_id;
     Vector   lpdus; /* FlexrayLpdu */
@@ -113,17 +194,61 @@ typedef struct VectorSlotMapItem {
 typedef struct VectorFlexrayLpduConfigTableItem {
     NCodecPduFlexrayNodeIdentifier node_ident;
     NCodecPduFlexrayLpduConfig*    table;
+    size_t                         count;
 } VectorFlexrayLpduConfigTableItem;
 
 
+typedef struct FlexraySlotRange {
+    uint32_t offset; /* Into FlexraySlotIndex.lpdu_list. */
+    uint32_t count;
+} FlexraySlotRange;
+
+
+typedef struct FlexraySlotCycle {
+    FlexraySlotRange tx; /* Tx LPDUs of the cycle (all nodes). */
+    FlexraySlotRange rx; /* Rx LPDUs of the cycle (this node). */
+} FlexraySlotCycle;
+
+
+typedef struct FlexraySlot {
+    FlexraySlotRange  tx;    /* Tx LPDUs of the slot (all cycles). */
+    FlexraySlotCycle* cycle; /* Per cycle (0..63), NULL if no LPDUs. */
+} FlexraySlot;
+
+
+typedef struct FlexrayScheduleItem {
+    uint32_t slot_id;
+} FlexrayScheduleItem;
+
+
+typedef struct FlexraySlotIndex {
+    FlexraySlot*      slot; /* Indexed by slot_id. */
+    uint32_t          slot_count;
+    FlexraySlotCycle* cycle_list;
+    Vector            lpdu_list; /* FlexrayLpdu* (into slot_map). */
+
+    /* Compiled schedule, ranges into schedule_list (ordered by slot_id). */
+    FlexraySlotRange schedule[FLEXRAY_CYCLE_COUNT]; /* Static slots with Tx. */
+    FlexraySlotRange dynamic; /* Slots with Tx LPDUs (any cycle). */
+    Vector           schedule_list; /* FlexrayScheduleItem */
+} FlexraySlotIndex;
+
+
 int  process_config(FlexrayBusModel* m, NCodecPdu* pdu);
 int  calculate_budget(FlexrayBusModel* m, double step_size);
 int  consume_slot(FlexrayBusModel* m);
 void release_config(FlexrayBusModel* m);
+void release_slot_index(FlexrayBusModel* m);
+bool patch_slot_index(FlexrayBusModel* m, uint32_t slot_id);
+void delete_node_config(
+    FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid, bool ecu);
+int  snapshot_config(FlexrayBusModel* m, ABCodecSnapshot* s);
+int  restore_config(FlexrayBusModel* m, ABCodecSnapshot* s);
 int  shift_cycle(FlexrayBusModel* m, uint32_t mt, uint8_t cycle, bool force);
 int  set_lpdu(FlexrayBusModel* m, uint64_t node_id, uint32_t slot_id,
      uint32_t frame_config_index, NCodecPduFlexrayLpduStatus status,
      const uint8_t* payload, size_t payload_len);
+FlexrayNodeStats get_node_stats(FlexrayBusModel* m, uint64_t node_id);
 
 int process_poc_command(FlexrayBusModel* m, FlexrayNodeState* state,
     NCodecPduFlexrayPocCommand command);
@@ -133,6 +258,8 @@ void register_node_state(FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid,
 void register_vcn_node_state(
     FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid);
 void release_state(FlexrayBusModel* m);
+int  snapshot_state(FlexrayBusModel* m, ABCodecSnapshot* s);
+int  restore_state(FlexrayBusModel* m, ABCodecSnapshot* s);
 void push_node_state(FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid,
     NCodecPduFlexrayPocCommand command);
 void calculate_bus_condition(FlexrayBusModel* m);
@@ -146,6 +273,12 @@ void set_poc_state(FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid,
 const char* tcvr_state_string(unsigned int state);
 const char* poc_state_string(unsigned int state);
 
+/* cluster.c */
+int  cluster_join(FlexrayBusModel* m, const char* name);
+void cluster_leave(FlexrayBusModel* m);
+bool cluster_consume(FlexrayBusModel* m, double time);
+bool cluster_progress(FlexrayBusModel* m, double time);
+
 /* fbs.c */
 #undef ns
 #define ns(x) FLATBUFFERS_WRAP_NAMESPACE(AutomotiveBus_Stream_Pdu, x)
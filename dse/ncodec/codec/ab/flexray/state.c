@@ -2,6 +2,7 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <string.h>
 #include <dse/ncodec/codec/ab/codec.h>
 #include <dse/ncodec/interface/pdu.h>
 #include <dse/ncodec/codec/ab/flexray/flexray.h>
@@ -142,14 +143,90 @@ static void __set_transceiver_state(FlexrayBusModel* m, FlexrayNodeState* state)
         tcvr_state_string(state->tcvr_state));
 }
 
+/*
+Node States are held (sorted) in a vector and indexed by a hash of node_id,
+the index is rebuilt when a Node State is added. The counters are updated
+on each change of a Node State so that the bus condition is calculated
+without visiting all nodes.
+*/
+
+static inline size_t __node_hash(uint64_t node_id, size_t size)
+{
+    node_id *= 0x9e3779b97f4a7c15ULL;
+    return (size_t)(node_id >> 32) & (size - 1);
+}
+
+static void __index_node_state(FlexrayState* s)
+{
+    size_t len = vector_len(&s->node_state);
+    size_t size = 16;
+    while (size < len * 2)
+        size <<= 1;
+    if (size != s->index.size) {
+        free(s->index.slot);
+        s->index.slot = calloc(size, sizeof(uint32_t));
+        s->index.size = size;
+    } else {
+        memset(s->index.slot, 0, size * sizeof(uint32_t));
+    }
+    FlexrayNodeState* list = s->node_state.items;
+    for (size_t i = 0; i < len; i++) {
+        size_t h = __node_hash(list[i].node_ident.node_id, size);
+        while (s->index.slot[h])
+            h = (h + 1) & (size - 1);
+        s->index.slot[h] = (uint32_t)(i + 1);
+    }
+}
+
+static FlexrayNodeState* __find_node_state(
+    FlexrayState* s, NCodecPduFlexrayNodeIdentifier nid)
+{
+    if (s->index.size == 0) return NULL;
+    FlexrayNodeState* list = s->node_state.items;
+    size_t            h = __node_hash(nid.node_id, s->index.size);
+    for (uint32_t idx; (idx = s->index.slot[h]) != 0;
+        h = (h + 1) & (s->index.size - 1)) {
+        if (list[idx - 1].node_ident.node_id == nid.node_id) {
+            return &list[idx - 1];
+        }
+    }
+    return NULL;
+}
+
+static void __count_node_state(
+    FlexrayState* s, const FlexrayNodeState* state, int delta)
+{
+    if ((size_t)state->poc_state < ARRAY_SIZE(s->count.poc)) {
+        s->count.poc[state->poc_state] += delta;
+    }
+    if ((size_t)state->tcvr_state < ARRAY_SIZE(s->count.tcvr)) {
+        s->count.tcvr[state->tcvr_state] += delta;
+    }
+}
+
+static void __count_state(FlexrayState* s)
+{
+    memset(&s->count, 0, sizeof(s->count));
+    for (size_t i = 0; i < vector_len(&s->node_state); i++) {
+        __count_node_state(s, vector_at(&s->node_state, i, NULL), 1);
+    }
+    for (size_t i = 0; i < vector_len(&s->vcs_node); i++) {
+        FlexrayNodeState* vcn = vector_at(&s->vcs_node, i, NULL);
+        if ((size_t)vcn->tcvr_state < ARRAY_SIZE(s->count.tcvr)) {
+            s->count.tcvr[vcn->tcvr_state]++;
+        }
+        s->count.coldstart++;
+    }
+}
+
 void set_node_power(
     FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid, bool power_on)
 {
     /* Node states are consolidated per Node by zeroing out the `swc_id`. */
     nid.node.swc_id = 0;
-    FlexrayNodeState* node_state = vector_find(&m->state.node_state,
-        &(FlexrayNodeState){ .node_ident = nid }, 0, NULL);
+    FlexrayNodeState* node_state = __find_node_state(&m->state, nid);
     if (node_state) {
+        __count_node_state(&m->state, node_state, -1);
         if (power_on &&
             node_state->tcvr_state == NCodecPduFlexrayTransceiverStateNoPower) {
             node_state->tcvr_state =
@@ -161,6 +238,7 @@ void set_node_power(
             node_state->poc_state = NCodecPduFlexrayPocStateDefaultConfig;
             log_debug(m->log_nc, "Power Off");
         }
+        __count_node_state(&m->state, node_state, 1);
     } else {
         log_error(m->log_nc, "Node State object not found (nid (%d:%d:%d))",
             nid.node.ecu_id, nid.node.cc_id, nid.node.swc_id);
@@ -265,8 +343,7 @@ void register_node_state(FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid,
             vector_make(sizeof(FlexrayNodeState), 0, __node_ident_compar);
     }
     nid.node.swc_id = 0;
-    FlexrayNodeState* node_state = vector_find(&m->state.node_state,
-        &(FlexrayNodeState){ .node_ident = nid }, 0, NULL);
+    FlexrayNodeState* node_state = __find_node_state(&m->state, nid);
     if (node_state == NULL) {
         /* Force power state, typically set via MIME type parameter `pon`. */
         NCodecPduFlexrayTransceiverState tcvr_state =
@@ -276,19 +353,23 @@ void register_node_state(FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid,
         } else if (pwr_off) {
             tcvr_state = NCodecPduFlexrayTransceiverStateNoPower;
         }
-        vector_push(&m->state.node_state,
-            &(FlexrayNodeState){ .node_ident = nid, .tcvr_state = tcvr_state });
+        FlexrayNodeState state = { .node_ident = nid, .tcvr_state = tcvr_state };
+        vector_push(&m->state.node_state, &state);
         vector_sort(&m->state.node_state);
+        __index_node_state(&m->state);
+        __count_node_state(&m->state, &state, 1);
         log_debug(m->log_nc, "Push Node State: tcvr_state=%d (nid (%d:%d:%d))",
             tcvr_state, nid.node.ecu_id, nid.node.cc_id, nid.node.swc_id);
     } else {
         /* Force power state, typically set via MIME type parameter `pon`. */
+        __count_node_state(&m->state, node_state, -1);
         if (pwr_on) {
             node_state->tcvr_state =
                 NCodecPduFlexrayTransceiverStateNoConnection;
         } else if (pwr_off) {
             node_state->tcvr_state = NCodecPduFlexrayTransceiverStateNoPower;
         }
+        __count_node_state(&m->state, node_state, 1);
 
         log_debug(m->log_nc,
             "Register Node State: tcvr_state=%d (nid (%d:%d:%d))",
@@ -302,11 +383,12 @@ void set_poc_state(FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid,
 {
     /* Node states are consolidated per Node by zeroing out the `swc_id`. */
     nid.node.swc_id = 0;
-    FlexrayNodeState* node_state = vector_find(&m->state.node_state,
-        &(FlexrayNodeState){ .node_ident = nid }, 0, NULL);
+    FlexrayNodeState* node_state = __find_node_state(&m->state, nid);
     if (node_state) {
+        __count_node_state(&m->state, node_state, -1);
         node_state->poc_state = poc_state;
         __set_transceiver_state(m, node_state);
+        __count_node_state(&m->state, node_state, 1);
     } else {
         log_error(m->log_nc, "Node State object not found (nid (%d:%d:%d))",
             nid.node.ecu_id, nid.node.cc_id, nid.node.swc_id);
@@ -328,6 +410,8 @@ void register_vcn_node_state(
             &(FlexrayNodeState){ .node_ident = nid,
                 .tcvr_state = NCodecPduFlexrayTransceiverStateFrameSync });
         vector_sort(&m->state.vcs_node);
+        m->state.count.tcvr[NCodecPduFlexrayTransceiverStateFrameSync]++;
+        m->state.count.coldstart++;
         log_debug(m->log_nc, "Push VCN Node State (nid (%d:%d:%d))",
             nid.node.ecu_id, nid.node.cc_id, nid.node.swc_id);
     }
@@ -338,11 +422,12 @@ void push_node_state(FlexrayBusModel* m, NCodecPduFlexrayNodeIdentifier nid,
 {
     /* Node states are consolidated per Node by zeroing out the `swc_id`. */
     nid.node.swc_id = 0;
-    FlexrayNodeState* node_state = vector_find(&m->state.node_state,
-        &(FlexrayNodeState){ .node_ident = nid }, 0, NULL);
+    FlexrayNodeState* node_state = __find_node_state(&m->state, nid);
     if (node_state) {
+        __count_node_state(&m->state, node_state, -1);
         process_poc_command(m, node_state, command);
         __set_transceiver_state(m, node_state);
+        __count_node_state(&m->state, node_state, 1);
     } else {
         log_error(m->log_nc, "Node State object not found (nid (%d:%d:%d))",
             nid.node.ecu_id, nid.node.cc_id, nid.node.swc_id);
@@ -354,33 +439,17 @@ FlexrayNodeState get_node_state(
 {
     /* Node states are consolidated per Node by zeroing out the `swc_id`. */
     nid.node.swc_id = 0;
-    FlexrayNodeState node_state = { 0 };
-    vector_find(&m->state.node_state, &(FlexrayNodeState){ .node_ident = nid },
-        0, &node_state);
+    FlexrayNodeState  node_state = { 0 };
+    FlexrayNodeState* item = __find_node_state(&m->state, nid);
+    if (item) node_state = *item;
     return node_state;
 }
 
 void calculate_bus_condition(FlexrayBusModel* m)
 {
-    int frame_sync_node_count = 0;
-    /* Range over Virtual Coldstart Nodes. */
-    for (size_t i = i; i < vector_len(&m->state.vcs_node); i++) {
-        FlexrayNodeState node_state = { 0 };
-        vector_at(&m->state.vcs_node, i, &node_state);
-        if (node_state.tcvr_state ==
-            NCodecPduFlexrayTransceiverStateFrameSync) {
-            frame_sync_node_count++;
-        }
-    }
-    /* Range over Nodes. */
-    for (size_t i = i; i < vector_len(&m->state.node_state); i++) {
-        FlexrayNodeState node_state = { 0 };
-        vector_at(&m->state.node_state, i, &node_state);
-        if (node_state.tcvr_state ==
-            NCodecPduFlexrayTransceiverStateFrameSync) {
-            frame_sync_node_count++;
-        }
-    }
+    /* Nodes (including Virtual Coldstart Nodes) in FrameSync. */
+    uint32_t frame_sync_node_count =
+        m->state.count.tcvr[NCodecPduFlexrayTransceiverStateFrameSync];
 
     switch (frame_sync_node_count) {
     case 0:
@@ -389,12 +458,17 @@ void calculate_bus_condition(FlexrayBusModel* m)
     case 1:
         m->state.bus_condition = NCodecPduFlexrayTransceiverStateFrameError;
         /* Push ActiveNormal nodes to ActivePassive. */
-        for (size_t i = i; i < vector_len(&m->state.node_state); i++) {
+        if (m->state.count.poc[NCodecPduFlexrayPocStateNormalActive] == 0) {
+            break;
+        }
+        for (size_t i = 0; i < vector_len(&m->state.node_state); i++) {
             FlexrayNodeState* node_state =
                 vector_at(&m->state.node_state, i, NULL);
             if (node_state->poc_state == NCodecPduFlexrayPocStateNormalActive) {
+                __count_node_state(&m->state, node_state, -1);
                 node_state->poc_state = NCodecPduFlexrayPocStateNormalPassive;
                 __set_transceiver_state(m, node_state);
+                __count_node_state(&m->state, node_state, 1);
             }
         }
         break;
@@ -408,6 +482,38 @@ void release_state(FlexrayBusModel* m)
 {
     vector_reset(&m->state.node_state);
     vector_reset(&m->state.vcs_node);
+    free(m->state.index.slot);
+    m->state.index.slot = NULL;
+    m->state.index.size = 0;
+    memset(&m->state.count, 0, sizeof(m->state.count));
+}
+
+int snapshot_state(FlexrayBusModel* m, ABCodecSnapshot* s)
+{
+    int rc = 0;
+    rc |= snapshot_write_vector(
+        s, &m->state.node_state, sizeof(FlexrayNodeState));
+    rc |= snapshot_write_vector(s, &m->state.vcs_node, sizeof(FlexrayNodeState));
+    rc |= snapshot_write(
+        s, &m->state.bus_condition, sizeof(m->state.bus_condition));
+    return rc;
+}
+
+int restore_state(FlexrayBusModel* m, ABCodecSnapshot* s)
+{
+    if (snapshot_read_vector(s, &m->state.node_state, sizeof(FlexrayNodeState),
+            __node_ident_compar))
+        return -EINVAL;
+    if (snapshot_read_vector(s, &m->state.vcs_node, sizeof(FlexrayNodeState),
+            __node_ident_compar))
+        return -EINVAL;
+    if (snapshot_read(
+            s, &m->state.bus_condition, sizeof(m->state.bus_condition)))
+        return -EINVAL;
+    /* The index and counters are derived from the Node States. */
+    __index_node_state(&m->state);
+    __count_state(&m->state);
+    return 0;
 }
 
 
@@ -422,33 +528,6 @@ static void __poc_state_defaultconfig(
     log_debug(m->log_nc, "POC State DefaultConfig entry func, nid (%d:%d:%d)",
         nid.node.ecu_id, nid.node.cc_id, nid.node.swc_id);
 
-    // Slotmap.
-    for (size_t i = 0; i < m->engine.slot_map.length; i++) {
-        VectorSlotMapItem* slot_item = vector_at(&m->engine.slot_map, i, NULL);
-        if (slot_item != NULL) {
-            // Reverse lookup as delete shifts items left.
-            for (size_t j = slot_item->lpdus.length; j > 0; j--) {
-                size_t idx = j - 1;
-
-                FlexrayLpdu* lpdu = vector_at(&slot_item->lpdus, idx, NULL);
-                if (lpdu != NULL) {
-                    if (lpdu->node_ident.node.ecu_id != nid.node.ecu_id)
-                        continue;
-                    free(lpdu->payload);
-                    vector_delete_at(&slot_item->lpdus, idx);
-                }
-            }
-        }
-    }
-    // Config list, reverse lookup as delete shifts items left.
-    for (size_t i = m->engine.config_list.length; i > 0; i--) {
-        size_t idx = i - 1;
-
-        VectorFlexrayLpduConfigTableItem config;
-        if (vector_at(&m->engine.config_list, idx, &config)) {
-            if (config.node_ident.node.ecu_id != nid.node.ecu_id) continue;
-            free(config.table);
-            vector_delete_at(&m->engine.config_list, idx);
-        }
-    }
+    // Slotmap and Config list, of all nodes of the ECU.
+    delete_node_config(m, nid, true);
 }
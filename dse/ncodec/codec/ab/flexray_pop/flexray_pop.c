@@ -4,6 +4,7 @@
 
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <dse/ncodec/stream/stream.h>
 #include <dse/ncodec/codec/ab/codec.h>
 #include <dse/ncodec/codec/ab/flexray_pop/flexray_pop.h>
@@ -12,94 +13,155 @@
 #define UNUSED(x) ((void)x)
 
 
+#define ARENA_BLOCK_SIZE 4096
+
+
 typedef NCodecPduFlexrayNodeIdentifier NodeIdentifier;
 
 typedef struct VectorPduRouteItem {
     NodeIdentifier node_ident;
-    Vector         pdu_list; /* NCodecPdu */
+    Vector         status_list; /* NCodecPdu, Status (written first). */
+    Vector         pdu_list;    /* NCodecPdu */
 } VectorPduRouteItem;
 
+typedef struct PopArenaBlock {
+    uint8_t* data;
+    size_t   size;
+    size_t   used;
+} PopArenaBlock;
 
-static int __node_ident_compar(const void* left, const void* right)
-{
-    NodeIdentifier l = ((VectorPduRouteItem*)left)->node_ident;
-    NodeIdentifier r = ((VectorPduRouteItem*)right)->node_ident;
 
-    if (l.node_id < r.node_id) return -1;
-    if (l.node_id > r.node_id) return 1;
-    return 0;
+static void* __arena_alloc(FlexrayPopBusModel* m, size_t len)
+{
+    if (len == 0) return NULL;
+    len = (len + 7) & ~(size_t)7;
+    if (m->arena.block_list.capacity == 0) {
+        m->arena.block_list = vector_make(sizeof(PopArenaBlock), 0, NULL);
+    }
+    for (; m->arena.index < vector_len(&m->arena.block_list);
+        m->arena.index++) {
+        PopArenaBlock* block =
+            vector_at(&m->arena.block_list, m->arena.index, NULL);
+        if (block->size - block->used >= len) {
+            void* p = block->data + block->used;
+            block->used += len;
+            return p;
+        }
+    }
+    size_t        size = (len > ARENA_BLOCK_SIZE) ? len : ARENA_BLOCK_SIZE;
+    PopArenaBlock block = { .data = malloc(size), .size = size, .used = len };
+    if (block.data == NULL) return NULL;
+    vector_push(&m->arena.block_list, &block);
+    m->arena.index = vector_len(&m->arena.block_list) - 1;
+    return block.data;
 }
 
-static int __pdu_status_first(const void* left, const void* right)
+static void __arena_reset(FlexrayPopBusModel* m)
 {
-    NCodecPdu* l = (NCodecPdu*)left;
-    NCodecPdu* r = (NCodecPdu*)right;
-
-    if (l->transport.flexray.metadata_type ==
-        r->transport.flexray.metadata_type)
-        return 0;
-    if (l->transport.flexray.metadata_type ==
-        NCodecPduFlexrayMetadataTypeStatus)
-        return -1;
-    return 1;
+    for (size_t i = 0; i < vector_len(&m->arena.block_list); i++) {
+        PopArenaBlock* block = vector_at(&m->arena.block_list, i, NULL);
+        block->used = 0;
+    }
+    m->arena.index = 0;
 }
 
-static void __pdu_payload_destory(void* item, void* data)
+static void __arena_destroy(FlexrayPopBusModel* m)
 {
-    UNUSED(data);
-
-    NCodecPdu* pdu = item;
-    free((uint8_t*)pdu->payload);
-    pdu->payload = NULL;
+    for (size_t i = 0; i < vector_len(&m->arena.block_list); i++) {
+        PopArenaBlock* block = vector_at(&m->arena.block_list, i, NULL);
+        free(block->data);
+    }
+    vector_reset(&m->arena.block_list);
+    m->arena.index = 0;
 }
 
-static void __pdu_list_clear(void* item, void* data)
+/* Returns NULL if the arena allocation failed (and data was not NULL). */
+static const void* __arena_copy(
+    FlexrayPopBusModel* m, const void* data, size_t len)
 {
-    UNUSED(data);
-    VectorPduRouteItem* pdu_route = item;
+    if (data == NULL || len == 0) return data;
+    void* p = __arena_alloc(m, len);
+    if (p == NULL) return NULL;
+    memcpy(p, data, len);
+    return p;
+}
 
-    // vector_clear(&pdu_route->pdu_list, __pdu_payload_destory, NULL);
-    vector_clear(&pdu_route->pdu_list, NULL, NULL);
+static inline size_t __route_hash(uint64_t node_id, size_t size)
+{
+    node_id *= 0x9e3779b97f4a7c15ULL;
+    return (size_t)(node_id >> 32) & (size - 1);
 }
 
-static void __pdu_list_destory(void* item, void* data)
+static void __route_index(FlexrayPopBusModel* m)
 {
-    UNUSED(data);
-    VectorPduRouteItem* pdu_route = item;
+    size_t len = vector_len(&m->pdu_router);
+    size_t size = 16;
+    while (size < len * 2)
+        size <<= 1;
+    free(m->route_index.slot);
+    m->route_index.slot = calloc(size, sizeof(uint32_t));
+    m->route_index.size = size;
+    VectorPduRouteItem* list = m->pdu_router.items;
+    for (size_t i = 0; i < len; i++) {
+        size_t h = __route_hash(list[i].node_ident.node_id, size);
+        while (m->route_index.slot[h])
+            h = (h + 1) & (size - 1);
+        m->route_index.slot[h] = (uint32_t)(i + 1);
+    }
+}
 
-    vector_clear(&pdu_route->pdu_list, __pdu_payload_destory, NULL);
-    vector_reset(&pdu_route->pdu_list);
+static VectorPduRouteItem* __pdu_router_find_route(
+    FlexrayPopBusModel* m, NodeIdentifier node_ident)
+{
+    if (m->route_index.size == 0) return NULL;
+    VectorPduRouteItem* list = m->pdu_router.items;
+    size_t h = __route_hash(node_ident.node_id, m->route_index.size);
+    for (uint32_t idx; (idx = m->route_index.slot[h]) != 0;
+        h = (h + 1) & (m->route_index.size - 1)) {
+        if (list[idx - 1].node_ident.node_id == node_ident.node_id) {
+            return &list[idx - 1];
+        }
+    }
+    return NULL;
 }
 
 static void __pdu_router_clear(FlexrayPopBusModel* m)
 {
     for (size_t i = 0; i < vector_len(&m->pdu_router); i++) {
-        void* item = vector_at(&m->pdu_router, i, NULL);
-        __pdu_list_clear(item, NULL);
+        VectorPduRouteItem* pdu_route = vector_at(&m->pdu_router, i, NULL);
+        vector_clear(&pdu_route->status_list, NULL, NULL);
+        vector_clear(&pdu_route->pdu_list, NULL, NULL);
     }
+    __arena_reset(m);
 }
 
 static void __pdu_router_destroy(FlexrayPopBusModel* m)
 {
-    vector_clear(&m->pdu_router, __pdu_list_destory, NULL);
+    for (size_t i = 0; i < vector_len(&m->pdu_router); i++) {
+        VectorPduRouteItem* pdu_route = vector_at(&m->pdu_router, i, NULL);
+        vector_reset(&pdu_route->status_list);
+        vector_reset(&pdu_route->pdu_list);
+    }
     vector_reset(&m->pdu_router);
+    free(m->route_index.slot);
+    m->route_index.slot = NULL;
+    m->route_index.size = 0;
+    __arena_destroy(m);
 }
 
 static VectorPduRouteItem* __pdu_router_ensure_route(
     FlexrayPopBusModel* m, NodeIdentifier node_ident)
 {
-    VectorPduRouteItem* route = vector_find(&m->pdu_router,
-        &(VectorPduRouteItem){ .node_ident = node_ident }, 0, NULL);
+    VectorPduRouteItem* route = __pdu_router_find_route(m, node_ident);
     if (route == NULL) {
         vector_push(&m->pdu_router,
             &(VectorPduRouteItem){
                 .node_ident = node_ident,
-                .pdu_list =
-                    vector_make(sizeof(NCodecPdu), 0, __pdu_status_first),
+                .status_list = vector_make(sizeof(NCodecPdu), 0, NULL),
+                .pdu_list = vector_make(sizeof(NCodecPdu), 0, NULL),
             });
-        vector_sort(&m->pdu_router);
-        route = vector_find(&m->pdu_router,
-            &(VectorPduRouteItem){ .node_ident = node_ident }, 0, NULL);
+        __route_index(m);
+        route = __pdu_router_find_route(m, node_ident);
     }
     assert(route);
     return (route);
@@ -113,16 +175,73 @@ static void __pdu_router_push(ABCodecBusModel* bm, NodeIdentifier node_ident,
     /* Create the origin & destination routes (the reverse/return route). */
     NCodecPduFlexrayNodeIdentifier orig_node_ident =
         pdu->transport.flexray.node_ident;
-    VectorPduRouteItem* orig_pdu_route =
-        __pdu_router_ensure_route(m, orig_node_ident);
+    __pdu_router_ensure_route(m, orig_node_ident);
     VectorPduRouteItem* pdu_route = __pdu_router_ensure_route(m, node_ident);
 
-    /* Push the PDU to the destination route. */
+    /* Push the PDU to the destination route, the payload (and config table)
+    is copied to the arena, the PDU read buffers are released before the PDU
+    is written. */
     log_info(bm->log_nc, "POP:Route: (%u:%u:%u) -[%s]-> (%u:%u:%u)",
         orig_node_ident.node.ecu_id, orig_node_ident.node.cc_id,
         orig_node_ident.node.swc_id, msg, node_ident.node.ecu_id,
         node_ident.node.cc_id, node_ident.node.swc_id);
-    vector_push(&pdu_route->pdu_list, pdu);  // FIXME: deep copy?
+    NCodecPdu _pdu = *pdu;
+    _pdu.payload = __arena_copy(m, pdu->payload, pdu->payload_len);
+    if (_pdu.payload == NULL && pdu->payload != NULL) goto alloc_failed;
+    switch (pdu->transport.flexray.metadata_type) {
+    case NCodecPduFlexrayMetadataTypeConfig: {
+        NCodecPduFlexrayConfig* config = &_pdu.transport.flexray.metadata.config;
+        const NCodecPduFlexrayConfig* _config =
+            &pdu->transport.flexray.metadata.config;
+        config->frame_config.table = (NCodecPduFlexrayLpduConfig*)__arena_copy(
+            m, config->frame_config.table,
+            config->frame_config.count * sizeof(NCodecPduFlexrayLpduConfig));
+        if (config->frame_config.table == NULL &&
+            _config->frame_config.table != NULL)
+            goto alloc_failed;
+        config->key_slot_payload = __arena_copy(
+            m, config->key_slot_payload, config->key_slot_payload_len);
+        if (config->key_slot_payload == NULL &&
+            _config->key_slot_payload != NULL)
+            goto alloc_failed;
+        config->key_slot_lpdu = NULL;
+        vector_push(&pdu_route->pdu_list, &_pdu);
+        break;
+    }
+    case NCodecPduFlexrayMetadataTypeStatus:
+        /* Routes to a node have the Status first, the PoP route (node_id 0)
+        keeps the order of the PDUs. */
+        if (node_ident.node_id != 0) {
+            vector_push(&pdu_route->status_list, &_pdu);
+        } else {
+            vector_push(&pdu_route->pdu_list, &_pdu);
+        }
+        break;
+    default:
+        vector_push(&pdu_route->pdu_list, &_pdu);
+        break;
+    }
+    return;
+
+alloc_failed:
+    /* The PDU is dropped (the arena is released at the end of the step). */
+    log_error(bm->log_nc, "POP:Route: arena allocation failed, PDU dropped");
+}
+
+
+/* Macrotick budget of a step, calculated from the step size of the codec
+(which may change in operation). */
+static void __calculate_step_budget(ABCodecBusModel* bm, FlexrayPopBusModel* m)
+{
+    if (m->config.macro2micro == 0 || m->config.microtick_ns == 0) return;
+    double   step_size = (bm->step_size > 0.0) ? bm->step_size : SIM_STEP_SIZE;
+    uint32_t step_budget_ut = (step_size * 1000000000) / m->config.microtick_ns;
+    uint32_t step_budget_mt = step_budget_ut / m->config.macro2micro;
+    if (step_budget_mt != m->config.step_budget_mt) {
+        m->config.step_budget_mt = step_budget_mt;
+        log_info(bm->log_nc, "PoP step width in Macrotick: %u",
+            m->config.step_budget_mt);
+    }
 }
 
 
@@ -154,8 +273,6 @@ bool flexray_pop_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu)
                 bm, (NodeIdentifier){ .node_id = 0 }, pdu, "Config");
         } else {
             /* PoP -> : extract config and discard. */
-// FIXME: step_size is a parameter.
-#define SIM_STEP_SIZE 0.0005
             NCodecPduFlexrayConfig* config =
                 &pdu->transport.flexray.metadata.config;
             m->config.bit_rate = config->bit_rate;
@@ -180,15 +297,10 @@ bool flexray_pop_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu)
                 break;
             }
 
-            uint32_t macro2micro =
+            m->config.macro2micro =
                 m->config.microtick_per_cycle / m->config.macrotick_per_cycle;
-            uint32_t microtick_ns = flexray_microtick_ns[m->config.bit_rate];
-            uint32_t step_budget_ut =
-                (SIM_STEP_SIZE * 1000000000) / microtick_ns;
-            m->config.step_budget_mt = step_budget_ut / macro2micro;
-
-            log_info(bm->log_nc, "PoP step width in Macrotick: %u",
-                m->config.step_budget_mt);
+            m->config.microtick_ns = flexray_microtick_ns[m->config.bit_rate];
+            __calculate_step_budget(bm, m);
         }
         break;
     case (NCodecPduFlexrayMetadataTypeStatus):
@@ -214,25 +326,37 @@ bool flexray_pop_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu)
                     break;
                 }
                 /* Set Macrotick. */
+                uint32_t cycles = 0;
                 if (status->macrotick != 0) {
                     /* Always take the provided Macrotick. */
                     m->status.pos_mt = status->macrotick;
                 } else {
                     m->status.pos_mt += m->config.step_budget_mt;
-                    if (m->status.pos_mt > m->config.macrotick_per_cycle) {
-                        m->status.pos_mt = m->config.macrotick_per_cycle;
+                    if (m->config.macrotick_per_cycle &&
+                        m->status.pos_mt >= m->config.macrotick_per_cycle) {
+                        /* Catch-up, the step may span several cycles. */
+                        cycles = m->status.pos_mt /
+                                 m->config.macrotick_per_cycle;
+                        m->status.pos_cycle = (m->status.pos_cycle + cycles) %
+                                              FLEXRAY_CYCLE_COUNT;
+                        m->status.pos_mt %= m->config.macrotick_per_cycle;
                     }
                 }
-                /* Evaluate the cycle and correct macrotick. */
-                if (status->cycle != m->status.pos_cycle ||
-                    m->status.running == false) {
-                    m->status.pos_cycle = status->cycle;
+                /* Evaluate the cycle and correct macrotick. A reported cycle
+                within the cycles spanned by the catch-up (the PoP lags the
+                estimate) keeps the estimated macrotick, otherwise the
+                estimate is resynchronised to the start of the cycle. */
+                uint32_t lag = (m->status.pos_cycle + FLEXRAY_CYCLE_COUNT -
+                                   status->cycle) %
+                               FLEXRAY_CYCLE_COUNT;
+                if (lag > cycles || m->status.running == false) {
                     if (status->macrotick == 0) {
                         /* Only adjust if microtick not provided. */
                         m->status.pos_mt = 0;
                     }
                     m->status.running = true;
                 }
+                m->status.pos_cycle = status->cycle;
                 log_debug(bm->log_nc,
                     "FlexRay%s: PoP Status: pos_cycle=%u pos_mt=%u", m->log_id,
                     m->status.pos_cycle, m->status.pos_mt);
@@ -318,6 +442,7 @@ void flexray_pop_bus_model_progress(ABCodecBusModel* bm)
     FlexrayPopBusModel* m = (FlexrayPopBusModel*)bm->model;
 
     log_debug(bm->log_nc, "FlexRay%s: Progress: ", m->log_id);
+    __calculate_step_budget(bm, m);
 
     /* Each route should have at least a Status Message. */
     for (size_t i = 0; i < vector_len(&m->pdu_router); i++) {
@@ -325,47 +450,32 @@ void flexray_pop_bus_model_progress(ABCodecBusModel* bm)
 
         if (pdu_route->node_ident.node_id == 0) continue;
 
-
-        /* Each node should have Status PDU first. */
-        NCodecPdu* pdu = vector_at(&pdu_route->pdu_list, 0, NULL);
-        if (pdu != NULL && pdu->transport.flexray.metadata_type ==
-                               NCodecPduFlexrayMetadataTypeStatus) {
-            /* Status is first. This should be the normal path. */
-            pdu->transport.flexray.metadata.status.cycle = m->status.pos_cycle;
-            pdu->transport.flexray.metadata.status.macrotick = m->status.pos_mt;
-            continue;
-        }
-        vector_sort(&pdu_route->pdu_list);
-        pdu = vector_at(&pdu_route->pdu_list, 0, NULL);
-        if (pdu != NULL && pdu->transport.flexray.metadata_type ==
-                               NCodecPduFlexrayMetadataTypeStatus) {
-            /* Status is first. */
-            pdu->transport.flexray.metadata.status.cycle = m->status.pos_cycle;
-            pdu->transport.flexray.metadata.status.macrotick = m->status.pos_mt;
-            continue;
-        } else {
+        NCodecPdu* pdu = vector_at(&pdu_route->status_list, 0, NULL);
+        if (pdu == NULL) {
             /* There is no status, add one. */
-            vector_push(&pdu_route->pdu_list,
+            vector_push(&pdu_route->status_list,
                 &(NCodecPdu){
                     .transport_type = NCodecPduTransportTypeFlexray,
                     .transport.flexray.metadata_type =
                         NCodecPduFlexrayMetadataTypeStatus,
                     .transport.flexray.node_ident = pdu_route->node_ident,
-                    .transport.flexray.metadata.status.cycle =
-                        m->status.pos_cycle,
-                    .transport.flexray.metadata.status.macrotick =
-                        m->status.pos_mt,
                     .transport.flexray.metadata.status.channel[0].tcvr_state =
                         NCodecPduFlexrayTransceiverStateNoConnection,
                 });
-            vector_sort(&pdu_route->pdu_list);
+            pdu = vector_at(&pdu_route->status_list, 0, NULL);
         }
+        pdu->transport.flexray.metadata.status.cycle = m->status.pos_cycle;
+        pdu->transport.flexray.metadata.status.macrotick = m->status.pos_mt;
     }
 
-    /* Encode the route list for _this_ node. */
-    VectorPduRouteItem* node_pdu_route = vector_find(&m->pdu_router,
-        &(VectorPduRouteItem){ .node_ident = m->node_ident }, 0, NULL);
+    /* Encode the route list for _this_ node, Status PDUs first. */
+    VectorPduRouteItem* node_pdu_route =
+        __pdu_router_find_route(m, m->node_ident);
     assert(node_pdu_route);
+    for (size_t i = 0; i < vector_len(&node_pdu_route->status_list); i++) {
+        NCodecPdu* pdu = vector_at(&node_pdu_route->status_list, i, NULL);
+        ncodec_write((NCODEC*)bm->nc, pdu);
+    }
     for (size_t i = 0; i < vector_len(&node_pdu_route->pdu_list); i++) {
         NCodecPdu* pdu = vector_at(&node_pdu_route->pdu_list, i, NULL);
         ncodec_write((NCODEC*)bm->nc, pdu);
@@ -401,7 +511,10 @@ void flexray_pop_bus_model_create(ABCodecInstance* nc)
     nc_copy->fbs_builder = (flatcc_builder_t){ 0 };
     nc_copy->fbs_builder_initalized = false;
     nc_copy->fbs_stream_initalized = false;
+    nc_copy->fbs_buffer = NULL;
+    nc_copy->fbs_buffer_size = 0;
     nc_copy->reader = (ABCodecReader){ 0 };
+    nc_copy->step = (ABCodecStep){ 0 };
 
 /* Rebuild various objects in the model NC. */
 #define BUFFER_LEN 1024
@@ -425,10 +538,12 @@ void flexray_pop_bus_model_create(ABCodecInstance* nc)
         m->node_ident.node.swc_id);
     log_debug(nc, "FlexRay%s: Create: ", m->log_id);
 
-    m->pdu_router =
-        vector_make(sizeof(VectorPduRouteItem), 0, __node_ident_compar);
+    m->pdu_router = vector_make(sizeof(VectorPduRouteItem), 0, NULL);
     __pdu_router_ensure_route(m, m->node_ident);
 
+    /* Set the step_size (initial value, may change in operation). */
+    nc->reader.bus_model.step_size = nc->simulation_time.step_size;
+
     /* Install and configure the Bus Model VTable. */
     nc->reader.bus_model.model = m;
     nc->reader.bus_model.vtable.consume = flexray_pop_bus_model_consume;
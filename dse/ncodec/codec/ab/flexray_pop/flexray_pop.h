@@ -12,15 +12,29 @@
 #include <dse/ncodec/interface/pdu.h>
 #include <dse/ncodec/schema/abs/stream/pdu_builder.h>
 
-#define FLEXRAY_LOG_ID_LEN 20
+#define FLEXRAY_LOG_ID_LEN  20
+#define FLEXRAY_CYCLE_COUNT 64 /* 0..63 */
 
 
 typedef struct FlexrayPopBusModel {
     NCodecPduFlexrayNodeIdentifier node_ident;
 
-    Vector pdu_router; /* NCodecPdu: indexed by node_ident. */
+    Vector pdu_router; /* VectorPduRouteItem: indexed by node_ident. */
     char   log_id[FLEXRAY_LOG_ID_LEN];
 
+    /* Route index, hash of node_id (open addressing). */
+    struct {
+        uint32_t* slot; /* Index + 1 of the route, 0 when empty. */
+        size_t    size; /* Power of 2. */
+    } route_index;
+
+    /* Payload arena, routed PDUs are deep copied into the arena which is
+    reset each step (the blocks are retained). */
+    struct {
+        Vector block_list; /* PopArenaBlock */
+        size_t index;      /* Current block. */
+    } arena;
+
     struct {
         /* Configuration items. */
         NCodecPduFlexrayBitrate bit_rate;
@@ -30,7 +44,9 @@ typedef struct FlexrayPopBusModel {
         uint32_t                static_slot_count;
 
         /* Calculated configuration. */
-        uint32_t step_budget_mt;
+        uint32_t macro2micro;
+        uint32_t microtick_ns;
+        uint32_t step_budget_mt; /* From the step size of the codec. */
     } config;
 
     struct {
@@ -15,6 +15,9 @@
 #define ns(x) FLATBUFFERS_WRAP_NAMESPACE(AutomotiveBus_Stream_Frame, x)
 
 
+extern uint8_t* copy_stream_buffer(ABCodecInstance* nc, size_t* length);
+
+
 static void initialize_stream(ABCodecInstance* nc)
 {
     if (nc->fbs_stream_initalized) return;
@@ -49,7 +52,7 @@ static void finalize_stream(
     flatcc_builder_t* B = &nc->fbs_builder;
     ns(Stream_frames_end(B));
     ns(Stream_end_as_root(B));
-    *buffer = flatcc_builder_finalize_buffer(B, length);
+    *buffer = copy_stream_buffer(nc, length);
     reset_stream(nc);
 }
 
@@ -216,7 +219,6 @@ int32_t can_flush(NCODEC* nc)
     finalize_stream(_nc, &buffer, &length);
     if (buffer) {
         stream->write(nc, buffer, length);
-        free(buffer);
     }
     return length;
 }
@@ -13,11 +13,23 @@
 #include <dse/ncodec/schema/abs/stream/pdu_builder.h>
 
 
+#define UNUSED(x) ((void)x)
+
+
 #undef ns
 #define ns(x) FLATBUFFERS_WRAP_NAMESPACE(AutomotiveBus_Stream_Pdu, x)
 
 
-extern void clear_free_list(ABCodecInstance* _nc);
+extern void     clear_free_list(ABCodecInstance* _nc);
+extern uint8_t* copy_stream_buffer(ABCodecInstance* nc, size_t* length);
+extern void     pdu_step_sync(ABCodecInstance* nc);
+extern int32_t  pdu_step_next(ABCodecInstance* nc, NCodecPdu* pdu);
+extern void     pdu_step_reset(ABCodecInstance* nc);
+#if NCODEC_AB_TRANSPORT_IP
+extern uint32_t some_ip_tp_header(size_t offset, bool more);
+extern int32_t  some_ip_tp_reassemble(ABCodecInstance* nc, NCodecPdu* pdu);
+extern void     some_ip_tp_reset(ABCodecInstance* nc);
+#endif
 
 
 static void initialize_stream(ABCodecInstance* nc)
@@ -55,11 +67,55 @@ static void finalize_stream(
     flatcc_builder_t* B = &nc->fbs_builder;
     ns(Stream_pdus_end(B));
     ns(Stream_end_as_root(B));
-    *buffer = flatcc_builder_finalize_buffer(B, length);
+    *buffer = copy_stream_buffer(nc, length);
     reset_stream(nc);
 }
 
 
+/* Finalize the Stream and append it to the chunk buffer. Chunks are written
+to the stream by pdu_flush(), a write at the current stream position (i.e.
+while the model is still reading) would overwrite unread Stream messages.
+Returns -ENOMEM if the Stream could not be held (its PDUs are lost). */
+static int32_t emit_chunk(ABCodecInstance* nc)
+{
+    uint8_t* buffer = NULL;
+    size_t   length = 0;
+    bool     pending = nc->fbs_stream_initalized;
+
+    finalize_stream(nc, &buffer, &length);
+    nc->chunk.pdu_count = 0;
+    if (buffer == NULL) return pending ? -ENOMEM : 0;
+
+    if (nc->chunk.length + length > nc->chunk.size) {
+        size_t   size = (nc->chunk.length + length) * 3 / 2;
+        uint8_t* _buffer = realloc(nc->chunk.buffer, size);
+        if (_buffer == NULL) {
+            log_error(nc, "Chunk buffer allocation failed (size=%zu)", size);
+            return -ENOMEM;
+        }
+        nc->chunk.buffer = _buffer;
+        nc->chunk.size = size;
+    }
+    memcpy(nc->chunk.buffer + nc->chunk.length, buffer, length);
+    nc->chunk.length += length;
+    return 0;
+}
+
+
+static int32_t check_chunk(ABCodecInstance* nc)
+{
+    /* Chunked flush, emit the Stream when a threshold is reached. */
+    nc->chunk.pdu_count++;
+    if ((nc->chunk_pdus && nc->chunk.pdu_count >= nc->chunk_pdus) ||
+        (nc->chunk_bytes && flatcc_builder_get_buffer_size(&nc->fbs_builder) >=
+                                nc->chunk_bytes)) {
+        return emit_chunk(nc);
+    }
+    return 0;
+}
+
+
+#if NCODEC_AB_TRANSPORT_CAN
 static uint32_t _emit_can_message_metadata(flatcc_builder_t* B, NCodecPdu* _pdu)
 {
     NCodecPduCanMessageMetadata* can = &_pdu->transport.can_message;
@@ -70,7 +126,9 @@ static uint32_t _emit_can_message_metadata(flatcc_builder_t* B, NCodecPdu* _pdu)
     ns(CanMessageMetadata_network_id_add(B, can->network_id));
     return ns(CanMessageMetadata_end(B));
 }
+#endif
 
+#if NCODEC_AB_TRANSPORT_IP
 static uint32_t _emit_ip_addr_v4(flatcc_builder_t* B, NCodecPdu* _pdu)
 {
     NCodecPduIpAddrV4* addr = &_pdu->transport.ip_message.ip_addr.ip_v4;
@@ -168,7 +226,9 @@ static uint32_t _emit_ip_message_metadata(flatcc_builder_t* B, NCodecPdu* _pdu)
     }
     return ns(IpMessageMetadata_end(B));
 }
+#endif
 
+#if NCODEC_AB_TRANSPORT_STRUCT
 static uint32_t _emit_struct_metadata(flatcc_builder_t* B, NCodecPdu* _pdu)
 {
     NCodecPduStructMetadata* struct_obj = &_pdu->transport.struct_object;
@@ -209,19 +269,14 @@ static uint32_t _emit_struct_metadata(flatcc_builder_t* B, NCodecPdu* _pdu)
 
     return ns(StructMetadata_end(B));
 }
+#endif
 
 
-int32_t pdu_write(NCODEC* nc, NCodecPdu* pdu)
+static int32_t __pdu_write(
+    ABCodecInstance* _nc, NCodecPdu* _pdu, const uint8_t* tp_header)
 {
-    ABCodecInstance* _nc = (ABCodecInstance*)nc;
-    NCodecPdu*       _pdu = (NCodecPdu*)pdu;
-    if (_nc == NULL) return -ENOSTR;
-    if (_pdu == NULL) return -EINVAL;
-    if (_nc->c.stream == NULL) return -ENOSR;
-
     uint32_t swc_id = _pdu->swc_id ? _pdu->swc_id : _nc->swc_id;
     uint32_t ecu_id = _pdu->ecu_id ? _pdu->ecu_id : _nc->ecu_id;
-    uint32_t cc_id = _nc->cc_id;
 
     flatcc_builder_t* B = &_nc->fbs_builder;
     initialize_stream(_nc);
@@ -233,18 +288,29 @@ int32_t pdu_write(NCODEC* nc, NCodecPdu* pdu)
     /* Encode the PDU. */
     // Transport Table
     switch (_pdu->transport_type) {
+#if NCODEC_AB_TRANSPORT_CAN
     case NCodecPduTransportTypeCan: {
         can_message_metadata = _emit_can_message_metadata(B, _pdu);
     } break;
+#endif
+#if NCODEC_AB_TRANSPORT_IP
     case NCodecPduTransportTypeIp: {
         ip_message_metadata = _emit_ip_message_metadata(B, _pdu);
     } break;
+#endif
+#if NCODEC_AB_TRANSPORT_STRUCT
     case NCodecPduTransportTypeStruct: {
         struct_metadata = _emit_struct_metadata(B, _pdu);
     } break;
+#endif
+#if NCODEC_AB_TRANSPORT_FLEXRAY
     case NCodecPduTransportTypeFlexray: {
         _pdu->transport.flexray.node_ident.node.ecu_id = ecu_id;
-        _pdu->transport.flexray.node_ident.node.cc_id = cc_id;
+        /* Multi-bus, the cc_id of the PDU (if set) selects the network. */
+        if (_nc->networks_str == NULL ||
+            _pdu->transport.flexray.node_ident.node.cc_id == 0) {
+            _pdu->transport.flexray.node_ident.node.cc_id = _nc->cc_id;
+        }
         _pdu->transport.flexray.node_ident.node.swc_id = swc_id;
         if (_pdu->transport.flexray.metadata_type ==
             NCodecPduFlexrayMetadataTypeConfig) {
@@ -273,6 +339,7 @@ int32_t pdu_write(NCODEC* nc, NCodecPdu* pdu)
         }
         flexray_metadata = emit_flexray_metadata(B, _pdu);
     } break;
+#endif
     default:
         break;
     }
@@ -280,7 +347,18 @@ int32_t pdu_write(NCODEC* nc, NCodecPdu* pdu)
     // PDU Table
     ns(Stream_pdus_push_start(B));
     ns(Pdu_id_add(B, _pdu->id));
-    if (_pdu->payload != NULL) {
+    if (tp_header != NULL) {
+        /* SOME/IP-TP segment, TP header followed by the segment data. */
+        flatbuffers_uint8_vec_start(B);
+        uint8_t* data = flatbuffers_uint8_vec_extend(
+            B, SOME_IP_TP_HEADER_LEN + _pdu->payload_len);
+        if (data) {
+            memcpy(data, tp_header, SOME_IP_TP_HEADER_LEN);
+            memcpy(data + SOME_IP_TP_HEADER_LEN, _pdu->payload,
+                _pdu->payload_len);
+        }
+        ns(Pdu_payload_add(B, flatbuffers_uint8_vec_end(B)));
+    } else if (_pdu->payload != NULL) {
         ns(Pdu_payload_add(B,
             flatbuffers_uint8_vec_create(B, _pdu->payload, _pdu->payload_len)));
     }
@@ -296,11 +374,114 @@ int32_t pdu_write(NCODEC* nc, NCodecPdu* pdu)
         ns(Pdu_transport_Flexray_add(B, flexray_metadata));
     }
     ns(Stream_pdus_push_end(B));
+    int32_t rc = check_chunk(_nc);
+    if (rc < 0) return rc;
 
     return _pdu->payload_len;
 }
 
 
+#if NCODEC_AB_TRANSPORT_IP
+static bool _is_some_ip_tp(ABCodecInstance* nc, NCodecPdu* pdu)
+{
+    if (nc->tp_segment_size == 0) return false;
+    if (pdu->payload_len <= nc->tp_segment_size) return false;
+    if (pdu->transport_type != NCodecPduTransportTypeIp) return false;
+    NCodecPduIpMessageMetadata* ip = &pdu->transport.ip_message;
+    if (ip->so_ad_type != NCodecPduSoAdSomeIP) return false;
+    /* Already a segment (e.g. forwarded by a Bus Model). */
+    if (ip->so_ad.some_ip.message_type & SOME_IP_TP_FLAG) return false;
+    return true;
+}
+
+/* SOME/IP-TP, write the message as segments of tp_segment_size (rounded down
+to a multiple of 16 bytes). Each segment is a PDU, which bounds the size of
+each PDU in the Stream (and, with chunk_bytes, the size of a Stream). */
+static int32_t _write_some_ip_tp(ABCodecInstance* nc, NCodecPdu* pdu)
+{
+    size_t segment_len = nc->tp_segment_size & ~(size_t)0xf;
+    if (segment_len == 0) segment_len = 16;
+
+    NCodecPdu               segment = *pdu;
+    NCodecPduSomeIpAdapter* a = &segment.transport.ip_message.so_ad.some_ip;
+    a->message_type |= SOME_IP_TP_FLAG;
+    for (size_t offset = 0; offset < pdu->payload_len; offset += segment_len) {
+        size_t len = pdu->payload_len - offset;
+        if (len > segment_len) len = segment_len;
+        uint32_t h = some_ip_tp_header(offset, offset + len < pdu->payload_len);
+        uint8_t  tp_header[SOME_IP_TP_HEADER_LEN] = {
+            (uint8_t)(h >> 24), (uint8_t)(h >> 16), (uint8_t)(h >> 8),
+            (uint8_t)h };
+        segment.payload = pdu->payload + offset;
+        segment.payload_len = len;
+        a->length = (uint32_t)(SOME_IP_HEADER_LEN + SOME_IP_TP_HEADER_LEN + len);
+        __pdu_write(nc, &segment, tp_header);
+    }
+
+    return pdu->payload_len;
+}
+#endif
+
+
+int32_t pdu_write(NCODEC* nc, NCodecPdu* pdu)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    NCodecPdu*       _pdu = (NCodecPdu*)pdu;
+    if (_nc == NULL) return -ENOSTR;
+    if (_pdu == NULL) return -EINVAL;
+    if (_nc->c.stream == NULL) return -ENOSR;
+    pdu_step_sync(_nc);
+
+#if NCODEC_AB_TRANSPORT_IP
+    if (_is_some_ip_tp(_nc, _pdu)) return _write_some_ip_tp(_nc, _pdu);
+#endif
+    return __pdu_write(_nc, _pdu, NULL);
+}
+
+
+int32_t pdu_write_ref(NCODEC* nc, NCodecPduRef* ref)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    if (_nc == NULL) return -ENOSTR;
+    if (ref == NULL) return -EINVAL;
+    if (_nc->c.stream == NULL) return -ENOSR;
+    pdu_step_sync(_nc);
+
+    uint32_t swc_id = ref->swc_id ? ref->swc_id : _nc->swc_id;
+    uint32_t ecu_id = ref->ecu_id ? ref->ecu_id : _nc->ecu_id;
+
+    flatcc_builder_t* B = &_nc->fbs_builder;
+    initialize_stream(_nc);
+
+    /* Transport Table, copied (without decoding) from the metadata handle. */
+    ns(TransportMetadata_union_ref_t) transport = { 0 };
+    if (ref->metadata && ref->transport_type) {
+        transport = ns(TransportMetadata_clone(
+            B, (ns(TransportMetadata_union_t)){ .type = ref->transport_type,
+                   .value = ref->metadata }));
+    }
+
+    // PDU Table
+    ns(Stream_pdus_push_start(B));
+    ns(Pdu_id_add(B, ref->id));
+    if (ref->payload != NULL) {
+        ns(Pdu_payload_add(B,
+            flatbuffers_uint8_vec_create(B, ref->payload, ref->payload_len)));
+    }
+    ns(Pdu_swc_id_add(B, swc_id));
+    ns(Pdu_ecu_id_add(B, ecu_id));
+    if (transport.value) {
+        ns(Pdu_transport_add(B, transport));
+    }
+    ns(Stream_pdus_push_end(B));
+    int32_t rc = check_chunk(_nc);
+    if (rc < 0) return rc;
+
+    return ref->payload_len;
+}
+
+
+#if NCODEC_AB_TRANSPORT_CAN
 static void _decode_can_message_metadata(ns(Pdu_table_t) pdu, NCodecPdu* _pdu)
 {
     NCodecPduCanMessageMetadata* can = &_pdu->transport.can_message;
@@ -312,7 +493,9 @@ static void _decode_can_message_metadata(ns(Pdu_table_t) pdu, NCodecPdu* _pdu)
     can->interface_id = ns(CanMessageMetadata_interface_id(can_msg));
     can->network_id = ns(CanMessageMetadata_network_id(can_msg));
 }
+#endif
 
+#if NCODEC_AB_TRANSPORT_IP
 static void _decode_ip_addr_v4(
     ns(IpMessageMetadata_table_t) ip_msg, NCodecPdu* _pdu)
 {
@@ -407,7 +590,9 @@ static void _decode_ip_message_metadata(ns(Pdu_table_t) pdu, NCodecPdu* _pdu)
         _decode_some_ip(ip_msg, _pdu);
     }
 }
+#endif
 
+#if NCODEC_AB_TRANSPORT_STRUCT
 static void _decode_struct_metadata(ns(Pdu_table_t) pdu, NCodecPdu* _pdu)
 {
     NCodecPduStructMetadata* struct_obj = &_pdu->transport.struct_object;
@@ -425,6 +610,7 @@ static void _decode_struct_metadata(ns(Pdu_table_t) pdu, NCodecPdu* _pdu)
     struct_obj->platform_os = ns(StructMetadata_platform_os(struct_md));
     struct_obj->platform_abi = ns(StructMetadata_platform_abi(struct_md));
 }
+#endif
 
 
 void _reader_reset_vector_state(ABCodecReader* reader)
@@ -526,7 +712,7 @@ static void get_vector_from_stream(ABCodecReader* reader)
 }
 
 
-int32_t _reader_get_pdu(ABCodecReader* reader, NCodecPdu* pdu)
+static ns(Pdu_table_t) _reader_next(ABCodecReader* reader)
 {
     assert(reader);
     ABCodecInstance* nc = reader->state.nc;
@@ -537,35 +723,10 @@ int32_t _reader_get_pdu(ABCodecReader* reader, NCodecPdu* pdu)
     if (reader->state.msg_ptr == NULL) get_stream_from_buffer(reader);
     if (reader->state.vector == NULL) get_vector_from_stream(reader);
     while (reader->state.msg_ptr && reader->state.vector) {
-        for (uint32_t _vi = reader->state.vector_idx;
-            _vi < reader->state.vector_len; _vi++) {
-            ns(Pdu_table_t) p = ns(Pdu_vec_at(reader->state.vector, _vi));
-
-            /* Return the message. */
-            pdu->id = ns(Pdu_id(p));
-            flatbuffers_uint8_vec_t payload = ns(Pdu_payload(p));
-            pdu->payload = (uint8_t*)payload;
-            pdu->payload_len = flatbuffers_uint8_vec_len(payload);
-            pdu->swc_id = ns(Pdu_swc_id(p));
-            pdu->ecu_id = ns(Pdu_ecu_id(p));
-
-            if (ns(Pdu_transport_is_present(p))) {
-                ns(TransportMetadata_union_type_t) transport_type =
-                    ns(Pdu_transport_type(p));
-                if (transport_type == ns(TransportMetadata_Can)) {
-                    _decode_can_message_metadata(p, pdu);
-                } else if (transport_type == ns(TransportMetadata_Ip)) {
-                    _decode_ip_message_metadata(p, pdu);
-                } else if (transport_type == ns(TransportMetadata_Struct)) {
-                    _decode_struct_metadata(p, pdu);
-                } else if (transport_type == ns(TransportMetadata_Flexray)) {
-                    decode_flexray_metadata(p, pdu, &nc->free_list);
-                }
-            }
-
-            /* ... but don't forget to save the vector index either. */
-            reader->state.vector_idx = _vi + 1;
-            return pdu->payload_len;
+        if (reader->state.vector_idx < reader->state.vector_len) {
+            /* Return the PDU, and save the vector index. */
+            return ns(Pdu_vec_at(
+                reader->state.vector, reader->state.vector_idx++));
         }
 
         /* Next msg/vector? */
@@ -575,32 +736,194 @@ int32_t _reader_get_pdu(ABCodecReader* reader, NCodecPdu* pdu)
     /* No messages in stream. */
 
     stream->seek((NCODEC*)nc, 0, NCODEC_SEEK_END);
-    return -ENOMSG;
+    return NULL;
 }
 
-int32_t _next_pdu(ABCodecInstance* nc, NCodecPdu* pdu)
+
+static int32_t _decode_pdu(
+    ABCodecInstance* nc, ns(Pdu_table_t) p, NCodecPdu* pdu)
+{
+    pdu->id = ns(Pdu_id(p));
+    flatbuffers_uint8_vec_t payload = ns(Pdu_payload(p));
+    pdu->payload = (uint8_t*)payload;
+    pdu->payload_len = flatbuffers_uint8_vec_len(payload);
+    pdu->swc_id = ns(Pdu_swc_id(p));
+    pdu->ecu_id = ns(Pdu_ecu_id(p));
+
+    if (ns(Pdu_transport_is_present(p))) {
+        switch (ns(Pdu_transport_type(p))) {
+#if NCODEC_AB_TRANSPORT_CAN
+        case ns(TransportMetadata_Can):
+            _decode_can_message_metadata(p, pdu);
+            break;
+#endif
+#if NCODEC_AB_TRANSPORT_IP
+        case ns(TransportMetadata_Ip):
+            _decode_ip_message_metadata(p, pdu);
+            break;
+#endif
+#if NCODEC_AB_TRANSPORT_STRUCT
+        case ns(TransportMetadata_Struct):
+            _decode_struct_metadata(p, pdu);
+            break;
+#endif
+#if NCODEC_AB_TRANSPORT_FLEXRAY
+        case ns(TransportMetadata_Flexray):
+            decode_flexray_metadata(p, pdu, &nc->free_list);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+
+    return pdu->payload_len;
+}
+
+
+/* Decode only the PDU header and the addressing fields of the transport
+metadata (Ethernet MAC/VLAN), sufficient for a Bus Model filter. */
+static void _decode_pdu_header(ns(Pdu_table_t) p, NCodecPdu* pdu)
 {
-    ABCodecReader* reader = &nc->reader;
+    pdu->id = ns(Pdu_id(p));
+    pdu->payload_len = flatbuffers_uint8_vec_len(ns(Pdu_payload(p)));
+    pdu->swc_id = ns(Pdu_swc_id(p));
+    pdu->ecu_id = ns(Pdu_ecu_id(p));
+#if NCODEC_AB_TRANSPORT_IP
+    if (ns(Pdu_transport_type(p)) == ns(TransportMetadata_Ip)) {
+        NCodecPduIpMessageMetadata* ip = &pdu->transport.ip_message;
+        ns(IpMessageMetadata_table_t) ip_msg =
+            (ns(IpMessageMetadata_table_t))ns(Pdu_transport(p));
+        pdu->transport_type = NCodecPduTransportTypeIp;
+        ip->eth_dst_mac = ns(IpMessageMetadata_eth_dst_mac(ip_msg));
+        ip->eth_src_mac = ns(IpMessageMetadata_eth_src_mac(ip_msg));
+        ip->eth_tci_pcp = ns(IpMessageMetadata_eth_tci_pcp(ip_msg));
+        ip->eth_tci_vid = ns(IpMessageMetadata_eth_tci_vid(ip_msg));
+    }
+#endif
+}
+
+
+static int32_t _decode_pdu_ref(ns(Pdu_table_t) p, NCodecPduRef* ref)
+{
+    ref->id = ns(Pdu_id(p));
+    flatbuffers_uint8_vec_t payload = ns(Pdu_payload(p));
+    ref->payload = (uint8_t*)payload;
+    ref->payload_len = flatbuffers_uint8_vec_len(payload);
+    ref->swc_id = ns(Pdu_swc_id(p));
+    ref->ecu_id = ns(Pdu_ecu_id(p));
+    /* The metadata is not decoded, only referenced. */
+    ref->transport_type = ns(Pdu_transport_type(p));
+    ref->metadata = ns(Pdu_transport(p));
+
+    return ref->payload_len;
+}
+
+
+/* Complete a decoded PDU for the caller of pdu_read(). SOME/IP-TP segments
+are reassembled, returns -EAGAIN until the message is complete. */
+static int32_t _complete_message(
+    ABCodecInstance* nc, NCodecPdu* pdu, int32_t rc)
+{
+#if NCODEC_AB_TRANSPORT_IP
+    rc = some_ip_tp_reassemble(nc, pdu);
+#else
+    UNUSED(nc);
+    UNUSED(pdu);
+#endif
+    return rc;
+}
+
+
+/* Decode a PDU for the caller of pdu_read(). */
+static int32_t _decode_message(
+    ABCodecInstance* nc, ABCodecInstance* pdu_nc, ns(Pdu_table_t) p, NCodecPdu* pdu)
+{
+    int32_t rc = _decode_pdu(pdu_nc, p, pdu);
+    if (rc < 0) return rc;
+    return _complete_message(nc, pdu, rc);
+}
+
+
+int32_t _reader_get_pdu(ABCodecReader* reader, NCodecPdu* pdu)
+{
+    ns(Pdu_table_t) p = _reader_next(reader);
+    if (p == NULL) return -ENOMSG;
+    return _decode_pdu(reader->state.nc, p, pdu);
+}
+
+
+/* Multi-bus, route the PDU to the Bus Model of its network. Returns NULL if
+no Bus Model is configured for the network. */
+static ABCodecBusModel* _route_bus_model(ABCodecReader* reader, NCodecPdu* pdu)
+{
+    if (reader->network_count == 0) return &reader->bus_model;
+
+    uint32_t network_id = bus_model_network_id(pdu);
+    if (reader->bus_model.network_id == network_id) return &reader->bus_model;
+    for (size_t i = 0; i < reader->network_count; i++) {
+        if (reader->networks[i].network_id == network_id) {
+            return &reader->networks[i];
+        }
+    }
+    return NULL;
+}
+
+
+static void _progress_bus_model(ABCodecInstance* nc, ABCodecBusModel* bm)
+{
+    if (bm->vtable.progress == NULL) return;
+    bm->simulation_time = nc->simulation_time.value;
+    bm->step_size = nc->simulation_time.step_size;
+    bm->vtable.progress(bm);
+}
+
+
+/* Return the next PDU as either a decoded PDU (pdu) or as a compact
+descriptor (ref). */
+static int32_t __next_pdu(ABCodecInstance* nc, NCodecPdu* pdu, NCodecPduRef* ref)
+{
+    ABCodecReader*  reader = &nc->reader;
+    ns(Pdu_table_t) p;
 
     /* Stage: NCodec PDUs. */
     if (reader->stage.ncodec_consumed == false) {
         reader->state.nc = nc;
-        while (true) {
-            int32_t rc = _reader_get_pdu(reader, pdu);
-            if (rc == -ENOMSG) break;
-            if (rc < 0) return rc; /* An error condition. */
+        while ((p = _reader_next(reader)) != NULL) {
+            int32_t    rc = -ENODATA; /* Not decoded. */
+            NCodecPdu  _pdu = {};
+            NCodecPdu* bm_pdu = pdu ? pdu : &_pdu;
             if (reader->bus_model.vtable.consume) {
-                if (reader->bus_model.vtable.consume(&reader->bus_model, pdu)) {
+                ABCodecBusModel* bm = &reader->bus_model;
+                if (reader->network_count == 0 && bm->vtable.filter) {
+                    /* Drop PDUs on the header, before the full decode. */
+                    NCodecPdu hdr = {};
+                    _decode_pdu_header(p, &hdr);
+                    if (bm->vtable.filter(bm, &hdr)) continue;
+                }
+                /* The Bus Model requires a decoded PDU (decoded once). */
+                rc = _decode_pdu(nc, p, bm_pdu);
+                if (rc < 0) return rc; /* An error condition. */
+                bm = _route_bus_model(reader, bm_pdu);
+                if (bm && bm->vtable.consume(bm, bm_pdu)) {
                     continue; /* The Bus Model consumed this PDU. */
                 }
             }
 
             /* Filter: sender==receiver. */
-            if ((nc->swc_id) && (nc->swc_id == pdu->swc_id)) {
+            if ((nc->swc_id) && (nc->swc_id == ns(Pdu_swc_id(p)))) {
                 if (nc->loopback == false) continue;
             }
 
-            return rc; /* PDU available, return length (i.e. rc). */
+            /* PDU available, return length. */
+            if (ref) return _decode_pdu_ref(p, ref);
+            if (rc == -ENODATA) {
+                rc = _decode_pdu(nc, p, pdu);
+                if (rc < 0) return rc;
+            }
+            rc = _complete_message(nc, pdu, rc);
+            if (rc == -EAGAIN) continue; /* SOME/IP-TP segment. */
+            return rc;
         }
 
         /* Trace - stream from SimBus. */
@@ -624,11 +947,10 @@ int32_t _next_pdu(ABCodecInstance* nc, NCodecPdu* pdu)
         if (reader->bus_model.trace.nc != NULL) {
             ncodec_truncate((NCODEC*)reader->bus_model.trace.nc);
         }
-        if (reader->bus_model.vtable.progress) {
-            reader->bus_model.simulation_time = nc->simulation_time.value;
-            reader->bus_model.step_size = nc->simulation_time.step_size;
-
-            reader->bus_model.vtable.progress(&reader->bus_model);
+        /* Multi-bus, all Bus Models write to the same Stream (single flush). */
+        _progress_bus_model(nc, &reader->bus_model);
+        for (size_t i = 0; i < reader->network_count; i++) {
+            _progress_bus_model(nc, &reader->networks[i]);
         }
         ncodec_flush((NCODEC*)reader->bus_model.nc);
         ncodec_seek((NCODEC*)reader->bus_model.nc, 0, NCODEC_SEEK_SET);
@@ -639,11 +961,12 @@ int32_t _next_pdu(ABCodecInstance* nc, NCodecPdu* pdu)
     if (reader->stage.model_consumed == false) {
         if (reader->bus_model.nc) {
             reader->state.nc = reader->bus_model.nc;
-            while (true) {
-                int32_t rc = _reader_get_pdu(reader, pdu);
-                if (rc == -ENOMSG) break;
-                if (rc < 0) return rc; /* An error condition. */
-                return rc; /* PDU available, return length (i.e. rc). */
+            while ((p = _reader_next(reader)) != NULL) {
+                /* PDU available, return length. */
+                if (ref) return _decode_pdu_ref(p, ref);
+                int32_t rc = _decode_message(nc, reader->bus_model.nc, p, pdu);
+                if (rc == -EAGAIN) continue; /* SOME/IP-TP segment. */
+                return rc;
             }
 
             /* Trace - stream from BusModel (_all_ Tx messages). */
@@ -685,6 +1008,11 @@ int32_t _next_pdu(ABCodecInstance* nc, NCodecPdu* pdu)
     return -ENOMSG;
 }
 
+int32_t _next_pdu(ABCodecInstance* nc, NCodecPdu* pdu)
+{
+    return __next_pdu(nc, pdu, NULL);
+}
+
 int32_t pdu_read(NCODEC* _nc, NCodecPdu* pdu)
 {
     ABCodecInstance* nc = (ABCodecInstance*)_nc;
@@ -695,25 +1023,60 @@ int32_t pdu_read(NCODEC* _nc, NCodecPdu* pdu)
     /* Reset the message, in case caller ignores the return value. */
     *pdu = (NCodecPdu){};
 
+    /* Pipelined step, return PDUs decoded by the step worker. */
+    pdu_step_sync(nc);
+    if (nc->step.ready) return pdu_step_next(nc, pdu);
+
     return _next_pdu(nc, pdu);
 }
 
 
+int32_t pdu_read_ref(NCODEC* _nc, NCodecPduRef* ref)
+{
+    ABCodecInstance* nc = (ABCodecInstance*)_nc;
+    if (nc == NULL) return -ENOSTR;
+    if (ref == NULL) return -EINVAL;
+    if (nc->c.stream == NULL) return -ENOSR;
+
+    /* Pipelined step, PDUs are already decoded (and SOME/IP-TP messages
+    reassembled) so there is no metadata handle to forward. */
+    pdu_step_sync(nc);
+    if (nc->step.ready) return -EBUSY;
+
+    return __next_pdu(nc, NULL, ref);
+}
+
+
 int32_t pdu_flush(NCODEC* nc)
 {
     ABCodecInstance* _nc = (ABCodecInstance*)nc;
     if (_nc == NULL) return -ENOSTR;
     if (_nc->c.stream == NULL) return -ENOSR;
+
     NCodecStreamVTable* stream = (NCodecStreamVTable*)_nc->c.stream;
 
     uint8_t* buffer = NULL;
     size_t   length = 0;
-
-    finalize_stream(_nc, &buffer, &length);
-    if (buffer) {
-        stream->write(nc, buffer, length);
-        free(buffer);
+    int32_t  rc = 0;
+
+    pdu_step_sync(_nc);
+    if (_nc->chunk.length) {
+        /* Chunked flush, write all chunks (including the pending PDUs). */
+        rc = emit_chunk(_nc);
+        buffer = _nc->chunk.buffer;
+        length = _nc->chunk.length;
+        _nc->chunk.length = 0;
+    } else {
+        finalize_stream(_nc, &buffer, &length);
+    }
+    if (buffer) stream->write(nc, buffer, length);
+    if (buffer && buffer == _nc->chunk.buffer && length < _nc->chunk.size / 2) {
+        /* Release the chunk buffer after a burst (not retained). */
+        free(_nc->chunk.buffer);
+        _nc->chunk.buffer = NULL;
+        _nc->chunk.size = 0;
     }
+    if (rc < 0) return rc;
     return length;
 }
 
@@ -725,10 +1088,17 @@ int32_t pdu_truncate(NCODEC* nc)
     if (_nc->c.stream == NULL) return -ENOSR;
     NCodecStreamVTable* stream = (NCodecStreamVTable*)_nc->c.stream;
 
+    pdu_step_sync(_nc);
+    pdu_step_reset(_nc);
     reset_stream(_nc);
+    _nc->chunk.pdu_count = 0;
+    _nc->chunk.length = 0;
     stream->seek(nc, 0, NCODEC_SEEK_RESET);
     _reader_reset(&_nc->reader);
     clear_free_list(_nc);
+#if NCODEC_AB_TRANSPORT_IP
+    some_ip_tp_reset(_nc);
+#endif
 
     if (_nc->simulation_time.broadcast.request) {
         // TODO inject utime message to PDU stream.
@@ -745,6 +1115,7 @@ int32_t pdu_utime(NCODEC* nc, NCodecUtimeOperation op)
     if (_nc->c.stream == NULL) return -ENOSR;
     if (op.simulation_time < 0.0) return -EINVAL;
     if (op.step_size < 0.0) return -EINVAL;
+    pdu_step_sync(_nc);
 
     int rc = -ENODATA; /* Default return, no action taken. */
 
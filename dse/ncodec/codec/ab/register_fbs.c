@@ -0,0 +1,467 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/interface/register.h>
+#include <dse/ncodec/schema/abs/register/can_builder.h>
+#include <dse/ncodec/schema/abs/register/flexray_builder.h>
+#include <dse/ncodec/schema/abs/register/ethernet_builder.h>
+
+
+#undef ns
+#define ns_can(x) FLATBUFFERS_WRAP_NAMESPACE(AutomotiveBus_Register_Can, x)
+#define ns_fr(x)  FLATBUFFERS_WRAP_NAMESPACE(AutomotiveBus_Register_FlexRay, x)
+#define ns_eth(x) FLATBUFFERS_WRAP_NAMESPACE(AutomotiveBus_Register_Ethernet, x)
+
+/* File identifiers of the Register schemas (the flatbuffers_identifier macro
+is redefined by each included schema). */
+#define REGISTER_CAN_IDENTIFIER      "RICA"
+#define REGISTER_FLEXRAY_IDENTIFIER  "RIFR"
+#define REGISTER_ETHERNET_IDENTIFIER "RIEN"
+
+#define PSEC10_PER_NSEC 100
+#define MAC_ADDR_LEN    6
+
+
+extern uint8_t* copy_stream_buffer(ABCodecInstance* nc, size_t* length);
+
+
+typedef enum {
+    REGISTER_BUS_NONE = 0,
+    REGISTER_BUS_CAN,
+    REGISTER_BUS_FLEXRAY,
+    REGISTER_BUS_ETHERNET,
+} RegisterBus;
+
+
+static RegisterBus register_bus(ABCodecInstance* nc)
+{
+    if (nc->bus == NULL) return REGISTER_BUS_NONE;
+    if (strcmp(nc->bus, "can") == 0) return REGISTER_BUS_CAN;
+    if (strcmp(nc->bus, "flexray") == 0) return REGISTER_BUS_FLEXRAY;
+    if (strcmp(nc->bus, "ethernet") == 0) return REGISTER_BUS_ETHERNET;
+    return REGISTER_BUS_NONE;
+}
+
+
+static void initialize_stream(ABCodecInstance* nc, RegisterBus bus)
+{
+    if (nc->fbs_stream_initalized) return;
+
+    flatcc_builder_t* B = &nc->fbs_builder;
+    flatcc_builder_reset(B);
+    switch (bus) {
+    case REGISTER_BUS_CAN:
+        ns_can(RegisterFile_start_as_root_with_size(B));
+        ns_can(RegisterFile_buffer_start(B));
+        break;
+    case REGISTER_BUS_FLEXRAY:
+        ns_fr(RegisterFile_start_as_root_with_size(B));
+        ns_fr(RegisterFile_buffer_start(B));
+        break;
+    case REGISTER_BUS_ETHERNET:
+        ns_eth(RegisterFile_start_as_root_with_size(B));
+        ns_eth(RegisterFile_buffer_start(B));
+        break;
+    default:
+        return;
+    }
+    nc->fbs_stream_initalized = true;
+}
+
+
+static void reset_stream(ABCodecInstance* nc)
+{
+    if (nc->fbs_stream_initalized == false) return;
+
+    flatcc_builder_t* B = &nc->fbs_builder;
+    flatcc_builder_reset(B);
+    nc->fbs_stream_initalized = false;
+}
+
+
+static void finalize_stream(
+    ABCodecInstance* nc, uint8_t** buffer, size_t* length)
+{
+    if (nc->fbs_stream_initalized == false) {
+        *buffer = NULL;
+        *length = 0;
+        return;
+    }
+
+    flatcc_builder_t* B = &nc->fbs_builder;
+    switch (register_bus(nc)) {
+    case REGISTER_BUS_CAN:
+        ns_can(RegisterFile_buffer_end(B));
+        ns_can(RegisterFile_end_as_root(B));
+        break;
+    case REGISTER_BUS_FLEXRAY:
+        ns_fr(RegisterFile_buffer_end(B));
+        ns_fr(RegisterFile_end_as_root(B));
+        break;
+    case REGISTER_BUS_ETHERNET:
+        ns_eth(RegisterFile_buffer_end(B));
+        ns_eth(RegisterFile_end_as_root(B));
+        break;
+    default:
+        break;
+    }
+    *buffer = copy_stream_buffer(nc, length);
+    reset_stream(nc);
+}
+
+
+static bool has_timing(NCodecRegisterBuffer* b)
+{
+    return b->timing.send || b->timing.arb || b->timing.recv;
+}
+
+
+static flatbuffers_uint8_vec_ref_t mac_vec_create(
+    flatcc_builder_t* B, uint64_t mac)
+{
+    uint8_t addr[MAC_ADDR_LEN];
+    for (size_t i = 0; i < MAC_ADDR_LEN; i++) {
+        addr[i] = (uint8_t)(mac >> (8 * (MAC_ADDR_LEN - 1 - i)));
+    }
+    return flatbuffers_uint8_vec_create(B, addr, MAC_ADDR_LEN);
+}
+
+
+static uint64_t mac_from_vec(flatbuffers_uint8_vec_t vec)
+{
+    uint64_t mac = 0;
+    size_t   len = flatbuffers_uint8_vec_len(vec);
+    if (len > MAC_ADDR_LEN) len = MAC_ADDR_LEN;
+    for (size_t i = 0; i < len; i++) {
+        mac = (mac << 8) | vec[i];
+    }
+    return mac;
+}
+
+
+static void encode_can(flatcc_builder_t* B, NCodecRegisterBuffer* b)
+{
+    ns_can(RegisterFile_buffer_push_start(B));
+    ns_can(MetaFrame_status_add(B, b->status));
+    ns_can(MetaFrame_direction_add(B, b->direction));
+    ns_can(MetaFrame_can_fd_enabled_add(B, b->bus.can.can_fd_enabled));
+    ns_can(MetaFrame_frame_start(B));
+    ns_can(Frame_frame_id_add(B, b->frame_id));
+    ns_can(Frame_payload_add(
+        B, flatbuffers_uint8_vec_create(B, b->payload, b->payload_len)));
+    ns_can(Frame_length_add(B, (uint8_t)b->payload_len));
+    ns_can(Frame_rtr_add(B, b->bus.can.rtr));
+    ns_can(Frame_frame_type_add(B, b->bus.can.frame_type));
+    ns_can(MetaFrame_frame_end(B));
+    if (has_timing(b)) {
+        ns_can(MetaFrame_timing_create(B, b->timing.send * PSEC10_PER_NSEC,
+            b->timing.arb * PSEC10_PER_NSEC, b->timing.recv * PSEC10_PER_NSEC));
+    }
+    ns_can(RegisterFile_buffer_push_end(B));
+}
+
+
+static void encode_flexray(flatcc_builder_t* B, NCodecRegisterBuffer* b)
+{
+    ns_fr(RegisterFile_buffer_push_start(B));
+    ns_fr(MetaFrame_status_add(B, b->status));
+    ns_fr(MetaFrame_direction_add(B, b->direction));
+    ns_fr(MetaFrame_channel_mask_add(B, b->bus.flexray.channel_mask));
+    ns_fr(MetaFrame_cycle_period_add(B, b->bus.flexray.cycle_period));
+    ns_fr(MetaFrame_cycle_offset_add(B, b->bus.flexray.cycle_offset));
+    ns_fr(MetaFrame_frame_start(B));
+    ns_fr(Frame_frame_id_add(B, (uint16_t)b->frame_id));
+    ns_fr(Frame_indicators_add(B, b->bus.flexray.indicators));
+    /* FlexRay header: payload length in 2-byte words. */
+    ns_fr(Frame_length_add(B, (uint8_t)((b->payload_len + 1) / 2)));
+    ns_fr(Frame_data_add(
+        B, flatbuffers_uint8_vec_create(B, b->payload, b->payload_len)));
+    ns_fr(MetaFrame_frame_end(B));
+    if (has_timing(b)) {
+        ns_fr(MetaFrame_timing_create(B, b->timing.send * PSEC10_PER_NSEC,
+            b->timing.arb * PSEC10_PER_NSEC, b->timing.recv * PSEC10_PER_NSEC));
+    }
+    ns_fr(RegisterFile_buffer_push_end(B));
+}
+
+
+static void encode_ethernet(flatcc_builder_t* B, NCodecRegisterBuffer* b)
+{
+    ns_eth(RegisterFile_buffer_push_start(B));
+    ns_eth(MetaFrame_status_add(B, b->status));
+    ns_eth(MetaFrame_direction_add(B, b->direction));
+    ns_eth(MetaFrame_frame_start(B));
+    ns_eth(Frame_dest_mac_add(B, mac_vec_create(B, b->bus.ethernet.dst_mac)));
+    ns_eth(Frame_src_mac_add(B, mac_vec_create(B, b->bus.ethernet.src_mac)));
+    ns_eth(Frame_vlan_tag_add(B, b->bus.ethernet.vlan_tag));
+    ns_eth(Frame_ether_type_add(B, b->bus.ethernet.ether_type));
+    ns_eth(Frame_data_add(
+        B, flatbuffers_uint8_vec_create(B, b->payload, b->payload_len)));
+    ns_eth(Frame_length_add(B, (uint16_t)b->payload_len));
+    ns_eth(MetaFrame_frame_end(B));
+    if (has_timing(b)) {
+        ns_eth(MetaFrame_timing_create(B, b->timing.send * PSEC10_PER_NSEC,
+            b->timing.arb * PSEC10_PER_NSEC, b->timing.recv * PSEC10_PER_NSEC));
+    }
+    ns_eth(RegisterFile_buffer_push_end(B));
+}
+
+
+int32_t register_write(NCODEC* nc, NCodecMessage* msg)
+{
+    ABCodecInstance*    _nc = (ABCodecInstance*)nc;
+    NCodecRegisterFile* _msg = (NCodecRegisterFile*)msg;
+    if (_nc == NULL) return -ENOSTR;
+    if (_msg == NULL) return -EINVAL;
+    if (_msg->count && _msg->buffer == NULL) return -EINVAL;
+    if (_nc->c.stream == NULL) return -ENOSR;
+
+    flatcc_builder_t* B = &_nc->fbs_builder;
+    RegisterBus       bus = register_bus(_nc);
+
+    /* Buffers from consecutive writes are encoded to the same Register File,
+    which is completed by ncodec_flush(). */
+    initialize_stream(_nc, bus);
+    for (size_t i = 0; i < _msg->count; i++) {
+        NCodecRegisterBuffer* b = &_msg->buffer[i];
+        switch (bus) {
+        case REGISTER_BUS_CAN:
+            encode_can(B, b);
+            break;
+        case REGISTER_BUS_FLEXRAY:
+            encode_flexray(B, b);
+            break;
+        case REGISTER_BUS_ETHERNET:
+            encode_ethernet(B, b);
+            break;
+        default:
+            return -EINVAL;
+        }
+    }
+
+    return (int32_t)_msg->count;
+}
+
+
+static void decode_timing(NCodecRegisterBuffer* b, int64_t send, int64_t arb,
+    int64_t recv)
+{
+    b->timing.send = (uint64_t)send / PSEC10_PER_NSEC;
+    b->timing.arb = (uint64_t)arb / PSEC10_PER_NSEC;
+    b->timing.recv = (uint64_t)recv / PSEC10_PER_NSEC;
+}
+
+
+static void decode_can(Vector* list, uint8_t* msg_ptr)
+{
+    ns_can(RegisterFile_table_t) rf = ns_can(RegisterFile_as_root(msg_ptr));
+    ns_can(MetaFrame_vec_t) vec = ns_can(RegisterFile_buffer(rf));
+    for (size_t i = 0; i < ns_can(MetaFrame_vec_len(vec)); i++) {
+        ns_can(MetaFrame_table_t) mf = ns_can(MetaFrame_vec_at(vec, i));
+        ns_can(Frame_table_t) f = ns_can(MetaFrame_frame(mf));
+        NCodecRegisterBuffer b = {
+            .direction = ns_can(MetaFrame_direction(mf)),
+            .status = ns_can(MetaFrame_status(mf)),
+            .bus.can.can_fd_enabled = ns_can(MetaFrame_can_fd_enabled(mf)),
+        };
+        if (f) {
+            flatbuffers_uint8_vec_t payload = ns_can(Frame_payload(f));
+            b.frame_id = ns_can(Frame_frame_id(f));
+            b.payload = payload;
+            b.payload_len = flatbuffers_uint8_vec_len(payload);
+            b.bus.can.rtr = ns_can(Frame_rtr(f));
+            b.bus.can.frame_type = ns_can(Frame_frame_type(f));
+        }
+        ns_can(MessageTiming_struct_t) t = ns_can(MetaFrame_timing(mf));
+        if (t) {
+            decode_timing(&b, t->send_request.psec10, t->arbitration.psec10,
+                t->reception.psec10);
+        }
+        vector_push(list, &b);
+    }
+}
+
+
+static void decode_flexray(Vector* list, uint8_t* msg_ptr)
+{
+    ns_fr(RegisterFile_table_t) rf = ns_fr(RegisterFile_as_root(msg_ptr));
+    ns_fr(MetaFrame_vec_t) vec = ns_fr(RegisterFile_buffer(rf));
+    for (size_t i = 0; i < ns_fr(MetaFrame_vec_len(vec)); i++) {
+        ns_fr(MetaFrame_table_t) mf = ns_fr(MetaFrame_vec_at(vec, i));
+        ns_fr(Frame_table_t) f = ns_fr(MetaFrame_frame(mf));
+        NCodecRegisterBuffer b = {
+            .direction = ns_fr(MetaFrame_direction(mf)),
+            .status = ns_fr(MetaFrame_status(mf)),
+            .bus.flexray.channel_mask = ns_fr(MetaFrame_channel_mask(mf)),
+            .bus.flexray.cycle_period = ns_fr(MetaFrame_cycle_period(mf)),
+            .bus.flexray.cycle_offset = ns_fr(MetaFrame_cycle_offset(mf)),
+        };
+        if (f) {
+            flatbuffers_uint8_vec_t data = ns_fr(Frame_data(f));
+            b.frame_id = ns_fr(Frame_frame_id(f));
+            b.payload = data;
+            b.payload_len = flatbuffers_uint8_vec_len(data);
+            b.bus.flexray.indicators = ns_fr(Frame_indicators(f));
+        }
+        ns_fr(MessageTiming_struct_t) t = ns_fr(MetaFrame_timing(mf));
+        if (t) {
+            decode_timing(&b, t->send_request.psec10, t->arbitration.psec10,
+                t->reception.psec10);
+        }
+        vector_push(list, &b);
+    }
+}
+
+
+static void decode_ethernet(Vector* list, uint8_t* msg_ptr)
+{
+    ns_eth(RegisterFile_table_t) rf = ns_eth(RegisterFile_as_root(msg_ptr));
+    ns_eth(MetaFrame_vec_t) vec = ns_eth(RegisterFile_buffer(rf));
+    for (size_t i = 0; i < ns_eth(MetaFrame_vec_len(vec)); i++) {
+        ns_eth(MetaFrame_table_t) mf = ns_eth(MetaFrame_vec_at(vec, i));
+        ns_eth(Frame_table_t) f = ns_eth(MetaFrame_frame(mf));
+        NCodecRegisterBuffer b = {
+            .direction = ns_eth(MetaFrame_direction(mf)),
+            .status = ns_eth(MetaFrame_status(mf)),
+        };
+        if (f) {
+            flatbuffers_uint8_vec_t data = ns_eth(Frame_data(f));
+            b.payload = data;
+            b.payload_len = flatbuffers_uint8_vec_len(data);
+            b.bus.ethernet.dst_mac = mac_from_vec(ns_eth(Frame_dest_mac(f)));
+            b.bus.ethernet.src_mac = mac_from_vec(ns_eth(Frame_src_mac(f)));
+            b.bus.ethernet.vlan_tag = ns_eth(Frame_vlan_tag(f));
+            b.bus.ethernet.ether_type = ns_eth(Frame_ether_type(f));
+        }
+        ns_eth(MessageTiming_struct_t) t = ns_eth(MetaFrame_timing(mf));
+        if (t) {
+            decode_timing(&b, t->send_request.psec10, t->arbitration.psec10,
+                t->reception.psec10);
+        }
+        vector_push(list, &b);
+    }
+}
+
+
+static uint8_t* get_msg_from_stream(NCODEC* nc, const char* identifier)
+{
+    ABCodecInstance*    _nc = (ABCodecInstance*)nc;
+    NCodecStreamVTable* stream = (NCodecStreamVTable*)_nc->c.stream;
+
+    /* Next message? */
+    uint8_t* buffer;
+    size_t   length;
+    stream->read(nc, &buffer, &length, NCODEC_POS_NC);
+
+    uint8_t*       msg_ptr = buffer;
+    uint8_t* const buffer_ptr = buffer;
+    while ((size_t)(msg_ptr - buffer_ptr) < length) {
+        /* Messages start with a size prefix. */
+        size_t msg_len = 0;
+        msg_ptr = flatbuffers_read_size_prefix(msg_ptr, &msg_len);
+        if (msg_len == 0) break;
+        /* Advance the stream pos (+4 for size prefix). */
+        stream->seek(nc, msg_len + 4, NCODEC_SEEK_CUR);
+        if (flatbuffers_has_identifier(msg_ptr, identifier)) return msg_ptr;
+        /* Next message in the stream. */
+        msg_ptr += msg_len;
+    }
+
+    /* No message in stream. */
+    stream->seek(nc, 0, NCODEC_SEEK_END);
+    return NULL;
+}
+
+
+int32_t register_read(NCODEC* nc, NCodecMessage* msg)
+{
+    ABCodecInstance*    _nc = (ABCodecInstance*)nc;
+    NCodecRegisterFile* _msg = (NCodecRegisterFile*)msg;
+    if (_nc == NULL) return -ENOSTR;
+    if (_msg == NULL) return -EINVAL;
+    if (_nc->c.stream == NULL) return -ENOSR;
+
+    /* Reset the message, in case caller ignores the return value. */
+    _msg->buffer = NULL;
+    _msg->count = 0;
+
+    RegisterBus bus = register_bus(_nc);
+    const char* identifier = NULL;
+    switch (bus) {
+    case REGISTER_BUS_CAN:
+        identifier = REGISTER_CAN_IDENTIFIER;
+        break;
+    case REGISTER_BUS_FLEXRAY:
+        identifier = REGISTER_FLEXRAY_IDENTIFIER;
+        break;
+    case REGISTER_BUS_ETHERNET:
+        identifier = REGISTER_ETHERNET_IDENTIFIER;
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    /* Each Register File (message) is decoded in a single call. The decoded
+    buffers are held by the codec, payloads reference the stream. */
+    uint8_t* msg_ptr = get_msg_from_stream(nc, identifier);
+    if (msg_ptr == NULL) return -ENOMSG;
+    if (_nc->register_list.capacity == 0) {
+        _nc->register_list = vector_make(sizeof(NCodecRegisterBuffer), 0, NULL);
+    }
+    vector_clear(&_nc->register_list, NULL, NULL);
+    switch (bus) {
+    case REGISTER_BUS_CAN:
+        decode_can(&_nc->register_list, msg_ptr);
+        break;
+    case REGISTER_BUS_FLEXRAY:
+        decode_flexray(&_nc->register_list, msg_ptr);
+        break;
+    case REGISTER_BUS_ETHERNET:
+        decode_ethernet(&_nc->register_list, msg_ptr);
+        break;
+    default:
+        break;
+    }
+    _msg->count = vector_len(&_nc->register_list);
+    _msg->buffer = vector_at(&_nc->register_list, 0, NULL);
+    return (int32_t)_msg->count;
+}
+
+
+int32_t register_flush(NCODEC* nc)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    if (_nc == NULL) return -ENOSTR;
+    if (_nc->c.stream == NULL) return -ENOSR;
+    NCodecStreamVTable* stream = (NCodecStreamVTable*)_nc->c.stream;
+
+    uint8_t* buffer = NULL;
+    size_t   length = 0;
+
+    finalize_stream(_nc, &buffer, &length);
+    if (buffer) {
+        stream->write(nc, buffer, length);
+    }
+    return length;
+}
+
+
+int32_t register_truncate(NCODEC* nc)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    if (_nc == NULL) return -ENOSTR;
+    if (_nc->c.stream == NULL) return -ENOSR;
+    NCodecStreamVTable* stream = (NCodecStreamVTable*)_nc->c.stream;
+
+    reset_stream(_nc);
+    vector_clear(&_nc->register_list, NULL, NULL);
+    stream->seek(nc, 0, NCODEC_SEEK_RESET);
+
+    return 0;
+}
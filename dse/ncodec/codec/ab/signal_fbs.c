@@ -0,0 +1,390 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/interface/signal.h>
+#include <dse/ncodec/schema/abs/signal/channel_builder.h>
+
+
+#undef ns
+#define ns(x) FLATBUFFERS_WRAP_NAMESPACE(AutomotiveBus_Signal_Channel, x)
+
+
+/* Signal vector encoding (SignalValue.data and SignalWrite.data), MsgPack
+as specified by the schema:
+
+    [ [uid, ...], [value, ...] ]
+
+UIDs are encoded as (the smallest) unsigned integer and values as float 64.
+Values are decoded from any MsgPack numeric type (integer or float). */
+
+
+extern uint8_t* copy_stream_buffer(ABCodecInstance* nc, size_t* length);
+
+
+static inline size_t mp_array_len(size_t count)
+{
+    if (count <= 15) return 1;
+    if (count <= 0xffff) return 3;
+    return 5;
+}
+
+static inline size_t mp_uint_len(uint32_t v)
+{
+    if (v <= 0x7f) return 1;
+    if (v <= 0xff) return 2;
+    if (v <= 0xffff) return 3;
+    return 5;
+}
+
+static inline uint8_t* mp_put_be(uint8_t* p, uint64_t v, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        p[i] = (uint8_t)(v >> (8 * (len - 1 - i)));
+    }
+    return p + len;
+}
+
+static uint8_t* mp_put_array(uint8_t* p, size_t count)
+{
+    if (count <= 15) {
+        *p++ = 0x90 | (uint8_t)count;
+        return p;
+    }
+    if (count <= 0xffff) {
+        *p++ = 0xdc;
+        return mp_put_be(p, count, 2);
+    }
+    *p++ = 0xdd;
+    return mp_put_be(p, count, 4);
+}
+
+static uint8_t* mp_put_uint(uint8_t* p, uint32_t v)
+{
+    switch (mp_uint_len(v)) {
+    case 1:
+        *p++ = (uint8_t)v;
+        return p;
+    case 2:
+        *p++ = 0xcc;
+        return mp_put_be(p, v, 1);
+    case 3:
+        *p++ = 0xcd;
+        return mp_put_be(p, v, 2);
+    default:
+        *p++ = 0xce;
+        return mp_put_be(p, v, 4);
+    }
+}
+
+static uint8_t* mp_put_double(uint8_t* p, double v)
+{
+    uint64_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    *p++ = 0xcb;
+    return mp_put_be(p, bits, 8);
+}
+
+
+int32_t signal_write(NCODEC* nc, NCodecMessage* msg)
+{
+    ABCodecInstance*    _nc = (ABCodecInstance*)nc;
+    NCodecSignalVector* _msg = (NCodecSignalVector*)msg;
+    if (_nc == NULL) return -ENOSTR;
+    if (_msg == NULL) return -EINVAL;
+    if (_msg->count && (_msg->uid == NULL || _msg->value == NULL)) {
+        return -EINVAL;
+    }
+    if (_nc->c.stream == NULL) return -ENOSR;
+    NCodecStreamVTable* stream = (NCodecStreamVTable*)_nc->c.stream;
+
+    flatcc_builder_t* B = &_nc->fbs_builder;
+    flatcc_builder_reset(B);
+    ns(ChannelMessage_start_as_root_with_size(B));
+    ns(ChannelMessage_model_uid_add(B, _nc->model_uid));
+    /* Encode the vectors (directly into the builder). */
+    size_t data_len = 1 + 2 * mp_array_len(_msg->count) + _msg->count * 9;
+    for (size_t i = 0; i < _msg->count; i++) {
+        data_len += mp_uint_len(_msg->uid[i]);
+    }
+    flatbuffers_uint8_vec_start(B);
+    uint8_t* data = flatbuffers_uint8_vec_extend(B, data_len);
+    if (data == NULL) {
+        flatcc_builder_reset(B);
+        return -ENOMEM;
+    }
+    *data++ = 0x92; /* fixarray (2) */
+    data = mp_put_array(data, _msg->count);
+    for (size_t i = 0; i < _msg->count; i++) {
+        data = mp_put_uint(data, _msg->uid[i]);
+    }
+    data = mp_put_array(data, _msg->count);
+    for (size_t i = 0; i < _msg->count; i++) {
+        data = mp_put_double(data, _msg->value[i]);
+    }
+    flatbuffers_uint8_vec_ref_t data_vec = flatbuffers_uint8_vec_end(B);
+    if (_msg->type == NCodecSignalVectorTypeWrite) {
+        ns(ChannelMessage_message_SignalWrite_add(
+            B, ns(SignalWrite_create(B, data_vec))));
+    } else {
+        ns(ChannelMessage_message_SignalValue_add(
+            B, ns(SignalValue_create(B, data_vec))));
+    }
+    ns(ChannelMessage_end_as_root(B));
+
+    /* Each vector is a complete message, written directly to the stream. */
+    size_t   length = 0;
+    uint8_t* buffer = copy_stream_buffer(_nc, &length);
+    flatcc_builder_reset(B);
+    if (buffer == NULL) return -ENOMEM;
+    stream->write(nc, buffer, length);
+
+    return (int32_t)_msg->count;
+}
+
+
+static uint8_t* get_msg_from_stream(NCODEC* nc)
+{
+    ABCodecInstance*    _nc = (ABCodecInstance*)nc;
+    NCodecStreamVTable* stream = (NCodecStreamVTable*)_nc->c.stream;
+
+    /* Next message? */
+    uint8_t* buffer;
+    size_t   length;
+    stream->read(nc, &buffer, &length, NCODEC_POS_NC);
+
+    uint8_t*       msg_ptr = buffer;
+    uint8_t* const buffer_ptr = buffer;
+    while ((size_t)(msg_ptr - buffer_ptr) < length) {
+        /* Messages start with a size prefix. */
+        size_t msg_len = 0;
+        msg_ptr = flatbuffers_read_size_prefix(msg_ptr, &msg_len);
+        if (msg_len == 0) break;
+        /* Advance the stream pos (+4 for size prefix). */
+        stream->seek(nc, msg_len + 4, NCODEC_SEEK_CUR);
+        if (flatbuffers_has_identifier(msg_ptr, flatbuffers_identifier)) {
+            return msg_ptr;
+        }
+        /* Next message in the stream. */
+        msg_ptr += msg_len;
+    }
+
+    /* No message in stream. */
+    stream->seek(nc, 0, NCODEC_SEEK_END);
+    return NULL;
+}
+
+
+typedef struct MpReader {
+    const uint8_t* p;
+    const uint8_t* end;
+} MpReader;
+
+static inline uint64_t mp_get_be(MpReader* r, size_t len, bool* ok)
+{
+    uint64_t v = 0;
+    if ((size_t)(r->end - r->p) < len) {
+        *ok = false;
+        return 0;
+    }
+    for (size_t i = 0; i < len; i++) {
+        v = (v << 8) | *r->p++;
+    }
+    return v;
+}
+
+static bool mp_get_array(MpReader* r, size_t* count)
+{
+    bool ok = true;
+    if (r->p >= r->end) return false;
+    uint8_t t = *r->p++;
+    if ((t & 0xf0) == 0x90) {
+        *count = t & 0x0f;
+    } else if (t == 0xdc) {
+        *count = (size_t)mp_get_be(r, 2, &ok);
+    } else if (t == 0xdd) {
+        *count = (size_t)mp_get_be(r, 4, &ok);
+    } else {
+        return false;
+    }
+    return ok;
+}
+
+/* Any MsgPack numeric type. */
+static bool mp_get_number(MpReader* r, double* v)
+{
+    bool ok = true;
+    if (r->p >= r->end) return false;
+    uint8_t t = *r->p++;
+    if (t <= 0x7f) {
+        *v = t; /* positive fixint */
+    } else if (t >= 0xe0) {
+        *v = (int8_t)t; /* negative fixint */
+    } else {
+        switch (t) {
+        case 0xcc:
+        case 0xcd:
+        case 0xce:
+        case 0xcf:
+            *v = (double)mp_get_be(r, (size_t)1 << (t - 0xcc), &ok);
+            break;
+        case 0xd0:
+            *v = (int8_t)mp_get_be(r, 1, &ok);
+            break;
+        case 0xd1:
+            *v = (int16_t)mp_get_be(r, 2, &ok);
+            break;
+        case 0xd2:
+            *v = (int32_t)mp_get_be(r, 4, &ok);
+            break;
+        case 0xd3:
+            *v = (double)(int64_t)mp_get_be(r, 8, &ok);
+            break;
+        case 0xca: {
+            uint32_t bits = (uint32_t)mp_get_be(r, 4, &ok);
+            float    f;
+            memcpy(&f, &bits, sizeof(f));
+            *v = f;
+            break;
+        }
+        case 0xcb: {
+            uint64_t bits = mp_get_be(r, 8, &ok);
+            memcpy(v, &bits, sizeof(*v));
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return ok;
+}
+
+/* Signal UID, an unsigned integer (uint32). */
+static bool mp_get_uid(MpReader* r, uint32_t* uid)
+{
+    double v;
+    if (mp_get_number(r, &v) == false) return false;
+    if (v < 0 || v > UINT32_MAX || v != (double)(uint32_t)v) return false;
+    *uid = (uint32_t)v;
+    return true;
+}
+
+static int decode_vector(ABCodecInstance* nc, flatbuffers_uint8_vec_t data,
+    NCodecSignalVector* msg)
+{
+    size_t   len = data ? flatbuffers_uint8_vec_len(data) : 0;
+    MpReader r = { data, data + len };
+    size_t   count = 0;
+    size_t   value_count = 0;
+    size_t   items = 0;
+    if (len == 0) goto done; /* Empty vector. */
+    if (mp_get_array(&r, &items) == false || items != 2) return -EBADMSG;
+    if (mp_get_array(&r, &count) == false) return -EBADMSG;
+    /* Each item is at least one byte. */
+    if (count > (size_t)(r.end - r.p)) return -EBADMSG;
+    if (count > nc->signal.capacity) {
+        uint32_t* uid = realloc(nc->signal.uid, count * sizeof(uint32_t));
+        if (uid == NULL) return -ENOMEM;
+        nc->signal.uid = uid;
+        double* value = realloc(nc->signal.value, count * sizeof(double));
+        if (value == NULL) return -ENOMEM;
+        nc->signal.value = value;
+        nc->signal.capacity = count;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (mp_get_uid(&r, &nc->signal.uid[i]) == false) return -EBADMSG;
+    }
+    if (mp_get_array(&r, &value_count) == false) return -EBADMSG;
+    if (value_count != count) return -EBADMSG;
+    for (size_t i = 0; i < count; i++) {
+        if (mp_get_number(&r, &nc->signal.value[i]) == false) return -EBADMSG;
+    }
+
+done:
+    msg->uid = nc->signal.uid;
+    msg->value = nc->signal.value;
+    msg->count = count;
+    return 0;
+}
+
+
+int32_t signal_read(NCODEC* nc, NCodecMessage* msg)
+{
+    ABCodecInstance*    _nc = (ABCodecInstance*)nc;
+    NCodecSignalVector* _msg = (NCodecSignalVector*)msg;
+    if (_nc == NULL) return -ENOSTR;
+    if (_msg == NULL) return -EINVAL;
+    if (_nc->c.stream == NULL) return -ENOSR;
+
+    /* Reset the message, in case caller ignores the return value. */
+    *_msg = (NCodecSignalVector){ 0 };
+
+    uint8_t* msg_ptr;
+    while ((msg_ptr = get_msg_from_stream(nc)) != NULL) {
+        ns(ChannelMessage_table_t) cm = ns(ChannelMessage_as_root(msg_ptr));
+
+        /* Filter: sender==receiver. */
+        uint32_t model_uid = ns(ChannelMessage_model_uid(cm));
+        if (_nc->model_uid && _nc->model_uid == model_uid && !_nc->loopback)
+            continue;
+
+        flatbuffers_uint8_vec_t data = NULL;
+        switch (ns(ChannelMessage_message_type(cm))) {
+        case ns(MessageType_SignalValue): {
+            ns(SignalValue_table_t) sv =
+                (ns(SignalValue_table_t))ns(ChannelMessage_message(cm));
+            data = ns(SignalValue_data(sv));
+            _msg->type = NCodecSignalVectorTypeValue;
+            break;
+        }
+        case ns(MessageType_SignalWrite): {
+            ns(SignalWrite_table_t) sw =
+                (ns(SignalWrite_table_t))ns(ChannelMessage_message(cm));
+            data = ns(SignalWrite_data(sw));
+            _msg->type = NCodecSignalVectorTypeWrite;
+            break;
+        }
+        default:
+            continue;
+        }
+
+        /* Return the vector. */
+        int rc = decode_vector(_nc, data, _msg);
+        if (rc) return rc;
+        _msg->sender.model_uid = model_uid;
+        return (int32_t)_msg->count;
+    }
+
+    return -ENOMSG;
+}
+
+
+int32_t signal_flush(NCODEC* nc)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    if (_nc == NULL) return -ENOSTR;
+    if (_nc->c.stream == NULL) return -ENOSR;
+
+    /* Vectors are written to the stream by signal_write(). */
+    return 0;
+}
+
+
+int32_t signal_truncate(NCODEC* nc)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    if (_nc == NULL) return -ENOSTR;
+    if (_nc->c.stream == NULL) return -ENOSR;
+    NCodecStreamVTable* stream = (NCodecStreamVTable*)_nc->c.stream;
+
+    stream->seek(nc, 0, NCODEC_SEEK_RESET);
+
+    return 0;
+}
@@ -0,0 +1,712 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dse/clib/collections/vector.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/simbus.h>
+#include <dse/ncodec/schema/abs/stream/pdu_reader.h>
+
+
+#undef ns
+#define ns(x) FLATBUFFERS_WRAP_NAMESPACE(AutomotiveBus_Stream_Pdu, x)
+
+#define SIMBUS_BUFFER_INIT 1024
+
+
+/* A published message (size prefixed), located in SimBusBuffer.data. */
+typedef struct SimBusMessage {
+    size_t   offset;
+    size_t   len;      /* Including the size prefix. */
+    size_t   id_first; /* Index of the first PDU id (SimBusBuffer.ids). */
+    size_t   id_count; /* 0 = not a PDU Stream, delivered to all. */
+} SimBusMessage;
+
+typedef struct SimBusBuffer {
+    uint8_t* data;
+    size_t   len;
+    size_t   capacity;
+    Vector   msgs; /* SimBusMessage */
+    Vector   ids;  /* uint32_t, PDU ids of each message (sorted). */
+} SimBusBuffer;
+
+typedef struct SimBusRef {
+    const uint8_t* data;
+    size_t         len;
+} SimBusRef;
+
+typedef struct SimBusSubscription {
+    uint32_t bus_id;
+    uint32_t id_first;
+    uint32_t id_last;
+} SimBusSubscription;
+
+/* Subscriber index, built when the subscriptions change. The id space of
+each bus is divided into segments (not overlapping) with the streams which
+are subscribed to all ids of the segment. */
+typedef struct SimBusRoute {
+    uint32_t bus_id;
+    size_t   stream_first; /* SimBusIndex.streams, all subscribers. */
+    size_t   stream_count;
+    size_t   segment_first; /* SimBusIndex.segments (sorted by id). */
+    size_t   segment_count;
+} SimBusRoute;
+
+typedef struct SimBusSegment {
+    uint32_t id_first;
+    uint32_t id_last;
+    size_t   stream_first; /* SimBusIndex.streams. */
+    size_t   stream_count;
+} SimBusSegment;
+
+typedef struct SimBusIndex {
+    bool   valid;
+    Vector routes;   /* SimBusRoute, sorted by bus_id. */
+    Vector segments; /* SimBusSegment */
+    Vector streams;  /* SimBusStream* */
+} SimBusIndex;
+
+/* Extension of the NCodecStreamVTable type. */
+typedef struct SimBusStream {
+    NCodecStreamVTable s;
+
+    NCodecSimBus* bus;
+    uint32_t      bus_id;
+    Vector        subscriptions; /* SimBusSubscription */
+    uint64_t      mark;          /* Last message delivered (NCodecSimBus). */
+
+    /* Messages written by the codec during the step (tx), and those
+    published by the last SimBus step (pub, referenced by other streams). */
+    SimBusBuffer tx;
+    SimBusBuffer pub;
+
+    /* Messages delivered to this stream, read position over all refs. */
+    struct {
+        Vector refs; /* SimBusRef */
+        size_t len;
+        size_t idx;
+        size_t offset;
+        size_t pos;
+    } rx;
+} SimBusStream;
+
+typedef struct NCodecSimBus {
+    Vector      streams;  /* SimBusStream* */
+    Vector      released; /* SimBusBuffer, of closed streams (referenced). */
+    SimBusIndex index;
+    uint64_t    mark; /* Current message of the step (delivered once). */
+} NCodecSimBus;
+
+/* Build the index: a subscription with its stream. */
+typedef struct SimBusSubscriber {
+    SimBusSubscription sub;
+    SimBusStream*      stream;
+} SimBusSubscriber;
+
+
+static int _compare_id(const void* a, const void* b)
+{
+    uint32_t l = *(const uint32_t*)a;
+    uint32_t r = *(const uint32_t*)b;
+    return (l > r) - (l < r);
+}
+
+static void _buffer_release(SimBusBuffer* b)
+{
+    free(b->data);
+    vector_reset(&b->msgs);
+    vector_reset(&b->ids);
+    *b = (SimBusBuffer){ 0 };
+}
+
+/* Index the messages of a published buffer, and the PDU ids of each PDU
+Stream message. */
+static void _buffer_index(SimBusBuffer* b)
+{
+    if (b->msgs.capacity == 0) {
+        b->msgs = vector_make(sizeof(SimBusMessage), 4, NULL);
+        b->ids = vector_make(sizeof(uint32_t), 64, NULL);
+    }
+    vector_clear(&b->msgs, NULL, NULL);
+    vector_clear(&b->ids, NULL, NULL);
+
+    size_t offset = 0;
+    while (offset + sizeof(uint32_t) <= b->len) {
+        size_t   msg_len = 0;
+        uint8_t* msg_ptr =
+            flatbuffers_read_size_prefix(b->data + offset, &msg_len);
+        if (msg_len == 0 || offset + msg_len + 4 > b->len) break;
+
+        SimBusMessage m = { .offset = offset,
+            .len = msg_len + 4,
+            .id_first = vector_len(&b->ids) };
+        if (flatbuffers_has_identifier(msg_ptr, flatbuffers_identifier)) {
+            ns(Stream_table_t) stream = ns(Stream_as_root(msg_ptr));
+            ns(Pdu_vec_t) pdus = ns(Stream_pdus(stream));
+            size_t count = ns(Pdu_vec_len(pdus));
+            for (size_t i = 0; i < count; i++) {
+                uint32_t id = ns(Pdu_id(ns(Pdu_vec_at(pdus, i))));
+                vector_push(&b->ids, &id);
+            }
+            m.id_count = count;
+            uint32_t* ids = (uint32_t*)b->ids.items + m.id_first;
+            if (count > 1) qsort(ids, count, sizeof(uint32_t), _compare_id);
+            /* An empty PDU Stream is not delivered. */
+            if (count == 0) {
+                offset += m.len;
+                continue;
+            }
+        }
+        vector_push(&b->msgs, &m);
+        offset += m.len;
+    }
+}
+
+
+static int _compare_subscriber(const void* a, const void* b)
+{
+    uint32_t l = ((const SimBusSubscriber*)a)->sub.bus_id;
+    uint32_t r = ((const SimBusSubscriber*)b)->sub.bus_id;
+    return (l > r) - (l < r);
+}
+
+static int _compare_bound(const void* a, const void* b)
+{
+    uint64_t l = *(const uint64_t*)a;
+    uint64_t r = *(const uint64_t*)b;
+    return (l > r) - (l < r);
+}
+
+/* Append a stream to the streams of a route or segment (once). */
+static void _index_push_stream(SimBusIndex* idx, size_t first, SimBusStream* s)
+{
+    SimBusStream** streams = idx->streams.items;
+    for (size_t i = first; i < vector_len(&idx->streams); i++) {
+        if (streams[i] == s) return;
+    }
+    vector_push(&idx->streams, &s);
+}
+
+static void _index_build(NCodecSimBus* bus)
+{
+    SimBusIndex* idx = &bus->index;
+    vector_clear(&idx->routes, NULL, NULL);
+    vector_clear(&idx->segments, NULL, NULL);
+    vector_clear(&idx->streams, NULL, NULL);
+
+    /* Collect the subscriptions, a stream without a subscription receives
+    all messages of its own bus. */
+    Vector subs = vector_make(sizeof(SimBusSubscriber), 0, _compare_subscriber);
+    Vector bounds = vector_make(sizeof(uint64_t), 0, _compare_bound);
+    for (size_t i = 0; i < vector_len(&bus->streams); i++) {
+        SimBusStream* s = NULL;
+        vector_at(&bus->streams, i, &s);
+        if (vector_len(&s->subscriptions) == 0) {
+            vector_push(&subs, &(SimBusSubscriber){
+                .sub = { s->bus_id, 0, UINT32_MAX }, .stream = s });
+        }
+        for (size_t j = 0; j < vector_len(&s->subscriptions); j++) {
+            SimBusSubscriber item = { .stream = s };
+            vector_at(&s->subscriptions, j, &item.sub);
+            vector_push(&subs, &item);
+        }
+    }
+    vector_sort(&subs);
+
+    /* Routes (one per bus) and their segments. */
+    SimBusSubscriber* items = subs.items;
+    size_t            count = vector_len(&subs);
+    for (size_t g = 0; g < count;) {
+        size_t end = g;
+        while (end < count && items[end].sub.bus_id == items[g].sub.bus_id)
+            end++;
+        SimBusRoute r = { .bus_id = items[g].sub.bus_id,
+            .stream_first = vector_len(&idx->streams),
+            .segment_first = vector_len(&idx->segments) };
+        vector_clear(&bounds, NULL, NULL);
+        for (size_t i = g; i < end; i++) {
+            uint64_t first = items[i].sub.id_first;
+            uint64_t next = (uint64_t)items[i].sub.id_last + 1;
+            vector_push(&bounds, &first);
+            vector_push(&bounds, &next);
+            _index_push_stream(idx, r.stream_first, items[i].stream);
+        }
+        r.stream_count = vector_len(&idx->streams) - r.stream_first;
+        vector_sort(&bounds);
+        uint64_t* bound = bounds.items;
+        for (size_t k = 0; k + 1 < vector_len(&bounds); k++) {
+            if (bound[k] == bound[k + 1]) continue;
+            SimBusSegment seg = { .id_first = (uint32_t)bound[k],
+                .id_last = (uint32_t)(bound[k + 1] - 1),
+                .stream_first = vector_len(&idx->streams) };
+            for (size_t i = g; i < end; i++) {
+                if (items[i].sub.id_first > seg.id_first) continue;
+                if (items[i].sub.id_last < seg.id_last) continue;
+                _index_push_stream(idx, seg.stream_first, items[i].stream);
+            }
+            seg.stream_count = vector_len(&idx->streams) - seg.stream_first;
+            if (seg.stream_count) vector_push(&idx->segments, &seg);
+        }
+        r.segment_count = vector_len(&idx->segments) - r.segment_first;
+        vector_push(&idx->routes, &r);
+        g = end;
+    }
+    vector_reset(&subs);
+    vector_reset(&bounds);
+    idx->valid = true;
+}
+
+static SimBusRoute* _index_route(SimBusIndex* idx, uint32_t bus_id)
+{
+    SimBusRoute* routes = idx->routes.items;
+    size_t       lo = 0;
+    size_t       hi = vector_len(&idx->routes);
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (routes[mid].bus_id < bus_id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < vector_len(&idx->routes) && routes[lo].bus_id == bus_id) {
+        return &routes[lo];
+    }
+    return NULL;
+}
+
+/* First index in ids[lo..hi) with ids[i] >= id (ids are sorted). */
+static size_t _lower_bound(
+    const uint32_t* ids, size_t lo, size_t hi, uint64_t id)
+{
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (ids[mid] < id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void _deliver(NCodecSimBus* bus, SimBusStream* s, SimBusRef* ref)
+{
+    if (s->mark == bus->mark) return; /* Already delivered. */
+    s->mark = bus->mark;
+    vector_push(&s->rx.refs, ref);
+    s->rx.len += ref->len;
+}
+
+/* Deliver a message to the subscribers of its route. Only the segments which
+contain an id of the message are visited. */
+static void _route_message(NCodecSimBus* bus, SimBusRoute* r, SimBusBuffer* b,
+    SimBusMessage* m, SimBusRef* ref)
+{
+    SimBusStream** streams = bus->index.streams.items;
+    bus->mark++;
+    if (m->id_count == 0) {
+        for (size_t i = 0; i < r->stream_count; i++) {
+            _deliver(bus, streams[r->stream_first + i], ref);
+        }
+        return;
+    }
+
+    const uint32_t* ids = (uint32_t*)b->ids.items + m->id_first;
+    SimBusSegment*  seg =
+        (SimBusSegment*)bus->index.segments.items + r->segment_first;
+    size_t seg_lo = 0;
+    size_t i = 0;
+    while (i < m->id_count) {
+        /* First segment with id_last >= ids[i]. */
+        size_t lo = seg_lo;
+        size_t hi = r->segment_count;
+        while (lo < hi) {
+            size_t mid = (lo + hi) / 2;
+            if (seg[mid].id_last < ids[i]) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo == r->segment_count) break;
+        seg_lo = lo;
+        if (seg[lo].id_first > ids[i]) {
+            i = _lower_bound(ids, i, m->id_count, seg[lo].id_first);
+            continue;
+        }
+        for (size_t k = 0; k < seg[lo].stream_count; k++) {
+            _deliver(bus, streams[seg[lo].stream_first + k], ref);
+        }
+        i = _lower_bound(ids, i, m->id_count, (uint64_t)seg[lo].id_last + 1);
+        seg_lo = lo + 1;
+    }
+}
+
+
+static void _rx_reset(SimBusStream* s)
+{
+    vector_clear(&s->rx.refs, NULL, NULL);
+    s->rx.len = s->rx.idx = s->rx.offset = s->rx.pos = 0;
+}
+
+/* Move the read position forward (to the end of the rx refs). */
+static void _rx_advance(SimBusStream* s, size_t n)
+{
+    size_t count = vector_len(&s->rx.refs);
+    while (n && s->rx.idx < count) {
+        SimBusRef* r = vector_at(&s->rx.refs, s->rx.idx, NULL);
+        size_t     remaining = r->len - s->rx.offset;
+        if (n < remaining) {
+            s->rx.offset += n;
+            s->rx.pos += n;
+            return;
+        }
+        n -= remaining;
+        s->rx.pos += remaining;
+        s->rx.idx++;
+        s->rx.offset = 0;
+    }
+}
+
+
+static size_t simbus_read(
+    NCODEC* nc, uint8_t** data, size_t* len, int32_t pos_op)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc == NULL || _nc->stream == NULL) return -ENOSTR;
+    if (data == NULL || len == NULL) return -EINVAL;
+
+    /* Return the current message reference, from current pos. */
+    SimBusStream* s = (SimBusStream*)_nc->stream;
+    if (s->rx.idx >= vector_len(&s->rx.refs)) {
+        *data = NULL;
+        *len = 0;
+        return 0;
+    }
+    SimBusRef* r = vector_at(&s->rx.refs, s->rx.idx, NULL);
+    *data = (uint8_t*)r->data + s->rx.offset;
+    *len = r->len - s->rx.offset;
+    if (pos_op == NCODEC_POS_UPDATE) _rx_advance(s, *len);
+
+    return *len;
+}
+
+static size_t simbus_write(NCODEC* nc, uint8_t* data, size_t len)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc == NULL || _nc->stream == NULL) return -ENOSTR;
+
+    /* Append to the tx buffer, published by the next SimBus step. */
+    SimBusStream* s = (SimBusStream*)_nc->stream;
+    if (s->tx.len + len > s->tx.capacity) {
+        size_t capacity = s->tx.capacity ? s->tx.capacity : SIMBUS_BUFFER_INIT;
+        while (capacity < s->tx.len + len)
+            capacity *= 2;
+        uint8_t* buffer = realloc(s->tx.data, capacity);
+        if (buffer == NULL) return -ENOMEM;
+        s->tx.data = buffer;
+        s->tx.capacity = capacity;
+    }
+    memcpy(s->tx.data + s->tx.len, data, len);
+    s->tx.len += len;
+    return len;
+}
+
+static int64_t simbus_seek(NCODEC* nc, size_t pos, int32_t op)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc == NULL || _nc->stream == NULL) return -ENOSTR;
+
+    SimBusStream* s = (SimBusStream*)_nc->stream;
+    switch (op) {
+    case NCODEC_SEEK_SET:
+        s->rx.idx = s->rx.offset = s->rx.pos = 0;
+        _rx_advance(s, pos);
+        break;
+    case NCODEC_SEEK_CUR:
+        _rx_advance(s, pos);
+        break;
+    case NCODEC_SEEK_END:
+        s->rx.idx = vector_len(&s->rx.refs);
+        s->rx.offset = 0;
+        s->rx.pos = s->rx.len;
+        break;
+    case NCODEC_SEEK_RESET:
+        /* Messages of this step are consumed, start a new tx buffer. */
+        _rx_reset(s);
+        s->tx.len = 0;
+        break;
+    default:
+        return -EINVAL;
+    }
+    return s->rx.pos;
+}
+
+static int64_t simbus_tell(NCODEC* nc)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc == NULL || _nc->stream == NULL) return -ENOSTR;
+    SimBusStream* s = (SimBusStream*)_nc->stream;
+    return s->rx.pos;
+}
+
+static int32_t simbus_eof(NCODEC* nc)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc && _nc->stream) {
+        SimBusStream* s = (SimBusStream*)_nc->stream;
+        if (s->rx.idx < vector_len(&s->rx.refs)) return 0;
+    }
+    return 1;
+}
+
+static int32_t simbus_close(NCODEC* nc)
+{
+    NCodecInstance* _nc = (NCodecInstance*)nc;
+    if (_nc == NULL || _nc->stream == NULL) return -ENOSTR;
+
+    SimBusStream* s = (SimBusStream*)_nc->stream;
+    if (s->bus) {
+        NCodecSimBus* bus = s->bus;
+        for (size_t i = 0; i < vector_len(&bus->streams); i++) {
+            SimBusStream* item = NULL;
+            vector_at(&bus->streams, i, &item);
+            if (item == s) {
+                vector_delete_at(&bus->streams, i);
+                break;
+            }
+        }
+        bus->index.valid = false;
+        /* Published messages may still be referenced by other streams. */
+        vector_push(&bus->released, &s->pub);
+        s->pub = (SimBusBuffer){ 0 };
+    }
+    _buffer_release(&s->tx);
+    _buffer_release(&s->pub);
+    vector_reset(&s->rx.refs);
+    vector_reset(&s->subscriptions);
+    free(s);
+    _nc->stream = NULL;
+    return 0;
+}
+
+
+/**
+ncodec_simbus_create
+====================
+
+Create an in-process SimBus.
+
+Returns
+-------
+NCodecSimBus (pointer)
+: The SimBus object, or NULL on failure.
+*/
+NCodecSimBus* ncodec_simbus_create(void)
+{
+    NCodecSimBus* bus = calloc(1, sizeof(NCodecSimBus));
+    if (bus == NULL) return NULL;
+    bus->streams = vector_make(sizeof(SimBusStream*), 8, NULL);
+    bus->released = vector_make(sizeof(SimBusBuffer), 0, NULL);
+    bus->index.routes = vector_make(sizeof(SimBusRoute), 0, NULL);
+    bus->index.segments = vector_make(sizeof(SimBusSegment), 0, NULL);
+    bus->index.streams = vector_make(sizeof(SimBusStream*), 0, NULL);
+    return bus;
+}
+
+
+/**
+ncodec_simbus_stream_create
+===========================
+
+Create a SimBus stream for a node, use with `ncodec_open()`. The stream is
+released by `ncodec_close()`.
+
+Parameters
+----------
+bus (NCodecSimBus*)
+: The SimBus object.
+
+bus_id (uint32_t)
+: The bus of the node, messages written by the node are published on this
+  bus.
+
+Returns
+-------
+NSTREAM (pointer)
+: The stream object, or NULL on failure.
+*/
+NSTREAM* ncodec_simbus_stream_create(NCodecSimBus* bus, uint32_t bus_id)
+{
+    if (bus == NULL) return NULL;
+    SimBusStream* s = calloc(1, sizeof(SimBusStream));
+    if (s == NULL) return NULL;
+    *s = (SimBusStream){
+        .s =
+            (struct NCodecStreamVTable){
+                .read = simbus_read,
+                .write = simbus_write,
+                .seek = simbus_seek,
+                .tell = simbus_tell,
+                .eof = simbus_eof,
+                .close = simbus_close,
+            },
+        .bus = bus,
+        .bus_id = bus_id,
+        .subscriptions = vector_make(sizeof(SimBusSubscription), 0, NULL),
+        .rx.refs = vector_make(sizeof(SimBusRef), 8, NULL),
+    };
+    vector_push(&bus->streams, &s);
+    bus->index.valid = false;
+    return (NSTREAM*)s;
+}
+
+
+/**
+ncodec_simbus_subscribe
+=======================
+
+Subscribe a SimBus stream to the PDUs of a bus. A message is delivered to the
+stream when it contains a PDU with an id in the range of a subscription
+(messages which are not PDU Streams are delivered to all subscribers of the
+bus). Subscriptions are indexed by the following call to
+`ncodec_simbus_step()`.
+
+Parameters
+----------
+stream (NSTREAM*)
+: A SimBus stream.
+
+bus_id (uint32_t)
+: The bus.
+
+id_first (uint32_t)
+: The first PDU id of the range.
+
+id_last (uint32_t)
+: The last PDU id of the range (inclusive), use UINT32_MAX for all PDUs.
+
+Returns
+-------
+0
+: The subscription was added.
+
+-EINVAL
+: Invalid parameters.
+*/
+int32_t ncodec_simbus_subscribe(
+    NSTREAM* stream, uint32_t bus_id, uint32_t id_first, uint32_t id_last)
+{
+    SimBusStream* s = (SimBusStream*)stream;
+    if (s == NULL || s->s.read != simbus_read) return -EINVAL;
+    if (id_first > id_last) return -EINVAL;
+
+    vector_push(&s->subscriptions,
+        &(SimBusSubscription){
+            .bus_id = bus_id, .id_first = id_first, .id_last = id_last });
+    if (s->bus) s->bus->index.valid = false;
+    return 0;
+}
+
+
+/**
+ncodec_simbus_step
+==================
+
+Publish the messages written by each node since the previous step and
+deliver them, by reference, to the subscribed nodes. Messages delivered by
+the previous step are released. Subscribers are located with an index (by
+bus and PDU id range), the cost of a step is proportional to the number of
+messages and deliveries rather than the number of nodes.
+
+Parameters
+----------
+bus (NCodecSimBus*)
+: The SimBus object.
+
+Returns
+-------
+0
+: The step completed.
+
+-EINVAL
+: Invalid parameters.
+*/
+int32_t ncodec_simbus_step(NCodecSimBus* bus)
+{
+    if (bus == NULL) return -EINVAL;
+    size_t count = vector_len(&bus->streams);
+    SimBusStream** streams = bus->streams.items;
+
+    /* Release the buffers of closed streams, and reset all rx refs. */
+    for (size_t i = 0; i < vector_len(&bus->released); i++) {
+        _buffer_release(vector_at(&bus->released, i, NULL));
+    }
+    vector_clear(&bus->released, NULL, NULL);
+    for (size_t i = 0; i < count; i++) {
+        _rx_reset(streams[i]);
+    }
+
+    /* Publish: swap the tx and pub buffers (both are retained). */
+    for (size_t i = 0; i < count; i++) {
+        SimBusStream* s = streams[i];
+        SimBusBuffer  b = s->pub;
+        s->pub = s->tx;
+        s->tx = b;
+        s->tx.len = 0;
+        _buffer_index(&s->pub);
+    }
+
+    /* Deliver references to the subscribed streams. */
+    if (bus->index.valid == false) _index_build(bus);
+    for (size_t p = 0; p < count; p++) {
+        SimBusStream* pub = streams[p];
+        SimBusRoute*  r = _index_route(&bus->index, pub->bus_id);
+        if (r == NULL) continue;
+        for (size_t m = 0; m < vector_len(&pub->pub.msgs); m++) {
+            SimBusMessage* msg = vector_at(&pub->pub.msgs, m, NULL);
+            SimBusRef      ref = { pub->pub.data + msg->offset, msg->len };
+            _route_message(bus, r, &pub->pub, msg, &ref);
+        }
+    }
+    return 0;
+}
+
+
+/**
+ncodec_simbus_destroy
+=====================
+
+Destroy a SimBus object. Streams which are still open are detached (they
+are released by `ncodec_close()`).
+
+Parameters
+----------
+bus (NCodecSimBus*)
+: The SimBus object.
+*/
+void ncodec_simbus_destroy(NCodecSimBus* bus)
+{
+    if (bus == NULL) return;
+    for (size_t i = 0; i < vector_len(&bus->streams); i++) {
+        SimBusStream* s = NULL;
+        vector_at(&bus->streams, i, &s);
+        s->bus = NULL;
+        _rx_reset(s);
+    }
+    for (size_t i = 0; i < vector_len(&bus->released); i++) {
+        _buffer_release(vector_at(&bus->released, i, NULL));
+    }
+    vector_reset(&bus->released);
+    vector_reset(&bus->streams);
+    vector_reset(&bus->index.routes);
+    vector_reset(&bus->index.segments);
+    vector_reset(&bus->index.streams);
+    free(bus);
+}
@@ -0,0 +1,63 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DSE_NCODEC_CODEC_AB_SIMBUS_H_
+#define DSE_NCODEC_CODEC_AB_SIMBUS_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <dse/ncodec/codec.h>
+
+
+/**
+In-process SimBus
+=================
+
+Connects several AB Codec instances (nodes) of one process. Each node opens
+its codec on a SimBus stream. The messages written (flushed) by a node
+during a step are published by `ncodec_simbus_step()` and delivered by
+reference to the streams of all subscribed nodes, where they are read with
+`ncodec_read()` in the following step. Messages are not copied, the
+published buffers remain valid until the next call to
+`ncodec_simbus_step()`.
+
+A node subscribes to a bus (the `bus_id` of the publishing stream) and
+optionally to a range of PDU ids. Only messages containing a PDU in one of
+its ranges are delivered to the node. A node without a subscription
+receives all messages of its own bus (including its own messages).
+
+Example
+-------
+
+    #include <dse/ncodec/codec/ab/simbus.h>
+
+    NCodecSimBus* bus = ncodec_simbus_create();
+    for (size_t i = 0; i < count; i++) {
+        NSTREAM* stream = ncodec_simbus_stream_create(bus, 1);
+        ncodec_simbus_subscribe(stream, 1, 0x100, 0x1ff);
+        node[i].nc = ncodec_open(node[i].mimetype, stream);
+    }
+    while (running) {
+        for (size_t i = 0; i < count; i++) step(&node[i]);
+        ncodec_simbus_step(bus);
+    }
+    for (size_t i = 0; i < count; i++) ncodec_close(node[i].nc);
+    ncodec_simbus_destroy(bus);
+*/
+
+
+typedef struct NCodecSimBus NCodecSimBus;
+
+
+/* codec/ab/simbus.c */
+DLL_PUBLIC NCodecSimBus* ncodec_simbus_create(void);
+DLL_PUBLIC NSTREAM*      ncodec_simbus_stream_create(
+    NCodecSimBus* bus, uint32_t bus_id);
+DLL_PUBLIC int32_t       ncodec_simbus_subscribe(
+    NSTREAM* stream, uint32_t bus_id, uint32_t id_first, uint32_t id_last);
+DLL_PUBLIC int32_t       ncodec_simbus_step(NCodecSimBus* bus);
+DLL_PUBLIC void          ncodec_simbus_destroy(NCodecSimBus* bus);
+
+
+#endif  // DSE_NCODEC_CODEC_AB_SIMBUS_H_
@@ -0,0 +1,263 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+
+
+#define SNAPSHOT_MAGIC   0x4e534241 /* "ABSN" */
+#define SNAPSHOT_VERSION 1
+
+
+extern void    pdu_step_sync(ABCodecInstance* nc);
+extern void    pdu_step_reset(ABCodecInstance* nc);
+extern int32_t pdu_truncate(NCODEC* nc);
+extern void    _reader_reset(ABCodecReader* reader);
+
+
+/* The snapshot is a sequence of raw objects and is only valid for codec
+objects of the same build (the header holds a layout guard). */
+typedef struct ABCodecSnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t layout; /* sizeof(ABCodecInstance) */
+    uint32_t model;  /* Bus Models (states follow the codec state). */
+} ABCodecSnapshotHeader;
+
+
+int snapshot_write(ABCodecSnapshot* s, const void* data, size_t len)
+{
+    if (s->length + len > s->capacity) {
+        size_t capacity = s->capacity ? s->capacity : 1024;
+        while (capacity < s->length + len)
+            capacity *= 2;
+        uint8_t* _data = realloc(s->data, capacity);
+        if (_data == NULL) return -ENOMEM;
+        s->data = _data;
+        s->capacity = capacity;
+    }
+    if (len) memcpy(s->data + s->length, data, len);
+    s->length += len;
+    return 0;
+}
+
+
+const void* snapshot_ref(ABCodecSnapshot* s, size_t len)
+{
+    if (len > s->length - s->pos) return NULL;
+    const void* ref = s->data + s->pos;
+    s->pos += len;
+    return ref;
+}
+
+
+int snapshot_read(ABCodecSnapshot* s, void* data, size_t len)
+{
+    const void* ref = snapshot_ref(s, len);
+    if (ref == NULL) return -EINVAL;
+    if (len) memcpy(data, ref, len);
+    return 0;
+}
+
+
+int snapshot_write_vector(ABCodecSnapshot* s, Vector* v, size_t item_size)
+{
+    uint32_t count = vector_len(v);
+    int      rc = snapshot_write(s, &count, sizeof(count));
+    for (uint32_t i = 0; rc == 0 && i < count; i++) {
+        rc = snapshot_write(s, vector_at(v, i, NULL), item_size);
+    }
+    return rc;
+}
+
+
+int snapshot_read_vector(
+    ABCodecSnapshot* s, Vector* v, size_t item_size, VectorCompar compar)
+{
+    uint32_t count;
+    if (snapshot_read(s, &count, sizeof(count))) return -EINVAL;
+    if ((size_t)count * item_size > s->length - s->pos) return -EINVAL;
+
+    /* Items are pushed in their original (sorted) order. */
+    *v = vector_make(item_size, count, compar);
+    for (uint32_t i = 0; i < count; i++) {
+        vector_push(v, (void*)snapshot_ref(s, item_size));
+    }
+    return 0;
+}
+
+
+/* Bus Models of the codec: the primary Bus Model and any networks
+(multi-bus), returned in snapshot order. */
+static ABCodecBusModel* _bus_model_at(ABCodecInstance* nc, size_t index)
+{
+    if (index == 0) return &nc->reader.bus_model;
+    return &nc->reader.networks[index - 1];
+}
+
+static uint32_t _bus_model_count(ABCodecInstance* nc)
+{
+    if (nc->reader.bus_model.model == NULL) return 0;
+    return 1 + nc->reader.network_count;
+}
+
+
+/* Restore the first count Bus Models from a snapshot of their previous
+state (a failed restore of a following Bus Model). */
+static void _bus_model_rollback(
+    ABCodecInstance* nc, ABCodecSnapshot* backup, uint32_t count)
+{
+    backup->pos = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        ABCodecBusModel* bm = _bus_model_at(nc, i);
+        if (bm->vtable.restore(bm, backup) != 0) {
+            log_error(nc, "Snapshot: Bus Model rollback failed (%u)", i);
+            return;
+        }
+    }
+}
+
+
+int32_t pdu_snapshot(NCODEC* nc, void** data, size_t* len)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    if (_nc == NULL) return -ENOSTR;
+    if (data == NULL || len == NULL) return -EINVAL;
+    pdu_step_sync(_nc);
+
+    /* Only at a step boundary: no pending writes, no partial read. */
+    if (_nc->fbs_stream_initalized || _nc->chunk.length) return -EBUSY;
+    if (_nc->reader.state.nc != NULL) return -EBUSY;
+    if (_nc->step.ready && _nc->step.pdu_idx < _nc->step.pdu_list.length) {
+        return -EBUSY;
+    }
+
+    ABCodecBusModel* bm = &_nc->reader.bus_model;
+    uint32_t         model_count = _bus_model_count(_nc);
+    for (uint32_t i = 0; i < model_count; i++) {
+        if (_bus_model_at(_nc, i)->vtable.snapshot == NULL) return -ENOSYS;
+    }
+
+    ABCodecSnapshot       s = { 0 };
+    ABCodecSnapshotHeader header = {
+        .magic = SNAPSHOT_MAGIC,
+        .version = SNAPSHOT_VERSION,
+        .layout = sizeof(ABCodecInstance),
+        .model = model_count,
+    };
+    int rc = 0;
+    rc |= snapshot_write(&s, &header, sizeof(header));
+    rc |= snapshot_write(&s, &_nc->reader.stage, sizeof(_nc->reader.stage));
+    rc |= snapshot_write(
+        &s, &_nc->simulation_time, sizeof(_nc->simulation_time));
+    if (header.model) {
+        rc |= snapshot_write(
+            &s, &bm->simulation_time, sizeof(bm->simulation_time));
+        rc |= snapshot_write(&s, &bm->step_size, sizeof(bm->step_size));
+        for (uint32_t i = 0; rc == 0 && i < model_count; i++) {
+            ABCodecBusModel* _bm = _bus_model_at(_nc, i);
+            rc = _bm->vtable.snapshot(_bm, &s);
+        }
+    }
+    if (rc != 0) {
+        free(s.data);
+        return rc;
+    }
+
+    *data = s.data;
+    *len = s.length;
+    return 0;
+}
+
+
+int32_t pdu_restore(NCODEC* nc, const void* data, size_t len)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    if (_nc == NULL) return -ENOSTR;
+    if (data == NULL) return -EINVAL;
+    pdu_step_sync(_nc);
+
+    ABCodecBusModel*      bm = &_nc->reader.bus_model;
+    ABCodecSnapshot       s = { .data = (uint8_t*)data, .length = len };
+    ABCodecSnapshotHeader header;
+    if (snapshot_read(&s, &header, sizeof(header))) return -EINVAL;
+    if (header.magic != SNAPSHOT_MAGIC) return -EINVAL;
+    if (header.version != SNAPSHOT_VERSION) return -EINVAL;
+    if (header.layout != sizeof(ABCodecInstance)) return -EINVAL;
+    if (header.model != _bus_model_count(_nc)) {
+        log_error(nc, "Snapshot: Bus Model does not match");
+        return -EINVAL;
+    }
+    for (uint32_t i = 0; i < header.model; i++) {
+        if (_bus_model_at(_nc, i)->vtable.restore == NULL) return -ENOSYS;
+    }
+
+    /* Locate the codec state, applied after the Bus Model is restored. */
+    const void* stage = snapshot_ref(&s, sizeof(_nc->reader.stage));
+    const void* sim_time = snapshot_ref(&s, sizeof(_nc->simulation_time));
+    const void* bm_time = NULL;
+    if (stage == NULL || sim_time == NULL) return -EINVAL;
+    if (header.model) {
+        bm_time = snapshot_ref(&s, sizeof(bm->simulation_time) +
+                                       sizeof(bm->step_size));
+        if (bm_time == NULL) return -EINVAL;
+        /* Each Bus Model restore is complete, or has no effect. Multi-bus,
+        the Bus Models restored before a failed restore are rolled back. */
+        ABCodecSnapshot backup = { 0 };
+        for (uint32_t i = 0; i + 1 < header.model; i++) {
+            ABCodecBusModel* _bm = _bus_model_at(_nc, i);
+            int              rc = -ENOSYS;
+            if (_bm->vtable.snapshot) rc = _bm->vtable.snapshot(_bm, &backup);
+            if (rc != 0) {
+                free(backup.data);
+                return rc;
+            }
+        }
+        for (uint32_t i = 0; i < header.model; i++) {
+            ABCodecBusModel* _bm = _bus_model_at(_nc, i);
+            int              rc = _bm->vtable.restore(_bm, &s);
+            if (rc != 0) {
+                _bus_model_rollback(_nc, &backup, i);
+                free(backup.data);
+                return rc;
+            }
+        }
+        free(backup.data);
+    }
+    if (s.pos != s.length) {
+        log_error(nc, "Snapshot: unexpected data (%u bytes)", s.length - s.pos);
+        return -EINVAL;
+    }
+
+    /* Discard any pending messages. */
+    if (_nc->c.stream) {
+        pdu_truncate(nc);
+    } else {
+        pdu_step_reset(_nc);
+        _reader_reset(&_nc->reader);
+    }
+
+    /* Apply the codec state. */
+    memcpy(&_nc->reader.stage, stage, sizeof(_nc->reader.stage));
+    memcpy(&_nc->simulation_time, sim_time, sizeof(_nc->simulation_time));
+    if (header.model) {
+        memcpy(&bm->simulation_time, bm_time, sizeof(bm->simulation_time));
+        memcpy(&bm->step_size, (const uint8_t*)bm_time + sizeof(double),
+            sizeof(bm->step_size));
+        for (size_t i = 0; i < _nc->reader.network_count; i++) {
+            _nc->reader.networks[i].simulation_time = bm->simulation_time;
+            _nc->reader.networks[i].step_size = bm->step_size;
+        }
+        if (bm->nc != NULL) bm->nc->simulation_time = _nc->simulation_time;
+        if (bm->trace.nc != NULL) {
+            bm->trace.nc->simulation_time = _nc->simulation_time;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,197 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+
+
+/* SOME/IP-TP reassembly.
+
+Each segment carries a 4 byte TP header (big endian) before the segment data:
+
+    [ offset (28 bit, units of 16 bytes) | reserved (3 bit) | more (1 bit) ]
+
+Segments are reassembled into a slot buffer (retained, only grows) and the
+complete message is returned as a single PDU whose payload references that
+buffer. A slot which delivered a message is not reused until the next call
+to ncodec_truncate(), so that the payload remains valid for the step (also
+when PDUs are decoded in advance by the pipelined step). Reassembly in
+progress is retained over ncodec_truncate(), segments of a message may be
+received in different steps.
+
+The slots (tp_slots) and their buffers (SOME_IP_TP_BUFFER_LEN) are allocated
+with the first segment. A reassembly which receives no segment for
+tp_timeout steps is expired, and when all slots are in use the oldest
+reassembly is evicted by the start of a new message. */
+typedef struct SomeIpTpSlot {
+    /* Message key. */
+    uint32_t swc_id;
+    uint32_t ecu_id;
+    uint32_t message_id;
+    uint32_t request_id;
+    /* Reassembly buffer. */
+    uint8_t* buffer;
+    size_t   capacity;
+    size_t   length;
+    bool     active;    /* Reassembly in progress. */
+    bool     delivered; /* Message delivered (this step). */
+    uint32_t step;      /* Step of the last segment (tp.step). */
+} SomeIpTpSlot;
+
+
+uint32_t some_ip_tp_header(size_t offset, bool more)
+{
+    return (uint32_t)(offset & ~(size_t)0xf) | (more ? 1 : 0);
+}
+
+
+static void _allocate_slots(ABCodecInstance* nc)
+{
+    size_t count = nc->tp_slots ? nc->tp_slots : SOME_IP_TP_SLOTS;
+    nc->tp.slots = vector_make(sizeof(SomeIpTpSlot), count, NULL);
+    for (size_t i = 0; i < count; i++) {
+        SomeIpTpSlot slot = { .buffer = malloc(SOME_IP_TP_BUFFER_LEN) };
+        if (slot.buffer) slot.capacity = SOME_IP_TP_BUFFER_LEN;
+        vector_push(&nc->tp.slots, &slot);
+    }
+}
+
+
+static SomeIpTpSlot* _slot(ABCodecInstance* nc, NCodecPdu* pdu, bool start)
+{
+    NCodecPduSomeIpAdapter* a = &pdu->transport.ip_message.so_ad.some_ip;
+    SomeIpTpSlot*           free_slot = NULL;
+    SomeIpTpSlot*           oldest = NULL;
+    uint32_t timeout = nc->tp_timeout ? nc->tp_timeout : SOME_IP_TP_TIMEOUT;
+
+    if (nc->tp.slots.capacity == 0) _allocate_slots(nc);
+    for (size_t i = 0; i < vector_len(&nc->tp.slots); i++) {
+        SomeIpTpSlot* s = vector_at(&nc->tp.slots, i, NULL);
+        if (s->delivered) continue;
+        if (s->active && nc->tp.step - s->step > timeout) {
+            log_debug(nc, "SOME/IP-TP: reassembly expired (message_id=%x)",
+                s->message_id);
+            s->active = false;
+        }
+        if (s->active && s->swc_id == pdu->swc_id &&
+            s->ecu_id == pdu->ecu_id && s->message_id == a->message_id &&
+            s->request_id == a->request_id) {
+            return s;
+        }
+        if (s->active == false && free_slot == NULL) free_slot = s;
+        if (s->active && (oldest == NULL || s->step < oldest->step)) {
+            oldest = s;
+        }
+    }
+    if (start == false) return NULL;
+    if (free_slot == NULL && oldest) {
+        log_error(nc, "SOME/IP-TP: reassembly evicted (message_id=%x)",
+            oldest->message_id);
+        free_slot = oldest;
+    }
+    if (free_slot == NULL) return NULL;
+    free_slot->swc_id = pdu->swc_id;
+    free_slot->ecu_id = pdu->ecu_id;
+    free_slot->message_id = a->message_id;
+    free_slot->request_id = a->request_id;
+    free_slot->length = 0;
+    free_slot->active = true;
+    return free_slot;
+}
+
+
+/* Returns the payload length of a complete message (pdu references the
+reassembly buffer), -EAGAIN if the PDU was a segment of an incomplete
+message, or the PDU length if the PDU is not a SOME/IP-TP segment. */
+int32_t some_ip_tp_reassemble(ABCodecInstance* nc, NCodecPdu* pdu)
+{
+    if (pdu->transport_type != NCodecPduTransportTypeIp) {
+        return pdu->payload_len;
+    }
+    NCodecPduIpMessageMetadata* ip = &pdu->transport.ip_message;
+    if (ip->so_ad_type != NCodecPduSoAdSomeIP) return pdu->payload_len;
+    NCodecPduSomeIpAdapter* a = &ip->so_ad.some_ip;
+    if ((a->message_type & SOME_IP_TP_FLAG) == 0) return pdu->payload_len;
+
+    /* Segment. */
+    if (pdu->payload_len < SOME_IP_TP_HEADER_LEN) return -EAGAIN;
+    const uint8_t* p = pdu->payload;
+    uint32_t       header = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+                      ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+    size_t         offset = header & ~0xfu;
+    bool           more = header & 0x1;
+    size_t         len = pdu->payload_len - SOME_IP_TP_HEADER_LEN;
+
+    SomeIpTpSlot* s = _slot(nc, pdu, offset == 0);
+    if (s == NULL) {
+        if (offset == 0) {
+            log_error(nc, "SOME/IP-TP: no reassembly slot (message_id=%x)",
+                a->message_id);
+        } else {
+            log_debug(nc, "SOME/IP-TP: segment without start (message_id=%x)",
+                a->message_id);
+        }
+        return -EAGAIN;
+    }
+    s->step = nc->tp.step;
+    /* First segment of a message, (re)starts the reassembly. */
+    if (offset == 0) s->length = 0;
+    if (offset != s->length) {
+        log_error(nc, "SOME/IP-TP: segment out of order (message_id=%x)",
+            a->message_id);
+        s->active = false;
+        return -EAGAIN;
+    }
+    if (offset + len > s->capacity) {
+        size_t capacity = s->capacity ? s->capacity : SOME_IP_TP_BUFFER_LEN;
+        while (capacity < offset + len)
+            capacity *= 2;
+        uint8_t* buffer = realloc(s->buffer, capacity);
+        if (buffer == NULL) {
+            s->active = false;
+            return -ENOMEM;
+        }
+        s->buffer = buffer;
+        s->capacity = capacity;
+    }
+    memcpy(s->buffer + offset, p + SOME_IP_TP_HEADER_LEN, len);
+    s->length = offset + len;
+    if (more) return -EAGAIN;
+
+    /* Message complete. */
+    s->active = false;
+    s->delivered = true;
+    pdu->payload = s->buffer;
+    pdu->payload_len = s->length;
+    a->message_type &= ~SOME_IP_TP_FLAG;
+    a->length = (uint32_t)(SOME_IP_HEADER_LEN + s->length);
+    return (int32_t)pdu->payload_len;
+}
+
+
+/* Messages delivered in this step are released (on truncate), reassembly in
+progress and buffers are retained. */
+void some_ip_tp_reset(ABCodecInstance* nc)
+{
+    nc->tp.step++;
+    for (size_t i = 0; i < vector_len(&nc->tp.slots); i++) {
+        SomeIpTpSlot* s = vector_at(&nc->tp.slots, i, NULL);
+        s->delivered = false;
+    }
+}
+
+
+void some_ip_tp_destroy(ABCodecInstance* nc)
+{
+    for (size_t i = 0; i < vector_len(&nc->tp.slots); i++) {
+        SomeIpTpSlot* s = vector_at(&nc->tp.slots, i, NULL);
+        free(s->buffer);
+    }
+    vector_reset(&nc->tp.slots);
+}
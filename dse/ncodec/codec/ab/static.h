@@ -0,0 +1,110 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DSE_NCODEC_CODEC_AB_STATIC_H_
+#define DSE_NCODEC_CODEC_AB_STATIC_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/interface/pdu.h>
+
+
+/**
+Static AB Codec (PDU Interface)
+===============================
+
+Inline API for a statically linked AB Codec with a fixed configuration
+(`interface=stream;type=pdu;schema=fbs`). Calls are made directly to the
+codec implementation, bypassing the `NCodecVTable` and trace hooks of the
+generic API. The codec functions themselves are not inline (they are
+out-of-line calls into the codec objects), and `ncodec_ab_open()` creates
+the codec with `ncodec_create()` (i.e. the MIME Type is parsed at open).
+
+The transports supported by the codec are selected at compile time with the
+`NCODEC_AB_TRANSPORT_CAN`, `NCODEC_AB_TRANSPORT_IP`,
+`NCODEC_AB_TRANSPORT_STRUCT` and `NCODEC_AB_TRANSPORT_FLEXRAY` macros
+(default 1, set to 0 to compile out). The CMake targets
+`ab-codec-static-can` and `ab-codec-static-flexray` set these definitions
+(see the examples `ab-pdu-static` and `ab-fray-static`).
+
+Example
+-------
+
+    #include <dse/ncodec/codec/ab/static.h>
+
+    NCODEC* nc = ncodec_ab_open(MIMETYPE, ncodec_buffer_stream_create(1024));
+    ncodec_ab_write(nc, &(struct NCodecPdu){ .id = 42, ... });
+    ncodec_ab_flush(nc);
+    ncodec_ab_close(nc);
+*/
+
+
+/* Codec implementation (codec/ab/codec.c, codec/ab/pdu_fbs.c). */
+extern int32_t pdu_write(NCODEC* nc, NCodecMessage* msg);
+extern int32_t pdu_read(NCODEC* nc, NCodecMessage* msg);
+extern int32_t pdu_flush(NCODEC* nc);
+extern int32_t pdu_truncate(NCODEC* nc);
+extern int32_t pdu_write_ref(NCODEC* nc, NCodecMessage* ref);
+extern int32_t pdu_read_ref(NCODEC* nc, NCodecMessage* ref);
+extern int32_t pdu_step_wait(NCODEC* nc);
+extern void    codec_close(NCODEC* nc);
+
+
+static inline NCODEC* ncodec_ab_open(const char* mime_type, NSTREAM* stream)
+{
+    NCODEC* nc = ncodec_create(mime_type);
+    if (nc) {
+        NCodecInstance* _nc = (NCodecInstance*)nc;
+        _nc->stream = stream;
+    }
+    return nc;
+}
+
+static inline int32_t ncodec_ab_write(NCODEC* nc, NCodecPdu* pdu)
+{
+    return pdu_write(nc, pdu);
+}
+
+static inline int32_t ncodec_ab_read(NCODEC* nc, NCodecPdu* pdu)
+{
+    return pdu_read(nc, pdu);
+}
+
+static inline int32_t ncodec_ab_write_ref(NCODEC* nc, NCodecPduRef* ref)
+{
+    return pdu_write_ref(nc, ref);
+}
+
+static inline int32_t ncodec_ab_read_ref(NCODEC* nc, NCodecPduRef* ref)
+{
+    return pdu_read_ref(nc, ref);
+}
+
+static inline int32_t ncodec_ab_flush(NCODEC* nc)
+{
+    return pdu_flush(nc);
+}
+
+static inline int32_t ncodec_ab_truncate(NCODEC* nc)
+{
+    return pdu_truncate(nc);
+}
+
+static inline int64_t ncodec_ab_seek(NCODEC* nc, size_t pos, int32_t op)
+{
+    NCodecInstance*     _nc = (NCodecInstance*)nc;
+    NCodecStreamVTable* stream = (NCodecStreamVTable*)_nc->stream;
+    /* Complete a pipelined step (as ncodec_seek()). */
+    pdu_step_wait(nc);
+    return stream->seek(nc, pos, op);
+}
+
+static inline void ncodec_ab_close(NCODEC* nc)
+{
+    codec_close(nc);
+}
+
+
+#endif  // DSE_NCODEC_CODEC_AB_STATIC_H_
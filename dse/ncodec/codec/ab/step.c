@@ -0,0 +1,180 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/interface/pdu.h>
+
+
+extern int32_t _next_pdu(ABCodecInstance* nc, NCodecPdu* pdu);
+
+
+/* The worker decodes the entire stream (including the Bus Model progress) of
+an NCodec object into the step.pdu_list. While a decode is pending the
+NCodec object is owned by the worker, all other codec operations (including
+ncodec_seek() and ncodec_tell()) first call pdu_step_sync() to wait for the
+worker. */
+typedef struct ABCodecStepWorker {
+    ABCodecInstance* nc;
+    pthread_t        thread;
+    pthread_mutex_t  mutex;
+    pthread_cond_t   cond;
+    bool             request;
+    bool             done;
+    bool             shutdown;
+} ABCodecStepWorker;
+
+
+static void __decode_step(ABCodecInstance* nc)
+{
+    vector_clear(&nc->step.pdu_list, NULL, NULL);
+    nc->step.pdu_idx = 0;
+    nc->step.rc = -ENOMSG;
+    while (true) {
+        NCodecPdu pdu = {};
+        int32_t   rc = _next_pdu(nc, &pdu);
+        if (rc < 0) {
+            nc->step.rc = rc;
+            break;
+        }
+        vector_push(&nc->step.pdu_list, &pdu);
+    }
+}
+
+
+static void* __worker_run(void* arg)
+{
+    ABCodecStepWorker* w = arg;
+
+    pthread_mutex_lock(&w->mutex);
+    while (true) {
+        while (w->request == false && w->shutdown == false) {
+            pthread_cond_wait(&w->cond, &w->mutex);
+        }
+        if (w->shutdown) break;
+        w->request = false;
+        pthread_mutex_unlock(&w->mutex);
+
+        __decode_step(w->nc);
+
+        pthread_mutex_lock(&w->mutex);
+        w->done = true;
+        pthread_cond_broadcast(&w->cond);
+    }
+    pthread_mutex_unlock(&w->mutex);
+    return NULL;
+}
+
+
+static ABCodecStepWorker* __worker_create(ABCodecInstance* nc)
+{
+    ABCodecStepWorker* w = calloc(1, sizeof(ABCodecStepWorker));
+    w->nc = nc;
+    pthread_mutex_init(&w->mutex, NULL);
+    pthread_cond_init(&w->cond, NULL);
+    if (pthread_create(&w->thread, NULL, __worker_run, w) != 0) {
+        log_error(nc, "Unable to create step worker thread");
+        pthread_cond_destroy(&w->cond);
+        pthread_mutex_destroy(&w->mutex);
+        free(w);
+        return NULL;
+    }
+    return w;
+}
+
+
+int32_t pdu_step_wait(NCODEC* nc)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    if (_nc == NULL) return -ENOSTR;
+    if (_nc->step.pending == false) return 0;
+
+    ABCodecStepWorker* w = _nc->step.worker;
+    /* Stream operations of the worker itself (i.e. ncodec_seek()). */
+    if (pthread_equal(pthread_self(), w->thread)) return 0;
+    pthread_mutex_lock(&w->mutex);
+    while (w->done == false) {
+        pthread_cond_wait(&w->cond, &w->mutex);
+    }
+    w->done = false;
+    pthread_mutex_unlock(&w->mutex);
+
+    _nc->step.pending = false;
+    _nc->step.ready = true;
+    return 0;
+}
+
+
+int32_t pdu_step_begin(NCODEC* nc)
+{
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    if (_nc == NULL) return -ENOSTR;
+    if (_nc->c.stream == NULL) return -ENOSR;
+    if (_nc->step.pending) return -EBUSY;
+
+    if (_nc->step.worker == NULL) {
+        _nc->step.worker = __worker_create(_nc);
+        if (_nc->step.worker == NULL) return -ENOSYS;
+    }
+    if (_nc->step.pdu_list.capacity == 0) {
+        _nc->step.pdu_list = vector_make(sizeof(NCodecPdu), 0, NULL);
+    }
+
+    ABCodecStepWorker* w = _nc->step.worker;
+    _nc->step.pending = true;
+    _nc->step.ready = false;
+    pthread_mutex_lock(&w->mutex);
+    w->done = false;
+    w->request = true;
+    pthread_cond_broadcast(&w->cond);
+    pthread_mutex_unlock(&w->mutex);
+    return 0;
+}
+
+
+void pdu_step_sync(ABCodecInstance* nc)
+{
+    if (nc->step.pending) pdu_step_wait((NCODEC*)nc);
+}
+
+
+int32_t pdu_step_next(ABCodecInstance* nc, NCodecPdu* pdu)
+{
+    if (nc->step.pdu_idx < nc->step.pdu_list.length) {
+        vector_at(&nc->step.pdu_list, nc->step.pdu_idx++, pdu);
+        return pdu->payload_len;
+    }
+    return nc->step.rc;
+}
+
+
+void pdu_step_reset(ABCodecInstance* nc)
+{
+    vector_clear(&nc->step.pdu_list, NULL, NULL);
+    nc->step.pdu_idx = 0;
+    nc->step.ready = false;
+}
+
+
+void pdu_step_destroy(ABCodecInstance* nc)
+{
+    ABCodecStepWorker* w = nc->step.worker;
+    if (w) {
+        pdu_step_sync(nc);
+        pthread_mutex_lock(&w->mutex);
+        w->shutdown = true;
+        pthread_cond_broadcast(&w->cond);
+        pthread_mutex_unlock(&w->mutex);
+        pthread_join(w->thread, NULL);
+        pthread_cond_destroy(&w->cond);
+        pthread_mutex_destroy(&w->mutex);
+        free(w);
+    }
+    vector_reset(&nc->step.pdu_list);
+    nc->step = (ABCodecStep){ 0 };
+}
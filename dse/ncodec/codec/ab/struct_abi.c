@@ -0,0 +1,609 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dse/clib/collections/vector.h>
+#include <dse/ncodec/codec/ab/struct_abi.h>
+
+
+#define ARRAY_SIZE(x)    (sizeof(x) / sizeof(x[0]))
+#define INTERN_INIT      64 /* Initial capacity, power of 2. */
+#define PLAN_TABLE_INIT  64 /* Initial capacity, power of 2. */
+#define PLATFORM_NATIVE  0  /* Index of the native platform. */
+#define FIELD_SIZE_MAX   8
+
+
+typedef struct StructAbiType {
+    NCodecStructField* fields;
+    size_t             count;
+} StructAbiType;
+
+/* Interned string, a registered type is attached to the type name. */
+typedef struct StructAbiString {
+    char*          str;
+    uint32_t       hash;
+    StructAbiType* type;
+} StructAbiString;
+
+typedef struct StructAbiPlatform {
+    /* Interned metadata. */
+    const char* arch;
+    const char* os;
+    const char* abi;
+    /* Layout rules. */
+    bool        big_endian;
+    uint16_t    align8; /* Alignment of 8 byte scalars. */
+} StructAbiPlatform;
+
+typedef struct StructAbiKey {
+    const char* type;
+    const char* encoding;
+    uint32_t    src_platform;
+    uint32_t    dst_platform;
+    uint16_t    src_aligned;
+    uint16_t    dst_aligned;
+    bool        src_packed;
+    bool        dst_packed;
+} StructAbiKey;
+
+typedef struct StructAbiPlanEntry {
+    StructAbiKey      key;
+    NCodecStructPlan* plan; /* NULL = unused. */
+} StructAbiPlanEntry;
+
+typedef struct NCodecStructAbi {
+    /* Interned strings, open addressing (linear probe). */
+    struct {
+        StructAbiString* entry;
+        size_t           capacity;
+        size_t           count;
+    } strings;
+    /* Platforms, items of StructAbiPlatform (few, linear search). */
+    Vector platforms;
+    /* Plan cache, open addressing (linear probe). */
+    struct {
+        StructAbiPlanEntry* entry;
+        size_t              capacity;
+        size_t              count;
+    } plans;
+} NCodecStructAbi;
+
+
+/* Layout rules of known architectures (platform_arch). */
+static const struct {
+    const char* arch;
+    bool        big_endian;
+    uint16_t    align8;
+} _arch_rules[] = {
+    { "amd64", false, 8 },
+    { "x86_64", false, 8 },
+    { "x64", false, 8 },
+    { "arm64", false, 8 },
+    { "aarch64", false, 8 },
+    { "arm", false, 8 },
+    { "armhf", false, 8 },
+    { "armv7", false, 8 },
+    { "riscv64", false, 8 },
+    { "ppc64le", false, 8 },
+    { "mipsel", false, 8 },
+    { "x86", false, 4 }, /* System V i386, 8 on Windows. */
+    { "i386", false, 4 },
+    { "i686", false, 4 },
+    { "ppc", true, 8 },
+    { "ppc64", true, 8 },
+    { "s390x", true, 8 },
+    { "mips", true, 8 },
+};
+
+
+static inline uint32_t _hash_str(const char* s)
+{
+    uint32_t h = 2166136261u; /* FNV-1a */
+    while (*s) {
+        h ^= (uint8_t)*s++;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static StructAbiString* _string_slot(
+    StructAbiString* entry, size_t capacity, const char* s, uint32_t hash)
+{
+    size_t i = hash & (capacity - 1);
+    while (entry[i].str != NULL &&
+           (entry[i].hash != hash || strcmp(entry[i].str, s) != 0)) {
+        i = (i + 1) & (capacity - 1);
+    }
+    return &entry[i];
+}
+
+static int _string_grow(NCodecStructAbi* abi)
+{
+    size_t capacity =
+        abi->strings.capacity ? abi->strings.capacity * 2 : INTERN_INIT;
+    StructAbiString* entry = calloc(capacity, sizeof(StructAbiString));
+    if (entry == NULL) return -ENOMEM;
+    for (size_t i = 0; i < abi->strings.capacity; i++) {
+        StructAbiString* e = &abi->strings.entry[i];
+        if (e->str == NULL) continue;
+        *_string_slot(entry, capacity, e->str, e->hash) = *e;
+    }
+    free(abi->strings.entry);
+    abi->strings.entry = entry;
+    abi->strings.capacity = capacity;
+    return 0;
+}
+
+/* Returns the interned string (NULL for NULL or empty strings). */
+static StructAbiString* _intern(NCodecStructAbi* abi, const char* s)
+{
+    if (s == NULL || *s == '\0') return NULL;
+    if ((abi->strings.count + 1) * 2 > abi->strings.capacity) {
+        if (_string_grow(abi)) return NULL;
+    }
+    uint32_t         hash = _hash_str(s);
+    StructAbiString* e =
+        _string_slot(abi->strings.entry, abi->strings.capacity, s, hash);
+    if (e->str == NULL) {
+        e->str = strdup(s);
+        if (e->str == NULL) return NULL;
+        e->hash = hash;
+        abi->strings.count++;
+    }
+    return e;
+}
+
+static inline const char* _intern_str(NCodecStructAbi* abi, const char* s)
+{
+    StructAbiString* e = _intern(abi, s);
+    return e ? e->str : NULL;
+}
+
+
+static int _platform_rules(StructAbiPlatform* p)
+{
+    for (size_t i = 0; i < ARRAY_SIZE(_arch_rules); i++) {
+        if (strcmp(p->arch, _arch_rules[i].arch) != 0) continue;
+        p->big_endian = _arch_rules[i].big_endian;
+        p->align8 = _arch_rules[i].align8;
+        /* Windows (MSVC and MinGW) aligns 8 byte scalars to 8 on x86. */
+        if (p->os && strcmp(p->os, "windows") == 0) p->align8 = 8;
+        if (p->abi && strcmp(p->abi, "msvc") == 0) p->align8 = 8;
+        return 0;
+    }
+    return -EINVAL;
+}
+
+/* Returns the index of the platform, or a negative errno. Platform metadata
+without an architecture is the native platform. */
+static int32_t _platform(NCodecStructAbi* abi, const NCodecPduStructMetadata* md)
+{
+    if (md == NULL) return PLATFORM_NATIVE;
+    const char* arch = _intern_str(abi, md->platform_arch);
+    if (arch == NULL) return PLATFORM_NATIVE;
+    const char* os = _intern_str(abi, md->platform_os);
+    const char* a = _intern_str(abi, md->platform_abi);
+
+    for (size_t i = 0; i < vector_len(&abi->platforms); i++) {
+        StructAbiPlatform* p = vector_at(&abi->platforms, i, NULL);
+        if (p->arch == arch && p->os == os && p->abi == a) return (int32_t)i;
+    }
+    StructAbiPlatform p = { .arch = arch, .os = os, .abi = a };
+    if (_platform_rules(&p)) return -EINVAL;
+    vector_push(&abi->platforms, &p);
+    return (int32_t)vector_len(&abi->platforms) - 1;
+}
+
+
+static inline bool _key_equal(const StructAbiKey* a, const StructAbiKey* b)
+{
+    return a->type == b->type && a->encoding == b->encoding &&
+           a->src_platform == b->src_platform &&
+           a->dst_platform == b->dst_platform &&
+           a->src_aligned == b->src_aligned &&
+           a->dst_aligned == b->dst_aligned &&
+           a->src_packed == b->src_packed && a->dst_packed == b->dst_packed;
+}
+
+static inline size_t _key_hash(const StructAbiKey* k, size_t capacity)
+{
+    uint64_t h = (uint64_t)(uintptr_t)k->type;
+    h = h * 31 + (uint64_t)(uintptr_t)k->encoding;
+    h = h * 31 + ((uint64_t)k->src_platform << 32 | k->dst_platform);
+    h = h * 31 + ((uint64_t)k->src_aligned << 16 | k->dst_aligned);
+    h = h * 31 + ((uint64_t)k->src_packed << 1 | k->dst_packed);
+    return (size_t)((h * 0x9e3779b97f4a7c15ULL) >> 32) & (capacity - 1);
+}
+
+static StructAbiPlanEntry* _plan_slot(
+    StructAbiPlanEntry* entry, size_t capacity, const StructAbiKey* key)
+{
+    size_t i = _key_hash(key, capacity);
+    while (entry[i].plan != NULL && !_key_equal(&entry[i].key, key)) {
+        i = (i + 1) & (capacity - 1);
+    }
+    return &entry[i];
+}
+
+static int _plan_grow(NCodecStructAbi* abi)
+{
+    size_t capacity =
+        abi->plans.capacity ? abi->plans.capacity * 2 : PLAN_TABLE_INIT;
+    StructAbiPlanEntry* entry = calloc(capacity, sizeof(StructAbiPlanEntry));
+    if (entry == NULL) return -ENOMEM;
+    for (size_t i = 0; i < abi->plans.capacity; i++) {
+        StructAbiPlanEntry* e = &abi->plans.entry[i];
+        if (e->plan == NULL) continue;
+        *_plan_slot(entry, capacity, &e->key) = *e;
+    }
+    free(abi->plans.entry);
+    abi->plans.entry = entry;
+    abi->plans.capacity = capacity;
+    return 0;
+}
+
+
+/* Field offsets and size of a type according to the platform rules. */
+static size_t _layout(StructAbiType* t, StructAbiPlatform* p, bool packed,
+    uint16_t aligned, uint32_t* offset)
+{
+    size_t pos = 0;
+    size_t max_align = 1;
+    for (size_t i = 0; i < t->count; i++) {
+        NCodecStructField* f = &t->fields[i];
+        size_t             align = (f->size == 8) ? p->align8 : f->size;
+        if (packed) align = 1;
+        if (align > max_align) max_align = align;
+        pos = (pos + align - 1) & ~(align - 1);
+        offset[i] = (uint32_t)pos;
+        pos += (size_t)f->size * (f->count ? f->count : 1);
+    }
+    if (aligned > max_align) max_align = aligned;
+    return (pos + max_align - 1) / max_align * max_align;
+}
+
+static NCodecStructPlan* _plan_compile(StructAbiType* t,
+    StructAbiPlatform* src_p, StructAbiPlatform* dst_p, const StructAbiKey* k)
+{
+    uint32_t* src_offset = calloc(t->count + 1, sizeof(uint32_t));
+    uint32_t* dst_offset = calloc(t->count + 1, sizeof(uint32_t));
+    NCodecStructPlan* plan = calloc(
+        1, sizeof(NCodecStructPlan) + t->count * sizeof(NCodecStructPlanOp));
+    if (src_offset == NULL || dst_offset == NULL || plan == NULL) {
+        free(src_offset);
+        free(dst_offset);
+        free(plan);
+        return NULL;
+    }
+    plan->op = (NCodecStructPlanOp*)(plan + 1);
+    plan->src_size =
+        _layout(t, src_p, k->src_packed, k->src_aligned, src_offset);
+    plan->dst_size =
+        _layout(t, dst_p, k->dst_packed, k->dst_aligned, dst_offset);
+    bool swap = src_p->big_endian != dst_p->big_endian;
+
+    /* Same layout, the plan is a single copy. */
+    if (swap == false && plan->src_size == plan->dst_size &&
+        memcmp(src_offset, dst_offset, t->count * sizeof(uint32_t)) == 0) {
+        plan->op[0] = (NCodecStructPlanOp){ .length = plan->dst_size };
+        plan->op_count = 1;
+        goto done;
+    }
+
+    /* Copy each field, merging adjacent fields with the same operation. */
+    size_t data_len = 0;
+    for (size_t i = 0; i < t->count; i++) {
+        NCodecStructField* f = &t->fields[i];
+        NCodecStructPlanOp op = {
+            .src_offset = src_offset[i],
+            .dst_offset = dst_offset[i],
+            .length = (uint32_t)f->size * (f->count ? f->count : 1),
+            .swap = (swap && f->size > 1) ? f->size : 0,
+        };
+        data_len += op.length;
+        if (op.length == 0) continue;
+        if (plan->op_count) {
+            NCodecStructPlanOp* last = &plan->op[plan->op_count - 1];
+            if (last->src_offset + last->length == op.src_offset &&
+                last->dst_offset + last->length == op.dst_offset &&
+                last->swap == op.swap) {
+                last->length += op.length;
+                continue;
+            }
+        }
+        plan->op[plan->op_count++] = op;
+    }
+    plan->dst_padded = data_len < plan->dst_size;
+
+done:
+    free(src_offset);
+    free(dst_offset);
+    return plan;
+}
+
+
+/**
+ncodec_struct_abi_create
+========================
+
+Create a Struct ABI translation cache.
+
+Returns
+-------
+NCodecStructAbi (pointer)
+: The translation cache, or NULL on failure.
+*/
+NCodecStructAbi* ncodec_struct_abi_create(void)
+{
+    NCodecStructAbi* abi = calloc(1, sizeof(NCodecStructAbi));
+    if (abi == NULL) return NULL;
+
+    /* The native platform. */
+    union {
+        uint16_t u16;
+        uint8_t  u8[2];
+    } order = { .u16 = 1 };
+    struct {
+        char    c;
+        int64_t i;
+    } align8;
+    abi->platforms = vector_make(sizeof(StructAbiPlatform), 4, NULL);
+    vector_push(&abi->platforms,
+        &(StructAbiPlatform){
+            .big_endian = (order.u8[0] == 0),
+            .align8 = (uint16_t)((char*)&align8.i - (char*)&align8),
+        });
+    return abi;
+}
+
+
+/**
+ncodec_struct_abi_register
+==========================
+
+Register a struct type. The fields are listed in declaration order, padding
+is derived from the platform rules (it should not be listed).
+
+Parameters
+----------
+abi (NCodecStructAbi*)
+: The translation cache.
+
+type_name (const char*)
+: The type name (`NCodecPduStructMetadata.type_name`).
+
+fields (const NCodecStructField*)
+: The fields of the type (copied).
+
+count (size_t)
+: The number of fields.
+
+Returns
+-------
+0
+: The type was registered.
+
+-EINVAL
+: Invalid parameters, or a field has an unsupported size.
+
+-EEXIST
+: The type is already registered.
+
+-ENOMEM
+: Allocation failed.
+*/
+int32_t ncodec_struct_abi_register(NCodecStructAbi* abi, const char* type_name,
+    const NCodecStructField* fields, size_t count)
+{
+    if (abi == NULL || fields == NULL || count == 0) return -EINVAL;
+    if (type_name == NULL || *type_name == '\0') return -EINVAL;
+    for (size_t i = 0; i < count; i++) {
+        uint16_t size = fields[i].size;
+        if (size == 0 || size > FIELD_SIZE_MAX || (size & (size - 1))) {
+            return -EINVAL;
+        }
+    }
+    StructAbiString* s = _intern(abi, type_name);
+    if (s == NULL) return -ENOMEM;
+    if (s->type) return -EEXIST;
+
+    StructAbiType* t = calloc(1, sizeof(StructAbiType));
+    if (t == NULL) return -ENOMEM;
+    t->fields = calloc(count, sizeof(NCodecStructField));
+    if (t->fields == NULL) {
+        free(t);
+        return -ENOMEM;
+    }
+    memcpy(t->fields, fields, count * sizeof(NCodecStructField));
+    t->count = count;
+    s->type = t;
+    return 0;
+}
+
+
+/**
+ncodec_struct_abi_plan
+======================
+
+Get the translation plan for a Struct PDU. The plan is compiled on first use
+and cached, following calls with equal metadata return the cached plan.
+
+Parameters
+----------
+abi (NCodecStructAbi*)
+: The translation cache.
+
+src (const NCodecPduStructMetadata*)
+: Metadata of the Struct PDU (source platform).
+
+dst (const NCodecPduStructMetadata*)
+: Metadata of the target platform, NULL for the native platform (unpacked
+  and without alignment attribute). Metadata without `platform_arch` also
+  selects the native platform.
+
+plan (const NCodecStructPlan**)
+: (out) The translation plan, valid until the cache is destroyed.
+
+Returns
+-------
+0
+: The translation plan was returned.
+
+-EINVAL
+: Invalid parameters, unknown platform or the encoding of the source and
+  target differ.
+
+-ENOENT
+: The type is not registered.
+
+-ENOMEM
+: Allocation failed.
+*/
+int32_t ncodec_struct_abi_plan(NCodecStructAbi* abi,
+    const NCodecPduStructMetadata* src, const NCodecPduStructMetadata* dst,
+    const NCodecStructPlan** plan)
+{
+    if (abi == NULL || src == NULL || plan == NULL) return -EINVAL;
+
+    /* Interned entries move when the table grows, keep the content. */
+    StructAbiString* s = _intern(abi, src->type_name);
+    if (s == NULL || s->type == NULL) return -ENOENT;
+    const char*    type_name = s->str;
+    StructAbiType* type = s->type;
+    const char*    encoding = _intern_str(abi, src->encoding);
+    if (dst && dst->encoding && _intern_str(abi, dst->encoding) != encoding) {
+        return -EINVAL;
+    }
+    int32_t src_p = _platform(abi, src);
+    int32_t dst_p = _platform(abi, dst);
+    if (src_p < 0 || dst_p < 0) return -EINVAL;
+
+    StructAbiKey key = {
+        .type = type_name,
+        .encoding = encoding,
+        .src_platform = (uint32_t)src_p,
+        .dst_platform = (uint32_t)dst_p,
+        .src_aligned = src->attribute_aligned,
+        .dst_aligned = dst ? dst->attribute_aligned : 0,
+        .src_packed = src->attribute_packed,
+        .dst_packed = dst ? dst->attribute_packed : false,
+    };
+    if ((abi->plans.count + 1) * 2 > abi->plans.capacity) {
+        if (_plan_grow(abi)) return -ENOMEM;
+    }
+    StructAbiPlanEntry* e =
+        _plan_slot(abi->plans.entry, abi->plans.capacity, &key);
+    if (e->plan == NULL) {
+        e->plan = _plan_compile(type,
+            vector_at(&abi->platforms, key.src_platform, NULL),
+            vector_at(&abi->platforms, key.dst_platform, NULL), &key);
+        if (e->plan == NULL) return -ENOMEM;
+        e->key = key;
+        abi->plans.count++;
+    }
+    *plan = e->plan;
+    return 0;
+}
+
+
+static inline void _copy_swap(
+    uint8_t* dst, const uint8_t* src, size_t length, size_t swap)
+{
+    for (size_t i = 0; i < length; i += swap) {
+        for (size_t j = 0; j < swap; j++) {
+            dst[i + j] = src[i + swap - 1 - j];
+        }
+    }
+}
+
+
+/**
+ncodec_struct_abi_convert
+=========================
+
+Convert a struct from the source layout to the target layout of a plan.
+
+Parameters
+----------
+plan (const NCodecStructPlan*)
+: The translation plan.
+
+src (const void*)
+: The source struct (i.e. the PDU payload).
+
+src_len (size_t)
+: Length of the source struct.
+
+dst (void*)
+: The target struct.
+
+dst_len (size_t)
+: Length of the target struct (buffer).
+
+Returns
+-------
++ve
+: The length of the converted struct.
+
+-EINVAL
+: Invalid parameters, or the source is shorter than the source layout.
+
+-ENOSPC
+: The target is shorter than the target layout.
+*/
+int32_t ncodec_struct_abi_convert(const NCodecStructPlan* plan,
+    const void* src, size_t src_len, void* dst, size_t dst_len)
+{
+    if (plan == NULL || src == NULL || dst == NULL) return -EINVAL;
+    if (src_len < plan->src_size) return -EINVAL;
+    if (dst_len < plan->dst_size) return -ENOSPC;
+
+    if (plan->dst_padded) memset(dst, 0, plan->dst_size);
+    for (size_t i = 0; i < plan->op_count; i++) {
+        const NCodecStructPlanOp* op = &plan->op[i];
+        const uint8_t*            s = (const uint8_t*)src + op->src_offset;
+        uint8_t*                  d = (uint8_t*)dst + op->dst_offset;
+        if (op->swap) {
+            _copy_swap(d, s, op->length, op->swap);
+        } else {
+            memcpy(d, s, op->length);
+        }
+    }
+    return (int32_t)plan->dst_size;
+}
+
+
+/**
+ncodec_struct_abi_destroy
+=========================
+
+Destroy a Struct ABI translation cache, including all plans.
+
+Parameters
+----------
+abi (NCodecStructAbi*)
+: The translation cache.
+*/
+void ncodec_struct_abi_destroy(NCodecStructAbi* abi)
+{
+    if (abi == NULL) return;
+    for (size_t i = 0; i < abi->plans.capacity; i++) {
+        free(abi->plans.entry[i].plan);
+    }
+    free(abi->plans.entry);
+    for (size_t i = 0; i < abi->strings.capacity; i++) {
+        StructAbiString* e = &abi->strings.entry[i];
+        if (e->type) free(e->type->fields);
+        free(e->type);
+        free(e->str);
+    }
+    free(abi->strings.entry);
+    vector_reset(&abi->platforms);
+    free(abi);
+}
@@ -0,0 +1,96 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DSE_NCODEC_CODEC_AB_STRUCT_ABI_H_
+#define DSE_NCODEC_CODEC_AB_STRUCT_ABI_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/interface/pdu.h>
+
+
+/**
+Struct ABI Translation
+======================
+
+Converts the payload of a Struct PDU (`NCodecPduTransportTypeStruct`) from
+the memory layout of the sending platform to the layout of the receiving
+platform. The layout of a type depends on the `platform_arch`,
+`platform_os` and `platform_abi` of the platform (byte order, alignment of
+8 byte scalars) and on the `attribute_packed` and `attribute_aligned`
+attributes of the struct.
+
+Types are registered once with a list of their fields (in declaration
+order). A (type, source platform, target platform) tuple is compiled into a
+translation plan on first use. Plans are cached, keyed by the interned
+metadata strings, so that the conversion of a PDU is a lookup followed by a
+short list of copy (and byte swap) operations.
+
+Example
+-------
+
+    #include <dse/ncodec/codec/ab/struct_abi.h>
+
+    static const NCodecStructField foo_fields[] = {
+        { .name = "a", .size = 1 },
+        { .name = "b", .size = 8 },
+        { .name = "c", .size = 2, .count = 4 },
+    };
+
+    NCodecStructAbi* abi = ncodec_struct_abi_create();
+    ncodec_struct_abi_register(abi, "foo", foo_fields, 3);
+
+    const NCodecStructPlan* plan;
+    if (ncodec_struct_abi_plan(abi, &pdu.transport.struct_object, NULL,
+            &plan) == 0) {
+        ncodec_struct_abi_convert(
+            plan, pdu.payload, pdu.payload_len, &foo, sizeof(foo));
+    }
+    ncodec_struct_abi_destroy(abi);
+*/
+
+
+/* A field of a struct type, scalars or arrays of scalars. */
+typedef struct NCodecStructField {
+    const char* name;
+    uint16_t    size;  /* Element size: 1, 2, 4 or 8 bytes. */
+    uint16_t    count; /* Array length, 0 = scalar. */
+} NCodecStructField;
+
+
+/* A copy operation of a plan, swap is the element size when the byte order
+of the elements is reversed, otherwise 0. */
+typedef struct NCodecStructPlanOp {
+    uint32_t src_offset;
+    uint32_t dst_offset;
+    uint32_t length;
+    uint32_t swap;
+} NCodecStructPlanOp;
+
+typedef struct NCodecStructPlan {
+    size_t              src_size;
+    size_t              dst_size;
+    bool                dst_padded; /* Target has padding (zeroed). */
+    size_t              op_count;
+    NCodecStructPlanOp* op;
+} NCodecStructPlan;
+
+
+typedef struct NCodecStructAbi NCodecStructAbi;
+
+
+/* codec/ab/struct_abi.c */
+DLL_PUBLIC NCodecStructAbi* ncodec_struct_abi_create(void);
+DLL_PUBLIC int32_t ncodec_struct_abi_register(NCodecStructAbi* abi,
+    const char* type_name, const NCodecStructField* fields, size_t count);
+DLL_PUBLIC int32_t ncodec_struct_abi_plan(NCodecStructAbi* abi,
+    const NCodecPduStructMetadata* src, const NCodecPduStructMetadata* dst,
+    const NCodecStructPlan** plan);
+DLL_PUBLIC int32_t ncodec_struct_abi_convert(const NCodecStructPlan* plan,
+    const void* src, size_t src_len, void* dst, size_t dst_len);
+DLL_PUBLIC void    ncodec_struct_abi_destroy(NCodecStructAbi* abi);
+
+
+#endif  // DSE_NCODEC_CODEC_AB_STRUCT_ABI_H_
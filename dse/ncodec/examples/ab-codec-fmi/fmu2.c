@@ -18,7 +18,9 @@
 #define VR_RX 1  // RX from perspective of FMU
 #define VR_TX 2  // TX from perspective of FMU
 
-static char* _rx_tx_buffer = NULL;
+static char*    _rx_tx_buffer = NULL;
+static uint8_t* _rx_buffer = NULL; /* Reused between steps. */
+static size_t   _rx_buffer_len = 0;
 
 int fmi2GetString(void* c, const unsigned int vr[], size_t nvr, char* value[])
 {
@@ -50,9 +52,17 @@ int fmi2DoStep(void* c, double currentCommunicationPoint,
     uint8_t* buffer = NULL;
     size_t   buffer_len = 0;
 
-    /* RX Codec - setup buffer and prime for reading. */
-    buffer = (uint8_t*)ncodec_ascii85_decode(_rx_tx_buffer, &buffer_len);
-    free(_rx_tx_buffer);
+    /* RX Codec - decode into the (reused) RX buffer and prime for reading. */
+    size_t rx_len = strlen(_rx_tx_buffer);
+    if (_rx_buffer_len < ncodec_ascii85_decode_bound(rx_len)) {
+        _rx_buffer_len = ncodec_ascii85_decode_bound(rx_len);
+        _rx_buffer = realloc(_rx_buffer, _rx_buffer_len);
+    }
+    int64_t len = ncodec_ascii85_decode_to(
+        _rx_tx_buffer, rx_len, _rx_buffer, _rx_buffer_len);
+    if (len < 0) return (int)len;
+    buffer = _rx_buffer;
+    buffer_len = (size_t)len;
     NCODEC* rx_nc = ncodec_open(MIMETYPE, ncodec_buffer_stream_create(0));
     ((NCodecInstance*)rx_nc)->stream->write(rx_nc, buffer, buffer_len);
     ncodec_seek(rx_nc, 0, NCODEC_SEEK_SET);
@@ -77,7 +87,9 @@ int fmi2DoStep(void* c, double currentCommunicationPoint,
     ncodec_seek(tx_nc, 0, NCODEC_SEEK_SET);
     ((NCodecInstance*)tx_nc)
         ->stream->read(tx_nc, &buffer, &buffer_len, NCODEC_POS_NC);
-    _rx_tx_buffer = ncodec_ascii85_encode((char*)buffer, buffer_len);
+    size_t tx_len = ncodec_ascii85_encode_bound(buffer_len) + 1;
+    _rx_tx_buffer = realloc(_rx_tx_buffer, tx_len);
+    ncodec_ascii85_encode_to(buffer, buffer_len, _rx_tx_buffer, tx_len);
 
     /* Destroy the NCodec objects. */
     ncodec_close(rx_nc);
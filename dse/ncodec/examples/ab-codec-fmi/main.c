@@ -71,7 +71,11 @@ int main(void)
     rc = ncodec_seek(nc, 0, NCODEC_SEEK_SET);
     if (rc) return _ncodec_fault("ncodec_seek", rc);
     stream->read(nc, &buffer, &buffer_len, NCODEC_POS_NC);
-    fmi_string = ncodec_ascii85_encode((char*)buffer, buffer_len);
+    size_t fmi_string_len = ncodec_ascii85_encode_bound(buffer_len) + 1;
+    fmi_string = malloc(fmi_string_len);
+    rc = (int)ncodec_ascii85_encode_to(
+        buffer, buffer_len, fmi_string, fmi_string_len);
+    if (rc < 0) return _ncodec_fault("ncodec_ascii85_encode_to", rc);
     _log("BUFFER TX", "(%zu)", buffer_len);
     _log("ASCII85 TX", "(%zu) %s", strlen(fmi_string), fmi_string);
 
@@ -89,7 +93,11 @@ int main(void)
 
     /* Decode the FMI 2 String Variable and inject into the stream buffer. */
     _log("ASCII85 RX", "(%zu) %s", strlen(v[0]), v[0]);
-    buffer = (uint8_t*)ncodec_ascii85_decode(v[0], &buffer_len);
+    buffer_len = ncodec_ascii85_decode_bound(strlen(v[0]));
+    buffer = malloc(buffer_len);
+    rc = (int)ncodec_ascii85_decode_to(v[0], strlen(v[0]), buffer, buffer_len);
+    if (rc < 0) return _ncodec_fault("ncodec_ascii85_decode_to", rc);
+    buffer_len = (size_t)rc;
     _log("BUFFER RX", "(%zu)", buffer_len);
     stream->write(nc, buffer, buffer_len);
     free(buffer);
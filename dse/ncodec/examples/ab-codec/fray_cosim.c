@@ -10,11 +10,12 @@
 #include <dse/ncodec/interface/pdu.h>
 #include <dse/ncodec/stream/stream.h>
 #include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/codec/ab/simbus.h>
 
 
 #define UNUSED(x)     ((void)x)
 #define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
-#define BUFFER_LEN    1024  // Initial buffer size, will grow as needed.
+#define BUS_ID        1
 #define CHECK_RC(call)                                                         \
     do {                                                                       \
         rc = (call);                                                           \
@@ -24,8 +25,6 @@
         }                                                                      \
     } while (0)
 
-extern int simbus(
-    void* nodes, size_t node_size, size_t nc_offset, size_t count);
 extern bool                       trace_off;
 extern NCodecPduFlexrayConfig     fray_config;
 extern NCodecPduFlexrayLpduConfig fray_frames[];
@@ -37,7 +36,6 @@ typedef struct {
     const char*         mimetype;
     const char*         greeting;
     size_t              tx_frame_index;
-    NCodecStreamVTable* stream;
     NCODEC*             nc;
 } Node;
 
@@ -69,11 +67,11 @@ static Node node_table[] = {
 };
 
 
-int setup(Node* node)
+int setup(Node* node, NCodecSimBus* bus)
 {
     int rc = 0;
-    node->stream = ncodec_buffer_stream_create(BUFFER_LEN);
-    node->nc = ncodec_open(node->mimetype, node->stream);
+    node->nc = ncodec_open(
+        node->mimetype, ncodec_simbus_stream_create(bus, BUS_ID));
 
     /* Push FlexRay Config Tables. */
     NCodecPduFlexrayLpduConfig* frames =
@@ -167,13 +165,13 @@ int main(int argc, char* argv[])
     int rc = 0;
     trace_off = true;
 
-    /* Setup the nodes. */
+    /* Setup the nodes, connected by an in-process SimBus. */
+    NCodecSimBus* bus = ncodec_simbus_create();
     for (size_t i = 0; i < ARRAY_SIZE(node_table); i++) {
         Node* n = &node_table[i];
-        setup(n);
+        setup(n, bus);
     }
-    simbus(node_table, sizeof(node_table[0]), offsetof(Node, nc),
-        ARRAY_SIZE(node_table));
+    ncodec_simbus_step(bus);
 
     /* Complete a Co-Simulation run (20 * 0.5 = 10mS). */
     for (int s = 0; s < 20; s++) {
@@ -181,8 +179,7 @@ int main(int argc, char* argv[])
             Node* n = &node_table[i];
             if ((rc = step(n, s)) != 0) break;
         }
-        simbus(node_table, sizeof(node_table[0]), offsetof(Node, nc),
-            ARRAY_SIZE(node_table));
+        ncodec_simbus_step(bus);
     }
 
     /* Close the NCodec. */
@@ -190,6 +187,7 @@ int main(int argc, char* argv[])
         Node* n = &node_table[i];
         ncodec_close(n->nc);
     }
+    ncodec_simbus_destroy(bus);
 
     return 0;
 }
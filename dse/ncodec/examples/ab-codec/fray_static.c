@@ -0,0 +1,147 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/static.h>
+#include <dse/ncodec/interface/pdu.h>
+#include <dse/ncodec/stream/stream.h>
+
+
+#define UNUSED(x) ((void)x)
+#define MIMETYPE                                                               \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "ecu_id=1;vcn=2;model=flexray;name=fray;loopback=1"
+#define BUFFER_LEN     1024  // Initial buffer size, will grow as needed.
+#define TX_FRAME_INDEX 0
+
+#define CHECK_RC(call)                                                         \
+    do {                                                                       \
+        rc = (call);                                                           \
+        if (rc < 0 && rc != -ENOMSG) {                                         \
+            printf("Error: call:%s rc=%d\n", #call, rc);                       \
+            return rc;                                                         \
+        }                                                                      \
+    } while (0)
+
+extern NCodecPduFlexrayConfig     fray_config;
+extern NCodecPduFlexrayLpduConfig fray_frames[];
+extern size_t                     frame_count(void);
+
+static const char* greeting = "Hello World from ECU 1";
+
+
+int setup(NCODEC* nc)
+{
+    int rc = 0;
+
+    /* Push FlexRay Config Tables (direct calls, no vtable). */
+    NCodecPduFlexrayLpduConfig* frames =
+        calloc(frame_count(), sizeof(NCodecPduFlexrayLpduConfig));
+    for (size_t i = 0; i < frame_count(); i++) {
+        frames[i] = fray_frames[i];
+        if (i == TX_FRAME_INDEX) {
+            frames[i].direction = NCodecPduFlexrayDirectionTx;
+            frames[i].transmit_mode = NCodecPduFlexrayTransmitModeContinuous;
+        }
+    }
+    NCodecPduFlexrayConfig config = fray_config;
+    config.frame_config.table = frames;
+    config.frame_config.count = frame_count();
+    rc = ncodec_ab_write(nc, &(struct NCodecPdu){
+        .transport_type = NCodecPduTransportTypeFlexray,
+        .transport.flexray = {
+            .metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+            .metadata.config = config,
+        },
+    });
+    free(frames);
+    if (rc < 0) return rc;
+
+    /* Push the Tx L-PDU. */
+    CHECK_RC(ncodec_ab_write(nc,
+        &(struct NCodecPdu){ .id = fray_frames[TX_FRAME_INDEX].slot_id,
+            .payload = (uint8_t*)greeting,
+            .payload_len = strlen(greeting) + 1,
+            .transport_type = NCodecPduTransportTypeFlexray,
+            .transport.flexray = {
+                .metadata_type = NCodecPduFlexrayMetadataTypeLpdu,
+                .metadata.lpdu = {
+                    .frame_config_index = TX_FRAME_INDEX,
+                    .status = NCodecPduFlexrayLpduStatusNotTransmitted,
+                },
+            } }));
+
+    CHECK_RC(ncodec_ab_flush(nc)); /* Call after writing PDUs. */
+    return 0;
+}
+
+
+int step(NCODEC* nc, int s)
+{
+    int rc = 0;
+
+    /* Read PDUs from the NCodec (direct calls, no vtable). */
+    while (1) {
+        NCodecPdu msg = {};
+        CHECK_RC(ncodec_ab_read(nc, &msg));
+        if (rc == -ENOMSG) break;
+        if (msg.transport_type != NCodecPduTransportTypeFlexray) continue;
+        if (msg.transport.flexray.metadata_type !=
+            NCodecPduFlexrayMetadataTypeLpdu)
+            continue;
+        switch (msg.transport.flexray.metadata.lpdu.status) {
+        case NCodecPduFlexrayLpduStatusTransmitted:
+            printf("ECU 1 (@%0.4f) -> Transmitted slot %u\n", s * 0.0005,
+                msg.id);
+            break;
+        case NCodecPduFlexrayLpduStatusReceived:
+            printf("ECU 1 (@%0.4f) -> Message is: %s\n", s * 0.0005,
+                (char*)msg.payload);
+            break;
+        default:
+            break;
+        }
+    }
+    CHECK_RC(ncodec_ab_truncate(nc)); /* Always call _once_ per step. */
+    CHECK_RC(ncodec_ab_flush(nc)); /* Typically call after writing PDUs. */
+
+    return 0;
+}
+
+
+int main(int argc, char* argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+    int rc = 0;
+
+    /* Open NCodec with buffer stream. */
+    NCodecStreamVTable* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*             nc = ncodec_ab_open(MIMETYPE, stream);
+    if (nc == NULL) return 1;
+    if ((rc = setup(nc)) != 0) {
+        ncodec_ab_close(nc);
+        return 1;
+    }
+    CHECK_RC(ncodec_ab_seek(nc, 0, NCODEC_SEEK_SET));
+
+    /* Complete a Co-Simulation run (20 * 0.5 = 10mS). */
+    for (int s = 0; s < 20; s++) {
+        if ((rc = step(nc, s)) != 0) break;
+
+        /* Effect SimBus exchange, seek to start of stream. */
+        CHECK_RC(ncodec_ab_seek(nc, 0, NCODEC_SEEK_SET));
+    }
+
+    /* Close the NCodec. */
+    ncodec_ab_close(nc);
+
+    return 0;
+}
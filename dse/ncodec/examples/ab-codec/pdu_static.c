@@ -0,0 +1,86 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/static.h>
+#include <dse/ncodec/interface/pdu.h>
+#include <dse/ncodec/stream/stream.h>
+
+
+#define UNUSED(x) ((void)x)
+#define MIMETYPE                                                               \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "name=example;swc_id=1;ecu_id=1;loopback=1"
+#define BUFFER_LEN 1024  // Initial buffer size, will grow as needed.
+
+#define CHECK_RC(call)                                                         \
+    do {                                                                       \
+        rc = (call);                                                           \
+        if (rc < 0 && rc != -ENOMSG) {                                         \
+            printf("Error: call:%s rc=%d\n", #call, rc);                       \
+            return rc;                                                         \
+        }                                                                      \
+    } while (0)
+
+static const char* greeting = "Hello World";
+
+int step(NCODEC* nc)
+{
+    int rc = 0;
+
+    /* Read PDUs from the NCodec (direct calls, no vtable). */
+    while (1) {
+        NCodecPdu msg = {};
+        CHECK_RC(ncodec_ab_read(nc, &msg));
+        if (rc == -ENOMSG) break;
+        printf("Message is: %s (can frame_type=%d)\n", (char*)msg.payload,
+            msg.transport.can_message.frame_type);
+    }
+    CHECK_RC(ncodec_ab_truncate(nc)); /* Always call _once_ per step. */
+
+    /* Write PDUs to the NCodec. */
+    CHECK_RC(ncodec_ab_write(nc,
+        &(struct NCodecPdu){
+            .id = 42,
+            .payload = (uint8_t*)greeting,
+            .payload_len = strlen(greeting),
+            .transport_type = NCodecPduTransportTypeCan,
+            .transport.can_message = {
+                .frame_format = NCodecPduCanFrameFormatBase,
+                .frame_type = NCodecPduCanFrameTypeData,
+            },
+        }));
+    CHECK_RC(ncodec_ab_flush(nc)); /* Call after writing PDUs. */
+
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    UNUSED(argc);
+    UNUSED(argv);
+    int rc = 0;
+
+    /* Open NCodec with buffer stream. */
+    NCodecStreamVTable* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*             nc = ncodec_ab_open(MIMETYPE, stream);
+
+    /* Complete a typical Co-Simulation step. */
+    for (int i = 0; i < 5; i++) {
+        if ((rc = step(nc)) != 0) break;
+
+        /* Effect SimBus exchange, seek to start of stream. */
+        CHECK_RC(ncodec_ab_seek(nc, 0, NCODEC_SEEK_SET));
+    }
+
+    /* Close the NCodec. */
+    ncodec_ab_close(nc);
+
+    return 0;
+}
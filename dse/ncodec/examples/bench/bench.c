@@ -0,0 +1,466 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <malloc.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <dse/clib/collections/vector.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/interface/pdu.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/codec/ab/flexray/flexray.h>
+
+
+#define BUFFER_LEN     (64 * 1024)
+#define REPETITION_MAX 8
+#define MIMETYPE_FMT                                                           \
+    "application/x-automotive-bus;"                                            \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "ecu_id=%zu;cc_id=0;swc_id=1;model=flexray%s"
+
+/* Cluster timing (10 MBit/s): 25 nSec microtick, 1 uSec macrotick. */
+#define MACRO2MICRO    40
+#define BITS_PER_MT    10
+#define MINISLOT_MT    6
+#define NIT_MT         20
+/* Cycles run before measuring (the schedule of all cycles is indexed). */
+#define WARMUP_CYCLES  FLEXRAY_CYCLE_COUNT
+
+
+typedef struct BenchArgs {
+    size_t  nodes;
+    size_t  static_slots;
+    size_t  dynamic_slots;
+    size_t  minislots;
+    uint8_t repetition[REPETITION_MAX];
+    size_t  repetition_count;
+    size_t  payload;
+    size_t  cycles;
+    double  step_size;
+    bool    single_shot;
+    bool    cluster;
+} BenchArgs;
+
+NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream);
+
+extern bool flexray_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu);
+extern void flexray_bus_model_progress(ABCodecBusModel* bm);
+
+
+/* Heap accounting. The allocator is wrapped at link time (see
+CMakeLists.txt), allocations made inside the C library (e.g. strdup) are
+not counted. */
+static struct {
+    uint64_t alloc_count;
+    int64_t  live_bytes;
+    int64_t  peak_bytes;
+} heap;
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t nmemb, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void  __real_free(void* ptr);
+
+static void heap_alloc(void* ptr)
+{
+    if (ptr == NULL) return;
+    heap.alloc_count++;
+    heap.live_bytes += (int64_t)malloc_usable_size(ptr);
+    if (heap.live_bytes > heap.peak_bytes) heap.peak_bytes = heap.live_bytes;
+}
+
+void* __wrap_malloc(size_t size)
+{
+    void* ptr = __real_malloc(size);
+    heap_alloc(ptr);
+    return ptr;
+}
+
+void* __wrap_calloc(size_t nmemb, size_t size)
+{
+    void* ptr = __real_calloc(nmemb, size);
+    heap_alloc(ptr);
+    return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    size_t old_size = ptr ? malloc_usable_size(ptr) : 0;
+    void*  _ptr = __real_realloc(ptr, size);
+    if (_ptr == NULL && size) return NULL; /* Original block is retained. */
+    heap.live_bytes -= (int64_t)old_size;
+    heap_alloc(_ptr);
+    return _ptr;
+}
+
+void __wrap_free(void* ptr)
+{
+    if (ptr) heap.live_bytes -= (int64_t)malloc_usable_size(ptr);
+    __real_free(ptr);
+}
+
+
+static double monotonic_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ((double)ts.tv_nsec / 1000000000.0);
+}
+
+
+typedef struct BenchCluster {
+    NCodecPduFlexrayConfig       config;
+    NCodecPduFlexrayLpduConfig** frame_table; /* Per node. */
+    size_t                       frame_count;
+
+    /* Tx LPDUs of all nodes (one per frame). */
+    NCodecPdu* tx_pdu;
+    uint8_t*   payload;
+
+    /* The NCodec objects (one, or one per node with --cluster). */
+    NCODEC** nc;
+    size_t   nc_count;
+} BenchCluster;
+
+
+static NCodecPduFlexrayNodeIdentifier node_ident(size_t node)
+{
+    return (NCodecPduFlexrayNodeIdentifier){
+        .node = { .ecu_id = (uint16_t)(node + 1), .cc_id = 0, .swc_id = 1 },
+    };
+}
+
+static ABCodecBusModel* bus_model(NCODEC* nc)
+{
+    return &((ABCodecInstance*)nc)->reader.bus_model;
+}
+
+/* The model which runs the schedule (the shared model of a cluster). */
+static FlexrayBusModel* engine_model(NCODEC* nc)
+{
+    FlexrayBusModel* m = bus_model(nc)->model;
+    return m->cluster ? &m->cluster->model : m;
+}
+
+/* Synthetic cluster configuration. Frames are assigned to the nodes in
+turn (Tx), all other nodes receive the frame (Rx). The static slots are
+sized to carry the payload, the dynamic segment (if not specified) is sized
+for all dynamic frames to be transmitted in each cycle. */
+static void configure_cluster(const BenchArgs* args, BenchCluster* cluster)
+{
+    uint32_t frame_bits = 80 + (uint32_t)args->payload * 8;
+    uint32_t static_slot_mt = (frame_bits + BITS_PER_MT - 1) / BITS_PER_MT;
+    uint32_t frame_minislots =
+        (40 + (uint32_t)args->payload * 8 + (MINISLOT_MT * BITS_PER_MT) - 1) /
+        (MINISLOT_MT * BITS_PER_MT);
+    uint32_t minislots = (uint32_t)args->minislots;
+    if (minislots == 0) {
+        minislots = (uint32_t)args->dynamic_slots * (frame_minislots + 1) + 1;
+    }
+    uint32_t nit_start =
+        static_slot_mt * (uint32_t)args->static_slots + minislots * MINISLOT_MT;
+    uint32_t cycle_mt = nit_start + NIT_MT;
+
+    cluster->config = (NCodecPduFlexrayConfig){
+        .bit_rate = NCodecPduFlexrayBitrate10,
+        .channel_enable = NCodecPduFlexrayChannelA,
+        .macrotick_per_cycle = cycle_mt,
+        .microtick_per_cycle = cycle_mt * MACRO2MICRO,
+        .network_idle_start = nit_start,
+        .static_slot_length = static_slot_mt,
+        .static_slot_count = (uint32_t)args->static_slots,
+        .minislot_length = MINISLOT_MT,
+        .minislot_count = minislots,
+        .static_slot_payload_length = (uint32_t)args->payload,
+        .inhibit_null_frames = true,
+        .initial_poc_state_cha = NCodecPduFlexrayPocStateNormalActive,
+    };
+
+    cluster->frame_count = args->static_slots + args->dynamic_slots;
+    cluster->frame_table =
+        calloc(args->nodes, sizeof(NCodecPduFlexrayLpduConfig*));
+    for (size_t n = 0; n < args->nodes; n++) {
+        NCodecPduFlexrayLpduConfig* table =
+            calloc(cluster->frame_count, sizeof(NCodecPduFlexrayLpduConfig));
+        for (size_t i = 0; i < cluster->frame_count; i++) {
+            uint8_t repetition = args->repetition[i % args->repetition_count];
+            table[i] = (NCodecPduFlexrayLpduConfig){
+                .slot_id = (uint16_t)(i + 1),
+                .payload_length = (uint8_t)args->payload,
+                .base_cycle = (uint8_t)(i % repetition),
+                .cycle_repetition = repetition,
+                .direction = (i % args->nodes == n)
+                                 ? NCodecPduFlexrayDirectionTx
+                                 : NCodecPduFlexrayDirectionRx,
+                .transmit_mode = args->single_shot
+                                     ? NCodecPduFlexrayTransmitModeSingleShot
+                                     : NCodecPduFlexrayTransmitModeContinuous,
+                .index = { .frame_table = (uint16_t)i },
+            };
+        }
+        cluster->frame_table[n] = table;
+    }
+
+    /* Tx LPDUs, all frames share one payload buffer. */
+    cluster->payload = calloc(1, args->payload + 1);
+    cluster->tx_pdu = calloc(cluster->frame_count, sizeof(NCodecPdu));
+    for (size_t i = 0; i < cluster->frame_count; i++) {
+        cluster->tx_pdu[i] = (NCodecPdu){
+            .id = (uint32_t)(i + 1),
+            .payload = cluster->payload,
+            .payload_len = args->payload,
+            .transport_type = NCodecPduTransportTypeFlexray,
+            .transport.flexray = {
+                .node_ident = node_ident(i % args->nodes),
+                .metadata_type = NCodecPduFlexrayMetadataTypeLpdu,
+                .metadata.lpdu = {
+                    .frame_config_index = (uint16_t)i,
+                    .status = NCodecPduFlexrayLpduStatusNotTransmitted,
+                },
+            },
+        };
+    }
+}
+
+static void release_cluster(const BenchArgs* args, BenchCluster* cluster)
+{
+    for (size_t i = 0; i < cluster->nc_count; i++) {
+        if (cluster->nc[i]) ncodec_close(cluster->nc[i]);
+    }
+    free(cluster->nc);
+    for (size_t n = 0; n < args->nodes; n++) {
+        free(cluster->frame_table[n]);
+    }
+    free(cluster->frame_table);
+    free(cluster->tx_pdu);
+    free(cluster->payload);
+}
+
+static NCODEC* open_node(size_t node, bool cluster)
+{
+    char mimetype[200];
+    snprintf(mimetype, sizeof(mimetype), MIMETYPE_FMT, node + 1,
+        cluster ? ";cluster=bench" : "");
+    NCODEC* nc = ncodec_open(mimetype, ncodec_buffer_stream_create(BUFFER_LEN));
+    if (nc == NULL) return NULL;
+    /* Measure the model, not the logging. */
+    ((ABCodecInstance*)nc)->log_level = NCODEC_LOG_QUIET;
+    return nc;
+}
+
+/* Consume the Config of each node, the first node also configures the
+Virtual Coldstart Nodes (VCN) which bring the bus to FrameSync. */
+static void consume_config(
+    const BenchArgs* args, BenchCluster* cluster, ABCodecBusModel* bm)
+{
+    for (size_t n = 0; n < args->nodes; n++) {
+        NCodecPduFlexrayConfig config = cluster->config;
+        config.node_ident = node_ident(n);
+        config.frame_config.table = cluster->frame_table[n];
+        config.frame_config.count = cluster->frame_count;
+        if (n == 0) {
+            config.vcn_count = 2;
+            config.vcn[0] = (NCodecPduFlexrayNodeIdentifier){
+                .node = { .ecu_id = 0xffff, .swc_id = 1 }
+            };
+            config.vcn[1] = (NCodecPduFlexrayNodeIdentifier){
+                .node = { .ecu_id = 0xffff, .swc_id = 2 }
+            };
+        }
+        NCodecPdu pdu = {
+            .transport_type = NCodecPduTransportTypeFlexray,
+            .transport.flexray = {
+                .node_ident = config.node_ident,
+                .metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+                .metadata.config = config,
+            },
+        };
+        flexray_bus_model_consume(bm, &pdu);
+    }
+}
+
+static void consume_tx(BenchCluster* cluster, ABCodecBusModel* bm)
+{
+    for (size_t i = 0; i < cluster->frame_count; i++) {
+        NCodecPdu pdu = cluster->tx_pdu[i];
+        flexray_bus_model_consume(bm, &pdu);
+    }
+}
+
+/* One simulation step of all NCodec objects, as the AB Codec reader
+(consume the PDUs of the step, then progress the Bus Model and encode the
+resultant PDUs to the Bus Model stream). */
+static void step_cluster(
+    const BenchArgs* args, BenchCluster* cluster, uint64_t step)
+{
+    double time = (double)step * args->step_size;
+
+    if (args->single_shot) cluster->payload[0] = (uint8_t)step;
+    for (size_t i = 0; i < cluster->nc_count; i++) {
+        ABCodecInstance* nc = (ABCodecInstance*)cluster->nc[i];
+        ABCodecBusModel* bm = bus_model(cluster->nc[i]);
+        nc->simulation_time.value = time;
+        if (args->single_shot) consume_tx(cluster, bm);
+    }
+    for (size_t i = 0; i < cluster->nc_count; i++) {
+        ABCodecBusModel* bm = bus_model(cluster->nc[i]);
+        ncodec_truncate((NCODEC*)bm->nc);
+        bm->simulation_time = time;
+        bm->step_size = args->step_size;
+        flexray_bus_model_progress(bm);
+        ncodec_flush((NCODEC*)bm->nc);
+    }
+}
+
+static size_t lpdu_count(FlexrayBusModel* m)
+{
+    size_t count = 0;
+    for (size_t i = 0; i < vector_len(&m->engine.slot_map); i++) {
+        VectorSlotMapItem* item = vector_at(&m->engine.slot_map, i, NULL);
+        count += vector_len(&item->lpdus);
+    }
+    return count;
+}
+
+int run_flexray_benchmark(const BenchArgs* args)
+{
+    int          rc = 0;
+    BenchCluster cluster = { 0 };
+
+    printf("\n");
+    printf("Setup Cluster\n");
+    printf("-------------\n");
+
+    configure_cluster(args, &cluster);
+    const int64_t  setup_bytes = heap.live_bytes;
+    const uint64_t setup_allocs = heap.alloc_count;
+    const double   setup_start = monotonic_seconds();
+
+    cluster.nc_count = args->cluster ? args->nodes : 1;
+    cluster.nc = calloc(cluster.nc_count, sizeof(NCODEC*));
+    for (size_t i = 0; i < cluster.nc_count; i++) {
+        cluster.nc[i] = open_node(i, args->cluster);
+        if (cluster.nc[i] == NULL) {
+            fprintf(stderr, "failed to create ncodec\n");
+            rc = 1;
+            goto cleanup;
+        }
+    }
+    const int64_t open_bytes = heap.live_bytes;
+    for (size_t i = 0; i < cluster.nc_count; i++) {
+        ABCodecBusModel* bm = bus_model(cluster.nc[i]);
+        consume_config(args, &cluster, bm);
+        if (args->single_shot == false) consume_tx(&cluster, bm);
+    }
+
+    const double     setup_end = monotonic_seconds();
+    FlexrayBusModel* m = engine_model(cluster.nc[0]);
+    printf("  cycle_length:      %.1f uSec\n",
+        (double)cluster.config.macrotick_per_cycle);
+    printf("  static_slot:       %u MT\n", cluster.config.static_slot_length);
+    printf("  minislots:         %u\n", cluster.config.minislot_count);
+    printf("  frames:            %zu\n", cluster.frame_count);
+    printf("  lpdus:             %zu\n", lpdu_count(m));
+    printf("  setup_time:        %.9f s\n", setup_end - setup_start);
+    printf("  setup_allocs:      %lu\n",
+        (unsigned long)(heap.alloc_count - setup_allocs));
+
+    /* Warm up, the first step also checks that the bus is running. */
+    uint64_t steps = 0;
+    step_cluster(args, &cluster, steps++);
+    if (m->state.bus_condition != NCodecPduFlexrayTransceiverStateFrameSync) {
+        fprintf(stderr, "bus not in FrameSync (bus_condition=%d)\n",
+            m->state.bus_condition);
+        rc = 1;
+        goto cleanup;
+    }
+    while (m->engine.stats.cycle_count < WARMUP_CYCLES) {
+        step_cluster(args, &cluster, steps++);
+    }
+
+    printf("\n");
+    printf("Run Benchmark\n");
+    printf("-------------\n");
+
+    const FlexrayEngineStats stats_start = m->engine.stats;
+    const uint64_t           allocs_start = heap.alloc_count;
+    const uint64_t           steps_start = steps;
+    heap.peak_bytes = heap.live_bytes;
+
+    const double wall_start = monotonic_seconds();
+    while (m->engine.stats.cycle_count - stats_start.cycle_count <
+           args->cycles) {
+        step_cluster(args, &cluster, steps++);
+    }
+    const double wall_end = monotonic_seconds();
+
+    const FlexrayEngineStats* stats = &m->engine.stats;
+    const uint64_t run_steps = steps - steps_start;
+    const uint64_t cycles = stats->cycle_count - stats_start.cycle_count;
+    const uint64_t slots = (stats->static_slot_count + stats->minislot_count) -
+                           (stats_start.static_slot_count +
+                               stats_start.minislot_count);
+    const uint64_t frames =
+        (stats->static_frame_count + stats->dynamic_frame_count) -
+        (stats_start.static_frame_count + stats_start.dynamic_frame_count);
+    const uint64_t null_frames =
+        stats->null_frame_count - stats_start.null_frame_count;
+    const uint64_t allocs = heap.alloc_count - allocs_start;
+    const double   wall_elapsed = wall_end - wall_start;
+    const double   wall_ns = wall_elapsed * 1000000000.0;
+    const double   simulated_elapsed = (double)run_steps * args->step_size;
+    const double   real_time_factor =
+        wall_elapsed > 0.0 ? simulated_elapsed / wall_elapsed : 0.0;
+    const size_t   lpdus = lpdu_count(m);
+    const int64_t  ncodec_bytes = heap.live_bytes - setup_bytes;
+    const int64_t  engine_bytes = heap.live_bytes - open_bytes;
+
+    printf("FlexRay benchmark result\n");
+    printf("  mode:              %s\n", args->cluster ? "cluster" : "engine");
+    printf("  nodes:             %zu\n", args->nodes);
+    printf("  static_slots:      %zu\n", args->static_slots);
+    printf("  dynamic_slots:     %zu\n", args->dynamic_slots);
+    printf("  cycle_repetition: ");
+    for (size_t i = 0; i < args->repetition_count; i++) {
+        printf("%s%u", i ? "," : " ", args->repetition[i]);
+    }
+    printf("\n");
+    printf("  payload:           %zu byte\n", args->payload);
+    printf("  transmit_mode:     %s\n",
+        args->single_shot ? "single-shot" : "continuous");
+    printf("  step_size:         %.1f uSec\n", args->step_size * 1000000.0);
+    printf("  simulated_time:    %.3f s\n", simulated_elapsed);
+    printf("  steps:             %lu\n", (unsigned long)run_steps);
+    printf("  cycles:            %lu\n", (unsigned long)cycles);
+    printf("  slots:             %lu\n", (unsigned long)slots);
+    printf("  frames:            %lu\n", (unsigned long)frames);
+    printf("  null_frames:       %lu\n", (unsigned long)null_frames);
+    printf("  wall_time:         %.9f s\n", wall_elapsed);
+    printf("  real_time_factor:  %.3f x\n", real_time_factor);
+    printf("  step cost:         %.3f uSec/step\n",
+        run_steps ? wall_ns / 1000.0 / (double)run_steps : 0.0);
+    printf("  cycle cost:        %.3f uSec/cycle\n",
+        cycles ? wall_ns / 1000.0 / (double)cycles : 0.0);
+    printf("  slot cost:         %.3f nSec/slot\n",
+        slots ? wall_ns / (double)slots : 0.0);
+    printf("  frame cost:        %.3f nSec/frame\n",
+        frames ? wall_ns / (double)frames : 0.0);
+    printf("  allocations:       %.3f /cycle\n",
+        cycles ? (double)allocs / (double)cycles : 0.0);
+    printf("  heap (ncodec):     %ld byte\n", (long)ncodec_bytes);
+    printf("  heap (engine):     %ld byte\n", (long)engine_bytes);
+    printf("  heap (peak):       %ld byte\n",
+        (long)(heap.peak_bytes - setup_bytes));
+    printf("  heap per lpdu:     %.1f byte\n",
+        lpdus ? (double)engine_bytes / (double)lpdus : 0.0);
+
+cleanup:
+    release_cluster(args, &cluster);
+    return rc;
+}
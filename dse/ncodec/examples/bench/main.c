@@ -0,0 +1,195 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <dse/ncodec/codec.h>
+
+#define REPETITION_MAX 8
+
+typedef struct BenchArgs {
+    size_t  nodes;
+    size_t  static_slots;
+    size_t  dynamic_slots;
+    size_t  minislots;
+    uint8_t repetition[REPETITION_MAX];
+    size_t  repetition_count;
+    size_t  payload;
+    size_t  cycles;
+    double  step_size;
+    bool    single_shot;
+    bool    cluster;
+} BenchArgs;
+
+int run_flexray_benchmark(const BenchArgs* args);
+
+NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream)
+{
+    NCODEC* nc = ncodec_create(mime_type);
+    if (nc) {
+        NCodecInstance* _nc = (NCodecInstance*)nc;
+        _nc->stream = stream;
+    }
+    return nc;
+}
+
+static void usage(const char* prog)
+{
+    fprintf(stderr,
+        "usage: %s [--nodes=<count>] [--static-slots=<count>] "
+        "[--dynamic-slots=<count>]\n"
+        "          [--minislots=<count>] [--cycle-repetition=<list>] "
+        "[--payload=<bytes>]\n"
+        "          [--cycles=<count>] [--step-size=<seconds>] "
+        "[--single-shot] [--cluster]\n"
+        "\n"
+        "example:\n"
+        "  %s --nodes=8 --static-slots=60 --dynamic-slots=40 "
+        "--cycle-repetition=1,2,4 --payload=32\n",
+        prog, prog);
+}
+
+static int parse_size_arg(const char* value, size_t* out)
+{
+    char* end = NULL;
+    errno = 0;
+
+    unsigned long long v = strtoull(value, &end, 10);
+    if (errno != 0 || end == value || *end != '\0') {
+        return -1;
+    }
+
+    *out = (size_t)v;
+    return 0;
+}
+
+static int parse_double_arg(const char* value, double* out)
+{
+    char* end = NULL;
+    errno = 0;
+
+    double v = strtod(value, &end);
+    if (errno != 0 || end == value || *end != '\0') {
+        return -1;
+    }
+
+    *out = v;
+    return 0;
+}
+
+/* Cycle repetition pattern, assigned to the frames in turn (e.g. "1,2,4"). */
+static int parse_repetition_arg(const char* value, BenchArgs* args)
+{
+    char* end = NULL;
+
+    args->repetition_count = 0;
+    do {
+        errno = 0;
+        unsigned long v = strtoul(value, &end, 10);
+        if (errno != 0 || end == value || (*end != ',' && *end != '\0')) {
+            return -1;
+        }
+        /* Valid repetitions are powers of 2 (1..64). */
+        if (v == 0 || v > 64 || (v & (v - 1)) != 0) return -1;
+        if (args->repetition_count == REPETITION_MAX) return -1;
+        args->repetition[args->repetition_count++] = (uint8_t)v;
+        value = end + 1;
+    } while (*end == ',');
+
+    return 0;
+}
+
+static int parse_args(int argc, char** argv, BenchArgs* args)
+{
+    args->nodes = 4;
+    args->static_slots = 60;
+    args->dynamic_slots = 20;
+    args->minislots = 0; /* Sized for the dynamic slots. */
+    args->repetition[0] = 1;
+    args->repetition_count = 1;
+    args->payload = 32;
+    args->cycles = 10000;
+    args->step_size = 0.0005;
+    args->single_shot = false;
+    args->cluster = false;
+
+    for (int i = 1; i < argc; i++) {
+        int rc = 0;
+        if (strncmp(argv[i], "--nodes=", 8) == 0) {
+            rc = parse_size_arg(argv[i] + 8, &args->nodes);
+        } else if (strncmp(argv[i], "--static-slots=", 15) == 0) {
+            rc = parse_size_arg(argv[i] + 15, &args->static_slots);
+        } else if (strncmp(argv[i], "--dynamic-slots=", 16) == 0) {
+            rc = parse_size_arg(argv[i] + 16, &args->dynamic_slots);
+        } else if (strncmp(argv[i], "--minislots=", 12) == 0) {
+            rc = parse_size_arg(argv[i] + 12, &args->minislots);
+        } else if (strncmp(argv[i], "--cycle-repetition=", 19) == 0) {
+            rc = parse_repetition_arg(argv[i] + 19, args);
+        } else if (strncmp(argv[i], "--payload=", 10) == 0) {
+            rc = parse_size_arg(argv[i] + 10, &args->payload);
+        } else if (strncmp(argv[i], "--cycles=", 9) == 0) {
+            rc = parse_size_arg(argv[i] + 9, &args->cycles);
+        } else if (strncmp(argv[i], "--step-size=", 12) == 0) {
+            rc = parse_double_arg(argv[i] + 12, &args->step_size);
+        } else if (strcmp(argv[i], "--single-shot") == 0) {
+            args->single_shot = true;
+        } else if (strcmp(argv[i], "--cluster") == 0) {
+            args->cluster = true;
+        } else if (strcmp(argv[i], "--help") == 0 ||
+                   strcmp(argv[i], "-h") == 0) {
+            usage(argv[0]);
+            exit(0);
+        } else {
+            fprintf(stderr, "unknown argument: %s\n", argv[i]);
+            return -1;
+        }
+        if (rc != 0) {
+            fprintf(stderr, "invalid argument value: %s\n", argv[i]);
+            return -1;
+        }
+    }
+
+    if (args->nodes == 0 || args->nodes > 64) {
+        fprintf(stderr, "--nodes must be 1..64\n");
+        return -1;
+    }
+    if (args->static_slots < 2 || args->static_slots > 1023) {
+        fprintf(stderr, "--static-slots must be 2..1023\n");
+        return -1;
+    }
+    if (args->static_slots + args->dynamic_slots > 2047) {
+        fprintf(stderr, "--static-slots + --dynamic-slots must be <= 2047\n");
+        return -1;
+    }
+    if (args->payload > 254) {
+        fprintf(stderr, "--payload must be 0..254\n");
+        return -1;
+    }
+    if (args->cycles == 0) {
+        fprintf(stderr, "--cycles must be > 0\n");
+        return -1;
+    }
+    if (args->step_size <= 0.0) {
+        fprintf(stderr, "--step-size must be > 0\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    BenchArgs args;
+
+    if (parse_args(argc, argv, &args) != 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    return run_flexray_benchmark(&args);
+}
@@ -430,4 +430,25 @@ typedef struct NCodecPdu {
     double pdu_time NCODEC_DEPRECATED("this field is deprecated");
 } NCodecPdu;
 
+
+/** PDU : Compact Descriptor
+    ------------------------
+
+    Compact representation of a PDU, for use with `ncodec_read_ref()` and
+    `ncodec_write_ref()`. The transport metadata is not decoded, instead
+    `metadata` is an opaque handle (owned by the codec) which can be passed,
+    with `transport_type`, to `ncodec_write_ref()` to forward the metadata.
+    Set `metadata` to NULL to write a PDU without transport metadata.
+*/
+
+typedef struct NCodecPduRef {
+    uint32_t               id;
+    uint32_t               swc_id;
+    const uint8_t*         payload;
+    size_t                 payload_len;
+    uint16_t               ecu_id;
+    NCodecPduTransportType transport_type;
+    const void*            metadata; /* Opaque handle (transport metadata). */
+} NCodecPduRef;
+
 #endif  // DSE_NCODEC_INTERFACE_PDU_H_
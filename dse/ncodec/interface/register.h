@@ -0,0 +1,95 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DSE_NCODEC_INTERFACE_REGISTER_H_
+#define DSE_NCODEC_INTERFACE_REGISTER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/** NCODEC API - Register/Stream
+    ============================
+
+    Types relating to the implementation of the Stream/Register interface of
+    the NCodec API. A virtual controller maps its message buffers (mailbox
+    registers) onto a Register File which is exchanged, in bulk, with a
+    single call to `ncodec_write()` or `ncodec_read()`.
+
+    The root type is `NCodecRegisterFile` which may be substituted for the
+    `NCodecMessage` type when calling NCodec API methods (e.g.
+   `ncodec_write()`).
+*/
+
+typedef enum NCodecRegisterDirection {
+    NCodecRegisterDirectionTx = 0,
+    NCodecRegisterDirectionRx = 1,
+} NCodecRegisterDirection;
+
+typedef enum NCodecRegisterStatus {
+    NCodecRegisterStatusNone = 0,
+    NCodecRegisterStatusRxError = 1,
+} NCodecRegisterStatus;
+
+typedef enum NCodecRegisterCanFrameType {
+    NCodecRegisterCanFrameTypeStandard = 0,
+    NCodecRegisterCanFrameTypeExtended = 1,
+} NCodecRegisterCanFrameType;
+
+typedef enum NCodecRegisterFlexrayChannel {
+    NCodecRegisterFlexrayChannelNone = 0,
+    NCodecRegisterFlexrayChannelA = 1,
+    NCodecRegisterFlexrayChannelB = 2,
+    NCodecRegisterFlexrayChannelBoth = 3,
+} NCodecRegisterFlexrayChannel;
+
+typedef struct NCodecRegisterBuffer {
+    /* Frame (message buffer content). */
+    uint32_t       frame_id; /* CAN ID, FlexRay Slot ID, (unused) Ethernet. */
+    const uint8_t* payload;
+    size_t         payload_len;
+
+    /* Buffer metadata. */
+    NCodecRegisterDirection direction;
+    NCodecRegisterStatus    status;
+
+    /* Bus specific metadata, selected by the `bus` MIME type parameter. */
+    union {
+        struct {
+            NCodecRegisterCanFrameType frame_type;
+            bool                       rtr;
+            bool                       can_fd_enabled;
+        } can;
+        struct {
+            uint8_t                      indicators; /* Frame indicator bits. */
+            NCodecRegisterFlexrayChannel channel_mask;
+            uint8_t                      cycle_period; /* 1..64 */
+            uint8_t                      cycle_offset; /* 0..63 */
+        } flexray;
+        struct {
+            uint64_t dst_mac; /* 48 bit MAC address. */
+            uint64_t src_mac; /* 48 bit MAC address. */
+            uint64_t vlan_tag;
+            uint16_t ether_type;
+        } ethernet;
+    } bus;
+
+    /* Timing metadata (optional), values in nSec. */
+    struct {
+        uint64_t send; /* Send request, by the controller. */
+        uint64_t arb;  /* Arbitration, on the bus. */
+        uint64_t recv; /* Reception, by the controller. */
+    } timing;
+} NCodecRegisterBuffer;
+
+typedef struct NCodecRegisterFile {
+    /* Write: the buffers to encode.
+       Read: buffers decoded by the codec (valid until the next call to
+       `ncodec_read()` or `ncodec_truncate()`). */
+    NCodecRegisterBuffer* buffer;
+    size_t                count;
+} NCodecRegisterFile;
+
+#endif  // DSE_NCODEC_INTERFACE_REGISTER_H_
@@ -0,0 +1,45 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef DSE_NCODEC_INTERFACE_SIGNAL_H_
+#define DSE_NCODEC_INTERFACE_SIGNAL_H_
+
+#include <stdint.h>
+#include <stdlib.h>
+
+
+/** NCODEC API - Signal/Stream
+    ==========================
+
+    Types relating to the implementation of the Stream/Signal interface of
+    the NCodec API. Scalar signals are exchanged as a vector of signal UIDs
+    and a vector of values, one call to `ncodec_write()` encodes the complete
+    vector and one call to `ncodec_read()` decodes the next vector.
+
+    The root type is `NCodecSignalVector` which may be substituted for the
+    `NCodecMessage` type when calling NCodec API methods (e.g.
+   `ncodec_write()`).
+*/
+
+typedef enum NCodecSignalVectorType {
+    NCodecSignalVectorTypeValue = 0, /* Signal values (SignalValue). */
+    NCodecSignalVectorTypeWrite = 1, /* Signal write request (SignalWrite). */
+} NCodecSignalVectorType;
+
+typedef struct NCodecSignalVector {
+    NCodecSignalVectorType type;
+    /* Write: the vectors to encode.
+       Read: vectors decoded by the codec (valid until the next call to
+       `ncodec_read()` or `ncodec_truncate()`). */
+    const uint32_t*        uid;
+    const double*          value;
+    size_t                 count;
+
+    /* Sender metadata (read). */
+    struct {
+        uint32_t model_uid;
+    } sender;
+} NCodecSignalVector;
+
+#endif  // DSE_NCODEC_INTERFACE_SIGNAL_H_
@@ -2,65 +2,475 @@
 //
 // SPDX-License-Identifier: Apache-2.0
 
+#include <errno.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
+#include <dse/ncodec/stream/stream.h>
+
+
+#define A85_POW4 52200625u /* 85^4 */
+#define A85_POW3 614125u   /* 85^3 */
+#define A85_POW2 7225u     /* 85^2 */
+
+
+/* Encode one group of 4 bytes (big endian) as 5 characters. */
+static inline void _encode_group(uint32_t x, char* en)
+{
+    en[0] = (char)(x / A85_POW4 + 33);
+    x %= A85_POW4;
+    en[1] = (char)(x / A85_POW3 + 33);
+    x %= A85_POW3;
+    en[2] = (char)(x / A85_POW2 + 33);
+    x %= A85_POW2;
+    en[3] = (char)(x / 85 + 33);
+    en[4] = (char)(x % 85 + 33);
+}
+
+static inline uint32_t _load_be32(const uint8_t* p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) |
+           ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/* Encode the complete groups of a block. A group of zeros is encoded as 'z'
+when at least 4 more bytes follow the group (as the first ASCII85
+implementation did), so a group is only encoded when the following 4 bytes
+are available or when the block is final. The partial (last) group is only
+encoded when the block is final. Returns the number of bytes consumed. */
+static size_t _encode_block(
+    const uint8_t* src, size_t len, char* en, size_t* en_len, bool final)
+{
+    size_t i = 0;
+    size_t n = 0;
+
+    /* Complete groups, with at least one following group. */
+    for (; i + 8 <= len; i += 4) {
+        uint32_t x = _load_be32(src + i);
+        if (x == 0) {
+            en[n++] = 'z';
+        } else {
+            _encode_group(x, en + n);
+            n += 5;
+        }
+    }
+    if (final) {
+        /* Remaining 1..7 bytes: a complete group followed by fewer than 4
+        bytes is not encoded as 'z'. */
+        for (; i + 4 <= len; i += 4) {
+            uint32_t x = _load_be32(src + i);
+            _encode_group(x, en + n);
+            n += 5;
+        }
+        size_t tail = len - i;
+        if (tail) {
+            uint8_t group[4] = { 0 };
+            memcpy(group, src + i, tail);
+            char chars[5];
+            _encode_group(_load_be32(group), chars);
+            memcpy(en + n, chars, tail + 1);
+            n += tail + 1;
+            i = len;
+        }
+    }
+    *en_len = n;
+    return i;
+}
 
 
 /**
- *  ncodec_ascii85_encode
+ *  ncodec_ascii85_encode_bound
  *
- *  Encode a binary string with ASCII85 encoding (to a null-terminated string).
+ *  The maximum length of the ASCII85 encoding of a binary string (excluding
+ *  the null-terminator). Also sufficient for a call to
+ *  ncodec_ascii85_encode_update() with an encoder (up to 7 bytes carried
+ *  from the previous call) when 7 is added to the source length.
  *
  *  Parameters
  *  ----------
- *  source : const char*
+ *  source_len : size_t
+ *      The length of the binary source string.
+ *
+ *  Returns
+ *  -------
+ *      size_t : Length of the encoded string.
+ */
+size_t ncodec_ascii85_encode_bound(size_t source_len)
+{
+    return (source_len + 3) / 4 * 5;
+}
+
+
+/**
+ *  ncodec_ascii85_encode_to
+ *
+ *  Encode a binary string with ASCII85 encoding into a caller buffer (as a
+ *  null-terminated string).
+ *
+ *  Parameters
+ *  ----------
+ *  source : const uint8_t*
  *      The binary string to be encoded.
  *
  *  source_len : size_t
  *      The length of the binary source string.
  *
+ *  dest : char*
+ *      Buffer for the encoded string.
+ *
+ *  dest_len : size_t
+ *      Length of the buffer, at least ncodec_ascii85_encode_bound() + 1.
+ *
  *  Returns
  *  -------
- *      char* : ASCII85 encoded string. Caller to free.
+ *      int64_t : Length of the encoded string (excluding the
+ *          null-terminator), or -ENOSPC if the buffer is too small.
  */
-char* ncodec_ascii85_encode(const char* source, size_t source_len)
+int64_t ncodec_ascii85_encode_to(
+    const uint8_t* source, size_t source_len, char* dest, size_t dest_len)
+{
+    if (dest == NULL || (source == NULL && source_len)) return -EINVAL;
+    if (dest_len < ncodec_ascii85_encode_bound(source_len) + 1) {
+        return -ENOSPC;
+    }
+    size_t len = 0;
+    _encode_block(source, source_len, dest, &len, true);
+    dest[len] = '\0';
+    return (int64_t)len;
+}
+
+
+/**
+ *  ncodec_ascii85_encode_update
+ *
+ *  Encode the next block of a binary string (streaming). Bytes which can
+ *  not be encoded yet are carried by the encoder to the next call, call
+ *  ncodec_ascii85_encode_final() after the last block. The encoded output
+ *  of all calls is equal to that of ncodec_ascii85_encode_to().
+ *
+ *  Parameters
+ *  ----------
+ *  encoder : NCodecAscii85Encoder*
+ *      Encoder state, zero initialised before the first call.
+ *
+ *  source : const uint8_t*
+ *      The next block of the binary string.
+ *
+ *  source_len : size_t
+ *      Length of the block.
+ *
+ *  dest : char*
+ *      Buffer for the encoded characters (not null-terminated).
+ *
+ *  dest_len : size_t
+ *      Length of the buffer, at least
+ *      ncodec_ascii85_encode_bound(source_len + 7).
+ *
+ *  Returns
+ *  -------
+ *      int64_t : Number of characters written, or -ENOSPC if the buffer is
+ *          too small (the block is not consumed).
+ */
+int64_t ncodec_ascii85_encode_update(NCodecAscii85Encoder* encoder,
+    const uint8_t* source, size_t source_len, char* dest, size_t dest_len)
 {
-    int required = (source_len + 3) / 4 * 5;
-    int padding = (source_len % 4) ? 4 - (source_len % 4) : 0;
-
-    /* Encode the source. */
-    char* en = calloc(required + 1, sizeof(char));
-    char* en_save = en;
-    while (source_len) {
-        uint32_t x = 0;
-        for (int chunk = 3; chunk >= 0; chunk--) {
-            x |= (uint8_t)*source << (chunk * 8);
-            source++;
-            /* Stop chunking if no more characters are available. */
-            if (--source_len == 0) break;
+    if (encoder == NULL || dest == NULL) return -EINVAL;
+    if (source == NULL && source_len) return -EINVAL;
+    if (dest_len < ncodec_ascii85_encode_bound(source_len + 7)) {
+        return -ENOSPC;
+    }
+    size_t n = 0;
+    size_t len = 0;
+
+    /* Carried bytes, a group is encoded when the carry is complete (the
+    group and the following 4 bytes). Then the following bytes are either
+    returned to the source, or remain in the carry. */
+    while (encoder->carry_len) {
+        size_t fill = sizeof(encoder->carry) - encoder->carry_len;
+        if (fill > source_len) fill = source_len;
+        memcpy(encoder->carry + encoder->carry_len, source, fill);
+        encoder->carry_len += fill;
+        source += fill;
+        source_len -= fill;
+        if (encoder->carry_len < sizeof(encoder->carry)) return (int64_t)n;
+
+        _encode_block(encoder->carry, 8, dest + n, &len, false);
+        n += len;
+        if (fill >= 4) {
+            source -= 4;
+            source_len += 4;
+            encoder->carry_len = 0;
+        } else {
+            memmove(encoder->carry, encoder->carry + 4, 4);
+            encoder->carry_len = 4;
         }
-        /* Special Case zero. */
-        if (x == 0 && source_len >= 4) {
-            en[0] = 'z';
-            en += 1;
-            continue;
+    }
+
+    size_t consumed = _encode_block(source, source_len, dest + n, &len, false);
+    n += len;
+    encoder->carry_len = source_len - consumed;
+    memcpy(encoder->carry, source + consumed, encoder->carry_len);
+    return (int64_t)n;
+}
+
+
+/**
+ *  ncodec_ascii85_encode_final
+ *
+ *  Complete a streaming encode, encoding the bytes carried by the encoder.
+ *  The encoder is reset.
+ *
+ *  Parameters
+ *  ----------
+ *  encoder : NCodecAscii85Encoder*
+ *      Encoder state.
+ *
+ *  dest : char*
+ *      Buffer for the encoded characters (not null-terminated).
+ *
+ *  dest_len : size_t
+ *      Length of the buffer, at least 10 characters.
+ *
+ *  Returns
+ *  -------
+ *      int64_t : Number of characters written, or -ENOSPC.
+ */
+int64_t ncodec_ascii85_encode_final(
+    NCodecAscii85Encoder* encoder, char* dest, size_t dest_len)
+{
+    if (encoder == NULL || dest == NULL) return -EINVAL;
+    if (dest_len < ncodec_ascii85_encode_bound(encoder->carry_len)) {
+        return -ENOSPC;
+    }
+    size_t len = 0;
+    _encode_block(encoder->carry, encoder->carry_len, dest, &len, true);
+    *encoder = (NCodecAscii85Encoder){ 0 };
+    return (int64_t)len;
+}
+
+
+/**
+ *  ncodec_ascii85_decode_update
+ *
+ *  Decode the next block of an ASCII85 encoded string (streaming). A
+ *  partial group is carried by the decoder to the next call, call
+ *  ncodec_ascii85_decode_final() after the last block.
+ *
+ *  Parameters
+ *  ----------
+ *  decoder : NCodecAscii85Decoder*
+ *      Decoder state, zero initialised before the first call.
+ *
+ *  source : const char*
+ *      The next block of the encoded string.
+ *
+ *  source_len : size_t
+ *      Length of the block.
+ *
+ *  dest : uint8_t*
+ *      Buffer for the decoded bytes.
+ *
+ *  dest_len : size_t
+ *      Length of the buffer, at least ncodec_ascii85_decode_bound().
+ *
+ *  Returns
+ *  -------
+ *      int64_t : Number of bytes written, -ENOSPC if the buffer is too
+ *          small, or -EINVAL if the source contains an invalid character.
+ */
+int64_t ncodec_ascii85_decode_update(NCodecAscii85Decoder* decoder,
+    const char* source, size_t source_len, uint8_t* dest, size_t dest_len)
+{
+    if (decoder == NULL || dest == NULL) return -EINVAL;
+    if (source == NULL && source_len) return -EINVAL;
+    if (dest_len < ncodec_ascii85_decode_bound(source_len)) return -ENOSPC;
+
+    const uint8_t* s = (const uint8_t*)source;
+    size_t         i = 0;
+    size_t         n = 0;
+    uint32_t       x = decoder->tuple;
+    uint32_t       count = decoder->count;
+    while (i < source_len) {
+        /* Fast path, complete groups. */
+        if (count == 0) {
+            while (i + 5 <= source_len) {
+                const uint8_t* g = s + i;
+                if (g[0] == 'z') break;
+                uint32_t d0 = g[0] - 33u;
+                uint32_t d1 = g[1] - 33u;
+                uint32_t d2 = g[2] - 33u;
+                uint32_t d3 = g[3] - 33u;
+                uint32_t d4 = g[4] - 33u;
+                if (d0 > 84 || d1 > 84 || d2 > 84 || d3 > 84 || d4 > 84) break;
+                uint32_t v =
+                    d0 * A85_POW4 + d1 * A85_POW3 + d2 * A85_POW2 + d3 * 85 + d4;
+                dest[n + 0] = (uint8_t)(v >> 24);
+                dest[n + 1] = (uint8_t)(v >> 16);
+                dest[n + 2] = (uint8_t)(v >> 8);
+                dest[n + 3] = (uint8_t)v;
+                n += 4;
+                i += 5;
+            }
+            if (i >= source_len) break;
+            if (s[i] == 'z') {
+                memset(dest + n, 0, 4);
+                n += 4;
+                i++;
+                continue;
+            }
+        }
+        /* Partial group (or a group spanning blocks). */
+        uint32_t d = s[i] - 33u;
+        if (d > 84) {
+            decoder->tuple = x;
+            decoder->count = count;
+            return -EINVAL;
         }
-        for (int byte = 4; byte >= 0; byte--) {
-            en[byte] = (x % 85) + 33;
-            x /= 85;
+        x = x * 85 + d;
+        i++;
+        if (++count == 5) {
+            dest[n + 0] = (uint8_t)(x >> 24);
+            dest[n + 1] = (uint8_t)(x >> 16);
+            dest[n + 2] = (uint8_t)(x >> 8);
+            dest[n + 3] = (uint8_t)x;
+            n += 4;
+            x = 0;
+            count = 0;
         }
-        en += 5;
     }
+    decoder->tuple = x;
+    decoder->count = count;
+    return (int64_t)n;
+}
 
-    /* Remove (essentially) the padded characters. */
-    for (int i = 1; i <= padding; i++) {
-        en_save[strlen(en_save) - 1] = '\0';
+
+/**
+ *  ncodec_ascii85_decode_final
+ *
+ *  Complete a streaming decode, decoding a carried partial group. The
+ *  decoder is reset.
+ *
+ *  Parameters
+ *  ----------
+ *  decoder : NCodecAscii85Decoder*
+ *      Decoder state.
+ *
+ *  dest : uint8_t*
+ *      Buffer for the decoded bytes (at least 3 bytes).
+ *
+ *  dest_len : size_t
+ *      Length of the buffer.
+ *
+ *  Returns
+ *  -------
+ *      int64_t : Number of bytes written, or -ENOSPC.
+ */
+int64_t ncodec_ascii85_decode_final(
+    NCodecAscii85Decoder* decoder, uint8_t* dest, size_t dest_len)
+{
+    if (decoder == NULL || dest == NULL) return -EINVAL;
+    size_t count = decoder->count;
+    if (count == 0) return 0;
+    if (dest_len < count - 1) return -ENOSPC;
+
+    /* Pad the partial group with 'u'. */
+    uint32_t x = decoder->tuple;
+    for (size_t i = count; i < 5; i++) {
+        x = x * 85 + 84;
+    }
+    for (size_t i = 0; i < count - 1; i++) {
+        dest[i] = (uint8_t)(x >> (24 - i * 8));
     }
+    *decoder = (NCodecAscii85Decoder){ 0 };
+    return (int64_t)(count - 1);
+}
+
 
-    return en_save;
+/**
+ *  ncodec_ascii85_decode_bound
+ *
+ *  The maximum length of the binary string decoded from an ASCII85 encoded
+ *  string (each character may be a 'z').
+ *
+ *  Parameters
+ *  ----------
+ *  source_len : size_t
+ *      The length of the encoded string.
+ *
+ *  Returns
+ *  -------
+ *      size_t : Length of the decoded binary string.
+ */
+size_t ncodec_ascii85_decode_bound(size_t source_len)
+{
+    return source_len * 4;
+}
+
+
+/**
+ *  ncodec_ascii85_decode_to
+ *
+ *  Decode an ASCII85 encoded string into a caller buffer.
+ *
+ *  Parameters
+ *  ----------
+ *  source : const char*
+ *      The ASCII85 string to be decoded.
+ *
+ *  source_len : size_t
+ *      Length of the ASCII85 string.
+ *
+ *  dest : uint8_t*
+ *      Buffer for the decoded binary string.
+ *
+ *  dest_len : size_t
+ *      Length of the buffer, at least ncodec_ascii85_decode_bound().
+ *
+ *  Returns
+ *  -------
+ *      int64_t : Length of the decoded binary string, -ENOSPC if the buffer
+ *          is too small, or -EINVAL if the source contains an invalid
+ *          character.
+ */
+int64_t ncodec_ascii85_decode_to(
+    const char* source, size_t source_len, uint8_t* dest, size_t dest_len)
+{
+    NCodecAscii85Decoder decoder = { 0 };
+    int64_t              n =
+        ncodec_ascii85_decode_update(&decoder, source, source_len, dest, dest_len);
+    if (n < 0) return n;
+    int64_t tail = ncodec_ascii85_decode_final(
+        &decoder, dest + n, dest_len - (size_t)n);
+    if (tail < 0) return tail;
+    return n + tail;
+}
+
+
+/**
+ *  ncodec_ascii85_encode
+ *
+ *  Encode a binary string with ASCII85 encoding (to a null-terminated string).
+ *
+ *  Parameters
+ *  ----------
+ *  source : const char*
+ *      The binary string to be encoded.
+ *
+ *  source_len : size_t
+ *      The length of the binary source string.
+ *
+ *  Returns
+ *  -------
+ *      char* : ASCII85 encoded string. Caller to free.
+ */
+char* ncodec_ascii85_encode(const char* source, size_t source_len)
+{
+    size_t len = ncodec_ascii85_encode_bound(source_len) + 1;
+    char*  en = malloc(len);
+    if (en == NULL) return NULL;
+    ncodec_ascii85_encode_to((const uint8_t*)source, source_len, en, len);
+    return en;
 }
 
 
@@ -84,55 +494,17 @@ char* ncodec_ascii85_encode(const char* source, size_t source_len)
  */
 char* ncodec_ascii85_decode(const char* source, size_t* len)
 {
-    /*
-    Decode is 5 -> 4, or 1 -> 4 for 'z' case. Calculate parameters with
-    necessary corrections.
-    */
-    int z_count = 0;
-    for (const char* p = source; *p; p++) {
-        if (*p == 'z') z_count++;
+    size_t source_len = strlen(source);
+    size_t bound = ncodec_ascii85_decode_bound(source_len);
+    char*  de = malloc(bound + 1);
+    if (de == NULL) return NULL;
+    int64_t n = ncodec_ascii85_decode_to(source, source_len, (uint8_t*)de, bound);
+    if (n < 0) {
+        free(de);
+        *len = 0;
+        return NULL;
     }
-    int required = (strlen(source) - z_count + 4) / 5 * 4 + z_count * 4;
-    int source_len = strlen(source) + z_count * 4;
-    int padding = (source_len % 5) ? (5 - (source_len % 5)) : 0;
-
-    /* Pad the source string. */
-    int   padded_len = strlen(source) + padding;
-    char* source_padded = calloc(padded_len + 1, sizeof(char));
-    snprintf(source_padded, padded_len + 1, "%s", source);
-    for (int i = 0; i < padding; i++) {
-        source_padded[strlen(source) + i] = 'u';
-    }
-
-    /* Decode the source. */
-    char* en = calloc(required + 1, sizeof(char));
-    char* en_walker = en;
-    char* src_walker = source_padded;
-    while (padded_len > 0) {
-        uint32_t x = 0;
-        if (src_walker[0] == 'z') {
-            padded_len--;
-            src_walker += 1;
-        } else {
-            for (int chunk = 0; chunk <= 4; chunk++) {
-                x = x * 85 + (src_walker[chunk] - 33);
-                padded_len--;
-            }
-            src_walker += 5;
-        }
-        for (int byte = 3; byte >= 0; byte--) {
-            *en_walker = x >> (byte * 8);
-            en_walker++;
-        }
-    }
-    free(source_padded);
-
-    /* Correct the padding. */
-    for (int i = 1; i <= padding; i++) {
-        en[required - i] = '\0';
-    }
-
-    /* Return the decoded binary string, and length. */
-    *len = required - padding;
-    return en;
+    de[n] = '\0';
+    *len = (size_t)n;
+    return de;
 }
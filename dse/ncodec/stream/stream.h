@@ -13,8 +13,32 @@
 DLL_PUBLIC NSTREAM* ncodec_buffer_stream_create(size_t buffer_size);
 
 /* ascii85.c */
-DLL_PUBLIC char* ncodec_ascii85_encode(const char* source, size_t source_len);
-DLL_PUBLIC char* ncodec_ascii85_decode(const char* source, size_t* len);
+typedef struct NCodecAscii85Encoder {
+    uint8_t carry[8];
+    size_t  carry_len;
+} NCodecAscii85Encoder;
+
+typedef struct NCodecAscii85Decoder {
+    uint32_t tuple;
+    uint32_t count;
+} NCodecAscii85Decoder;
+
+DLL_PUBLIC char*   ncodec_ascii85_encode(const char* source, size_t source_len);
+DLL_PUBLIC char*   ncodec_ascii85_decode(const char* source, size_t* len);
+DLL_PUBLIC size_t  ncodec_ascii85_encode_bound(size_t source_len);
+DLL_PUBLIC size_t  ncodec_ascii85_decode_bound(size_t source_len);
+DLL_PUBLIC int64_t ncodec_ascii85_encode_to(
+    const uint8_t* source, size_t source_len, char* dest, size_t dest_len);
+DLL_PUBLIC int64_t ncodec_ascii85_decode_to(
+    const char* source, size_t source_len, uint8_t* dest, size_t dest_len);
+DLL_PUBLIC int64_t ncodec_ascii85_encode_update(NCodecAscii85Encoder* encoder,
+    const uint8_t* source, size_t source_len, char* dest, size_t dest_len);
+DLL_PUBLIC int64_t ncodec_ascii85_encode_final(
+    NCodecAscii85Encoder* encoder, char* dest, size_t dest_len);
+DLL_PUBLIC int64_t ncodec_ascii85_decode_update(NCodecAscii85Decoder* decoder,
+    const char* source, size_t source_len, uint8_t* dest, size_t dest_len);
+DLL_PUBLIC int64_t ncodec_ascii85_decode_final(
+    NCodecAscii85Decoder* decoder, uint8_t* dest, size_t dest_len);
 
 
 #endif  // DSE_NCODEC_STREAM_STREAM_H_
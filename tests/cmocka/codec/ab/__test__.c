@@ -8,10 +8,12 @@
 uint8_t __log_level__ = LOG_QUIET; /* LOG_QUIET LOG_INFO LOG_DEBUG LOG_TRACE */
 
 extern int run_codec_tests(void);
+extern int run_ascii85_tests(void);
 
 int main()
 {
     int rc = 0;
     rc |= run_codec_tests();
+    rc |= run_ascii85_tests();
     return rc;
 }
@@ -0,0 +1,391 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/pdu.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    1024
+#define WARMUP_STEPS  25
+#define AUDIT_STEPS   200
+
+
+extern NCODEC* ncodec_create(const char* mime_type);
+
+NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream)
+{
+    NCODEC* nc = ncodec_create(mime_type);
+    if (nc) {
+        NCodecInstance* _nc = (NCodecInstance*)nc;
+        _nc->stream = stream;
+    }
+    return nc;
+}
+
+
+/* Allocation audit, the allocators are interposed by the linker
+(-Wl,--wrap=malloc etc.) and count calls while the audit is enabled. */
+extern void* __real_malloc(size_t size);
+extern void* __real_calloc(size_t nmemb, size_t size);
+extern void* __real_realloc(void* ptr, size_t size);
+extern void  __real_free(void* ptr);
+
+static struct {
+    volatile bool enabled;
+    volatile bool fail_realloc;
+    size_t        alloc_count;
+    size_t        free_count;
+} __audit;
+
+void* __wrap_malloc(size_t size)
+{
+    if (__audit.enabled) __sync_fetch_and_add(&__audit.alloc_count, 1);
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t nmemb, size_t size)
+{
+    if (__audit.enabled) __sync_fetch_and_add(&__audit.alloc_count, 1);
+    return __real_calloc(nmemb, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    if (__audit.fail_realloc) return NULL;
+    if (__audit.enabled) __sync_fetch_and_add(&__audit.alloc_count, 1);
+    return __real_realloc(ptr, size);
+}
+
+void __wrap_free(void* ptr)
+{
+    if (__audit.enabled && ptr) __sync_fetch_and_add(&__audit.free_count, 1);
+    __real_free(ptr);
+}
+
+static void audit_start(void)
+{
+    __audit.alloc_count = 0;
+    __audit.free_count = 0;
+    __audit.enabled = true;
+}
+
+static void audit_stop(void)
+{
+    __audit.enabled = false;
+    __audit.fail_realloc = false;
+}
+
+
+typedef struct Mock {
+    NCODEC* nc;
+} Mock;
+
+
+#define MIMETYPE_CAN                                                           \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "swc_id=4;ecu_id=5"
+#define MIMETYPE_FLEXRAY                                                       \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "ecu_id=1;vcn=2;model=flexray"
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    audit_stop();
+    if (mock && mock->nc) ncodec_close((void*)mock->nc);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static void _can_step(NCODEC* nc, size_t step, bool pipelined)
+{
+    static const char* payload = "Hello World (step)";
+    int                rc;
+
+    ncodec_truncate(nc);
+    for (size_t i = 0; i < 8; i++) {
+        rc = ncodec_write(nc, &(struct NCodecPdu){
+                                  .id = 0x100 + i,
+                                  .payload = (const uint8_t*)payload,
+                                  .payload_len = 1 + (step + i) % 16,
+                                  .swc_id = 42,
+                                  .ecu_id = 24,
+                                  .transport_type = NCodecPduTransportTypeCan,
+                                  .transport.can_message = {
+                                      .frame_format =
+                                          NCodecPduCanFrameFormatFdBase,
+                                      .interface_id = 1,
+                                      .network_id = 2,
+                                  } });
+        assert_int_equal(rc, 1 + (step + i) % 16);
+    }
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+
+    if (pipelined) {
+        rc = ncodec_step_begin(nc);
+        assert_int_equal(rc, 0);
+    }
+    size_t    count = 0;
+    NCodecPdu pdu;
+    while (ncodec_read(nc, &pdu) >= 0) {
+        assert_int_equal(pdu.id, 0x100 + count);
+        count++;
+    }
+    assert_int_equal(count, 8);
+}
+
+
+void test_alloc__can(void** state)
+{
+    Mock* mock = *state;
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE_CAN, stream);
+    assert_non_null(mock->nc);
+
+    for (size_t step = 0; step < WARMUP_STEPS; step++) {
+        _can_step(mock->nc, step, false);
+    }
+    audit_start();
+    for (size_t step = 0; step < AUDIT_STEPS; step++) {
+        _can_step(mock->nc, step, false);
+    }
+    audit_stop();
+    assert_int_equal(__audit.alloc_count, 0);
+    assert_int_equal(__audit.free_count, 0);
+}
+
+
+void test_alloc__can_pipelined(void** state)
+{
+    Mock* mock = *state;
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE_CAN, stream);
+    assert_non_null(mock->nc);
+
+    for (size_t step = 0; step < WARMUP_STEPS; step++) {
+        _can_step(mock->nc, step, true);
+    }
+    audit_start();
+    for (size_t step = 0; step < AUDIT_STEPS; step++) {
+        _can_step(mock->nc, step, true);
+    }
+    audit_stop();
+    assert_int_equal(__audit.alloc_count, 0);
+    assert_int_equal(__audit.free_count, 0);
+}
+
+
+static NCodecPduFlexrayLpduConfig frame_table[] = {
+    {
+        .slot_id = 7,
+        .payload_length = 16,
+        .cycle_repetition = 1,
+        .index = { .frame_table = 0 },
+        .direction = NCodecPduFlexrayDirectionTx,
+        .transmit_mode = NCodecPduFlexrayTransmitModeContinuous,
+        .status = NCodecPduFlexrayLpduStatusNotTransmitted,
+    },
+    {
+        .slot_id = 7,
+        .payload_length = 16,
+        .cycle_repetition = 1,
+        .index = { .frame_table = 1 },
+        .direction = NCodecPduFlexrayDirectionRx,
+        .status = NCodecPduFlexrayLpduStatusNotReceived,
+    },
+    {
+        .slot_id = 41,
+        .payload_length = 16,
+        .cycle_repetition = 2,
+        .index = { .frame_table = 2 },
+        .direction = NCodecPduFlexrayDirectionTx,
+        .transmit_mode = NCodecPduFlexrayTransmitModeSingleShot,
+        .status = NCodecPduFlexrayLpduStatusNotTransmitted,
+    },
+    {
+        .slot_id = 41,
+        .payload_length = 16,
+        .cycle_repetition = 2,
+        .index = { .frame_table = 3 },
+        .direction = NCodecPduFlexrayDirectionRx,
+        .status = NCodecPduFlexrayLpduStatusNotReceived,
+    },
+};
+
+
+static void _flexray_setup(NCODEC* nc)
+{
+    NCodecPduFlexrayConfig config = {
+        .bit_rate = NCodecPduFlexrayBitrate10,
+        .channel_enable = NCodecPduFlexrayChannelA,
+        .macrotick_per_cycle = 3361u,
+        .microtick_per_cycle = 200000u,
+        .network_idle_start = (3361u - 5u - 1u),
+        .static_slot_length = 55u,
+        .static_slot_count = 38u,
+        .minislot_length = 6u,
+        .minislot_count = 211u,
+        .static_slot_payload_length = (32u * 2),
+        .frame_config = { .count = ARRAY_SIZE(frame_table),
+            .table = frame_table },
+    };
+    ncodec_truncate(nc);
+    ncodec_write(nc, &(NCodecPdu){ .transport_type =
+                                       NCodecPduTransportTypeFlexray,
+                         .transport.flexray = {
+                             .metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+                             .metadata.config = config,
+                         } });
+    NCodecPduFlexrayPocCommand commands[] = {
+        NCodecPduFlexrayCommandConfig,
+        NCodecPduFlexrayCommandReady,
+        NCodecPduFlexrayCommandRun,
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(commands); i++) {
+        ncodec_write(nc,
+            &(NCodecPdu){ .transport_type = NCodecPduTransportTypeFlexray,
+                .transport.flexray = {
+                    .metadata_type = NCodecPduFlexrayMetadataTypeStatus,
+                    .metadata.status = {
+                        .channel[0].poc_command = commands[i],
+                    } } });
+    }
+    ncodec_flush(nc);
+}
+
+
+static size_t _flexray_step(NCODEC* nc, size_t step)
+{
+    static const char* payload = "0123456789ABCDEF";
+    size_t             rx_count = 0;
+
+    /* Read (the Bus Model runs), then write the Tx LPDUs for the next step. */
+    NCodecPdu pdu;
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    while (ncodec_read(nc, &pdu) >= 0) {
+        if (pdu.transport.flexray.metadata_type !=
+            NCodecPduFlexrayMetadataTypeLpdu)
+            continue;
+        if (pdu.payload_len) rx_count++;
+    }
+    ncodec_truncate(nc);
+    for (size_t i = 0; i < 2; i++) {
+        ncodec_write(nc,
+            &(NCodecPdu){ .id = frame_table[i * 2].slot_id,
+                .payload = (const uint8_t*)payload + (step % 8),
+                .payload_len = 8,
+                .transport_type = NCodecPduTransportTypeFlexray,
+                .transport.flexray = {
+                    .metadata_type = NCodecPduFlexrayMetadataTypeLpdu,
+                    .metadata.lpdu = {
+                        .frame_config_index = i * 2,
+                        .status = NCodecPduFlexrayLpduStatusNotTransmitted,
+                    } } });
+    }
+    ncodec_flush(nc);
+    return rx_count;
+}
+
+
+void test_alloc__flexray(void** state)
+{
+    Mock* mock = *state;
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE_FLEXRAY, stream);
+    assert_non_null(mock->nc);
+
+    /* Warmup: startup and several cycles (the Rx payloads are allocated). */
+    _flexray_setup(mock->nc);
+    for (size_t step = 0; step < WARMUP_STEPS; step++) {
+        _flexray_step(mock->nc, step);
+    }
+    size_t rx_count = 0;
+    audit_start();
+    for (size_t step = 0; step < AUDIT_STEPS; step++) {
+        rx_count += _flexray_step(mock->nc, step);
+    }
+    audit_stop();
+    assert_true(rx_count >= AUDIT_STEPS / 10);
+    assert_int_equal(__audit.alloc_count, 0);
+    assert_int_equal(__audit.free_count, 0);
+}
+
+
+void test_alloc__chunk_enomem(void** state)
+{
+    Mock*     mock = *state;
+    NCodecPdu pdu;
+    int       rc;
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE_CAN ";chunk_pdus=2", stream);
+    assert_non_null(mock->nc);
+    for (size_t step = 0; step < WARMUP_STEPS; step++) {
+        _can_step(mock->nc, step, false);
+    }
+
+    /* The chunk buffer can not grow, the write reports the lost chunk. */
+    ncodec_truncate(mock->nc);
+    __audit.fail_realloc = true;
+    int    enomem = 0;
+    size_t written = 0;
+    for (size_t i = 0; i < 64; i++) {
+        rc = ncodec_write(mock->nc, &(struct NCodecPdu){ .id = 0x100 + i,
+                                        .payload = (const uint8_t*)"burst",
+                                        .payload_len = 5,
+                                        .swc_id = 42 });
+        if (rc == -ENOMEM) enomem++;
+        if (rc == 5 && (i % 2) == 1) written += 2;
+    }
+    __audit.fail_realloc = false;
+    assert_true(enomem > 0);
+    ncodec_flush(mock->nc);
+    ncodec_seek(mock->nc, 0, NCODEC_SEEK_SET);
+    size_t count = 0;
+    while (ncodec_read(mock->nc, &pdu) >= 0) {
+        count++;
+    }
+    assert_int_equal(count, written);
+}
+
+
+int run_alloc_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_alloc__can, s, t),
+        cmocka_unit_test_setup_teardown(test_alloc__can_pipelined, s, t),
+        cmocka_unit_test_setup_teardown(test_alloc__flexray, s, t),
+        cmocka_unit_test_setup_teardown(test_alloc__chunk_enomem, s, t),
+    };
+
+    return cmocka_run_group_tests_name("ALLOC", tests, NULL, NULL);
+}
@@ -10,7 +10,15 @@ uint8_t __log_level__ = LOG_QUIET; /* LOG_QUIET LOG_INFO LOG_DEBUG LOG_TRACE */
 extern int run_pdu_tests(void);
 extern int run_pdu_can_tests(void);
 extern int run_pdu_ip_tests(void);
+extern int run_pdu_some_ip_tp_tests(void);
 extern int run_pdu_struct_tests(void);
+extern int run_struct_abi_tests(void);
+extern int run_pdu_step_tests(void);
+extern int run_pdu_snapshot_tests(void);
+extern int run_pdu_multi_bus_tests(void);
+extern int run_simbus_tests(void);
+extern int run_can_bus_model_tests(void);
+extern int run_ethernet_bus_model_tests(void);
 extern int run_pdu_flexray_tests(void);
 extern int run_pdu_flexray_engine_tests(void);
 extern int run_pdu_flexray_state_tests(void);
@@ -27,7 +35,15 @@ int main()
     rc |= run_pdu_tests();
     rc |= run_pdu_can_tests();
     rc |= run_pdu_ip_tests();
+    rc |= run_pdu_some_ip_tp_tests();
     rc |= run_pdu_struct_tests();
+    rc |= run_struct_abi_tests();
+    rc |= run_pdu_step_tests();
+    rc |= run_pdu_snapshot_tests();
+    rc |= run_pdu_multi_bus_tests();
+    rc |= run_simbus_tests();
+    rc |= run_can_bus_model_tests();
+    rc |= run_ethernet_bus_model_tests();
     rc |= run_pdu_flexray_tests();
     rc |= run_pdu_flexray_engine_tests();
     rc |= run_pdu_flexray_state_tests();
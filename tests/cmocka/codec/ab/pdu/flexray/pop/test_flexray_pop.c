@@ -2861,6 +2861,142 @@ void macrotick_estimation__lpdu_adjust__retard(void** state)
     flexray_harness_run_pop_test(&mock->test);
 }
 
+void pop_router__payload_arena(void** state)
+{
+    NCODEC* nc = ncodec_open(
+        testnode_POP.mimetype, ncodec_buffer_stream_create(16384));
+    assert_non_null(nc);
+    ABCodecBusModel*    bm = &((ABCodecInstance*)nc)->reader.bus_model;
+    FlexrayPopBusModel* m = bm->model;
+    assert_non_null(m);
+
+    uint8_t small[16];
+    uint8_t large[5000];
+    for (size_t step = 0; step < 2; step++) {
+        /* Node -> PoP, routed LPDUs (payloads are copied to the arena). */
+        memset(small, 0x11 + step, sizeof(small));
+        memset(large, 0x22 + step, sizeof(large));
+        NCodecPdu pdu = {
+            .id = 5,
+            .payload = small,
+            .payload_len = sizeof(small),
+            .transport_type = NCodecPduTransportTypeFlexray,
+            .transport.flexray.node_ident = { .node.ecu_id = 1 },
+            .transport.flexray.metadata_type = NCodecPduFlexrayMetadataTypeLpdu,
+        };
+        assert_true(bm->vtable.consume(bm, &pdu));
+        pdu.id = 6;
+        pdu.payload = large;
+        pdu.payload_len = sizeof(large);
+        assert_true(bm->vtable.consume(bm, &pdu));
+        memset(small, 0, sizeof(small));
+        memset(large, 0, sizeof(large));
+
+        /* Progress, the PoP route is written to the model NC. */
+        NCODEC* model_nc = (NCODEC*)bm->nc;
+        ncodec_truncate(model_nc);
+        bm->vtable.progress(bm);
+        ncodec_flush(model_nc);
+        ncodec_seek(model_nc, 0, NCODEC_SEEK_SET);
+        NCodecPdu rx = { 0 };
+        assert_int_equal(sizeof(small), ncodec_read(model_nc, &rx));
+        assert_int_equal(5, rx.id);
+        assert_int_equal(0x11 + step, rx.payload[0]);
+        assert_int_equal(0x11 + step, rx.payload[sizeof(small) - 1]);
+        assert_int_equal(sizeof(large), ncodec_read(model_nc, &rx));
+        assert_int_equal(6, rx.id);
+        assert_int_equal(0x22 + step, rx.payload[sizeof(large) - 1]);
+
+        /* The arena blocks are retained (and reused) across steps. */
+        assert_int_equal(2, vector_len(&m->arena.block_list));
+        assert_int_equal(0, m->arena.index);
+    }
+
+    ncodec_close(nc);
+}
+
+void macrotick_estimation__coarse_step(void** state)
+{
+    NCODEC* nc = ncodec_open(
+        testnode_POP.mimetype, ncodec_buffer_stream_create(16384));
+    assert_non_null(nc);
+    ABCodecBusModel*    bm = &((ABCodecInstance*)nc)->reader.bus_model;
+    FlexrayPopBusModel* m = bm->model;
+    assert_non_null(m);
+    assert_double_equal(SIM_STEP_SIZE, bm->step_size, 0.0);
+
+    /* Controller -> PoP : Config, step budget from the codec step size. */
+    NCodecPdu pdu = {
+        .transport_type = NCodecPduTransportTypeFlexray,
+        .transport.flexray.metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+        .transport.flexray.metadata.config = config,
+    };
+    assert_true(bm->vtable.consume(bm, &pdu));
+    uint32_t step_budget_mt = m->config.step_budget_mt;
+    assert_int_equal(338, step_budget_mt);
+
+    /* Coarse step (20x), the budget spans 2 cycles. */
+    bm->step_size = SIM_STEP_SIZE * 20;
+    bm->vtable.progress(bm);
+    assert_int_equal(6779, m->config.step_budget_mt);
+
+    /* Controller -> PoP : Status (no macrotick). */
+    pdu = (NCodecPdu){
+        .transport_type = NCodecPduTransportTypeFlexray,
+        .transport.flexray.metadata_type = NCodecPduFlexrayMetadataTypeStatus,
+        .transport.flexray.metadata.status.cycle = 5,
+        .transport.flexray.metadata.status.channel[0].tcvr_state =
+            NCodecPduFlexrayTransceiverStateFrameSync,
+    };
+    assert_true(bm->vtable.consume(bm, &pdu));
+    assert_int_equal(5, m->status.pos_cycle);
+    assert_int_equal(0, m->status.pos_mt);
+
+    /* Multi-cycle catch-up, 6779 mt = 2 cycles + 57 mt. */
+    pdu.transport.flexray.metadata.status.cycle = 7;
+    assert_true(bm->vtable.consume(bm, &pdu));
+    assert_int_equal(7, m->status.pos_cycle);
+    assert_int_equal(57, m->status.pos_mt);
+
+    /* Cycle wrap (63 -> 0). */
+    m->status.pos_cycle = 62;
+    pdu.transport.flexray.metadata.status.cycle = 0;
+    assert_true(bm->vtable.consume(bm, &pdu));
+    assert_int_equal(0, m->status.pos_cycle);
+    assert_int_equal(114, m->status.pos_mt);
+
+    /* The PoP reports the advanced cycle, catch-up is kept (0 -> 2). */
+    pdu.transport.flexray.metadata.status.cycle = 2;
+    assert_true(bm->vtable.consume(bm, &pdu));
+    assert_int_equal(2, m->status.pos_cycle);
+    assert_int_equal(171, m->status.pos_mt);
+
+    /* The PoP lags the estimate (2 -> 4), estimated macrotick is kept. */
+    pdu.transport.flexray.metadata.status.cycle = 3;
+    assert_true(bm->vtable.consume(bm, &pdu));
+    assert_int_equal(3, m->status.pos_cycle);
+    assert_int_equal(228, m->status.pos_mt);
+
+    /* The PoP is ahead of the estimate, resync to the start of the cycle. */
+    pdu.transport.flexray.metadata.status.cycle = 10;
+    assert_true(bm->vtable.consume(bm, &pdu));
+    assert_int_equal(10, m->status.pos_cycle);
+    assert_int_equal(0, m->status.pos_mt);
+
+    /* Step of exactly one cycle, the macrotick wraps to 0. */
+    m->config.step_budget_mt = 3361;
+    assert_true(bm->vtable.consume(bm, &pdu));
+    assert_int_equal(10, m->status.pos_cycle);
+    assert_int_equal(0, m->status.pos_mt);
+    pdu.transport.flexray.metadata.status.cycle = 11;
+    m->status.pos_mt = 10;
+    assert_true(bm->vtable.consume(bm, &pdu));
+    assert_int_equal(11, m->status.pos_cycle);
+    assert_int_equal(10, m->status.pos_mt);
+
+    ncodec_close(nc);
+}
+
 void single_node__tx_rx(void** state)
 {
     Mock* mock = *state;
@@ -2906,6 +3042,8 @@ int run_pdu_flexray_pop(void)
         T(macrotick_estimation__lpdu_adjust__static_part, s, t),
         T(macrotick_estimation__lpdu_adjust__dynamic_part, s, t),
         T(macrotick_estimation__lpdu_adjust__retard, s, t),
+        T(macrotick_estimation__coarse_step, s, t),
+        T(pop_router__payload_arena, s, t),
         T(single_node__tx_rx, s, t),
         T(multi_node__tx_rx, s, t),
         T(single_node__wup, s, t),
@@ -0,0 +1,373 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/pdu.h>
+#include <dse/ncodec/codec/ab/can/can.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    1024
+#define FRAME_COUNT   10
+#define QUEUE_COUNT   5000
+
+
+extern NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream);
+
+
+typedef struct Mock {
+    NCODEC* nc;
+} Mock;
+
+
+typedef struct RxRecord {
+    uint32_t count;
+    uint32_t id[100];
+} RxRecord;
+
+
+#define MIMETYPE                                                               \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "swc_id=1;ecu_id=1;model=can"
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE, stream);
+    assert_non_null(mock->nc);
+    ncodec_truncate(mock->nc);
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock && mock->nc) ncodec_close((void*)mock->nc);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static void _write_frame(NCODEC* nc, uint32_t id, uint8_t swc_id,
+    NCodecPduCanFrameFormat frame_format)
+{
+    int rc = ncodec_write(nc, &(NCodecPdu){
+                                  .id = id,
+                                  .payload = (const uint8_t*)"12345678",
+                                  .payload_len = 8,
+                                  .swc_id = swc_id,
+                                  .transport_type = NCodecPduTransportTypeCan,
+                                  .transport.can_message = {
+                                      .frame_format = frame_format,
+                                  },
+                              });
+    assert_int_equal(rc, 8);
+}
+
+
+/* Run one step, returns the number of frames received. */
+static uint32_t _run_step(NCODEC* nc, RxRecord* record)
+{
+    uint32_t  count = 0;
+    NCodecPdu pdu;
+
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    while (ncodec_read(nc, &pdu) >= 0) {
+        assert_int_equal(pdu.transport_type, NCodecPduTransportTypeCan);
+        assert_int_equal(pdu.payload_len, 8);
+        assert_memory_equal(pdu.payload, "12345678", 8);
+        if (record && record->count < ARRAY_SIZE(record->id)) {
+            record->id[record->count++] = pdu.id;
+        }
+        count++;
+    }
+    ncodec_truncate(nc);
+    return count;
+}
+
+
+void test_can_bus_model__frame_bits(void** state)
+{
+    UNUSED(state);
+
+    /* CAN, worst-case stuffing. */
+    assert_int_equal(can_frame_bits(NCodecPduCanFrameFormatBase,
+                         NCodecPduCanFrameTypeData, 8, NULL),
+        135);
+    assert_int_equal(can_frame_bits(NCodecPduCanFrameFormatExtended,
+                         NCodecPduCanFrameTypeData, 8, NULL),
+        160);
+    assert_int_equal(can_frame_bits(NCodecPduCanFrameFormatBase,
+                         NCodecPduCanFrameTypeData, 0, NULL),
+        55);
+    assert_int_equal(can_frame_bits(NCodecPduCanFrameFormatBase,
+                         NCodecPduCanFrameTypeRemote, 8, NULL),
+        55);
+
+    /* CAN FD, arbitration and data phase. */
+    uint32_t data_bits = 0;
+    assert_int_equal(can_frame_bits(NCodecPduCanFrameFormatFdBase,
+                         NCodecPduCanFrameTypeData, 64, &data_bits),
+        34);
+    assert_int_equal(data_bits, 678);
+    /* Payload rounded up to the next DLC length (17 -> 20). */
+    uint32_t data_bits_17 = 0;
+    uint32_t data_bits_20 = 0;
+    can_frame_bits(NCodecPduCanFrameFormatFdBase, NCodecPduCanFrameTypeData,
+        17, &data_bits_17);
+    can_frame_bits(NCodecPduCanFrameFormatFdBase, NCodecPduCanFrameTypeData,
+        20, &data_bits_20);
+    assert_int_equal(data_bits_17, data_bits_20);
+
+    /* Duration, 500 kbit/s and 2 Mbit/s. */
+    CanBusModel m = { .bitrate = 500000, .fd_bitrate = 2000000 };
+    assert_int_equal(can_frame_duration_ns(&m, NCodecPduCanFrameFormatBase,
+                         NCodecPduCanFrameTypeData, 8),
+        270000);
+    assert_int_equal(can_frame_duration_ns(&m, NCodecPduCanFrameFormatFdBase,
+                         NCodecPduCanFrameTypeData, 64),
+        68000 + 339000);
+}
+
+
+void test_can_bus_model__arbitration_key(void** state)
+{
+    UNUSED(state);
+    NCodecPduCanFrameFormat base = NCodecPduCanFrameFormatBase;
+    NCodecPduCanFrameFormat ext = NCodecPduCanFrameFormatExtended;
+    NCodecPduCanFrameType   data = NCodecPduCanFrameTypeData;
+    NCodecPduCanFrameType   remote = NCodecPduCanFrameTypeRemote;
+
+    /* Lower identifier wins. */
+    assert_true(can_frame_key(0x100, base, data) <
+                can_frame_key(0x101, base, data));
+    /* Data frame wins over remote frame. */
+    assert_true(
+        can_frame_key(0x100, base, data) < can_frame_key(0x100, base, remote));
+    /* Base frame wins over extended frame (same base identifier). */
+    assert_true(can_frame_key(0x100, base, data) <
+                can_frame_key(0x100 << 18, ext, data));
+    /* Base identifier is arbitrated before the extended identifier. */
+    assert_true(can_frame_key((0x100 << 18) | 0x3ffff, ext, data) <
+                can_frame_key(0x101, base, data));
+    assert_true(can_frame_key((0x100 << 18) | 1, ext, data) <
+                can_frame_key((0x100 << 18) | 2, ext, data));
+}
+
+
+void test_can_bus_model__queue(void** state)
+{
+    UNUSED(state);
+    CanBusModel m = { .queue = vector_make(sizeof(CanFrame), 0, NULL) };
+
+    /* Pseudo random identifiers, popped in arbitration order. */
+    uint32_t x = 42;
+    for (size_t i = 0; i < QUEUE_COUNT; i++) {
+        x = x * 1103515245 + 12345;
+        uint32_t id = (x >> 16) & 0x7ff;
+        CanFrame frame = { .id = id,
+            .key = can_frame_key(
+                id, NCodecPduCanFrameFormatBase, NCodecPduCanFrameTypeData) };
+        assert_int_equal(can_queue_push(&m, &frame), 0);
+    }
+    CanFrame last = { 0 };
+    for (size_t i = 0; i < QUEUE_COUNT; i++) {
+        CanFrame frame;
+        assert_int_equal(can_queue_pop(&m, &frame), 0);
+        if (i) {
+            assert_true(frame.key >= last.key);
+            /* Equal keys are sent in FIFO order. */
+            if (frame.key == last.key) assert_true(frame.seq > last.seq);
+        }
+        last = frame;
+    }
+    CanFrame frame;
+    assert_int_equal(can_queue_pop(&m, &frame), -ENOMSG);
+    vector_reset(&m.queue);
+}
+
+
+void test_can_bus_model__arbitration(void** state)
+{
+    Mock*    mock = *state;
+    NCODEC*  nc = mock->nc;
+    RxRecord record = { 0 };
+
+    /* Frames queued in reverse priority order. */
+    for (uint32_t id = FRAME_COUNT; id > 0; id--) {
+        _write_frame(nc, 0x100 + id, 2, NCodecPduCanFrameFormatBase);
+    }
+    for (size_t step = 0; step < FRAME_COUNT; step++) {
+        _run_step(nc, &record);
+    }
+    assert_int_equal(record.count, FRAME_COUNT);
+    for (uint32_t i = 0; i < FRAME_COUNT; i++) {
+        assert_int_equal(record.id[i], 0x101 + i);
+    }
+}
+
+
+void test_can_bus_model__latency(void** state)
+{
+    Mock*    mock = *state;
+    NCODEC*  nc = mock->nc;
+    RxRecord record = { 0 };
+
+    /* 500 kbit/s and 0.5 ms step, 250 bits/step (8 byte frame, 135 bits). */
+    for (uint32_t id = 0; id < FRAME_COUNT; id++) {
+        _write_frame(nc, 0x200 + id, 2, NCodecPduCanFrameFormatBase);
+    }
+    assert_int_equal(_run_step(nc, &record), 1);
+    /* A frame in transmission is not preempted. */
+    _write_frame(nc, 0x010, 2, NCodecPduCanFrameFormatBase);
+    assert_int_equal(_run_step(nc, &record), 2);
+    assert_int_equal(record.id[1], 0x201);
+    assert_int_equal(record.id[2], 0x010);
+    uint32_t total = record.count;
+    while (total < FRAME_COUNT + 1) {
+        uint32_t count = _run_step(nc, &record);
+        assert_true(count >= 1 && count <= 2);
+        total += count;
+    }
+    assert_int_equal(_run_step(nc, &record), 0);
+}
+
+
+void test_can_bus_model__bus_load(void** state)
+{
+    Mock*            mock = *state;
+    NCODEC*          nc = mock->nc;
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    CanBusModel*     m = _nc->reader.bus_model.model;
+    assert_non_null(m);
+    assert_int_equal(m->bitrate, CAN_DEFAULT_BITRATE);
+    assert_int_equal(m->fd_bitrate, CAN_DEFAULT_FD_BITRATE);
+
+    /* Saturated bus. */
+    for (uint32_t id = 0; id < FRAME_COUNT; id++) {
+        _write_frame(nc, 0x300 + id, 2, NCodecPduCanFrameFormatBase);
+    }
+    _run_step(nc, NULL);
+    _run_step(nc, NULL);
+    assert_true(m->stats.step_load == 1.0);
+
+    /* Idle bus. */
+    while (_run_step(nc, NULL))
+        ;
+    assert_true(m->stats.step_load == 0.0);
+    assert_int_equal(m->stats.frame_count, FRAME_COUNT);
+    assert_int_equal(m->stats.busy_ns, FRAME_COUNT * 270000);
+    assert_true(m->stats.elapsed_ns > m->stats.busy_ns);
+}
+
+
+void test_can_bus_model__filter(void** state)
+{
+    Mock*            mock = *state;
+    NCODEC*          nc = mock->nc;
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    CanBusModel*     m = _nc->reader.bus_model.model;
+    RxRecord         record = { 0 };
+
+    /* Frames sent by this node occupy the bus but are not received. */
+    _write_frame(nc, 0x400, 0, NCodecPduCanFrameFormatBase);
+    _write_frame(nc, 0x401, 2, NCodecPduCanFrameFormatBase);
+    for (size_t step = 0; step < 4; step++) {
+        _run_step(nc, &record);
+    }
+    assert_int_equal(record.count, 1);
+    assert_int_equal(record.id[0], 0x401);
+    assert_int_equal(m->stats.frame_count, 2);
+}
+
+
+void test_can_bus_model__bitrate(void** state)
+{
+    UNUSED(state);
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*  nc = (void*)ncodec_open(
+        MIMETYPE ";bitrate=1000000;fd_bitrate=5000000", stream);
+    assert_non_null(nc);
+    CanBusModel* m = ((ABCodecInstance*)nc)->reader.bus_model.model;
+    assert_non_null(m);
+    assert_int_equal(m->bitrate, 1000000);
+    assert_int_equal(m->fd_bitrate, 5000000);
+
+    /* 1 Mbit/s and 0.5 ms step, 3 frames per step (135 us). */
+    ncodec_truncate(nc);
+    for (uint32_t id = 0; id < FRAME_COUNT; id++) {
+        _write_frame(nc, 0x500 + id, 2, NCodecPduCanFrameFormatBase);
+    }
+    assert_int_equal(_run_step(nc, NULL), 3);
+    ncodec_close(nc);
+}
+
+
+void test_can_bus_model__snapshot(void** state)
+{
+    Mock*    mock = *state;
+    NCODEC*  nc = mock->nc;
+    RxRecord expect = { 0 };
+    RxRecord actual = { 0 };
+    void*    data = NULL;
+    size_t   len = 0;
+    int      rc;
+
+    for (uint32_t id = 0; id < FRAME_COUNT; id++) {
+        _write_frame(nc, 0x600 + (id * 7) % FRAME_COUNT, 2,
+            NCodecPduCanFrameFormatBase);
+    }
+    _run_step(nc, NULL);
+
+    /* Queue and in-flight frame are included in the snapshot. */
+    rc = ncodec_snapshot(nc, &data, &len);
+    assert_int_equal(rc, 0);
+    for (size_t step = 0; step < FRAME_COUNT; step++) {
+        _run_step(nc, &expect);
+    }
+    rc = ncodec_restore(nc, data, len);
+    assert_int_equal(rc, 0);
+    for (size_t step = 0; step < FRAME_COUNT; step++) {
+        _run_step(nc, &actual);
+    }
+    assert_int_equal(expect.count, FRAME_COUNT - 1);
+    assert_memory_equal(&actual, &expect, sizeof(expect));
+    free(data);
+}
+
+
+int run_can_bus_model_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_can_bus_model__frame_bits),
+        cmocka_unit_test(test_can_bus_model__arbitration_key),
+        cmocka_unit_test(test_can_bus_model__queue),
+        cmocka_unit_test_setup_teardown(test_can_bus_model__arbitration, s, t),
+        cmocka_unit_test_setup_teardown(test_can_bus_model__latency, s, t),
+        cmocka_unit_test_setup_teardown(test_can_bus_model__bus_load, s, t),
+        cmocka_unit_test_setup_teardown(test_can_bus_model__filter, s, t),
+        cmocka_unit_test_setup_teardown(test_can_bus_model__bitrate, s, t),
+        cmocka_unit_test_setup_teardown(test_can_bus_model__snapshot, s, t),
+    };
+
+    return cmocka_run_group_tests_name("CAN BUS MODEL", tests, NULL, NULL);
+}
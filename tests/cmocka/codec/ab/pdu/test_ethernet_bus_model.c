@@ -0,0 +1,374 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/pdu.h>
+#include <dse/ncodec/codec/ab/ethernet/ethernet.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    1024
+#define MAC_COUNT     1000
+#define PAYLOAD_LEN   100
+
+#define MAC_NODE1 0x020000000001ULL
+#define MAC_NODE2 0x020000000002ULL
+#define MAC_NODE3 0x020000000003ULL
+#define MAC_BCAST 0xffffffffffffULL
+
+
+extern NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream);
+
+
+typedef struct Mock {
+    NCODEC* nc;
+} Mock;
+
+
+typedef struct RxRecord {
+    uint32_t count;
+    uint32_t id[100];
+} RxRecord;
+
+
+#define MIMETYPE                                                               \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "swc_id=1;ecu_id=1;model=ethernet"
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE, stream);
+    assert_non_null(mock->nc);
+    ncodec_truncate(mock->nc);
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock && mock->nc) ncodec_close((void*)mock->nc);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static void _write_ip(NCODEC* nc, uint32_t id, uint8_t swc_id, uint64_t src,
+    uint64_t dst, uint8_t pcp)
+{
+    static uint8_t payload[PAYLOAD_LEN];
+    int            rc = ncodec_write(nc,
+                   &(NCodecPdu){
+                       .id = id,
+                       .payload = payload,
+                       .payload_len = PAYLOAD_LEN,
+                       .swc_id = swc_id,
+                       .transport_type = NCodecPduTransportTypeIp,
+                       .transport.ip_message = {
+                           .eth_src_mac = src,
+                           .eth_dst_mac = dst,
+                           .eth_tci_pcp = pcp,
+                           .ip_protocol = NCodecPduIpProtocolUdp,
+                           .ip_addr_type = NCodecPduIpAddrIPv4,
+                       },
+                   });
+    assert_int_equal(rc, PAYLOAD_LEN);
+}
+
+
+/* Run one step, returns the number of frames received. */
+static uint32_t _run_step(NCODEC* nc, RxRecord* record)
+{
+    uint32_t  count = 0;
+    NCodecPdu pdu;
+
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    while (ncodec_read(nc, &pdu) >= 0) {
+        assert_int_equal(pdu.transport_type, NCodecPduTransportTypeIp);
+        assert_int_equal(pdu.payload_len, PAYLOAD_LEN);
+        if (record && record->count < ARRAY_SIZE(record->id)) {
+            record->id[record->count++] = pdu.id;
+        }
+        count++;
+    }
+    ncodec_truncate(nc);
+    return count;
+}
+
+
+void test_ethernet_bus_model__frame_bits(void** state)
+{
+    UNUSED(state);
+    NCodecPduIpMessageMetadata udp = {
+        .ip_protocol = NCodecPduIpProtocolUdp,
+        .ip_addr_type = NCodecPduIpAddrIPv4,
+    };
+    NCodecPduIpMessageMetadata none = { 0 };
+
+    /* Preamble, header, IPv4/UDP, payload, FCS and IFG. */
+    assert_int_equal(eth_frame_bits(&udp, 100), (38 + 28 + 100) * 8);
+    /* Minimum frame size. */
+    assert_int_equal(eth_frame_bits(&none, 0), (38 + 46) * 8);
+    /* VLAN tag. */
+    udp.eth_tci_vid = 5;
+    assert_int_equal(eth_frame_bits(&udp, 100), (42 + 28 + 100) * 8);
+    /* Larger than MTU, 3 frames. */
+    udp.eth_tci_vid = 0;
+    assert_int_equal(eth_frame_bits(&udp, 3000), (3 * 38 + 3000 + 46) * 8);
+}
+
+
+void test_ethernet_bus_model__mac_table(void** state)
+{
+    UNUSED(state);
+    EthMacTable t = { 0 };
+
+    assert_int_equal(eth_mac_lookup(&t, MAC_NODE1, 0), -ENOENT);
+    for (uint32_t i = 1; i <= MAC_COUNT; i++) {
+        assert_int_equal(eth_mac_learn(&t, i, 0, i % 40), 0);
+    }
+    assert_int_equal(t.count, MAC_COUNT);
+    for (uint32_t i = 1; i <= MAC_COUNT; i++) {
+        assert_int_equal(eth_mac_lookup(&t, i, 0), i % 40);
+    }
+    /* Same MAC, different VLAN. */
+    assert_int_equal(eth_mac_lookup(&t, 1, 2), -ENOENT);
+    eth_mac_learn(&t, 1, 2, 7);
+    assert_int_equal(eth_mac_lookup(&t, 1, 2), 7);
+    assert_int_equal(eth_mac_lookup(&t, 1, 0), 1);
+    /* Station moves to another port. */
+    eth_mac_learn(&t, 1, 0, 9);
+    assert_int_equal(eth_mac_lookup(&t, 1, 0), 9);
+    assert_int_equal(t.count, MAC_COUNT + 1);
+    /* MAC 0 is not learned. */
+    assert_int_equal(eth_mac_learn(&t, 0, 0, 1), -EINVAL);
+    eth_mac_release(&t);
+}
+
+
+void test_ethernet_bus_model__switch(void** state)
+{
+    Mock*             mock = *state;
+    NCODEC*           nc = mock->nc;
+    EthernetBusModel* m = ((ABCodecInstance*)nc)->reader.bus_model.model;
+    RxRecord          record = { 0 };
+    assert_non_null(m);
+    assert_int_equal(m->port, 1);
+    assert_int_equal(m->bitrate, ETH_DEFAULT_BITRATE);
+
+    /* Step 1: learning. */
+    _write_ip(nc, 1, 2, MAC_NODE2, MAC_BCAST, 0); /* Broadcast. */
+    _write_ip(nc, 2, 3, MAC_NODE3, MAC_NODE2, 0); /* Port 2. */
+    _write_ip(nc, 3, 2, MAC_NODE2, MAC_NODE1, 0); /* Unknown, flood. */
+    _write_ip(nc, 4, 1, MAC_NODE1, MAC_NODE2, 0); /* Sent by this node. */
+    assert_int_equal(_run_step(nc, &record), 2);
+    assert_int_equal(record.id[0], 1);
+    assert_int_equal(record.id[1], 3);
+    assert_int_equal(m->mac_table.count, 3);
+
+    /* Step 2: only frames for this node are delivered. */
+    _write_ip(nc, 5, 3, MAC_NODE3, MAC_NODE2, 0);
+    _write_ip(nc, 6, 2, MAC_NODE2, MAC_NODE1, 0);
+    _write_ip(nc, 7, 2, MAC_NODE2, MAC_NODE3, 0);
+    _write_ip(nc, 8, 3, MAC_NODE3, MAC_NODE1, 0);
+    assert_int_equal(_run_step(nc, &record), 2);
+    assert_int_equal(record.id[2], 6);
+    assert_int_equal(record.id[3], 8);
+
+    assert_int_equal(m->stats.frame_count, 4);
+    assert_int_equal(m->stats.filtered_count, 4);
+    assert_int_equal(m->stats.flood_count, 2);
+}
+
+
+extern bool ethernet_bus_model_consume(ABCodecBusModel* bm, NCodecPdu* pdu);
+static uint32_t __consume_count;
+static bool     __consume(ABCodecBusModel* bm, NCodecPdu* pdu)
+{
+    __consume_count++;
+    return ethernet_bus_model_consume(bm, pdu);
+}
+
+void test_ethernet_bus_model__filter(void** state)
+{
+    Mock*             mock = *state;
+    NCODEC*           nc = mock->nc;
+    ABCodecBusModel*  bm = &((ABCodecInstance*)nc)->reader.bus_model;
+    EthernetBusModel* m = bm->model;
+    RxRecord          record = { 0 };
+    assert_non_null(bm->vtable.filter);
+
+    /* Step 1: learning. */
+    _write_ip(nc, 1, 2, MAC_NODE2, MAC_BCAST, 0);
+    _write_ip(nc, 2, 3, MAC_NODE3, MAC_BCAST, 0);
+    assert_int_equal(_run_step(nc, &record), 2);
+
+    /* Step 2: frames for other ports are not decoded (not consumed). */
+    __consume_count = 0;
+    bm->vtable.consume = __consume;
+    _write_ip(nc, 3, 3, MAC_NODE3, MAC_NODE2, 0); /* Port 2, filtered. */
+    _write_ip(nc, 4, 2, MAC_NODE2, MAC_NODE1, 0); /* Unknown, flood. */
+    _write_ip(nc, 5, 2, MAC_NODE2, MAC_NODE3, 0); /* Port 3, filtered. */
+    _write_ip(nc, 6, 3, MAC_NODE3, MAC_BCAST, 0); /* Broadcast. */
+    assert_int_equal(_run_step(nc, &record), 2);
+    assert_int_equal(record.id[2], 4);
+    assert_int_equal(record.id[3], 6);
+    assert_int_equal(__consume_count, 2);
+    assert_false(m->forwarded);
+
+    /* Stats are counted once per frame (filter, not consume). */
+    assert_int_equal(m->stats.frame_count, 4);
+    assert_int_equal(m->stats.filtered_count, 2);
+    assert_int_equal(m->stats.flood_count, 4);
+}
+
+
+void test_ethernet_bus_model__passthrough(void** state)
+{
+    Mock*            mock = *state;
+    NCODEC*          nc = mock->nc;
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    NCodecPdu        pdu = {};
+
+    /* A FlexRay Config PDU is not consumed by the Bus Model, and is decoded
+    once (one frame table allocated). */
+    NCodecPduFlexrayLpduConfig frame_table[2] = {
+        { .slot_id = 7, .payload_length = 8 },
+        { .slot_id = 9, .payload_length = 8 },
+    };
+    int rc = ncodec_write(nc,
+        &(NCodecPdu){ .swc_id = 2,
+            .transport_type = NCodecPduTransportTypeFlexray,
+            .transport.flexray = {
+                .metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+                .metadata.config = {
+                    .frame_config = { .count = 2, .table = frame_table } },
+            } });
+    assert_int_equal(rc, 0);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    assert_int_equal(ncodec_read(nc, &pdu), 0);
+    assert_int_equal(pdu.transport_type, NCodecPduTransportTypeFlexray);
+    NCodecPduFlexrayConfig* config = &pdu.transport.flexray.metadata.config;
+    assert_int_equal(config->frame_config.count, 2);
+    assert_int_equal(config->frame_config.table[1].slot_id, 9);
+    assert_int_equal(vector_len(&_nc->free_list), 1);
+    assert_int_equal(ncodec_read(nc, &pdu), -ENOMSG);
+    ncodec_truncate(nc);
+}
+
+
+void test_ethernet_bus_model__priority(void** state)
+{
+    Mock*    mock = *state;
+    NCODEC*  nc = mock->nc;
+    RxRecord record = { 0 };
+
+    /* Egress in priority (PCP) order, FIFO within a priority. */
+    _write_ip(nc, 1, 2, MAC_NODE2, MAC_BCAST, 0);
+    _write_ip(nc, 2, 2, MAC_NODE2, MAC_BCAST, 7);
+    _write_ip(nc, 3, 2, MAC_NODE2, MAC_BCAST, 3);
+    _write_ip(nc, 4, 2, MAC_NODE2, MAC_BCAST, 7);
+    assert_int_equal(_run_step(nc, &record), 4);
+    uint32_t expect[] = { 2, 4, 3, 1 };
+    assert_memory_equal(record.id, expect, sizeof(expect));
+}
+
+
+void test_ethernet_bus_model__bandwidth(void** state)
+{
+    UNUSED(state);
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*  nc = (void*)ncodec_open(MIMETYPE ";bitrate=10000000", stream);
+    assert_non_null(nc);
+    EthernetBusModel* m = ((ABCodecInstance*)nc)->reader.bus_model.model;
+    assert_int_equal(m->bitrate, 10000000);
+
+    /* 10 Mbit/s and 0.5 ms step, 5000 bits/step (frame 1328 bits). */
+    ncodec_truncate(nc);
+    for (uint32_t id = 0; id < 10; id++) {
+        _write_ip(nc, id, 2, MAC_NODE2, MAC_BCAST, 0);
+    }
+    assert_int_equal(_run_step(nc, NULL), 3);
+    assert_true(m->stats.step_load == 1.0);
+    assert_int_equal(_run_step(nc, NULL), 4);
+    assert_int_equal(_run_step(nc, NULL), 3);
+    assert_int_equal(_run_step(nc, NULL), 0);
+    assert_int_equal(m->stats.frame_count, 10);
+    ncodec_close(nc);
+}
+
+
+void test_ethernet_bus_model__snapshot(void** state)
+{
+    UNUSED(state);
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*  nc = (void*)ncodec_open(MIMETYPE ";bitrate=10000000", stream);
+    RxRecord expect = { 0 };
+    RxRecord actual = { 0 };
+    void*    data = NULL;
+    size_t   len = 0;
+    int      rc;
+
+    ncodec_truncate(nc);
+    for (uint32_t id = 0; id < 10; id++) {
+        _write_ip(nc, id, 2, MAC_NODE2, MAC_BCAST, id % 8);
+    }
+    _run_step(nc, NULL);
+
+    /* MAC table, queues and in-flight frame are included in the snapshot. */
+    rc = ncodec_snapshot(nc, &data, &len);
+    assert_int_equal(rc, 0);
+    _write_ip(nc, 20, 3, MAC_NODE3, MAC_NODE2, 0); /* Filtered (learned). */
+    for (size_t step = 0; step < 4; step++) {
+        _run_step(nc, &expect);
+    }
+    rc = ncodec_restore(nc, data, len);
+    assert_int_equal(rc, 0);
+    _write_ip(nc, 20, 3, MAC_NODE3, MAC_NODE2, 0);
+    for (size_t step = 0; step < 4; step++) {
+        _run_step(nc, &actual);
+    }
+    assert_int_equal(expect.count, 7);
+    assert_memory_equal(&actual, &expect, sizeof(expect));
+    free(data);
+    ncodec_close(nc);
+}
+
+
+int run_ethernet_bus_model_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test(test_ethernet_bus_model__frame_bits),
+        cmocka_unit_test(test_ethernet_bus_model__mac_table),
+        cmocka_unit_test_setup_teardown(test_ethernet_bus_model__switch, s, t),
+        cmocka_unit_test_setup_teardown(test_ethernet_bus_model__filter, s, t),
+        cmocka_unit_test_setup_teardown(
+            test_ethernet_bus_model__passthrough, s, t),
+        cmocka_unit_test_setup_teardown(
+            test_ethernet_bus_model__priority, s, t),
+        cmocka_unit_test(test_ethernet_bus_model__bandwidth),
+        cmocka_unit_test(test_ethernet_bus_model__snapshot),
+    };
+
+    return cmocka_run_group_tests_name("ETHERNET BUS MODEL", tests, NULL, NULL);
+}
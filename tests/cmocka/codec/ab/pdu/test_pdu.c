@@ -367,6 +367,245 @@ void test_pdu_fbs_readwrite_messages(void** state)
 }
 
 
+void test_pdu_fbs_chunked_flush(void** state)
+{
+    UNUSED(state);
+    int rc;
+
+    const char* greeting = "Hello World";
+    const char* mime_types[] = {
+        MIMETYPE ";chunk_pdus=2",
+        MIMETYPE ";chunk_bytes=64",
+    };
+
+    for (size_t i = 0; i < ARRAY_SIZE(mime_types); i++) {
+        NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+        NCODEC*  nc = (void*)ncodec_open(mime_types[i], stream);
+        assert_non_null(nc);
+
+        // Write PDUs, chunks are held by the codec until flush.
+        ncodec_seek(nc, 0, NCODEC_SEEK_RESET);
+        for (uint32_t id = 1; id <= 5; id++) {
+            rc = ncodec_write(nc, &(struct NCodecPdu){ .id = id,
+                                      .payload = (uint8_t*)greeting,
+                                      .payload_len = strlen(greeting),
+                                      .swc_id = 42,
+                                      .ecu_id = 24 });
+            assert_int_equal(rc, strlen(greeting));
+        }
+        assert_int_equal(ncodec_tell(nc), 0);
+        size_t len = ncodec_flush(nc);
+        assert_true(len > 0);
+        assert_int_equal(ncodec_tell(nc), len);
+
+        // Read the PDUs back, from the several Stream messages.
+        ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+        for (uint32_t id = 1; id <= 5; id++) {
+            NCodecPdu pdu = {};
+            len = ncodec_read(nc, &pdu);
+            assert_int_equal(len, strlen(greeting));
+            assert_int_equal(pdu.id, id);
+            assert_memory_equal(pdu.payload, greeting, strlen(greeting));
+        }
+        NCodecPdu pdu = {};
+        rc = ncodec_read(nc, &pdu);
+        assert_int_equal(rc, -ENOMSG);
+
+        ncodec_close(nc);
+    }
+}
+
+
+void test_pdu_fbs_chunked_interleave(void** state)
+{
+    UNUSED(state);
+    int rc;
+
+    const char* greeting = "Hello World";
+    const char* reply = "Hello Again";
+    NSTREAM*    stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*     nc = (void*)ncodec_open(MIMETYPE ";chunk_pdus=1", stream);
+    assert_non_null(nc);
+
+    // Stream with 3 PDUs.
+    ncodec_seek(nc, 0, NCODEC_SEEK_RESET);
+    for (uint32_t id = 1; id <= 3; id++) {
+        ncodec_write(nc, &(struct NCodecPdu){ .id = id,
+                             .payload = (uint8_t*)greeting,
+                             .payload_len = strlen(greeting),
+                             .swc_id = 42,
+                             .ecu_id = 24 });
+    }
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+
+    // Read one PDU, then write PDUs (each a chunk) before reading the rest.
+    NCodecPdu first = {};
+    size_t    len = ncodec_read(nc, &first);
+    assert_int_equal(len, strlen(greeting));
+    assert_int_equal(first.id, 1);
+    for (uint32_t id = 10; id <= 12; id++) {
+        rc = ncodec_write(nc, &(struct NCodecPdu){ .id = id,
+                                  .payload = (uint8_t*)reply,
+                                  .payload_len = strlen(reply),
+                                  .swc_id = 42,
+                                  .ecu_id = 24 });
+        assert_int_equal(rc, strlen(reply));
+    }
+    for (uint32_t id = 2; id <= 3; id++) {
+        NCodecPdu pdu = {};
+        len = ncodec_read(nc, &pdu);
+        assert_int_equal(len, strlen(greeting));
+        assert_int_equal(pdu.id, id);
+        assert_memory_equal(pdu.payload, greeting, strlen(greeting));
+    }
+    assert_memory_equal(first.payload, greeting, strlen(greeting));
+    NCodecPdu pdu = {};
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, -ENOMSG);
+
+    // Flush, then read the written PDUs.
+    ncodec_truncate(nc);
+    len = ncodec_flush(nc);
+    assert_int_equal(len, 0);
+    for (uint32_t id = 10; id <= 12; id++) {
+        ncodec_write(nc, &(struct NCodecPdu){ .id = id,
+                             .payload = (uint8_t*)reply,
+                             .payload_len = strlen(reply),
+                             .swc_id = 42,
+                             .ecu_id = 24 });
+    }
+    len = ncodec_flush(nc);
+    assert_true(len > 0);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    for (uint32_t id = 10; id <= 12; id++) {
+        NCodecPdu pdu = {};
+        len = ncodec_read(nc, &pdu);
+        assert_int_equal(len, strlen(reply));
+        assert_int_equal(pdu.id, id);
+        assert_memory_equal(pdu.payload, reply, strlen(reply));
+    }
+
+    ncodec_close(nc);
+}
+
+
+static NCodecMessage* __trace_read_msg;
+static NCodecMessage* __trace_write_msg;
+
+static void __trace_read(NCODEC* nc, NCodecMessage* msg)
+{
+    UNUSED(nc);
+    __trace_read_msg = msg;
+}
+
+static void __trace_write(NCODEC* nc, NCodecMessage* msg)
+{
+    UNUSED(nc);
+    __trace_write_msg = msg;
+}
+
+
+void test_pdu_fbs_readwrite_ref(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = mock->nc;
+    int     rc;
+
+    const char* greeting = "Hello World";
+
+    assert_true(sizeof(NCodecPduRef) <= 48);
+
+    // Write and flush a CAN message, and a message without metadata.
+    ncodec_seek(nc, 0, NCODEC_SEEK_RESET);
+    rc = ncodec_write(nc, &(struct NCodecPdu){ .id = 42,
+                              .payload = (uint8_t*)greeting,
+                              .payload_len = strlen(greeting),
+                              .swc_id = 42,
+                              .ecu_id = 24,
+                              .transport_type = NCodecPduTransportTypeCan,
+                              .transport.can_message = {
+                                  .frame_format =
+                                      NCodecPduCanFrameFormatFdExtended,
+                                  .frame_type = NCodecPduCanFrameTypeRemote,
+                                  .interface_id = 3,
+                                  .network_id = 4,
+                              } });
+    assert_int_equal(rc, strlen(greeting));
+    rc = ncodec_write_ref(nc, &(struct NCodecPduRef){ .id = 43,
+                                  .payload = (uint8_t*)greeting,
+                                  .payload_len = strlen(greeting),
+                                  .swc_id = 42 });
+    assert_int_equal(rc, strlen(greeting));
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+
+    // Read the compact descriptors.
+    NCodecPduRef ref[2] = {};
+    rc = ncodec_read_ref(nc, &ref[0]);
+    assert_int_equal(rc, strlen(greeting));
+    assert_int_equal(ref[0].id, 42);
+    assert_int_equal(ref[0].swc_id, 42);
+    assert_int_equal(ref[0].ecu_id, 24);
+    assert_int_equal(ref[0].payload_len, strlen(greeting));
+    assert_memory_equal(ref[0].payload, greeting, strlen(greeting));
+    assert_int_equal(ref[0].transport_type, NCodecPduTransportTypeCan);
+    assert_non_null(ref[0].metadata);
+    rc = ncodec_read_ref(nc, &ref[1]);
+    assert_int_equal(rc, strlen(greeting));
+    assert_int_equal(ref[1].id, 43);
+    assert_int_equal(ref[1].ecu_id, 5);  // From MIME type.
+    assert_int_equal(ref[1].transport_type, NCodecPduTransportTypeNone);
+    assert_null(ref[1].metadata);
+    rc = ncodec_read_ref(nc, &ref[1]);
+    assert_int_equal(rc, -ENOMSG);
+
+    // Forward the descriptor (with metadata) to another codec.
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*  nc2 = (void*)ncodec_open(MIMETYPE, stream);
+    assert_non_null(nc2);
+    rc = ncodec_write_ref(nc2, &ref[0]);
+    assert_int_equal(rc, strlen(greeting));
+    ncodec_flush(nc2);
+    ncodec_seek(nc2, 0, NCODEC_SEEK_SET);
+
+    NCodecPdu pdu = {};
+    rc = ncodec_read(nc2, &pdu);
+    assert_int_equal(rc, strlen(greeting));
+    assert_int_equal(pdu.id, 42);
+    assert_memory_equal(pdu.payload, greeting, strlen(greeting));
+    assert_int_equal(pdu.transport_type, NCodecPduTransportTypeCan);
+    assert_int_equal(pdu.transport.can_message.frame_format,
+        NCodecPduCanFrameFormatFdExtended);
+    assert_int_equal(
+        pdu.transport.can_message.frame_type, NCodecPduCanFrameTypeRemote);
+    assert_int_equal(pdu.transport.can_message.interface_id, 3);
+    assert_int_equal(pdu.transport.can_message.network_id, 4);
+    rc = ncodec_read(nc2, &pdu);
+    assert_int_equal(rc, -ENOMSG);
+
+    // Trace hooks are called with the compact descriptor.
+    NCodecInstance* _nc2 = (NCodecInstance*)nc2;
+    _nc2->trace.read = __trace_read;
+    _nc2->trace.write = __trace_write;
+    ncodec_truncate(nc2);
+    rc = ncodec_write_ref(nc2, &ref[0]);
+    assert_int_equal(rc, strlen(greeting));
+    assert_ptr_equal(__trace_write_msg, &ref[0]);
+    ncodec_flush(nc2);
+    ncodec_seek(nc2, 0, NCODEC_SEEK_SET);
+    NCodecPduRef ref2 = {};
+    rc = ncodec_read_ref(nc2, &ref2);
+    assert_int_equal(rc, strlen(greeting));
+    assert_ptr_equal(__trace_read_msg, &ref2);
+    __trace_read_msg = NULL;
+    rc = ncodec_read_ref(nc2, &ref2);
+    assert_int_equal(rc, -ENOMSG);
+    assert_null(__trace_read_msg);
+    ncodec_close(nc2);
+}
+
+
 int run_pdu_tests(void)
 {
     void* s = test_setup;
@@ -382,6 +621,9 @@ int run_pdu_tests(void)
         cmocka_unit_test_setup_teardown(test_pdu_fbs_truncate, s, t),
         cmocka_unit_test_setup_teardown(test_pdu_fbs_readwrite_pdus, s, t),
         cmocka_unit_test_setup_teardown(test_pdu_fbs_readwrite_messages, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_fbs_chunked_flush, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_fbs_chunked_interleave, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_fbs_readwrite_ref, s, t),
     };
 
     return cmocka_run_group_tests_name("PDU", tests, NULL, NULL);
@@ -1051,12 +1051,581 @@ void test_flexray__engine_txrx__frames(void** state)
             vector_at(&engine->txrx_list, txrx_len - 1, &rx_lpdu);
             assert_int_equal(
                 checks[step].expect.rx_status, rx_lpdu->lpdu_config.status);
-            assert_memory_equal(PAYLOAD, rx_lpdu->payload, strlen(PAYLOAD));
+            assert_memory_equal(
+                PAYLOAD, rx_lpdu->rx_payload, strlen(PAYLOAD));
         }
         release_config(&mock->model);
     }
 }
 
+void test_flexray__engine_slot_index(void** state)
+{
+    Mock*                      mock = *state;
+    NCodecPduFlexrayConfig     config = cc_config;
+    NCodecPduFlexrayLpduConfig frame_table[] = {
+        { .slot_id = 5,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .base_cycle = 0,
+            .cycle_repetition = 2 },
+        { .slot_id = 5,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .base_cycle = 1,
+            .cycle_repetition = 4 },
+        { .slot_id = 5,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .base_cycle = 1,
+            .cycle_repetition = 0 }, /* Never in a cycle. */
+        { .slot_id = 9,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .base_cycle = 0,
+            .cycle_repetition = 1 },
+    };
+    config.node_ident.node_id = 1;
+    config.frame_config.table = frame_table;
+    config.frame_config.count = ARRAY_SIZE(frame_table);
+    NCodecPdu pdu = {
+        .transport_type = NCodecPduTransportTypeFlexray,
+        .transport.flexray.metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+        .transport.flexray.metadata.config = config,
+    };
+    FlexrayBusModel* m = &mock->model;
+    FlexrayEngine*   engine = &m->engine;
+    *engine = (FlexrayEngine){ .node_ident.node_id = 1 };
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_null(engine->slot_index);
+
+    /* The Slot Index is built when the first slot is processed. */
+    assert_int_equal(0, calculate_budget(m, SIM_STEP_SIZE));
+    for (; consume_slot(m) == 0;) {
+    }
+    FlexraySlotIndex* index = engine->slot_index;
+    assert_non_null(index);
+    assert_int_equal(10, index->slot_count);
+    assert_null(index->slot[4].cycle);
+    FlexraySlot* slot = &index->slot[5];
+    assert_non_null(slot->cycle);
+    assert_int_equal(2, slot->tx.count);
+    for (size_t c = 0; c < 64; c++) {
+        assert_int_equal((c % 2 == 0), slot->cycle[c].tx.count);
+        assert_int_equal((c % 4 == 1), slot->cycle[c].rx.count);
+    }
+    FlexrayLpdu** lpdu_list = index->lpdu_list.items;
+    FlexrayLpdu*  rx_lpdu = lpdu_list[slot->cycle[5].rx.offset];
+    assert_int_equal(
+        NCodecPduFlexrayDirectionRx, rx_lpdu->lpdu_config.direction);
+    assert_int_equal(1, rx_lpdu->lpdu_config.base_cycle);
+    slot = &index->slot[9];
+    assert_int_equal(0, slot->tx.count);
+    assert_int_equal(1, slot->cycle[63].rx.count);
+
+    /* Rx LPDUs of other nodes are not indexed. */
+    config.node_ident.node_id = 2;
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_null(engine->slot_index);
+    assert_int_equal(0, calculate_budget(m, SIM_STEP_SIZE));
+    for (; consume_slot(m) == 0;) {
+    }
+    index = engine->slot_index;
+    assert_non_null(index);
+    assert_int_equal(4, index->slot[5].tx.count);
+    assert_int_equal(2, index->slot[5].cycle[0].tx.count);
+    assert_int_equal(1, index->slot[5].cycle[1].rx.count);
+    assert_int_equal(1, index->slot[9].cycle[0].rx.count);
+}
+
+void test_flexray__engine_schedule(void** state)
+{
+    Mock*                      mock = *state;
+    NCodecPduFlexrayConfig     config = cc_config;
+    NCodecPduFlexrayLpduConfig frame_table[] = {
+        { .slot_id = 5,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .base_cycle = 0,
+            .cycle_repetition = 2 },
+        { .slot_id = 20,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .base_cycle = 0,
+            .cycle_repetition = 1 },
+        { .slot_id = 30,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .base_cycle = 0,
+            .cycle_repetition = 1 },
+        { .slot_id = 100,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .status = NCodecPduFlexrayLpduStatusNotTransmitted },
+    };
+    config.node_ident.node_id = 1;
+    config.frame_config.table = frame_table;
+    config.frame_config.count = ARRAY_SIZE(frame_table);
+    NCodecPdu pdu = {
+        .transport_type = NCodecPduTransportTypeFlexray,
+        .transport.flexray.metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+        .transport.flexray.metadata.config = config,
+    };
+    FlexrayBusModel* m = &mock->model;
+    FlexrayEngine*   engine = &m->engine;
+    *engine = (FlexrayEngine){ .node_ident.node_id = 1 };
+    assert_int_equal(0, process_config(m, &pdu));
+
+    /* Consume one cycle (5 ms). */
+    size_t count = 0;
+    assert_int_equal(0, calculate_budget(m, 0.005));
+    for (; consume_slot(m) == 0;) {
+        count++;
+    }
+    assert_int_equal(1, engine->pos_cycle);
+    assert_int_equal(1, engine->pos_slot);
+    assert_int_equal(0, engine->pos_mt);
+    assert_int_equal(0, engine->step_budget_ut);
+    /* Fast-forward: 38 static slots and 211 minislots in a few calls. */
+    assert_true(count < 10);
+
+    /* The compiled schedule. */
+    FlexraySlotIndex* index = engine->slot_index;
+    assert_non_null(index);
+    assert_int_equal(2, index->schedule[0].count);
+    FlexrayScheduleItem* item = vector_at(&index->schedule_list, index->schedule[0].offset, NULL);
+    assert_int_equal(5, item[0].slot_id);
+    assert_int_equal(20, item[1].slot_id);
+    assert_int_equal(1, index->schedule[1].count);
+    item = vector_at(&index->schedule_list, index->schedule[1].offset, NULL);
+    assert_int_equal(20, item[0].slot_id);
+    assert_int_equal(3, index->dynamic.count);
+    item = vector_at(&index->schedule_list, index->dynamic.offset, NULL);
+    assert_int_equal(100, item[2].slot_id);
+}
+
+void test_flexray__engine_rx_payload(void** state)
+{
+    Mock*                      mock = *state;
+    NCodecPduFlexrayConfig     config_0 = cc_config; /* TX */
+    NCodecPduFlexrayConfig     config_1 = cc_config; /* RX */
+    NCodecPduFlexrayLpduConfig frame_table_0[] = {
+        { .slot_id = 5,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .cycle_repetition = 1,
+            .transmit_mode = NCodecPduFlexrayTransmitModeContinuous },
+        { .slot_id = 6,
+            .payload_length = 8,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .cycle_repetition = 1,
+            .index.frame_table = 1,
+            .transmit_mode = NCodecPduFlexrayTransmitModeContinuous },
+    };
+    NCodecPduFlexrayLpduConfig frame_table_1[] = {
+        { .slot_id = 5,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .cycle_repetition = 1,
+            .status = NCodecPduFlexrayLpduStatusNotReceived },
+        { .slot_id = 6,
+            .payload_length = 16,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .cycle_repetition = 1,
+            .status = NCodecPduFlexrayLpduStatusNotReceived },
+    };
+    config_0.node_ident.node_id = 1;
+    config_0.frame_config.table = frame_table_0;
+    config_0.frame_config.count = ARRAY_SIZE(frame_table_0);
+    config_1.node_ident.node_id = 2;
+    config_1.frame_config.table = frame_table_1;
+    config_1.frame_config.count = ARRAY_SIZE(frame_table_1);
+    NCodecPdu pdu = {
+        .transport_type = NCodecPduTransportTypeFlexray,
+        .transport.flexray.metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+    };
+    FlexrayBusModel* m = &mock->model;
+    FlexrayEngine*   engine = &m->engine;
+    *engine = (FlexrayEngine){ .node_ident.node_id = 2 };
+    pdu.transport.flexray.metadata.config = config_0;
+    assert_int_equal(0, process_config(m, &pdu));
+    pdu.transport.flexray.metadata.config = config_1;
+    assert_int_equal(0, process_config(m, &pdu));
+    for (uint32_t i = 0; i < 2; i++) {
+        assert_int_equal(0, set_lpdu(m, 1, 5 + i, i,
+                                NCodecPduFlexrayLpduStatusNotTransmitted,
+                                (uint8_t*)"hello world", 12));
+    }
+
+    /* Consume the static segment. */
+    assert_int_equal(0, calculate_budget(m, 0.0005));
+    for (; consume_slot(m) == 0;) {
+    }
+    assert_int_equal(2, vector_len(&engine->txrx_list));
+    FlexrayLpdu* rx_lpdu = NULL;
+
+    /* Equal payload length, delivered by reference to the Tx payload. */
+    vector_at(&engine->txrx_list, 0, &rx_lpdu);
+    assert_int_equal(5, rx_lpdu->lpdu_config.slot_id);
+    assert_int_equal(
+        NCodecPduFlexrayLpduStatusReceived, rx_lpdu->lpdu_config.status);
+    assert_null(rx_lpdu->payload);
+    assert_non_null(rx_lpdu->rx_payload);
+    assert_string_equal("hello world", (char*)rx_lpdu->rx_payload);
+
+    /* Shorter Tx payload, copied to the (padded) Rx payload. */
+    vector_at(&engine->txrx_list, 1, &rx_lpdu);
+    assert_int_equal(6, rx_lpdu->lpdu_config.slot_id);
+    assert_non_null(rx_lpdu->payload);
+    assert_ptr_equal(rx_lpdu->payload, rx_lpdu->rx_payload);
+    assert_memory_equal(
+        "hello wo\0\0\0\0\0\0\0\0", rx_lpdu->rx_payload, 16);
+
+    /* References are released with a modified Slot Map. */
+    pdu.transport.flexray.metadata.config = config_1;
+    pdu.transport.flexray.metadata.config.node_ident.node_id = 3;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_int_equal(0, vector_len(&engine->txrx_list));
+}
+
+static FlexrayLpdu* _slot_lpdu(FlexrayEngine* engine, uint32_t slot_id,
+    size_t index)
+{
+    VectorSlotMapItem* item = vector_find(&engine->slot_map,
+        &(VectorSlotMapItem){ .slot_id = slot_id }, 0, NULL);
+    if (item == NULL) return NULL;
+    return vector_at(&item->lpdus, index, NULL);
+}
+
+void test_flexray__engine_frame_table(void** state)
+{
+    Mock*                      mock = *state;
+    NCodecPduFlexrayConfig     config = cc_config;
+    NCodecPduFlexrayLpduConfig frame_table[] = {
+        { .slot_id = 9, .payload_length = 8, .index.frame_table = 0 },
+        { .slot_id = 3, .payload_length = 8, .index.frame_table = 1 },
+        { .slot_id = 7,
+            .payload_length = 8,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .index.frame_table = 2 },
+        { .slot_id = 3, .payload_length = 8, .index.frame_table = 3 },
+    };
+    config.node_ident.node_id = 1;
+    config.frame_config.table = frame_table;
+    config.frame_config.count = ARRAY_SIZE(frame_table);
+    NCodecPdu pdu = {
+        .transport_type = NCodecPduTransportTypeFlexray,
+        .transport.flexray.metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+    };
+    FlexrayBusModel* m = &mock->model;
+    FlexrayEngine*   engine = &m->engine;
+    *engine = (FlexrayEngine){ .node_ident.node_id = 1 };
+
+    /* Bulk ingest, sorted Slot Map with LPDUs in frame table order. */
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_int_equal(3, vector_len(&engine->slot_map));
+    VectorSlotMapItem* item = engine->slot_map.items;
+    assert_int_equal(3, item[0].slot_id);
+    assert_int_equal(7, item[1].slot_id);
+    assert_int_equal(9, item[2].slot_id);
+    assert_int_equal(2, vector_len(&item[0].lpdus));
+    assert_int_equal(1, _slot_lpdu(engine, 3, 0)->lpdu_config.index.frame_table);
+    assert_int_equal(3, _slot_lpdu(engine, 3, 1)->lpdu_config.index.frame_table);
+
+    /* Merge, update an existing LPDU and add a new slot. */
+    NCodecPduFlexrayLpduConfig merge_table[] = {
+        { .slot_id = 7,
+            .payload_length = 32,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .index.frame_table = 2 },
+        { .slot_id = 1, .payload_length = 8, .index.frame_table = 4 },
+    };
+    assert_int_equal(0, set_lpdu(m, 1, 7, 2,
+                            NCodecPduFlexrayLpduStatusNotTransmitted,
+                            (uint8_t*)"hello", 6));
+    assert_non_null(_slot_lpdu(engine, 7, 0)->payload);
+    config.operation = NCodecPduFlexrayLpduConfigFrameTableMerge;
+    config.frame_config.table = merge_table;
+    config.frame_config.count = ARRAY_SIZE(merge_table);
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_int_equal(4, vector_len(&engine->slot_map));
+    assert_int_equal(1, vector_len(&item[0].lpdus));
+    assert_int_equal(1, ((VectorSlotMapItem*)engine->slot_map.items)->slot_id);
+    assert_int_equal(1, vector_len(&((VectorSlotMapItem*)vector_find(
+        &engine->slot_map, &(VectorSlotMapItem){ .slot_id = 7 }, 0, NULL))
+                                         ->lpdus));
+    assert_int_equal(32, _slot_lpdu(engine, 7, 0)->lpdu_config.payload_length);
+    assert_null(_slot_lpdu(engine, 7, 0)->payload);
+    assert_int_equal(1, vector_len(&engine->config_list));
+
+    /* Delete an LPDU. */
+    NCodecPduFlexrayLpduConfig delete_table[] = {
+        { .slot_id = 3, .index.frame_table = 1 },
+    };
+    config.operation = NCodecPduFlexrayLpduConfigFrameTableDelete;
+    config.frame_config.table = delete_table;
+    config.frame_config.count = ARRAY_SIZE(delete_table);
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_int_equal(3, _slot_lpdu(engine, 3, 0)->lpdu_config.index.frame_table);
+    assert_null(_slot_lpdu(engine, 3, 1));
+
+    /* Set, replaces the frame table of the node (only). */
+    config = cc_config;
+    config.node_ident.node_id = 2;
+    config.frame_config.table = frame_table;
+    config.frame_config.count = 1;
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    NCodecPduFlexrayLpduConfig set_table[] = {
+        { .slot_id = 20, .payload_length = 8, .index.frame_table = 0 },
+    };
+    config.node_ident.node_id = 1;
+    config.operation = NCodecPduFlexrayLpduConfigFrameTableSet;
+    config.frame_config.table = set_table;
+    config.frame_config.count = ARRAY_SIZE(set_table);
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_null(_slot_lpdu(engine, 3, 0));
+    assert_null(_slot_lpdu(engine, 7, 0));
+    assert_int_equal(2, _slot_lpdu(engine, 9, 0)->node_ident.node_id);
+    assert_int_equal(1, _slot_lpdu(engine, 20, 0)->node_ident.node_id);
+    assert_int_equal(2, vector_len(&engine->config_list));
+    VectorFlexrayLpduConfigTableItem* config_item = engine->config_list.items;
+    assert_int_equal(2, config_item[0].node_ident.node_id);
+    assert_int_equal(1, config_item[1].node_ident.node_id);
+    assert_int_equal(1, config_item[1].count);
+
+    /* Unknown operation. */
+    pdu.transport.flexray.metadata.config.operation = 42;
+    assert_int_equal(-EINVAL, process_config(m, &pdu));
+}
+
+void test_flexray__engine_frame_table_patch(void** state)
+{
+    Mock*                      mock = *state;
+    NCodecPduFlexrayConfig     config = cc_config;
+    NCodecPduFlexrayLpduConfig frame_table[] = {
+        { .slot_id = 5,
+            .payload_length = 8,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .base_cycle = 0,
+            .cycle_repetition = 2,
+            .index.frame_table = 0 },
+        { .slot_id = 5,
+            .payload_length = 8,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .base_cycle = 1,
+            .cycle_repetition = 2,
+            .index.frame_table = 1 },
+        { .slot_id = 20,
+            .payload_length = 8,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .base_cycle = 0,
+            .cycle_repetition = 1,
+            .index.frame_table = 2 },
+        { .slot_id = 30,
+            .payload_length = 8,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .base_cycle = 0,
+            .cycle_repetition = 1,
+            .index.frame_table = 3 },
+    };
+    config.node_ident.node_id = 1;
+    config.frame_config.table = frame_table;
+    config.frame_config.count = ARRAY_SIZE(frame_table);
+    NCodecPdu pdu = {
+        .transport_type = NCodecPduTransportTypeFlexray,
+        .transport.flexray.metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+        .transport.flexray.metadata.config = config,
+    };
+    FlexrayBusModel* m = &mock->model;
+    FlexrayEngine*   engine = &m->engine;
+    *engine = (FlexrayEngine){ .node_ident.node_id = 1 };
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_int_equal(0, calculate_budget(m, 0.005));
+    for (; consume_slot(m) == 0;) {
+    }
+    FlexraySlotIndex* index = engine->slot_index;
+    assert_non_null(index);
+    assert_int_equal(2, index->schedule[0].count);
+    assert_int_equal(2, index->schedule[1].count);
+
+    /* Delete, the slot is patched in place. */
+    NCodecPduFlexrayLpduConfig delete_table[] = {
+        { .slot_id = 5, .index.frame_table = 1 },
+    };
+    config.operation = NCodecPduFlexrayLpduConfigFrameTableDelete;
+    config.frame_config.table = delete_table;
+    config.frame_config.count = ARRAY_SIZE(delete_table);
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_ptr_equal(index, engine->slot_index);
+    FlexraySlot* slot = &index->slot[5];
+    assert_int_equal(1, slot->tx.count);
+    assert_int_equal(1, slot->cycle[0].tx.count);
+    assert_int_equal(0, slot->cycle[1].tx.count);
+    FlexrayLpdu** lpdu_list = index->lpdu_list.items;
+    assert_ptr_equal(_slot_lpdu(engine, 5, 0), lpdu_list[slot->tx.offset]);
+    assert_int_equal(2, index->schedule[0].count);
+    assert_int_equal(1, index->schedule[1].count);
+    FlexrayScheduleItem* item =
+        vector_at(&index->schedule_list, index->schedule[1].offset, NULL);
+    assert_int_equal(20, item[0].slot_id);
+    VectorFlexrayLpduConfigTableItem* config_item = engine->config_list.items;
+    assert_int_equal(1, vector_len(&engine->config_list));
+    assert_int_equal(3, config_item[0].count);
+
+    /* Merge, an updated LPDU which shrinks the ranges is patched in place. */
+    NCodecPduFlexrayLpduConfig merge_table[] = {
+        { .slot_id = 20,
+            .payload_length = 8,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .base_cycle = 0,
+            .cycle_repetition = 2,
+            .index.frame_table = 2 },
+    };
+    config.operation = NCodecPduFlexrayLpduConfigFrameTableMerge;
+    config.frame_config.table = merge_table;
+    config.frame_config.count = ARRAY_SIZE(merge_table);
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_ptr_equal(index, engine->slot_index);
+    assert_int_equal(0, index->schedule[1].count);
+    assert_int_equal(2, index->schedule[2].count);
+    assert_int_equal(3, config_item[0].count);
+    assert_int_equal(2, config_item[0].table[1].cycle_repetition);
+    assert_int_equal(0, calculate_budget(m, 0.005));
+    for (; consume_slot(m) == 0;) {
+    }
+
+    /* Merge, an added LPDU (the ranges grow) releases the Slot Index. */
+    NCodecPduFlexrayLpduConfig add_table[] = {
+        { .slot_id = 30,
+            .payload_length = 8,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .base_cycle = 1,
+            .cycle_repetition = 2,
+            .index.frame_table = 4 },
+    };
+    config.frame_config.table = add_table;
+    config.frame_config.count = ARRAY_SIZE(add_table);
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_null(engine->slot_index);
+    config_item = engine->config_list.items;
+    assert_int_equal(4, config_item[0].count);
+    assert_int_equal(4, config_item[0].table[3].index.frame_table);
+
+    /* Delete all entries, the Config List is emptied. */
+    config.operation = NCodecPduFlexrayLpduConfigFrameTableDelete;
+    config.frame_config.table = frame_table;
+    config.frame_config.count = ARRAY_SIZE(frame_table);
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    config.frame_config.table = add_table;
+    config.frame_config.count = ARRAY_SIZE(add_table);
+    pdu.transport.flexray.metadata.config = config;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_int_equal(0, vector_len(&engine->config_list));
+}
+
+void test_flexray__engine_stats(void** state)
+{
+    Mock*                      mock = *state;
+    NCodecPduFlexrayConfig     config_0 = cc_config; /* TX */
+    NCodecPduFlexrayConfig     config_1 = cc_config; /* RX */
+    NCodecPduFlexrayLpduConfig frame_table_0[] = {
+        { .slot_id = 5,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .cycle_repetition = 1,
+            .transmit_mode = NCodecPduFlexrayTransmitModeContinuous },
+        { .slot_id = 100,
+            .payload_length = 16,
+            .direction = NCodecPduFlexrayDirectionTx,
+            .cycle_repetition = 1,
+            .index.frame_table = 1,
+            .transmit_mode = NCodecPduFlexrayTransmitModeSingleShot },
+    };
+    NCodecPduFlexrayLpduConfig frame_table_1[] = {
+        { .slot_id = 5,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .cycle_repetition = 1,
+            .status = NCodecPduFlexrayLpduStatusNotReceived },
+        { .slot_id = 100,
+            .payload_length = 16,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .cycle_repetition = 1,
+            .status = NCodecPduFlexrayLpduStatusNotReceived },
+        { .slot_id = 5,
+            .payload_length = 64,
+            .direction = NCodecPduFlexrayDirectionRx,
+            .cycle_repetition = 1,
+            .index.frame_table = 2,
+            .status = NCodecPduFlexrayLpduStatusNone }, /* Not accepted. */
+    };
+    config_0.node_ident.node_id = 1;
+    config_0.frame_config.table = frame_table_0;
+    config_0.frame_config.count = ARRAY_SIZE(frame_table_0);
+    config_1.node_ident.node_id = 2;
+    config_1.frame_config.table = frame_table_1;
+    config_1.frame_config.count = ARRAY_SIZE(frame_table_1);
+    NCodecPdu pdu = {
+        .transport_type = NCodecPduTransportTypeFlexray,
+        .transport.flexray.metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+    };
+    FlexrayBusModel* m = &mock->model;
+    FlexrayEngine*   engine = &m->engine;
+    *engine = (FlexrayEngine){ .node_ident.node_id = 2 };
+    pdu.transport.flexray.metadata.config = config_0;
+    assert_int_equal(0, process_config(m, &pdu));
+    pdu.transport.flexray.metadata.config = config_1;
+    assert_int_equal(0, process_config(m, &pdu));
+    assert_int_equal(0, set_lpdu(m, 1, 5, 0,
+                            NCodecPduFlexrayLpduStatusNotTransmitted,
+                            (uint8_t*)"hello world", 12));
+    /* Single shot Tx, replaced before transmission (dropped). */
+    for (size_t i = 0; i < 2; i++) {
+        assert_int_equal(0, set_lpdu(m, 1, 100, 1,
+                                NCodecPduFlexrayLpduStatusNotTransmitted,
+                                (uint8_t*)"hello world", 12));
+    }
+
+    /* One cycle (10 steps). */
+    for (size_t step = 0; step < 10; step++) {
+        assert_int_equal(0, calculate_budget(m, SIM_STEP_SIZE));
+        for (; consume_slot(m) == 0;) {
+        }
+        assert_true(engine->stats.step_used_ut <= engine->stats.step_budget_ut);
+    }
+    assert_int_equal(1, engine->pos_cycle);
+
+    FlexrayEngineStats* stats = &engine->stats;
+    assert_int_equal(1, stats->cycle_count);
+    assert_int_equal(cc_config.static_slot_count, stats->static_slot_count);
+    assert_int_equal(1, stats->static_frame_count);
+    assert_int_equal(0, stats->null_frame_count);
+    assert_int_equal(1, stats->dynamic_frame_count);
+    assert_true(stats->frame_minislot_count > 1);
+    assert_true(stats->minislot_count > stats->frame_minislot_count);
+    assert_true(stats->minislot_count <= cc_config.minislot_count);
+    assert_int_equal(cc_config.microtick_per_cycle,
+        stats->used_ut + engine->step_budget_ut);
+
+    FlexrayNodeStats node_stats = get_node_stats(m, 1);
+    assert_int_equal(2, node_stats.tx_count);
+    assert_int_equal(0, node_stats.rx_count);
+    assert_int_equal(1, node_stats.drop_count);
+    node_stats = get_node_stats(m, 2);
+    assert_int_equal(0, node_stats.tx_count);
+    assert_int_equal(2, node_stats.rx_count);
+    assert_int_equal(1, node_stats.drop_count);
+}
+
 int run_pdu_flexray_engine_tests(void)
 {
     void* s = test_setup;
@@ -1074,6 +1643,15 @@ int run_pdu_flexray_engine_tests(void)
             test_flexray__engine_cycle__shift, s, t),
         cmocka_unit_test_setup_teardown(
             test_flexray__engine_txrx__frames, s, t),
+        cmocka_unit_test_setup_teardown(test_flexray__engine_slot_index, s, t),
+        cmocka_unit_test_setup_teardown(test_flexray__engine_schedule, s, t),
+        cmocka_unit_test_setup_teardown(
+            test_flexray__engine_rx_payload, s, t),
+        cmocka_unit_test_setup_teardown(
+            test_flexray__engine_frame_table, s, t),
+        cmocka_unit_test_setup_teardown(
+            test_flexray__engine_frame_table_patch, s, t),
+        cmocka_unit_test_setup_teardown(test_flexray__engine_stats, s, t),
     };
 
     return cmocka_run_group_tests_name("PDU FLEXRAY ENGINE", tests, NULL, NULL);
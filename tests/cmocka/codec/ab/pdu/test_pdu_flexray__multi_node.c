@@ -61,6 +61,21 @@ static TestNode testnode_C = (TestNode){
                 "interface=stream;type=pdu;schema=fbs;"
                 "ecu_id=3;model=flexray",
 };
+static TestNode testnode_A_2vcn_cluster = (TestNode){
+    .mimetype = "application/x-automotive-bus; "
+                "interface=stream;type=pdu;schema=fbs;"
+                "ecu_id=1;vcn=2;model=flexray;cluster=fr1",
+};
+static TestNode testnode_B_cluster = (TestNode){
+    .mimetype = "application/x-automotive-bus; "
+                "interface=stream;type=pdu;schema=fbs;"
+                "ecu_id=2;model=flexray;cluster=fr1",
+};
+static TestNode testnode_C_cluster = (TestNode){
+    .mimetype = "application/x-automotive-bus; "
+                "interface=stream;type=pdu;schema=fbs;"
+                "ecu_id=3;model=flexray;cluster=fr1",
+};
 
 static TestFrameTable frame_table_A = { .list = {
     {
@@ -491,6 +506,70 @@ void multi_node__mixed__2vcn(void** state)
 }
 
 
+void multi_node__cluster(void** state)
+{
+    testnode_A_2vcn_cluster.config = config;
+    testnode_B_cluster.config = config;
+    testnode_C_cluster.config = config;
+
+    /* As multi_node__mixed__2vcn, with a shared engine. */
+    Mock* mock = *state;
+    mock->test = (TestTxRx){
+        .config = {
+            .node = {
+                testnode_A_2vcn_cluster,
+                testnode_B_cluster,
+                testnode_C_cluster,
+            },
+            .frame_table = { .map = {
+                frame_table_A,
+                frame_table_B,
+                frame_table_C,
+            }, },
+        },
+        .run = {
+            .push_active = true,
+            .pdu_map = { .map = {
+                pdu_table_A,
+                pdu_table_B,
+                pdu_table_C,
+            }, },
+            .cycles = 1,
+        },
+        .expect = {
+            .cycle = 1+1,
+            .macrotick = 0,
+            .poc_state = NCodecPduFlexrayPocStateNormalActive,
+            .tcvr_state = NCodecPduFlexrayTransceiverStateFrameSync,
+            .pdu = pdu_multi_check,
+        },
+    };
+    flexray_harness_run_test(&mock->test);
+
+    /* All nodes are members of one cluster (engine). */
+    FlexrayCluster* cluster = NULL;
+    for (size_t i = 0; i < 3; i++) {
+        ABCodecInstance* nc = (ABCodecInstance*)mock->test.config.node[i].nc;
+        FlexrayBusModel* m = nc->reader.bus_model.model;
+        assert_non_null(m->cluster);
+        if (cluster == NULL) cluster = m->cluster;
+        assert_ptr_equal(m->cluster, cluster);
+        /* The engine of the node is not used. */
+        assert_int_equal(vector_len(&m->engine.slot_map), 0);
+    }
+    assert_int_equal(vector_len(&cluster->member_list), 3);
+    assert_int_equal(vector_len(&cluster->model.engine.node_list), 3);
+    assert_int_equal(vector_len(&cluster->model.engine.slot_map), 4);
+
+    /* Snapshots are not supported. */
+    void*  data = NULL;
+    size_t len = 0;
+    assert_int_equal(
+        ncodec_snapshot(mock->test.config.node[0].nc, &data, &len), -ENOSYS);
+    assert_null(data);
+}
+
+
 /*
 Node A B C
 
@@ -516,6 +595,7 @@ int run_pdu_flexray_multi_node_tests(void)
 
     const struct CMUnitTest tests[] = {
         T(multi_node__mixed__2vcn, s, t),
+        T(multi_node__cluster, s, t),
         // T(multi_node__2vcn, s, t),
         // T(multi_node__active, s, t),
         // T(multi_node__bridge, s, t),
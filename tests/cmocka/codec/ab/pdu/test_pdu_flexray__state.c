@@ -552,6 +552,87 @@ void test_flexray__bus_condition(void** _state)
 }
 
 
+void test_flexray__state_counters(void** _state)
+{
+    Mock*            mock = *_state;
+    FlexrayBusModel* m = &mock->model;
+    FlexrayState*    state = &m->state;
+    const uint32_t   node_count = 40;
+
+    /* Register nodes (not in order), lookup via the Node State index. */
+    for (uint32_t i = 0; i < node_count; i++) {
+        NCodecPduFlexrayNodeIdentifier nid = {
+            .node = { .ecu_id = (i * 7) % node_count + 1, .swc_id = 3 }
+        };
+        register_node_state(m, nid, true, false);
+    }
+    assert_int_equal(node_count, vector_len(&state->node_state));
+    assert_int_equal(node_count,
+        state->count.tcvr[NCodecPduFlexrayTransceiverStateNoConnection]);
+    assert_int_equal(
+        node_count, state->count.poc[NCodecPduFlexrayPocStateDefaultConfig]);
+    for (uint32_t i = 0; i < node_count; i++) {
+        NCodecPduFlexrayNodeIdentifier nid = { .node = { .ecu_id = i + 1 } };
+        assert_int_equal(
+            i + 1, get_node_state(m, nid).node_ident.node.ecu_id);
+    }
+    NCodecPduFlexrayNodeIdentifier unknown = { .node = { .ecu_id = 99 } };
+    assert_int_equal(0, get_node_state(m, unknown).node_ident.node_id);
+
+    /* Single node in NormalActive, FrameError (node pushed to Passive). */
+    NCodecPduFlexrayNodeIdentifier nid_1 = { .node = { .ecu_id = 1 } };
+    NCodecPduFlexrayNodeIdentifier nid_2 = { .node = { .ecu_id = 2 } };
+    push_node_state(m, nid_1, NCodecPduFlexrayCommandConfig);
+    push_node_state(m, nid_1, NCodecPduFlexrayCommandReady);
+    push_node_state(m, nid_1, NCodecPduFlexrayCommandRun);
+    assert_int_equal(
+        1, state->count.poc[NCodecPduFlexrayPocStateNormalActive]);
+    assert_int_equal(
+        1, state->count.tcvr[NCodecPduFlexrayTransceiverStateFrameSync]);
+    calculate_bus_condition(m);
+    assert_int_equal(
+        NCodecPduFlexrayTransceiverStateFrameError, state->bus_condition);
+    assert_int_equal(
+        0, state->count.poc[NCodecPduFlexrayPocStateNormalActive]);
+    assert_int_equal(
+        1, state->count.poc[NCodecPduFlexrayPocStateNormalPassive]);
+    assert_int_equal(
+        0, state->count.tcvr[NCodecPduFlexrayTransceiverStateFrameSync]);
+
+    /* Two nodes in NormalActive, FrameSync. */
+    push_node_state(m, nid_1, NCodecPduFlexrayCommandRun);
+    set_poc_state(m, nid_2, NCodecPduFlexrayPocStateNormalActive);
+    calculate_bus_condition(m);
+    assert_int_equal(
+        NCodecPduFlexrayTransceiverStateFrameSync, state->bus_condition);
+    assert_int_equal(
+        2, state->count.tcvr[NCodecPduFlexrayTransceiverStateFrameSync]);
+
+    /* Power off, NoSignal. */
+    set_node_power(m, nid_1, false);
+    set_node_power(m, nid_2, false);
+    assert_int_equal(
+        2, state->count.tcvr[NCodecPduFlexrayTransceiverStateNoPower]);
+    calculate_bus_condition(m);
+    assert_int_equal(
+        NCodecPduFlexrayTransceiverStateNoSignal, state->bus_condition);
+
+    /* Virtual Coldstart Nodes are counted in FrameSync. */
+    register_vcn_node_state(m, (NCodecPduFlexrayNodeIdentifier){
+                                   .node = { .ecu_id = 1, .swc_id = 1 } });
+    register_vcn_node_state(m, (NCodecPduFlexrayNodeIdentifier){
+                                   .node = { .ecu_id = 1, .swc_id = 2 } });
+    assert_int_equal(2, state->count.coldstart);
+    calculate_bus_condition(m);
+    assert_int_equal(
+        NCodecPduFlexrayTransceiverStateFrameSync, state->bus_condition);
+
+    release_state(m);
+    assert_null(state->index.slot);
+    assert_int_equal(0, state->count.coldstart);
+}
+
+
 int run_pdu_flexray_state_tests(void)
 {
     void* s = test_setup;
@@ -563,6 +644,7 @@ int run_pdu_flexray_state_tests(void)
         T(test_flexray__node_state_changes, s, t),
         T(test_flexray__state_entry_func, s2, t),
         T(test_flexray__bus_condition, s, t),
+        T(test_flexray__state_counters, s, t),
     };
 
     return cmocka_run_group_tests_name("PDU  FLEXRAY STATE", tests, NULL, NULL);
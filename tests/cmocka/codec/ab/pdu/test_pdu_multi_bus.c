@@ -0,0 +1,321 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/pdu.h>
+#include <dse/ncodec/codec/ab/flexray/flexray.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    1024
+#define RUN_STEPS     20
+#define NETWORKS      3
+
+
+extern NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream);
+
+
+typedef struct Mock {
+    NCODEC* nc;
+} Mock;
+
+
+typedef struct NetworkRecord {
+    uint32_t status_count;
+    uint8_t  poc_state;
+    uint32_t rx_count;
+    uint8_t  rx_payload[8];
+} NetworkRecord;
+
+
+#define MIMETYPE                                                               \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "ecu_id=1;cc_id=1;vcn=2;model=flexray;networks=2,3"
+
+
+static NCodecPduFlexrayLpduConfig frame_table[] = {
+    {
+        .slot_id = 7,
+        .payload_length = 8,
+        .cycle_repetition = 1,
+        .index = { .frame_table = 0 },
+        .direction = NCodecPduFlexrayDirectionTx,
+        .transmit_mode = NCodecPduFlexrayTransmitModeContinuous,
+        .status = NCodecPduFlexrayLpduStatusNotTransmitted,
+    },
+    {
+        .slot_id = 7,
+        .payload_length = 8,
+        .cycle_repetition = 1,
+        .index = { .frame_table = 1 },
+        .direction = NCodecPduFlexrayDirectionRx,
+        .status = NCodecPduFlexrayLpduStatusNotReceived,
+    },
+};
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE, stream);
+    assert_non_null(mock->nc);
+    ncodec_truncate(mock->nc);
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock && mock->nc) ncodec_close((void*)mock->nc);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static void _setup_network(NCODEC* nc, uint8_t cc_id, const char* payload)
+{
+    NCodecPduFlexrayNodeIdentifier node_ident = { .node.cc_id = cc_id };
+    NCodecPduFlexrayConfig         config = {
+                .bit_rate = NCodecPduFlexrayBitrate10,
+                .channel_enable = NCodecPduFlexrayChannelA,
+                .macrotick_per_cycle = 3361u,
+                .microtick_per_cycle = 200000u,
+                .network_idle_start = (3361u - 5u - 1u),
+                .static_slot_length = 55u,
+                .static_slot_count = 38u,
+                .minislot_length = 6u,
+                .minislot_count = 211u,
+                .static_slot_payload_length = (32u * 2),
+                .frame_config = { .count = ARRAY_SIZE(frame_table),
+                    .table = frame_table },
+    };
+    ncodec_write(nc, &(NCodecPdu){ .transport_type =
+                                       NCodecPduTransportTypeFlexray,
+                         .transport.flexray = {
+                             .node_ident = node_ident,
+                             .metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+                             .metadata.config = config,
+                         } });
+    NCodecPduFlexrayPocCommand commands[] = {
+        NCodecPduFlexrayCommandConfig,
+        NCodecPduFlexrayCommandReady,
+        NCodecPduFlexrayCommandRun,
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(commands); i++) {
+        ncodec_write(nc,
+            &(NCodecPdu){ .transport_type = NCodecPduTransportTypeFlexray,
+                .transport.flexray = {
+                    .node_ident = node_ident,
+                    .metadata_type = NCodecPduFlexrayMetadataTypeStatus,
+                    .metadata.status = {
+                        .channel[0].poc_command = commands[i],
+                    } } });
+    }
+    int rc = ncodec_write(nc,
+        &(NCodecPdu){ .id = 7,
+            .payload = (const uint8_t*)payload,
+            .payload_len = 8,
+            .transport_type = NCodecPduTransportTypeFlexray,
+            .transport.flexray = {
+                .node_ident = node_ident,
+                .metadata_type = NCodecPduFlexrayMetadataTypeLpdu,
+                .metadata.lpdu = {
+                    .frame_config_index = 0,
+                    .status = NCodecPduFlexrayLpduStatusNotTransmitted,
+                } } });
+    assert_int_equal(rc, 8);
+}
+
+
+static void _run_steps(NCODEC* nc, NetworkRecord* record, size_t steps)
+{
+    for (size_t i = 0; i < steps; i++) {
+        NCodecPdu pdu;
+        ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+        while (ncodec_read(nc, &pdu) >= 0) {
+            if (pdu.transport_type != NCodecPduTransportTypeFlexray) continue;
+            uint8_t cc_id = pdu.transport.flexray.node_ident.node.cc_id;
+            assert_true(cc_id >= 1 && cc_id <= NETWORKS);
+            NetworkRecord* r = &record[cc_id - 1];
+            switch (pdu.transport.flexray.metadata_type) {
+            case NCodecPduFlexrayMetadataTypeStatus:
+                r->status_count++;
+                r->poc_state =
+                    pdu.transport.flexray.metadata.status.channel[0].poc_state;
+                break;
+            case NCodecPduFlexrayMetadataTypeLpdu:
+                if (pdu.payload_len == 0) break;
+                r->rx_count++;
+                memcpy(r->rx_payload, pdu.payload, 8);
+                break;
+            default:
+                break;
+            }
+        }
+        ncodec_truncate(nc);
+    }
+}
+
+
+void test_pdu_multi_bus__create(void** state)
+{
+    Mock*            mock = *state;
+    ABCodecInstance* _nc = (ABCodecInstance*)mock->nc;
+    ABCodecReader*   reader = &_nc->reader;
+
+    /* Primary network (cc_id) and the additional networks. */
+    assert_non_null(reader->bus_model.model);
+    assert_int_equal(reader->bus_model.network_id, 1);
+    assert_int_equal(reader->network_count, 2);
+    for (size_t i = 0; i < reader->network_count; i++) {
+        ABCodecBusModel* bm = &reader->networks[i];
+        assert_non_null(bm->model);
+        assert_int_equal(bm->network_id, 2 + i);
+        /* All networks share one Stream (builder and message). */
+        assert_ptr_equal(bm->nc, reader->bus_model.nc);
+        FlexrayBusModel* m = bm->model;
+        assert_int_equal(m->node_ident.node.ecu_id, 1);
+        assert_int_equal(m->node_ident.node.cc_id, 2 + i);
+    }
+
+    /* Duplicate networks are ignored. */
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*  nc = (void*)ncodec_open(MIMETYPE ",1,3", stream);
+    assert_non_null(nc);
+    assert_int_equal(((ABCodecInstance*)nc)->reader.network_count, 2);
+    ncodec_close(nc);
+
+    /* Invalid networks (empty or not a number) are ignored. */
+    const char* invalid[] = { ",,4", ",x", ", 4x", ",-4", ",65536", "" };
+    for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        char mimetype[256];
+        snprintf(mimetype, sizeof(mimetype), "%s%s", MIMETYPE, invalid[i]);
+        stream = ncodec_buffer_stream_create(BUFFER_LEN);
+        nc = (void*)ncodec_open(mimetype, stream);
+        assert_non_null(nc);
+        ABCodecReader* r = &((ABCodecInstance*)nc)->reader;
+        assert_int_equal(r->network_count, (i == 0) ? 3 : 2);
+        assert_int_equal(r->networks[0].network_id, 2);
+        assert_int_equal(r->networks[1].network_id, 3);
+        if (i == 0) assert_int_equal(r->networks[2].network_id, 4);
+        ncodec_close(nc);
+    }
+
+    /* Network ids are not truncated (257 is not network 1). */
+    stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    nc = (void*)ncodec_open(MIMETYPE ",257", stream);
+    assert_non_null(nc);
+    ABCodecReader* r = &((ABCodecInstance*)nc)->reader;
+    assert_int_equal(r->network_count, 3);
+    assert_int_equal(r->networks[2].network_id, 257);
+    FlexrayBusModel* m = r->networks[2].model;
+    assert_int_equal(m->node_ident.node.cc_id, 257);
+    ncodec_close(nc);
+}
+
+
+void test_pdu_multi_bus__run(void** state)
+{
+    Mock*         mock = *state;
+    NCODEC*       nc = mock->nc;
+    NetworkRecord record[NETWORKS] = { 0 };
+
+    /* Networks 1 and 2 are configured, network 3 is not. */
+    _setup_network(nc, 1, "NETWORK1");
+    _setup_network(nc, 2, "NETWORK2");
+    ncodec_flush(nc);
+    _run_steps(nc, record, RUN_STEPS);
+
+    /* Each network produces its own status and LPDUs. */
+    for (size_t i = 0; i < NETWORKS; i++) {
+        assert_int_equal(record[i].status_count, RUN_STEPS);
+    }
+    assert_int_equal(record[0].poc_state, NCodecPduFlexrayPocStateNormalActive);
+    assert_int_equal(record[1].poc_state, NCodecPduFlexrayPocStateNormalActive);
+    assert_int_not_equal(
+        record[2].poc_state, NCodecPduFlexrayPocStateNormalActive);
+    assert_true(record[0].rx_count > 0);
+    assert_memory_equal(record[0].rx_payload, "NETWORK1", 8);
+    assert_true(record[1].rx_count > 0);
+    assert_memory_equal(record[1].rx_payload, "NETWORK2", 8);
+    assert_int_equal(record[2].rx_count, 0);
+}
+
+
+void test_pdu_multi_bus__snapshot(void** state)
+{
+    Mock*            mock = *state;
+    NCODEC*          nc = mock->nc;
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    NetworkRecord    expect[NETWORKS] = { 0 };
+    NetworkRecord    actual[NETWORKS] = { 0 };
+    void*            data = NULL;
+    size_t           len = 0;
+    int              rc;
+
+    _setup_network(nc, 1, "NETWORK1");
+    _setup_network(nc, 2, "NETWORK2");
+    ncodec_flush(nc);
+    _run_steps(nc, expect, 10);
+
+    /* All networks are included in the snapshot. */
+    rc = ncodec_snapshot(nc, &data, &len);
+    assert_int_equal(rc, 0);
+    memset(expect, 0, sizeof(expect));
+    _run_steps(nc, expect, RUN_STEPS);
+    rc = ncodec_restore(nc, data, len);
+    assert_int_equal(rc, 0);
+    _run_steps(nc, actual, RUN_STEPS);
+    assert_memory_equal(actual, expect, sizeof(expect));
+
+    /* A failed restore (last network) has no effect on the other networks. */
+    FlexrayEngine* e = &((FlexrayBusModel*)_nc->reader.bus_model.model)->engine;
+    void*          current = NULL;
+    size_t         current_len = 0;
+    rc = ncodec_snapshot(nc, &current, &current_len);
+    assert_int_equal(rc, 0);
+    memset(expect, 0, sizeof(expect));
+    memset(actual, 0, sizeof(actual));
+    _run_steps(nc, expect, 10);
+    rc = ncodec_restore(nc, current, current_len);
+    assert_int_equal(rc, 0);
+    uint32_t pos_mt = e->pos_mt;
+    uint8_t  pos_cycle = e->pos_cycle;
+    rc = ncodec_restore(nc, data, len - 1);
+    assert_int_equal(rc, -EINVAL);
+    assert_int_equal(e->pos_mt, pos_mt);
+    assert_int_equal(e->pos_cycle, pos_cycle);
+    _run_steps(nc, actual, 10);
+    assert_memory_equal(actual, expect, sizeof(expect));
+    free(current);
+    free(data);
+}
+
+
+int run_pdu_multi_bus_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_pdu_multi_bus__create, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_multi_bus__run, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_multi_bus__snapshot, s, t),
+    };
+
+    return cmocka_run_group_tests_name("PDU MULTI BUS", tests, NULL, NULL);
+}
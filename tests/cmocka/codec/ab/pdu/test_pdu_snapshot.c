@@ -0,0 +1,303 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/pdu.h>
+#include <dse/ncodec/codec/ab/flexray/flexray.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    1024
+#define RUN_STEPS     20
+
+
+extern NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream);
+
+
+typedef struct Mock {
+    NCODEC* nc;
+} Mock;
+
+
+typedef struct StepRecord {
+    uint8_t  cycle;
+    uint16_t macrotick;
+    uint8_t  poc_state;
+    uint32_t rx_count;
+    uint8_t  rx_payload[8];
+} StepRecord;
+
+
+#define MIMETYPE                                                               \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "ecu_id=1;vcn=2;model=flexray"
+#define MIMETYPE_PDU                                                           \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "swc_id=4;ecu_id=5"
+#define MIMETYPE_FRAME                                                         \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=frame;bus=can;schema=fbs"
+
+
+static NCodecPduFlexrayLpduConfig frame_table[] = {
+    {
+        .slot_id = 7,
+        .payload_length = 8,
+        .cycle_repetition = 1,
+        .index = { .frame_table = 0 },
+        .direction = NCodecPduFlexrayDirectionTx,
+        .transmit_mode = NCodecPduFlexrayTransmitModeContinuous,
+        .status = NCodecPduFlexrayLpduStatusNotTransmitted,
+    },
+    {
+        .slot_id = 7,
+        .payload_length = 8,
+        .cycle_repetition = 1,
+        .index = { .frame_table = 1 },
+        .direction = NCodecPduFlexrayDirectionRx,
+        .status = NCodecPduFlexrayLpduStatusNotReceived,
+    },
+};
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE, stream);
+    assert_non_null(mock->nc);
+    ncodec_truncate(mock->nc);
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock && mock->nc) ncodec_close((void*)mock->nc);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static void _write_lpdu(NCODEC* nc, const char* payload)
+{
+    int rc = ncodec_write(nc,
+        &(NCodecPdu){ .id = 7,
+            .payload = (const uint8_t*)payload,
+            .payload_len = 8,
+            .transport_type = NCodecPduTransportTypeFlexray,
+            .transport.flexray = {
+                .metadata_type = NCodecPduFlexrayMetadataTypeLpdu,
+                .metadata.lpdu = {
+                    .frame_config_index = 0,
+                    .status = NCodecPduFlexrayLpduStatusNotTransmitted,
+                } } });
+    assert_int_equal(rc, 8);
+}
+
+
+static void _setup_node(NCODEC* nc)
+{
+    NCodecPduFlexrayConfig config = {
+        .bit_rate = NCodecPduFlexrayBitrate10,
+        .channel_enable = NCodecPduFlexrayChannelA,
+        .macrotick_per_cycle = 3361u,
+        .microtick_per_cycle = 200000u,
+        .network_idle_start = (3361u - 5u - 1u),
+        .static_slot_length = 55u,
+        .static_slot_count = 38u,
+        .minislot_length = 6u,
+        .minislot_count = 211u,
+        .static_slot_payload_length = (32u * 2),
+        .frame_config = { .count = ARRAY_SIZE(frame_table),
+            .table = frame_table },
+    };
+    ncodec_write(nc, &(NCodecPdu){ .transport_type =
+                                       NCodecPduTransportTypeFlexray,
+                         .transport.flexray = {
+                             .metadata_type = NCodecPduFlexrayMetadataTypeConfig,
+                             .metadata.config = config,
+                         } });
+    NCodecPduFlexrayPocCommand commands[] = {
+        NCodecPduFlexrayCommandConfig,
+        NCodecPduFlexrayCommandReady,
+        NCodecPduFlexrayCommandRun,
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(commands); i++) {
+        ncodec_write(nc,
+            &(NCodecPdu){ .transport_type = NCodecPduTransportTypeFlexray,
+                .transport.flexray = {
+                    .metadata_type = NCodecPduFlexrayMetadataTypeStatus,
+                    .metadata.status = {
+                        .channel[0].poc_command = commands[i],
+                    } } });
+    }
+    _write_lpdu(nc, "01234567");
+    ncodec_flush(nc);
+}
+
+
+static void _run_steps(NCODEC* nc, StepRecord* record, size_t steps)
+{
+    for (size_t i = 0; i < steps; i++) {
+        NCodecPdu pdu;
+        ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+        while (ncodec_read(nc, &pdu) >= 0) {
+            if (record == NULL) continue;
+            if (pdu.transport_type != NCodecPduTransportTypeFlexray) continue;
+            switch (pdu.transport.flexray.metadata_type) {
+            case NCodecPduFlexrayMetadataTypeStatus:
+                record[i].cycle = pdu.transport.flexray.metadata.status.cycle;
+                record[i].macrotick =
+                    pdu.transport.flexray.metadata.status.macrotick;
+                record[i].poc_state =
+                    pdu.transport.flexray.metadata.status.channel[0].poc_state;
+                break;
+            case NCodecPduFlexrayMetadataTypeLpdu:
+                if (pdu.payload_len == 0) break;
+                record[i].rx_count++;
+                memcpy(record[i].rx_payload, pdu.payload, 8);
+                break;
+            default:
+                break;
+            }
+        }
+        ncodec_truncate(nc);
+    }
+}
+
+
+void test_pdu_snapshot__api(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = mock->nc;
+    void*   data = NULL;
+    size_t  len = 0;
+    int     rc;
+
+    rc = ncodec_snapshot(NULL, &data, &len);
+    assert_int_equal(rc, -ENOSTR);
+    rc = ncodec_restore(NULL, data, len);
+    assert_int_equal(rc, -ENOSTR);
+    rc = ncodec_snapshot(nc, NULL, &len);
+    assert_int_equal(rc, -EINVAL);
+    rc = ncodec_restore(nc, NULL, 0);
+    assert_int_equal(rc, -EINVAL);
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*  nc_frame = (void*)ncodec_open(MIMETYPE_FRAME, stream);
+    assert_non_null(nc_frame);
+    rc = ncodec_snapshot(nc_frame, &data, &len);
+    assert_int_equal(rc, -ENOSYS);
+    ncodec_close(nc_frame);
+
+    /* Not at a step boundary. */
+    _write_lpdu(nc, "01234567");
+    rc = ncodec_snapshot(nc, &data, &len);
+    assert_int_equal(rc, -EBUSY);
+    ncodec_truncate(nc);
+
+    /* Snapshot must match the Bus Model of the codec. */
+    rc = ncodec_snapshot(nc, &data, &len);
+    assert_int_equal(rc, 0);
+    assert_non_null(data);
+    assert_true(len > 0);
+    stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC* nc_pdu = (void*)ncodec_open(MIMETYPE_PDU, stream);
+    assert_non_null(nc_pdu);
+    rc = ncodec_restore(nc_pdu, data, len);
+    assert_int_equal(rc, -EINVAL);
+    ncodec_close(nc_pdu);
+
+    /* Malformed snapshots. */
+    rc = ncodec_restore(nc, data, len - 1);
+    assert_int_equal(rc, -EINVAL);
+    ((uint8_t*)data)[0] ^= 0xff;
+    rc = ncodec_restore(nc, data, len);
+    assert_int_equal(rc, -EINVAL);
+    free(data);
+}
+
+
+void test_pdu_snapshot__flexray(void** state)
+{
+    Mock*            mock = *state;
+    NCODEC*          nc = mock->nc;
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    FlexrayBusModel* m = _nc->reader.bus_model.model;
+    StepRecord       expect[RUN_STEPS] = { 0 };
+    StepRecord       actual[RUN_STEPS] = { 0 };
+    void*            data = NULL;
+    size_t           len = 0;
+    int              rc;
+
+    /* Warm up, the node reaches NormalActive. */
+    _setup_node(nc);
+    _run_steps(nc, NULL, 10);
+    assert_int_equal(m->state.bus_condition,
+        NCodecPduFlexrayTransceiverStateFrameSync);
+
+    /* Snapshot and run (expected). */
+    rc = ncodec_snapshot(nc, &data, &len);
+    assert_int_equal(rc, 0);
+    double        sim_time = _nc->simulation_time.value;
+    FlexrayEngine engine = m->engine;
+    _run_steps(nc, expect, RUN_STEPS);
+    assert_int_equal(expect[RUN_STEPS - 1].poc_state,
+        NCodecPduFlexrayPocStateNormalActive);
+    /* Slot 7 is received once per cycle (10 steps). */
+    assert_int_equal(expect[1].rx_count, 1);
+    assert_memory_equal(expect[1].rx_payload, "01234567", 8);
+    assert_int_equal(expect[11].rx_count, 1);
+
+    /* Diverge (new payload), then restore. */
+    _write_lpdu(nc, "ABCDEFGH");
+    ncodec_flush(nc);
+    _run_steps(nc, NULL, 5);
+    rc = ncodec_restore(nc, data, len);
+    assert_int_equal(rc, 0);
+    assert_double_equal(_nc->simulation_time.value, sim_time, 0.0);
+    assert_int_equal(m->engine.pos_cycle, engine.pos_cycle);
+    assert_int_equal(m->engine.pos_slot, engine.pos_slot);
+    assert_int_equal(m->engine.pos_mt, engine.pos_mt);
+    assert_int_equal(m->engine.step_budget_ut, engine.step_budget_ut);
+    assert_ptr_equal(m->engine.log_id, m->log_id);
+
+    /* Run from the restored state (actual), repeat. */
+    for (int i = 0; i < 3; i++) {
+        memset(actual, 0, sizeof(actual));
+        _run_steps(nc, actual, RUN_STEPS);
+        assert_memory_equal(actual, expect, sizeof(expect));
+        rc = ncodec_restore(nc, data, len);
+        assert_int_equal(rc, 0);
+    }
+    free(data);
+}
+
+
+int run_pdu_snapshot_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_pdu_snapshot__api, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_snapshot__flexray, s, t),
+    };
+
+    return cmocka_run_group_tests_name("PDU SNAPSHOT", tests, NULL, NULL);
+}
@@ -0,0 +1,358 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/pdu.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    1024
+#define MESSAGE_LEN   (1024 * 1024)
+#define SEGMENT_SIZE  1000 /* Segment data, 992 bytes (multiple of 16). */
+#define SEGMENT_DATA  992
+
+
+extern NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream);
+
+
+typedef struct Mock {
+    NCODEC*  nc;
+    uint8_t* message;
+} Mock;
+
+
+#define MIMETYPE                                                               \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "swc_id=1;ecu_id=1;tp_segment_size=1000"
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE, stream);
+    assert_non_null(mock->nc);
+    mock->message = malloc(MESSAGE_LEN);
+    for (size_t i = 0; i < MESSAGE_LEN; i++) {
+        mock->message[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock && mock->nc) ncodec_close((void*)mock->nc);
+    if (mock) free(mock->message);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static void _write_message(NCODEC* nc, uint32_t id, const uint8_t* payload,
+    size_t len, uint32_t request_id)
+{
+    int rc = ncodec_write(nc,
+        &(NCodecPdu){
+            .id = id,
+            .payload = payload,
+            .payload_len = len,
+            .swc_id = 2,
+            .transport_type = NCodecPduTransportTypeIp,
+            .transport.ip_message = {
+                .ip_protocol = NCodecPduIpProtocolUdp,
+                .ip_addr_type = NCodecPduIpAddrIPv4,
+                .so_ad_type = NCodecPduSoAdSomeIP,
+                .so_ad.some_ip = {
+                    .message_id = 0x12340001,
+                    .length = (uint32_t)(8 + len),
+                    .request_id = request_id,
+                    .message_type = 0x02,
+                },
+            },
+        });
+    assert_int_equal(rc, len);
+}
+
+
+/* Segment as forwarded by a Bus Model (already has the TP flag and header). */
+static void _write_segment(NCODEC* nc, uint32_t id, uint32_t request_id,
+    const uint8_t* data, size_t offset, size_t len, bool more)
+{
+    uint8_t  segment[SOME_IP_TP_HEADER_LEN + SEGMENT_DATA];
+    uint32_t h = (uint32_t)offset | (more ? 1 : 0);
+    segment[0] = (uint8_t)(h >> 24);
+    segment[1] = (uint8_t)(h >> 16);
+    segment[2] = (uint8_t)(h >> 8);
+    segment[3] = (uint8_t)h;
+    memcpy(segment + SOME_IP_TP_HEADER_LEN, data + offset, len);
+    int rc = ncodec_write(nc,
+        &(NCodecPdu){
+            .id = id,
+            .payload = segment,
+            .payload_len = SOME_IP_TP_HEADER_LEN + len,
+            .swc_id = 2,
+            .transport_type = NCodecPduTransportTypeIp,
+            .transport.ip_message = {
+                .ip_protocol = NCodecPduIpProtocolUdp,
+                .ip_addr_type = NCodecPduIpAddrIPv4,
+                .so_ad_type = NCodecPduSoAdSomeIP,
+                .so_ad.some_ip = {
+                    .message_id = 0x12340001,
+                    .length = (uint32_t)(8 + SOME_IP_TP_HEADER_LEN + len),
+                    .request_id = request_id,
+                    .message_type = 0x02 | SOME_IP_TP_FLAG,
+                },
+            },
+        });
+    assert_int_equal(rc, SOME_IP_TP_HEADER_LEN + len);
+}
+
+
+void test_pdu_some_ip_tp__reassemble(void** state)
+{
+    Mock*     mock = *state;
+    NCODEC*   nc = mock->nc;
+    NCodecPdu pdu;
+    int       rc;
+
+    for (size_t step = 0; step < 3; step++) {
+        ncodec_truncate(nc);
+        _write_message(nc, 42, mock->message, MESSAGE_LEN, step);
+        ncodec_flush(nc);
+        ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+
+        /* One PDU, the complete message. */
+        rc = ncodec_read(nc, &pdu);
+        assert_int_equal(rc, MESSAGE_LEN);
+        assert_int_equal(pdu.id, 42);
+        assert_int_equal(pdu.swc_id, 2);
+        assert_int_equal(pdu.payload_len, MESSAGE_LEN);
+        assert_memory_equal(pdu.payload, mock->message, MESSAGE_LEN);
+        NCodecPduSomeIpAdapter* a =
+            &pdu.transport.ip_message.so_ad.some_ip;
+        assert_int_equal(a->message_id, 0x12340001);
+        assert_int_equal(a->request_id, step);
+        assert_int_equal(a->message_type, 0x02);
+        assert_int_equal(a->length, 8 + MESSAGE_LEN);
+        rc = ncodec_read(nc, &pdu);
+        assert_int_equal(rc, -ENOMSG);
+    }
+
+    /* Reassembly slots are preallocated and retained. */
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    assert_int_equal(vector_len(&_nc->tp.slots), SOME_IP_TP_SLOTS);
+}
+
+
+void test_pdu_some_ip_tp__segments(void** state)
+{
+    Mock*        mock = *state;
+    NCODEC*      nc = mock->nc;
+    NCodecPduRef ref;
+    size_t       len = SEGMENT_DATA * 3 + 10;
+
+    ncodec_truncate(nc);
+    _write_message(nc, 42, mock->message, len, 0);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+
+    /* PDU references are not reassembled, each segment has a TP header. */
+    size_t offset = 0;
+    for (size_t i = 0; i < 4; i++) {
+        int rc = ncodec_read_ref(nc, &ref);
+        size_t expect = (i < 3) ? SEGMENT_DATA : 10;
+        assert_int_equal(rc, expect + 4);
+        uint32_t header = ((uint32_t)ref.payload[0] << 24) |
+                          ((uint32_t)ref.payload[1] << 16) |
+                          ((uint32_t)ref.payload[2] << 8) | ref.payload[3];
+        assert_int_equal(header & ~0xfu, offset);
+        assert_int_equal(header & 0x1, (i < 3) ? 1 : 0);
+        assert_memory_equal(ref.payload + 4, mock->message + offset, expect);
+        offset += expect;
+    }
+    assert_int_equal(ncodec_read_ref(nc, &ref), -ENOMSG);
+}
+
+
+void test_pdu_some_ip_tp__multiple(void** state)
+{
+    Mock*     mock = *state;
+    NCODEC*   nc = mock->nc;
+    NCodecPdu pdu[3];
+    int       rc;
+
+    /* Two segmented messages with the same key, and a message which is not
+    segmented (tp_segment_size). All payloads remain valid until truncate. */
+    ncodec_truncate(nc);
+    _write_message(nc, 1, mock->message, 5000, 7);
+    _write_message(nc, 2, mock->message + 1, SEGMENT_SIZE, 7);
+    _write_message(nc, 3, mock->message + 2, 5000, 7);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    for (size_t i = 0; i < ARRAY_SIZE(pdu); i++) {
+        rc = ncodec_read(nc, &pdu[i]);
+        assert_int_equal(pdu[i].id, i + 1);
+    }
+    NCodecPdu none;
+    rc = ncodec_read(nc, &none);
+    assert_int_equal(rc, -ENOMSG);
+    assert_int_equal(pdu[0].payload_len, 5000);
+    assert_memory_equal(pdu[0].payload, mock->message, 5000);
+    assert_int_equal(pdu[1].payload_len, SEGMENT_SIZE);
+    assert_memory_equal(pdu[1].payload, mock->message + 1, SEGMENT_SIZE);
+    assert_int_equal(pdu[2].payload_len, 5000);
+    assert_memory_equal(pdu[2].payload, mock->message + 2, 5000);
+    assert_ptr_not_equal(pdu[0].payload, pdu[2].payload);
+}
+
+
+void test_pdu_some_ip_tp__step(void** state)
+{
+    Mock*     mock = *state;
+    NCODEC*   nc = mock->nc;
+    NCodecPdu pdu[2];
+    int       rc;
+
+    /* Pipelined step, messages are reassembled by the step worker. */
+    ncodec_truncate(nc);
+    _write_message(nc, 1, mock->message, 50000, 1);
+    _write_message(nc, 2, mock->message + 3, 50000, 2);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, 0);
+    for (size_t i = 0; i < ARRAY_SIZE(pdu); i++) {
+        rc = ncodec_read(nc, &pdu[i]);
+        assert_int_equal(rc, 50000);
+    }
+    assert_memory_equal(pdu[0].payload, mock->message, 50000);
+    assert_memory_equal(pdu[1].payload, mock->message + 3, 50000);
+    ncodec_truncate(nc);
+}
+
+
+void test_pdu_some_ip_tp__span_steps(void** state)
+{
+    Mock*     mock = *state;
+    NCODEC*   nc = mock->nc;
+    NCodecPdu pdu;
+    int       rc;
+    size_t    len = SEGMENT_DATA * 2 + 10;
+
+    /* Step 1: first two segments, the message is incomplete. */
+    ncodec_truncate(nc);
+    _write_segment(nc, 42, 5, mock->message, 0, SEGMENT_DATA, true);
+    _write_segment(nc, 42, 5, mock->message, SEGMENT_DATA, SEGMENT_DATA, true);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, -ENOMSG);
+
+    /* Step 2: last segment (e.g. delayed by a Bus Model), message complete. */
+    ncodec_truncate(nc);
+    _write_segment(nc, 42, 5, mock->message, SEGMENT_DATA * 2, 10, false);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, len);
+    assert_int_equal(pdu.id, 42);
+    assert_int_equal(pdu.payload_len, len);
+    assert_memory_equal(pdu.payload, mock->message, len);
+    NCodecPduSomeIpAdapter* a = &pdu.transport.ip_message.so_ad.some_ip;
+    assert_int_equal(a->message_type, 0x02);
+    assert_int_equal(a->request_id, 5);
+    assert_int_equal(a->length, 8 + len);
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, -ENOMSG);
+
+    /* Step 3: an incomplete message is restarted by its first segment. */
+    ncodec_truncate(nc);
+    _write_segment(nc, 42, 5, mock->message, 0, SEGMENT_DATA, true);
+    _write_segment(nc, 42, 5, mock->message + 1, 0, SEGMENT_DATA, false);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, SEGMENT_DATA);
+    assert_memory_equal(pdu.payload, mock->message + 1, SEGMENT_DATA);
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, -ENOMSG);
+}
+
+
+void test_pdu_some_ip_tp__expire(void** state)
+{
+    UNUSED(state);
+    uint8_t   data[SEGMENT_DATA + 10] = { 1, 2, 3 };
+    NCodecPdu pdu;
+    int       rc;
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*  nc =
+        (void*)ncodec_open(MIMETYPE ";tp_slots=2;tp_timeout=2", stream);
+    assert_non_null(nc);
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+
+    /* Step 1: three messages start, the oldest (request 1) is evicted. */
+    ncodec_truncate(nc);
+    for (uint32_t request_id = 1; request_id <= 3; request_id++) {
+        _write_segment(nc, 42, request_id, data, 0, SEGMENT_DATA, true);
+    }
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    assert_int_equal(ncodec_read(nc, &pdu), -ENOMSG);
+    assert_int_equal(vector_len(&_nc->tp.slots), 2);
+
+    /* Step 2: only request 3 is complete. */
+    ncodec_truncate(nc);
+    _write_segment(nc, 42, 1, data, SEGMENT_DATA, 10, false);
+    _write_segment(nc, 42, 3, data, SEGMENT_DATA, 10, false);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, SEGMENT_DATA + 10);
+    assert_int_equal(pdu.transport.ip_message.so_ad.some_ip.request_id, 3);
+    assert_int_equal(ncodec_read(nc, &pdu), -ENOMSG);
+
+    /* Step 5: request 2 expired (no segment for tp_timeout steps). */
+    ncodec_truncate(nc);
+    ncodec_truncate(nc);
+    ncodec_truncate(nc);
+    _write_segment(nc, 42, 2, data, SEGMENT_DATA, 10, false);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    assert_int_equal(ncodec_read(nc, &pdu), -ENOMSG);
+    assert_int_equal(vector_len(&_nc->tp.slots), 2);
+    ncodec_close(nc);
+}
+
+
+int run_pdu_some_ip_tp_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_pdu_some_ip_tp__reassemble, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_some_ip_tp__segments, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_some_ip_tp__multiple, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_some_ip_tp__step, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_some_ip_tp__span_steps, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_some_ip_tp__expire, s, t),
+    };
+
+    return cmocka_run_group_tests_name("PDU SOME/IP-TP", tests, NULL, NULL);
+}
@@ -0,0 +1,310 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/pdu.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    1024
+
+
+extern NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream);
+
+
+typedef struct Mock {
+    NCODEC* nc;
+} Mock;
+
+
+#define MIMETYPE                                                               \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=pdu;schema=fbs;"                                    \
+    "swc_id=4;ecu_id=5"
+#define MIMETYPE_FRAME                                                         \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=frame;bus=can;schema=fbs"
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE, stream);
+    assert_non_null(mock->nc);
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock && mock->nc) ncodec_close((void*)mock->nc);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static void _write_pdus(NCODEC* nc, const char** greetings, size_t count)
+{
+    ncodec_truncate(nc);
+    for (size_t i = 0; i < count; i++) {
+        int rc = ncodec_write(nc, &(struct NCodecPdu){ .id = 42 + i,
+                                      .payload = (uint8_t*)greetings[i],
+                                      .payload_len = strlen(greetings[i]),
+                                      .swc_id = 42,
+                                      .ecu_id = 24 });
+        assert_int_equal(rc, strlen(greetings[i]));
+    }
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+}
+
+
+void test_pdu_step__no_stream(void** state)
+{
+    UNUSED(state);
+    int rc;
+
+    rc = ncodec_step_begin(NULL);
+    assert_int_equal(rc, -ENOSTR);
+    rc = ncodec_step_wait(NULL);
+    assert_int_equal(rc, -ENOSTR);
+
+    NCODEC* nc = (void*)ncodec_create(MIMETYPE);
+    assert_non_null(nc);
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, -ENOSR);
+    ncodec_close(nc);
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    nc = (void*)ncodec_open(MIMETYPE_FRAME, stream);
+    assert_non_null(nc);
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, -ENOSYS);
+    rc = ncodec_step_wait(nc);
+    assert_int_equal(rc, -ENOSYS);
+    ncodec_close(nc);
+}
+
+
+void test_pdu_step__read(void** state)
+{
+    Mock*       mock = *state;
+    NCODEC*     nc = mock->nc;
+    const char* greetings[] = { "Hello World", "Foo Bar", "Hello Again" };
+    int         rc;
+
+    for (int step = 0; step < 3; step++) {
+        _write_pdus(nc, greetings, ARRAY_SIZE(greetings));
+
+        rc = ncodec_step_begin(nc);
+        assert_int_equal(rc, 0);
+
+        for (size_t i = 0; i < ARRAY_SIZE(greetings); i++) {
+            NCodecPdu pdu = {};
+            rc = ncodec_read(nc, &pdu);
+            assert_int_equal(rc, strlen(greetings[i]));
+            assert_int_equal(pdu.id, 42 + i);
+            assert_int_equal(pdu.payload_len, strlen(greetings[i]));
+            assert_memory_equal(
+                pdu.payload, greetings[i], strlen(greetings[i]));
+            assert_int_equal(pdu.swc_id, 42);
+            assert_int_equal(pdu.ecu_id, 24);
+        }
+        NCodecPdu pdu = {};
+        rc = ncodec_read(nc, &pdu);
+        assert_int_equal(rc, -ENOMSG);
+        rc = ncodec_read(nc, &pdu);
+        assert_int_equal(rc, -ENOMSG);
+    }
+}
+
+
+void test_pdu_step__read_ref(void** state)
+{
+    Mock*        mock = *state;
+    NCODEC*      nc = mock->nc;
+    const char*  greetings[] = { "Hello World", "Foo Bar" };
+    NCodecPduRef ref = {};
+    int          rc;
+
+    /* Compact descriptors are not available from a pipelined step. */
+    _write_pdus(nc, greetings, ARRAY_SIZE(greetings));
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, 0);
+    rc = ncodec_read_ref(nc, &ref);
+    assert_int_equal(rc, -EBUSY);
+    for (size_t i = 0; i < ARRAY_SIZE(greetings); i++) {
+        NCodecPdu pdu = {};
+        rc = ncodec_read(nc, &pdu);
+        assert_int_equal(rc, strlen(greetings[i]));
+        assert_int_equal(pdu.id, 42 + i);
+    }
+
+    /* Without a pipelined step, descriptors have the metadata handle. */
+    ncodec_truncate(nc);
+    ncodec_write(nc, &(struct NCodecPdu){ .id = 42,
+                         .payload = (uint8_t*)greetings[0],
+                         .payload_len = strlen(greetings[0]),
+                         .swc_id = 42,
+                         .transport_type = NCodecPduTransportTypeCan,
+                         .transport.can_message = { .interface_id = 3 } });
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read_ref(nc, &ref);
+    assert_int_equal(rc, strlen(greetings[0]));
+    assert_int_equal(ref.transport_type, NCodecPduTransportTypeCan);
+    assert_non_null(ref.metadata);
+}
+
+
+void test_pdu_step__busy(void** state)
+{
+    Mock*       mock = *state;
+    NCODEC*     nc = mock->nc;
+    const char* greetings[] = { "Hello World" };
+    int         rc;
+
+    _write_pdus(nc, greetings, ARRAY_SIZE(greetings));
+
+    rc = ncodec_step_wait(nc);
+    assert_int_equal(rc, 0);
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, 0);
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, -EBUSY);
+    rc = ncodec_step_wait(nc);
+    assert_int_equal(rc, 0);
+    rc = ncodec_step_wait(nc);
+    assert_int_equal(rc, 0);
+
+    NCodecPdu pdu = {};
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, strlen(greetings[0]));
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, -ENOMSG);
+}
+
+
+void test_pdu_step__seek(void** state)
+{
+    Mock*       mock = *state;
+    NCODEC*     nc = mock->nc;
+    const char* greetings[] = { "Hello World", "Foo Bar" };
+    int         rc;
+
+    /* Seek and tell complete the pending step (the worker consumed the
+    stream and reset its position). */
+    _write_pdus(nc, greetings, ARRAY_SIZE(greetings));
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, 0);
+    assert_int_equal(ncodec_tell(nc), 0);
+    _write_pdus(nc, greetings, ARRAY_SIZE(greetings));
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, 0);
+    assert_int_equal(ncodec_seek(nc, 0, NCODEC_SEEK_SET), 0);
+
+    /* The PDUs of the completed step are still returned. */
+    for (size_t i = 0; i < ARRAY_SIZE(greetings); i++) {
+        NCodecPdu pdu = {};
+        rc = ncodec_read(nc, &pdu);
+        assert_int_equal(rc, strlen(greetings[i]));
+        assert_int_equal(pdu.id, 42 + i);
+    }
+    NCodecPdu pdu = {};
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, -ENOMSG);
+}
+
+
+void test_pdu_step__config(void** state)
+{
+    Mock*            mock = *state;
+    NCODEC*          nc = mock->nc;
+    ABCodecInstance* _nc = (ABCodecInstance*)nc;
+    const char*      greetings[] = { "Hello World", "Foo Bar" };
+    int              rc;
+
+    /* Config and stat complete the pending step. */
+    _write_pdus(nc, greetings, ARRAY_SIZE(greetings));
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, 0);
+    ncodec_config(nc, (struct NCodecConfigItem){
+                          .name = "swc_id", .value = "7" });
+    assert_false(_nc->step.pending);
+    _write_pdus(nc, greetings, ARRAY_SIZE(greetings));
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, 0);
+    int32_t          index = 0;
+    NCodecConfigItem item = ncodec_stat(nc, &index);
+    assert_false(_nc->step.pending);
+    assert_non_null(item.name);
+
+    /* The PDUs of the completed step are still returned. */
+    for (size_t i = 0; i < ARRAY_SIZE(greetings); i++) {
+        NCodecPdu pdu = {};
+        rc = ncodec_read(nc, &pdu);
+        assert_int_equal(rc, strlen(greetings[i]));
+        assert_int_equal(pdu.id, 42 + i);
+    }
+}
+
+
+void test_pdu_step__truncate(void** state)
+{
+    Mock*       mock = *state;
+    NCODEC*     nc = mock->nc;
+    const char* greetings[] = { "Hello World", "Foo Bar" };
+    int         rc;
+
+    /* Truncate waits for the step, and discards the decoded PDUs. */
+    _write_pdus(nc, greetings, ARRAY_SIZE(greetings));
+    rc = ncodec_step_begin(nc);
+    assert_int_equal(rc, 0);
+    rc = ncodec_truncate(nc);
+    assert_int_equal(rc, 0);
+
+    NCodecPdu pdu = {};
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, -ENOMSG);
+
+    /* Sequential read still works after a pipelined step. */
+    _write_pdus(nc, greetings, ARRAY_SIZE(greetings));
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, strlen(greetings[0]));
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, strlen(greetings[1]));
+    rc = ncodec_read(nc, &pdu);
+    assert_int_equal(rc, -ENOMSG);
+}
+
+
+int run_pdu_step_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_pdu_step__no_stream, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_step__read, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_step__read_ref, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_step__busy, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_step__seek, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_step__config, s, t),
+        cmocka_unit_test_setup_teardown(test_pdu_step__truncate, s, t),
+    };
+
+    return cmocka_run_group_tests_name("PDU STEP", tests, NULL, NULL);
+}
@@ -0,0 +1,258 @@
+// Copyright 2026 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/interface/pdu.h>
+#include <dse/ncodec/codec/ab/simbus.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define NODE_COUNT    3
+
+
+extern NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream);
+
+
+typedef struct Mock {
+    NCodecSimBus* bus;
+    NCODEC*       nc[NODE_COUNT];
+} Mock;
+
+
+static const char* mimetype[NODE_COUNT] = {
+    "application/x-automotive-bus; "
+    "interface=stream;type=pdu;schema=fbs;swc_id=1;ecu_id=1",
+    "application/x-automotive-bus; "
+    "interface=stream;type=pdu;schema=fbs;swc_id=2;ecu_id=1",
+    "application/x-automotive-bus; "
+    "interface=stream;type=pdu;schema=fbs;swc_id=3;ecu_id=1",
+};
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    mock->bus = ncodec_simbus_create();
+    assert_non_null(mock->bus);
+    for (size_t i = 0; i < NODE_COUNT; i++) {
+        NSTREAM* stream = ncodec_simbus_stream_create(mock->bus, 1);
+        assert_non_null(stream);
+        mock->nc[i] = ncodec_open(mimetype[i], stream);
+        assert_non_null(mock->nc[i]);
+    }
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock) {
+        for (size_t i = 0; i < NODE_COUNT; i++) {
+            if (mock->nc[i]) ncodec_close(mock->nc[i]);
+        }
+        ncodec_simbus_destroy(mock->bus);
+        free(mock);
+    }
+
+    return 0;
+}
+
+
+static void _write(NCODEC* nc, uint32_t id, const char* payload)
+{
+    int rc = ncodec_write(nc, &(NCodecPdu){ .id = id,
+                                  .payload = (const uint8_t*)payload,
+                                  .payload_len = strlen(payload) + 1 });
+    assert_int_equal(rc, strlen(payload) + 1);
+}
+
+
+/* Read all PDUs of a node, returns the number of PDUs. */
+static size_t _read(NCODEC* nc, NCodecPdu* pdu, size_t count)
+{
+    size_t    n = 0;
+    NCodecPdu _pdu;
+    while (ncodec_read(nc, &_pdu) >= 0) {
+        if (n < count) pdu[n] = _pdu;
+        n++;
+    }
+    return n;
+}
+
+
+void test_simbus__broadcast(void** state)
+{
+    Mock*     mock = *state;
+    NCodecPdu pdu[NODE_COUNT][4];
+    char      msg[NODE_COUNT][20];
+
+    for (size_t step = 0; step < 3; step++) {
+        for (size_t i = 0; i < NODE_COUNT; i++) {
+            ncodec_truncate(mock->nc[i]);
+            snprintf(msg[i], sizeof(msg[i]), "node %zu step %zu", i, step);
+            _write(mock->nc[i], (uint32_t)(i + 1), msg[i]);
+            ncodec_flush(mock->nc[i]);
+        }
+        assert_int_equal(ncodec_simbus_step(mock->bus), 0);
+
+        /* Each node receives the PDUs of the other nodes (own PDUs are
+        filtered by swc_id). */
+        for (size_t i = 0; i < NODE_COUNT; i++) {
+            assert_int_equal(_read(mock->nc[i], pdu[i], 4), NODE_COUNT - 1);
+            for (size_t j = 0; j < NODE_COUNT - 1; j++) {
+                size_t from = pdu[i][j].id - 1;
+                assert_int_not_equal(from, i);
+                assert_string_equal((char*)pdu[i][j].payload, msg[from]);
+            }
+        }
+        /* Delivered by reference, node 2 and 3 read the same payload. */
+        assert_ptr_equal(pdu[1][0].payload, pdu[2][0].payload);
+    }
+}
+
+
+void test_simbus__subscribe(void** state)
+{
+    Mock*     mock = *state;
+    NCodecPdu pdu[4];
+    NSTREAM*  stream = ((NCodecInstance*)mock->nc[2])->stream;
+
+    /* Node 3 only subscribes to ids 100..199. */
+    assert_int_equal(ncodec_simbus_subscribe(stream, 1, 100, 199), 0);
+    assert_int_equal(ncodec_simbus_subscribe(stream, 1, 10, 9), -EINVAL);
+
+    /* Two messages from node 1 (flush after each PDU). */
+    ncodec_truncate(mock->nc[0]);
+    _write(mock->nc[0], 50, "fifty");
+    ncodec_flush(mock->nc[0]);
+    _write(mock->nc[0], 150, "one fifty");
+    ncodec_flush(mock->nc[0]);
+    ncodec_simbus_step(mock->bus);
+
+    assert_int_equal(_read(mock->nc[1], pdu, 4), 2);
+    assert_int_equal(pdu[0].id, 50);
+    assert_int_equal(pdu[1].id, 150);
+    assert_int_equal(_read(mock->nc[2], pdu, 4), 1);
+    assert_int_equal(pdu[0].id, 150);
+
+    /* Messages are delivered for one step. */
+    ncodec_truncate(mock->nc[1]);
+    ncodec_simbus_step(mock->bus);
+    assert_int_equal(_read(mock->nc[1], pdu, 4), 0);
+}
+
+
+void test_simbus__subscribe_overlap(void** state)
+{
+    Mock*     mock = *state;
+    NCodecPdu pdu[8];
+    NSTREAM*  stream = ((NCodecInstance*)mock->nc[2])->stream;
+
+    /* Overlapping ranges, a message is delivered once. */
+    assert_int_equal(ncodec_simbus_subscribe(stream, 1, 100, 199), 0);
+    assert_int_equal(ncodec_simbus_subscribe(stream, 1, 150, 299), 0);
+    assert_int_equal(ncodec_simbus_subscribe(stream, 1, 500, 500), 0);
+    assert_int_equal(ncodec_simbus_subscribe(stream, 2, 0, UINT32_MAX), 0);
+
+    ncodec_truncate(mock->nc[0]);
+    _write(mock->nc[0], 170, "a");
+    _write(mock->nc[0], 160, "b");
+    ncodec_flush(mock->nc[0]);
+    _write(mock->nc[0], 300, "c");
+    ncodec_flush(mock->nc[0]);
+    _write(mock->nc[0], 50, "d");
+    _write(mock->nc[0], 500, "e");
+    ncodec_flush(mock->nc[0]);
+    _write(mock->nc[0], 499, "f");
+    _write(mock->nc[0], 501, "g");
+    ncodec_flush(mock->nc[0]);
+    ncodec_simbus_step(mock->bus);
+
+    assert_int_equal(_read(mock->nc[1], pdu, 8), 7);
+    assert_int_equal(_read(mock->nc[2], pdu, 8), 4);
+    assert_int_equal(pdu[0].id, 170);
+    assert_int_equal(pdu[1].id, 160);
+    assert_int_equal(pdu[2].id, 50);
+    assert_int_equal(pdu[3].id, 500);
+}
+
+
+void test_simbus__bus_id(void** state)
+{
+    Mock*     mock = *state;
+    NCodecPdu pdu[4];
+
+    /* A node on bus 2, subscribed to the PDUs of bus 1 (all ids). */
+    NSTREAM* stream = ncodec_simbus_stream_create(mock->bus, 2);
+    NCODEC*  nc = ncodec_open(
+        "application/x-automotive-bus; "
+        "interface=stream;type=pdu;schema=fbs;swc_id=4;ecu_id=1",
+        stream);
+    assert_non_null(nc);
+
+    _write(mock->nc[0], 1, "bus 1");
+    ncodec_flush(mock->nc[0]);
+    _write(nc, 2, "bus 2");
+    ncodec_flush(nc);
+    ncodec_simbus_step(mock->bus);
+    assert_int_equal(_read(nc, pdu, 4), 0);
+    assert_int_equal(_read(mock->nc[1], pdu, 4), 1);
+    assert_int_equal(pdu[0].id, 1);
+
+    ncodec_truncate(mock->nc[0]);
+    ncodec_truncate(nc);
+    ncodec_simbus_subscribe(stream, 1, 0, UINT32_MAX);
+    _write(mock->nc[0], 1, "bus 1");
+    ncodec_flush(mock->nc[0]);
+    ncodec_simbus_step(mock->bus);
+    assert_int_equal(_read(nc, pdu, 4), 1);
+    assert_string_equal((char*)pdu[0].payload, "bus 1");
+    ncodec_close(nc);
+}
+
+
+void test_simbus__close(void** state)
+{
+    Mock*     mock = *state;
+    NCodecPdu pdu[4];
+
+    _write(mock->nc[0], 1, "last message");
+    ncodec_flush(mock->nc[0]);
+    ncodec_simbus_step(mock->bus);
+
+    /* Published messages remain valid after the node is closed. */
+    ncodec_close(mock->nc[0]);
+    mock->nc[0] = NULL;
+    assert_int_equal(_read(mock->nc[1], pdu, 4), 1);
+    assert_string_equal((char*)pdu[0].payload, "last message");
+    ncodec_truncate(mock->nc[1]);
+    ncodec_simbus_step(mock->bus);
+    assert_int_equal(_read(mock->nc[1], pdu, 4), 0);
+}
+
+
+int run_simbus_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_simbus__broadcast, s, t),
+        cmocka_unit_test_setup_teardown(test_simbus__subscribe, s, t),
+        cmocka_unit_test_setup_teardown(test_simbus__subscribe_overlap, s, t),
+        cmocka_unit_test_setup_teardown(test_simbus__bus_id, s, t),
+        cmocka_unit_test_setup_teardown(test_simbus__close, s, t),
+    };
+
+    return cmocka_run_group_tests_name("SIMBUS", tests, NULL, NULL);
+}
@@ -0,0 +1,323 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/pdu.h>
+#include <dse/ncodec/codec/ab/struct_abi.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    1024
+
+
+extern NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream);
+
+
+typedef struct Foo {
+    uint8_t  a;
+    double   b;
+    uint16_t c[4];
+    uint32_t d;
+} Foo;
+
+static const NCodecStructField foo_fields[] = {
+    { .name = "a", .size = 1 },
+    { .name = "b", .size = 8 },
+    { .name = "c", .size = 2, .count = 4 },
+    { .name = "d", .size = 4 },
+};
+
+
+typedef struct Mock {
+    NCodecStructAbi* abi;
+} Mock;
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    mock->abi = ncodec_struct_abi_create();
+    assert_non_null(mock->abi);
+    int rc = ncodec_struct_abi_register(
+        mock->abi, "Foo", foo_fields, ARRAY_SIZE(foo_fields));
+    assert_int_equal(rc, 0);
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock) ncodec_struct_abi_destroy(mock->abi);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static void _check_foo(Foo* foo)
+{
+    assert_int_equal(foo->a, 0x11);
+    assert_true(foo->b == 1.5);
+    for (size_t i = 0; i < 4; i++) {
+        assert_int_equal(foo->c[i], 0x0100 + i);
+    }
+    assert_int_equal(foo->d, 0xaabbccdd);
+}
+
+
+/* Store a value (little or big endian). */
+static void _put(uint8_t* p, const void* v, size_t size, bool big_endian)
+{
+    const uint8_t* b = v;
+    uint16_t       probe = 1;
+    bool native_be = (*(uint8_t*)&probe == 0);
+    for (size_t i = 0; i < size; i++) {
+        p[i] = (native_be == big_endian) ? b[i] : b[size - 1 - i];
+    }
+}
+
+static void _put_foo(uint8_t* p, const uint32_t* offset, bool big_endian)
+{
+    uint8_t  a = 0x11;
+    double   b = 1.5;
+    uint32_t d = 0xaabbccdd;
+    _put(p + offset[0], &a, 1, big_endian);
+    _put(p + offset[1], &b, 8, big_endian);
+    for (uint16_t i = 0; i < 4; i++) {
+        uint16_t c = 0x0100 + i;
+        _put(p + offset[2] + i * 2, &c, 2, big_endian);
+    }
+    _put(p + offset[3], &d, 4, big_endian);
+}
+
+
+void test_struct_abi__native(void** state)
+{
+    Mock*                   mock = *state;
+    const NCodecStructPlan* plan = NULL;
+    Foo                     src = { 0x11, 1.5, { 0x100, 0x101, 0x102, 0x103 },
+                            0xaabbccdd };
+    Foo                     dst;
+
+    /* No platform metadata, a single copy. */
+    NCodecPduStructMetadata md = { .type_name = "Foo" };
+    assert_int_equal(ncodec_struct_abi_plan(mock->abi, &md, NULL, &plan), 0);
+    assert_non_null(plan);
+    assert_int_equal(plan->src_size, sizeof(Foo));
+    assert_int_equal(plan->dst_size, sizeof(Foo));
+    assert_int_equal(plan->op_count, 1);
+    assert_false(plan->dst_padded);
+
+    int rc = ncodec_struct_abi_convert(plan, &src, sizeof(src), &dst, sizeof(dst));
+    assert_int_equal(rc, sizeof(Foo));
+    _check_foo(&dst);
+
+    /* Buffer lengths. */
+    rc = ncodec_struct_abi_convert(plan, &src, sizeof(src) - 1, &dst, sizeof(dst));
+    assert_int_equal(rc, -EINVAL);
+    rc = ncodec_struct_abi_convert(plan, &src, sizeof(src), &dst, sizeof(dst) - 1);
+    assert_int_equal(rc, -ENOSPC);
+}
+
+
+void test_struct_abi__i386(void** state)
+{
+    Mock*                   mock = *state;
+    const NCodecStructPlan* plan = NULL;
+    uint8_t                 src[24] = { 0 };
+    Foo                     dst;
+
+    /* System V i386, 8 byte scalars aligned to 4. */
+    NCodecPduStructMetadata md = {
+        .type_name = "Foo",
+        .platform_arch = "i386",
+        .platform_os = "linux",
+    };
+    assert_int_equal(ncodec_struct_abi_plan(mock->abi, &md, NULL, &plan), 0);
+    assert_int_equal(plan->src_size, 24);
+    assert_int_equal(plan->dst_size, sizeof(Foo));
+
+    _put_foo(src, (uint32_t[]){ 0, 4, 12, 20 }, false);
+    memset(&dst, 0xff, sizeof(dst));
+    int rc = ncodec_struct_abi_convert(plan, src, 24, &dst, sizeof(dst));
+    assert_int_equal(rc, sizeof(Foo));
+    _check_foo(&dst);
+
+    /* Packed, no padding. */
+    md.attribute_packed = true;
+    assert_int_equal(ncodec_struct_abi_plan(mock->abi, &md, NULL, &plan), 0);
+    assert_int_equal(plan->src_size, 21);
+    memset(src, 0, sizeof(src));
+    _put_foo(src, (uint32_t[]){ 0, 1, 9, 17 }, false);
+    rc = ncodec_struct_abi_convert(plan, src, 21, &dst, sizeof(dst));
+    assert_int_equal(rc, sizeof(Foo));
+    _check_foo(&dst);
+
+    /* Windows, 8 byte scalars aligned to 8. */
+    md.attribute_packed = false;
+    md.platform_os = "windows";
+    assert_int_equal(ncodec_struct_abi_plan(mock->abi, &md, NULL, &plan), 0);
+    assert_int_equal(plan->src_size, 32);
+}
+
+
+void test_struct_abi__big_endian(void** state)
+{
+    Mock*                   mock = *state;
+    const NCodecStructPlan* plan = NULL;
+    uint8_t                 src[32] = { 0 };
+    Foo                     dst;
+
+    NCodecPduStructMetadata md = {
+        .type_name = "Foo",
+        .platform_arch = "ppc",
+        .platform_os = "linux",
+        .attribute_aligned = 16,
+    };
+    assert_int_equal(ncodec_struct_abi_plan(mock->abi, &md, NULL, &plan), 0);
+    assert_int_equal(plan->src_size, 32);
+    assert_int_equal(plan->op_count, 4);
+
+    _put_foo(src, (uint32_t[]){ 0, 8, 16, 24 }, true);
+    int rc = ncodec_struct_abi_convert(plan, src, sizeof(src), &dst, sizeof(dst));
+    assert_int_equal(rc, sizeof(Foo));
+    _check_foo(&dst);
+
+    /* Native to big endian (target metadata). */
+    NCodecPduStructMetadata native = { .type_name = "Foo" };
+    uint8_t                 out[32];
+    assert_int_equal(ncodec_struct_abi_plan(mock->abi, &native, &md, &plan), 0);
+    rc = ncodec_struct_abi_convert(plan, &dst, sizeof(dst), out, sizeof(out));
+    assert_int_equal(rc, 32);
+    assert_memory_equal(out, src, sizeof(src));
+}
+
+
+void test_struct_abi__cache(void** state)
+{
+    Mock*                   mock = *state;
+    const NCodecStructPlan* plan = NULL;
+    const NCodecStructPlan* cached = NULL;
+    char                    type_name[] = "Foo";
+    char                    arch[] = "arm64";
+
+    NCodecPduStructMetadata md = {
+        .type_name = "Foo",
+        .platform_arch = "arm64",
+        .platform_os = "linux",
+    };
+    assert_int_equal(ncodec_struct_abi_plan(mock->abi, &md, NULL, &plan), 0);
+
+    /* Equal metadata (other strings), the cached plan is returned. */
+    md.type_name = type_name;
+    md.platform_arch = arch;
+    assert_int_equal(ncodec_struct_abi_plan(mock->abi, &md, NULL, &cached), 0);
+    assert_ptr_equal(plan, cached);
+    md.attribute_aligned = 16;
+    assert_int_equal(ncodec_struct_abi_plan(mock->abi, &md, NULL, &cached), 0);
+    assert_ptr_not_equal(plan, cached);
+
+    /* Errors. */
+    md.type_name = "Bar";
+    assert_int_equal(
+        ncodec_struct_abi_plan(mock->abi, &md, NULL, &plan), -ENOENT);
+    md.type_name = "Foo";
+    md.platform_arch = "z80";
+    assert_int_equal(
+        ncodec_struct_abi_plan(mock->abi, &md, NULL, &plan), -EINVAL);
+    md.platform_arch = "arm64";
+    NCodecPduStructMetadata dst = { .encoding = "xdr" };
+    assert_int_equal(
+        ncodec_struct_abi_plan(mock->abi, &md, &dst, &plan), -EINVAL);
+    assert_int_equal(ncodec_struct_abi_register(mock->abi, "Foo", foo_fields,
+                         ARRAY_SIZE(foo_fields)),
+        -EEXIST);
+    NCodecStructField bad = { .name = "x", .size = 3 };
+    assert_int_equal(
+        ncodec_struct_abi_register(mock->abi, "Bad", &bad, 1), -EINVAL);
+}
+
+
+void test_struct_abi__pdu(void** state)
+{
+    Mock*   mock = *state;
+    uint8_t payload[32] = { 0 };
+    Foo     foo;
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    NCODEC*  nc = (void*)ncodec_open("application/x-automotive-bus; "
+                                     "interface=stream;type=pdu;schema=fbs;"
+                                     "swc_id=1;ecu_id=1",
+         stream);
+    assert_non_null(nc);
+
+    /* Struct PDU from a big endian platform. */
+    _put_foo(payload, (uint32_t[]){ 0, 8, 16, 24 }, true);
+    ncodec_truncate(nc);
+    for (size_t i = 0; i < 3; i++) {
+        int rc = ncodec_write(nc,
+            &(NCodecPdu){
+                .id = 42,
+                .payload = payload,
+                .payload_len = sizeof(payload),
+                .swc_id = 2,
+                .transport_type = NCodecPduTransportTypeStruct,
+                .transport.struct_object = {
+                    .type_name = "Foo",
+                    .platform_arch = "ppc64",
+                    .platform_os = "linux",
+                },
+            });
+        assert_int_equal(rc, sizeof(payload));
+    }
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+
+    const NCodecStructPlan* first = NULL;
+    NCodecPdu               pdu;
+    size_t                  count = 0;
+    while (ncodec_read(nc, &pdu) >= 0) {
+        const NCodecStructPlan* plan = NULL;
+        assert_int_equal(pdu.transport_type, NCodecPduTransportTypeStruct);
+        int rc = ncodec_struct_abi_plan(
+            mock->abi, &pdu.transport.struct_object, NULL, &plan);
+        assert_int_equal(rc, 0);
+        if (first == NULL) first = plan;
+        assert_ptr_equal(plan, first);
+        rc = ncodec_struct_abi_convert(
+            plan, pdu.payload, pdu.payload_len, &foo, sizeof(foo));
+        assert_int_equal(rc, sizeof(Foo));
+        _check_foo(&foo);
+        count++;
+    }
+    assert_int_equal(count, 3);
+    ncodec_close(nc);
+}
+
+
+int run_struct_abi_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_struct_abi__native, s, t),
+        cmocka_unit_test_setup_teardown(test_struct_abi__i386, s, t),
+        cmocka_unit_test_setup_teardown(test_struct_abi__big_endian, s, t),
+        cmocka_unit_test_setup_teardown(test_struct_abi__cache, s, t),
+        cmocka_unit_test_setup_teardown(test_struct_abi__pdu, s, t),
+    };
+
+    return cmocka_run_group_tests_name("STRUCT ABI", tests, NULL, NULL);
+}
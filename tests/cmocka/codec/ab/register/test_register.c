@@ -0,0 +1,327 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/register.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    2048
+
+
+extern NCODEC* ncodec_create(const char* mime_type);
+
+NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream)
+{
+    NCODEC* nc = ncodec_create(mime_type);
+    if (nc) {
+        NCodecInstance* _nc = (NCodecInstance*)nc;
+        _nc->stream = stream;
+    }
+    return nc;
+}
+
+
+typedef struct Mock {
+    NCODEC* nc;
+} Mock;
+
+
+#define MIMETYPE_CAN                                                           \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=register;bus=can;schema=fbs"
+#define MIMETYPE_FLEXRAY                                                       \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=register;bus=flexray;schema=fbs"
+#define MIMETYPE_ETHERNET                                                      \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=register;bus=ethernet;schema=fbs"
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock && mock->nc) ncodec_close((void*)mock->nc);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static NCODEC* _open(Mock* mock, const char* mime_type)
+{
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(mime_type, stream);
+    assert_non_null(mock->nc);
+    return mock->nc;
+}
+
+
+void test_register__create(void** state)
+{
+    UNUSED(state);
+    const char* invalid[] = {
+        "application/x-automotive-bus; "
+        "interface=stream;type=register;schema=fbs",
+        "application/x-automotive-bus; "
+        "interface=stream;type=register;bus=lin;schema=fbs",
+        "application/x-automotive-bus; "
+        "interface=stream;type=register;bus=can;schema=json",
+    };
+    for (size_t i = 0; i < ARRAY_SIZE(invalid); i++) {
+        NCODEC* nc = ncodec_create(invalid[i]);
+        assert_null(nc);
+    }
+    const char* valid[] = { MIMETYPE_CAN, MIMETYPE_FLEXRAY, MIMETYPE_ETHERNET };
+    for (size_t i = 0; i < ARRAY_SIZE(valid); i++) {
+        NCODEC* nc = ncodec_create(valid[i]);
+        assert_non_null(nc);
+        ncodec_close(nc);
+    }
+}
+
+
+void test_register__can(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = _open(mock, MIMETYPE_CAN);
+    int     rc;
+
+    NCodecRegisterBuffer buffer[] = {
+        {
+            .frame_id = 0x101,
+            .payload = (const uint8_t*)"HELLO",
+            .payload_len = 5,
+            .direction = NCodecRegisterDirectionTx,
+            .bus.can = { .frame_type = NCodecRegisterCanFrameTypeStandard },
+        },
+        {
+            .frame_id = 0x1ABCDE,
+            .payload = (const uint8_t*)"WORLD 0123456789",
+            .payload_len = 16,
+            .direction = NCodecRegisterDirectionTx,
+            .bus.can = { .frame_type = NCodecRegisterCanFrameTypeExtended,
+                .can_fd_enabled = true },
+            .timing = { .send = 1000, .arb = 2000, .recv = 3000 },
+        },
+        {
+            .frame_id = 0x200,
+            .direction = NCodecRegisterDirectionRx,
+            .status = NCodecRegisterStatusRxError,
+            .bus.can = { .rtr = true },
+        },
+    };
+
+    /* Bulk write (and an empty write) to a single Register File. */
+    ncodec_truncate(nc);
+    rc = ncodec_write(nc, &(NCodecRegisterFile){ .buffer = buffer, .count = 2 });
+    assert_int_equal(rc, 2);
+    rc = ncodec_write(nc, &(NCodecRegisterFile){ .count = 0 });
+    assert_int_equal(rc, 0);
+    rc = ncodec_write(
+        nc, &(NCodecRegisterFile){ .buffer = &buffer[2], .count = 1 });
+    assert_int_equal(rc, 1);
+    ncodec_flush(nc);
+
+    /* Bulk read. */
+    NCodecRegisterFile rf;
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &rf);
+    assert_int_equal(rc, ARRAY_SIZE(buffer));
+    assert_int_equal(rf.count, ARRAY_SIZE(buffer));
+    assert_non_null(rf.buffer);
+    for (size_t i = 0; i < ARRAY_SIZE(buffer); i++) {
+        NCodecRegisterBuffer* b = &rf.buffer[i];
+        assert_int_equal(b->frame_id, buffer[i].frame_id);
+        assert_int_equal(b->payload_len, buffer[i].payload_len);
+        if (b->payload_len) {
+            assert_memory_equal(b->payload, buffer[i].payload, b->payload_len);
+        }
+        assert_int_equal(b->direction, buffer[i].direction);
+        assert_int_equal(b->status, buffer[i].status);
+        assert_int_equal(b->bus.can.frame_type, buffer[i].bus.can.frame_type);
+        assert_int_equal(b->bus.can.rtr, buffer[i].bus.can.rtr);
+        assert_int_equal(
+            b->bus.can.can_fd_enabled, buffer[i].bus.can.can_fd_enabled);
+        assert_int_equal(b->timing.send, buffer[i].timing.send);
+        assert_int_equal(b->timing.arb, buffer[i].timing.arb);
+        assert_int_equal(b->timing.recv, buffer[i].timing.recv);
+    }
+    rc = ncodec_read(nc, &rf);
+    assert_int_equal(rc, -ENOMSG);
+    assert_int_equal(rf.count, 0);
+    assert_null(rf.buffer);
+}
+
+
+void test_register__flexray(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = _open(mock, MIMETYPE_FLEXRAY);
+    int     rc;
+
+    NCodecRegisterBuffer buffer[] = {
+        {
+            .frame_id = 7,
+            .payload = (const uint8_t*)"01234567",
+            .payload_len = 8,
+            .direction = NCodecRegisterDirectionTx,
+            .bus.flexray = { .indicators = 0x0c,
+                .channel_mask = NCodecRegisterFlexrayChannelA,
+                .cycle_period = 1 },
+        },
+        {
+            .frame_id = 41,
+            .payload = (const uint8_t*)"89ABCDEF01234567",
+            .payload_len = 16,
+            .direction = NCodecRegisterDirectionRx,
+            .bus.flexray = { .indicators = 0x0c,
+                .channel_mask = NCodecRegisterFlexrayChannelBoth,
+                .cycle_period = 4,
+                .cycle_offset = 2 },
+            .timing = { .recv = 5000 },
+        },
+    };
+
+    /* Two steps, each with a single Register File. */
+    for (size_t step = 0; step < 2; step++) {
+        ncodec_truncate(nc);
+        rc = ncodec_write(nc, &(NCodecRegisterFile){
+                                  .buffer = buffer, .count = ARRAY_SIZE(buffer) });
+        assert_int_equal(rc, ARRAY_SIZE(buffer));
+        ncodec_flush(nc);
+
+        NCodecRegisterFile rf;
+        ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+        rc = ncodec_read(nc, &rf);
+        assert_int_equal(rc, ARRAY_SIZE(buffer));
+        for (size_t i = 0; i < ARRAY_SIZE(buffer); i++) {
+            NCodecRegisterBuffer* b = &rf.buffer[i];
+            assert_int_equal(b->frame_id, buffer[i].frame_id);
+            assert_int_equal(b->payload_len, buffer[i].payload_len);
+            assert_memory_equal(b->payload, buffer[i].payload, b->payload_len);
+            assert_int_equal(b->direction, buffer[i].direction);
+            assert_int_equal(
+                b->bus.flexray.indicators, buffer[i].bus.flexray.indicators);
+            assert_int_equal(
+                b->bus.flexray.channel_mask, buffer[i].bus.flexray.channel_mask);
+            assert_int_equal(
+                b->bus.flexray.cycle_period, buffer[i].bus.flexray.cycle_period);
+            assert_int_equal(
+                b->bus.flexray.cycle_offset, buffer[i].bus.flexray.cycle_offset);
+            assert_int_equal(b->timing.recv, buffer[i].timing.recv);
+        }
+        rc = ncodec_read(nc, &rf);
+        assert_int_equal(rc, -ENOMSG);
+    }
+}
+
+
+void test_register__ethernet(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = _open(mock, MIMETYPE_ETHERNET);
+    int     rc;
+
+    uint8_t payload[300];
+    for (size_t i = 0; i < sizeof(payload); i++)
+        payload[i] = (uint8_t)i;
+    NCodecRegisterBuffer buffer = {
+        .payload = payload,
+        .payload_len = sizeof(payload),
+        .direction = NCodecRegisterDirectionTx,
+        .bus.ethernet = { .dst_mac = 0x0102030405a6,
+            .src_mac = 0xf1f2f3f4f5f6,
+            .vlan_tag = 0x8100000a,
+            .ether_type = 0x0800 },
+    };
+
+    ncodec_truncate(nc);
+    rc = ncodec_write(nc, &(NCodecRegisterFile){ .buffer = &buffer, .count = 1 });
+    assert_int_equal(rc, 1);
+    ncodec_flush(nc);
+
+    NCodecRegisterFile rf;
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &rf);
+    assert_int_equal(rc, 1);
+    assert_int_equal(rf.buffer[0].payload_len, sizeof(payload));
+    assert_memory_equal(rf.buffer[0].payload, payload, sizeof(payload));
+    assert_int_equal(rf.buffer[0].bus.ethernet.dst_mac, 0x0102030405a6);
+    assert_int_equal(rf.buffer[0].bus.ethernet.src_mac, 0xf1f2f3f4f5f6);
+    assert_int_equal(rf.buffer[0].bus.ethernet.vlan_tag, 0x8100000a);
+    assert_int_equal(rf.buffer[0].bus.ethernet.ether_type, 0x0800);
+}
+
+
+void test_register__bus_filter(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = _open(mock, MIMETYPE_CAN);
+    int     rc;
+
+    /* A FlexRay Register File on the same stream is ignored. */
+    NCODEC* nc_fr = ncodec_create(MIMETYPE_FLEXRAY);
+    assert_non_null(nc_fr);
+    ((NCodecInstance*)nc_fr)->stream = ((NCodecInstance*)nc)->stream;
+
+    NCodecRegisterBuffer buffer = {
+        .frame_id = 42,
+        .payload = (const uint8_t*)"ABCD",
+        .payload_len = 4,
+    };
+    ncodec_truncate(nc);
+    rc = ncodec_write(
+        nc_fr, &(NCodecRegisterFile){ .buffer = &buffer, .count = 1 });
+    assert_int_equal(rc, 1);
+    ncodec_flush(nc_fr);
+    buffer.frame_id = 43;
+    rc = ncodec_write(nc, &(NCodecRegisterFile){ .buffer = &buffer, .count = 1 });
+    assert_int_equal(rc, 1);
+    ncodec_flush(nc);
+
+    NCodecRegisterFile rf;
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &rf);
+    assert_int_equal(rc, 1);
+    assert_int_equal(rf.buffer[0].frame_id, 43);
+    rc = ncodec_read(nc, &rf);
+    assert_int_equal(rc, -ENOMSG);
+
+    /* The stream is owned by nc. */
+    ((NCodecInstance*)nc_fr)->stream = NULL;
+    ncodec_close(nc_fr);
+}
+
+
+int run_register_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_register__create, s, t),
+        cmocka_unit_test_setup_teardown(test_register__can, s, t),
+        cmocka_unit_test_setup_teardown(test_register__flexray, s, t),
+        cmocka_unit_test_setup_teardown(test_register__ethernet, s, t),
+        cmocka_unit_test_setup_teardown(test_register__bus_filter, s, t),
+    };
+
+    return cmocka_run_group_tests_name("REGISTER", tests, NULL, NULL);
+}
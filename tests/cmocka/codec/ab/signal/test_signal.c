@@ -0,0 +1,323 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/codec/ab/codec.h>
+#include <dse/ncodec/stream/stream.h>
+#include <dse/ncodec/interface/signal.h>
+#include <dse/ncodec/schema/abs/signal/channel_builder.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define BUFFER_LEN    1024
+#define SIGNAL_COUNT  1000
+
+
+#undef ns
+#define ns(x) FLATBUFFERS_WRAP_NAMESPACE(AutomotiveBus_Signal_Channel, x)
+
+
+extern NCODEC* ncodec_create(const char* mime_type);
+
+NCODEC* ncodec_open(const char* mime_type, NSTREAM* stream)
+{
+    NCODEC* nc = ncodec_create(mime_type);
+    if (nc) {
+        NCodecInstance* _nc = (NCodecInstance*)nc;
+        _nc->stream = stream;
+    }
+    return nc;
+}
+
+
+typedef struct Mock {
+    NCODEC* nc;
+} Mock;
+
+
+#define MIMETYPE                                                               \
+    "application/x-automotive-bus; "                                           \
+    "interface=stream;type=signal;schema=fbs;model_uid=42"
+
+
+static int test_setup(void** state)
+{
+    Mock* mock = calloc(1, sizeof(Mock));
+    assert_non_null(mock);
+
+    NSTREAM* stream = ncodec_buffer_stream_create(BUFFER_LEN);
+    mock->nc = (void*)ncodec_open(MIMETYPE, stream);
+    assert_non_null(mock->nc);
+
+    *state = mock;
+    return 0;
+}
+
+
+static int test_teardown(void** state)
+{
+    Mock* mock = *state;
+    if (mock && mock->nc) ncodec_close((void*)mock->nc);
+    if (mock) free(mock);
+
+    return 0;
+}
+
+
+static NCODEC* _peer(NCODEC* nc, uint32_t model_uid)
+{
+    char mime_type[200];
+    snprintf(mime_type, sizeof(mime_type),
+        "application/x-automotive-bus; "
+        "interface=stream;type=signal;schema=fbs;model_uid=%u",
+        model_uid);
+    NCODEC* peer = ncodec_create(mime_type);
+    assert_non_null(peer);
+    ((NCodecInstance*)peer)->stream = ((NCodecInstance*)nc)->stream;
+    return peer;
+}
+
+
+static void _peer_close(NCODEC* peer)
+{
+    /* The stream is owned by the Mock codec. */
+    ((NCodecInstance*)peer)->stream = NULL;
+    ncodec_close(peer);
+}
+
+
+void test_signal__vector(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = mock->nc;
+    NCODEC* peer = _peer(nc, 7);
+    int     rc;
+
+    uint32_t uid[SIGNAL_COUNT];
+    double   value[SIGNAL_COUNT];
+    for (size_t i = 0; i < SIGNAL_COUNT; i++) {
+        uid[i] = 1000 + (uint32_t)i;
+        value[i] = (double)i * 0.5;
+    }
+
+    /* One encode (peer) and one decode (nc) per step. */
+    for (size_t step = 0; step < 3; step++) {
+        value[0] = (double)step;
+        ncodec_truncate(nc);
+        rc = ncodec_write(peer, &(NCodecSignalVector){
+                                    .uid = uid,
+                                    .value = value,
+                                    .count = SIGNAL_COUNT,
+                                });
+        assert_int_equal(rc, SIGNAL_COUNT);
+        ncodec_flush(peer);
+
+        NCodecSignalVector sv;
+        ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+        rc = ncodec_read(nc, &sv);
+        assert_int_equal(rc, SIGNAL_COUNT);
+        assert_int_equal(sv.count, SIGNAL_COUNT);
+        assert_int_equal(sv.type, NCodecSignalVectorTypeValue);
+        assert_int_equal(sv.sender.model_uid, 7);
+        assert_memory_equal(sv.uid, uid, sizeof(uid));
+        assert_memory_equal(sv.value, value, sizeof(value));
+        rc = ncodec_read(nc, &sv);
+        assert_int_equal(rc, -ENOMSG);
+        assert_int_equal(sv.count, 0);
+    }
+
+    _peer_close(peer);
+}
+
+
+void test_signal__write_type(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = mock->nc;
+    NCODEC* peer = _peer(nc, 8);
+    int     rc;
+
+    uint32_t uid[] = { 1, 2, 3 };
+    double   value[] = { 1.1, 2.2, 3.3 };
+    ncodec_truncate(nc);
+    rc = ncodec_write(peer, &(NCodecSignalVector){
+                                .type = NCodecSignalVectorTypeWrite,
+                                .uid = uid,
+                                .value = value,
+                                .count = ARRAY_SIZE(uid),
+                            });
+    assert_int_equal(rc, ARRAY_SIZE(uid));
+    /* An empty vector is a valid message. */
+    rc = ncodec_write(peer, &(NCodecSignalVector){ .count = 0 });
+    assert_int_equal(rc, 0);
+    ncodec_flush(peer);
+
+    NCodecSignalVector sv;
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &sv);
+    assert_int_equal(rc, ARRAY_SIZE(uid));
+    assert_int_equal(sv.type, NCodecSignalVectorTypeWrite);
+    assert_memory_equal(sv.uid, uid, sizeof(uid));
+    assert_memory_equal(sv.value, value, sizeof(value));
+    rc = ncodec_read(nc, &sv);
+    assert_int_equal(rc, 0);
+    assert_int_equal(sv.type, NCodecSignalVectorTypeValue);
+    rc = ncodec_read(nc, &sv);
+    assert_int_equal(rc, -ENOMSG);
+
+    /* Bad vectors. */
+    rc = ncodec_write(peer, &(NCodecSignalVector){ .count = 1 });
+    assert_int_equal(rc, -EINVAL);
+
+    _peer_close(peer);
+}
+
+
+void test_signal__filter(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = mock->nc;
+    int     rc;
+
+    uint32_t uid[] = { 1 };
+    double   value[] = { 42.0 };
+
+    /* Vectors written by this model are filtered. */
+    ncodec_truncate(nc);
+    rc = ncodec_write(nc, &(NCodecSignalVector){
+                              .uid = uid, .value = value, .count = 1 });
+    assert_int_equal(rc, 1);
+    ncodec_flush(nc);
+    NCodecSignalVector sv;
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &sv);
+    assert_int_equal(rc, -ENOMSG);
+
+    /* Unless loopback is enabled. */
+    ncodec_config(nc, (struct NCodecConfigItem){
+                          .name = "loopback", .value = "1" });
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    rc = ncodec_read(nc, &sv);
+    assert_int_equal(rc, 1);
+    assert_int_equal(sv.sender.model_uid, 42);
+    assert_true(sv.value[0] == 42.0);
+}
+
+
+/* Write a SignalValue message with (MsgPack) data from another producer. */
+static void _write_data(NCODEC* nc, const uint8_t* data, size_t len)
+{
+    flatcc_builder_t B;
+    flatcc_builder_init(&B);
+    ns(ChannelMessage_start_as_root_with_size(&B));
+    ns(ChannelMessage_model_uid_add(&B, 9));
+    flatbuffers_uint8_vec_ref_t v =
+        flatbuffers_uint8_vec_create(&B, data, len);
+    ns(ChannelMessage_message_SignalValue_add(
+        &B, ns(SignalValue_create(&B, v))));
+    ns(ChannelMessage_end_as_root(&B));
+    size_t size = 0;
+    void*  buffer = flatcc_builder_finalize_buffer(&B, &size);
+    assert_non_null(buffer);
+    NCodecStreamVTable* stream = ((NCodecInstance*)nc)->stream;
+    stream->write(nc, buffer, size);
+    free(buffer);
+    flatcc_builder_clear(&B);
+}
+
+
+void test_signal__msgpack(void** state)
+{
+    Mock*   mock = *state;
+    NCODEC* nc = mock->nc;
+    int     rc;
+
+    /* Encoded as MsgPack: [[uid...],[value...]]. */
+    uint32_t uid[] = { 1, 300 };
+    double   value[] = { 0.5, 2.0 };
+    ncodec_truncate(nc);
+    rc = ncodec_write(nc, &(NCodecSignalVector){
+                              .uid = uid, .value = value, .count = 2 });
+    assert_int_equal(rc, 2);
+    ncodec_flush(nc);
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    uint8_t*            buffer = NULL;
+    size_t              len = 0;
+    NCodecStreamVTable* stream = ((NCodecInstance*)nc)->stream;
+    stream->read(nc, &buffer, &len, NCODEC_POS_NC);
+    size_t   msg_len = 0;
+    uint8_t* msg_ptr = flatbuffers_read_size_prefix(buffer, &msg_len);
+    ns(ChannelMessage_table_t) cm = ns(ChannelMessage_as_root(msg_ptr));
+    assert_int_equal(
+        ns(ChannelMessage_message_type(cm)), ns(MessageType_SignalValue));
+    flatbuffers_uint8_vec_t data =
+        ns(SignalValue_data((ns(SignalValue_table_t))ns(
+            ChannelMessage_message(cm))));
+    const uint8_t expect[] = {
+        0x92,                                           // [
+        0x92, 0x01, 0xcd, 0x01, 0x2c,                   //  [1, 300],
+        0x92, 0xcb, 0x3f, 0xe0, 0x00, 0x00, 0x00, 0x00, //  [0.5,
+        0x00, 0x00, 0xcb, 0x40, 0x00, 0x00, 0x00, 0x00, //   2.0]
+        0x00, 0x00, 0x00,                               // ]
+    };
+    assert_int_equal(flatbuffers_uint8_vec_len(data), sizeof(expect));
+    assert_memory_equal(data, expect, sizeof(expect));
+
+    /* Values with any MsgPack numeric type. */
+    const uint8_t other[] = {
+        0x92,                                     // [
+        0x93, 0x01, 0xcc, 0xc8,                   //  [1, 200,
+        0xce, 0x00, 0x01, 0x11, 0x70,             //   70000],
+        0x93, 0xfd, 0xca, 0x3f, 0xc0, 0x00, 0x00, //  [-3, 1.5f,
+        0xd1, 0xfc, 0x18,                         //   -1000]
+    };
+    ncodec_truncate(nc);
+    _write_data(nc, other, sizeof(other));
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    NCodecSignalVector sv;
+    rc = ncodec_read(nc, &sv);
+    assert_int_equal(rc, 3);
+    assert_int_equal(sv.sender.model_uid, 9);
+    assert_int_equal(sv.uid[0], 1);
+    assert_int_equal(sv.uid[1], 200);
+    assert_int_equal(sv.uid[2], 70000);
+    assert_true(sv.value[0] == -3.0);
+    assert_true(sv.value[1] == 1.5);
+    assert_true(sv.value[2] == -1000.0);
+
+    /* Bad vectors. */
+    const uint8_t mismatch[] = { 0x92, 0x91, 0x01, 0x90 };
+    const uint8_t negative_uid[] = { 0x92, 0x91, 0xff, 0x91, 0x01 };
+    const uint8_t truncated[] = { 0x92, 0x91, 0x01, 0x91, 0xcb, 0x40 };
+    ncodec_truncate(nc);
+    _write_data(nc, mismatch, sizeof(mismatch));
+    _write_data(nc, negative_uid, sizeof(negative_uid));
+    _write_data(nc, truncated, sizeof(truncated));
+    ncodec_seek(nc, 0, NCODEC_SEEK_SET);
+    for (size_t i = 0; i < 3; i++) {
+        rc = ncodec_read(nc, &sv);
+        assert_int_equal(rc, -EBADMSG);
+    }
+    rc = ncodec_read(nc, &sv);
+    assert_int_equal(rc, -ENOMSG);
+}
+
+
+int run_signal_tests(void)
+{
+    void* s = test_setup;
+    void* t = test_teardown;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_signal__vector, s, t),
+        cmocka_unit_test_setup_teardown(test_signal__write_type, s, t),
+        cmocka_unit_test_setup_teardown(test_signal__filter, s, t),
+        cmocka_unit_test_setup_teardown(test_signal__msgpack, s, t),
+    };
+
+    return cmocka_run_group_tests_name("SIGNAL", tests, NULL, NULL);
+}
@@ -0,0 +1,182 @@
+// Copyright 2025 Robert Bosch GmbH
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include <dse/testing.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dse/ncodec/codec.h>
+#include <dse/ncodec/stream/stream.h>
+
+#define UNUSED(x)     ((void)x)
+#define ARRAY_SIZE(x) (sizeof(x) / sizeof(x[0]))
+#define DATA_LEN      1000
+
+
+typedef struct TestVector {
+    const char* data;
+    size_t      data_len;
+    const char* encoded;
+} TestVector;
+
+
+static const TestVector vectors[] = {
+    { "", 0, "" },
+    { "h", 1, "BE" },
+    { "hello", 5, "BOu!rDZ" },
+    { "Hello World", 11, "87cURD]i,\"Ebo7" },
+    { "\0\0\0\0", 4, "!!!!!" },
+    { "\0\0\0\0\0\0\0\0", 8, "z!!!!!" },
+    { "\0\0\0\0\0\0\0\0\0", 9, "z!!!!!!!" },
+    { "\0\0\0\0abc", 7, "!!!!!@:E^" },
+};
+
+
+void test_ascii85__vectors(void** state)
+{
+    UNUSED(state);
+
+    for (size_t i = 0; i < ARRAY_SIZE(vectors); i++) {
+        char*  encoded = ncodec_ascii85_encode(
+            vectors[i].data, vectors[i].data_len);
+        assert_string_equal(encoded, vectors[i].encoded);
+
+        size_t len = 0;
+        char*  decoded = ncodec_ascii85_decode(encoded, &len);
+        assert_int_equal(len, vectors[i].data_len);
+        assert_memory_equal(decoded, vectors[i].data, len);
+        free(encoded);
+        free(decoded);
+    }
+}
+
+
+void test_ascii85__buffers(void** state)
+{
+    UNUSED(state);
+    uint8_t data[DATA_LEN];
+    char    encoded[DATA_LEN * 2];
+    uint8_t decoded[DATA_LEN * 5];
+
+    srand(42);
+    for (size_t i = 0; i < DATA_LEN; i++) {
+        data[i] = (i % 3) ? (uint8_t)rand() : 0;
+    }
+    memset(data + 100, 0, 40);
+
+    for (size_t len = 0; len < DATA_LEN; len += 7) {
+        size_t  bound = ncodec_ascii85_encode_bound(len);
+        int64_t rc = ncodec_ascii85_encode_to(data, len, encoded, bound + 1);
+        assert_true(rc >= 0);
+        assert_true((size_t)rc <= bound);
+        assert_int_equal(strlen(encoded), rc);
+
+        /* Same encoding as the allocating API. */
+        char* legacy = ncodec_ascii85_encode((const char*)data, len);
+        assert_string_equal(encoded, legacy);
+        free(legacy);
+
+        size_t encoded_len = (size_t)rc;
+        rc = ncodec_ascii85_decode_to(encoded, encoded_len, decoded,
+            ncodec_ascii85_decode_bound(encoded_len));
+        assert_int_equal(rc, len);
+        assert_memory_equal(decoded, data, len);
+    }
+}
+
+
+void test_ascii85__streaming(void** state)
+{
+    UNUSED(state);
+    uint8_t data[DATA_LEN];
+    char    encoded[DATA_LEN * 2];
+    char    expect[DATA_LEN * 2];
+    uint8_t decoded[DATA_LEN * 5];
+
+    srand(7);
+    for (size_t i = 0; i < DATA_LEN; i++) {
+        data[i] = (rand() % 4) ? (uint8_t)rand() : 0;
+    }
+    int64_t expect_len =
+        ncodec_ascii85_encode_to(data, DATA_LEN, expect, sizeof(expect));
+    assert_true(expect_len > 0);
+
+    for (size_t chunk = 1; chunk < 20; chunk++) {
+        /* Encode in chunks. */
+        NCodecAscii85Encoder enc = { 0 };
+        size_t               len = 0;
+        for (size_t pos = 0; pos < DATA_LEN; pos += chunk) {
+            size_t  n = (DATA_LEN - pos < chunk) ? DATA_LEN - pos : chunk;
+            int64_t rc = ncodec_ascii85_encode_update(
+                &enc, data + pos, n, encoded + len, sizeof(encoded) - len);
+            assert_true(rc >= 0);
+            len += (size_t)rc;
+        }
+        int64_t rc = ncodec_ascii85_encode_final(
+            &enc, encoded + len, sizeof(encoded) - len);
+        assert_true(rc >= 0);
+        len += (size_t)rc;
+        assert_int_equal(len, expect_len);
+        assert_memory_equal(encoded, expect, len);
+
+        /* Decode in chunks. */
+        NCodecAscii85Decoder dec = { 0 };
+        size_t               decoded_len = 0;
+        for (size_t pos = 0; pos < len; pos += chunk) {
+            size_t n = (len - pos < chunk) ? len - pos : chunk;
+            rc = ncodec_ascii85_decode_update(&dec, encoded + pos, n,
+                decoded + decoded_len, sizeof(decoded) - decoded_len);
+            assert_true(rc >= 0);
+            decoded_len += (size_t)rc;
+        }
+        rc = ncodec_ascii85_decode_final(
+            &dec, decoded + decoded_len, sizeof(decoded) - decoded_len);
+        assert_true(rc >= 0);
+        decoded_len += (size_t)rc;
+        assert_int_equal(decoded_len, DATA_LEN);
+        assert_memory_equal(decoded, data, DATA_LEN);
+    }
+}
+
+
+void test_ascii85__errors(void** state)
+{
+    UNUSED(state);
+    uint8_t data[16] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    char    encoded[32];
+    uint8_t decoded[64];
+    size_t  len = 42;
+
+    /* Destination too small. */
+    assert_int_equal(ncodec_ascii85_encode_to(data, 8, encoded, 10), -ENOSPC);
+    assert_int_equal(ncodec_ascii85_encode_to(data, 8, encoded, 11), 10);
+    assert_int_equal(ncodec_ascii85_decode_to(encoded, 10, decoded, 8), -ENOSPC);
+
+    /* Invalid characters. */
+    assert_int_equal(
+        ncodec_ascii85_decode_to("BOu!r~Z", 7, decoded, sizeof(decoded)),
+        -EINVAL);
+    assert_int_equal(
+        ncodec_ascii85_decode_to("BOzu!r", 6, decoded, sizeof(decoded)),
+        -EINVAL);
+    assert_null(ncodec_ascii85_decode("BOu!r\x7f", &len));
+    assert_int_equal(len, 0);
+}
+
+
+int run_ascii85_tests(void)
+{
+    void* s = NULL;
+    void* t = NULL;
+
+    const struct CMUnitTest tests[] = {
+        cmocka_unit_test_setup_teardown(test_ascii85__vectors, s, t),
+        cmocka_unit_test_setup_teardown(test_ascii85__buffers, s, t),
+        cmocka_unit_test_setup_teardown(test_ascii85__streaming, s, t),
+        cmocka_unit_test_setup_teardown(test_ascii85__errors, s, t),
+    };
+
+    return cmocka_run_group_tests_name("ASCII85", tests, NULL, NULL);
+}
@@ -234,6 +234,42 @@ void test_codec_config(void** state)
             .int_value = 1,
             .offset_value = offsetof(ABCodecInstance, loopback_str),
             .offset_int_value = offsetof(ABCodecInstance, loopback) },
+        { .name = "chunk_bytes",
+            .value = "65536",
+            .offset_value = offsetof(ABCodecInstance, chunk_bytes_str),
+            .offset_int_value = 0 },
+        { .name = "chunk_pdus",
+            .value = "100",
+            .offset_value = offsetof(ABCodecInstance, chunk_pdus_str),
+            .offset_int_value = 0 },
+        { .name = "networks",
+            .value = "2,3",
+            .offset_value = offsetof(ABCodecInstance, networks_str),
+            .offset_int_value = 0 },
+        { .name = "model_uid",
+            .value = "4242",
+            .offset_value = offsetof(ABCodecInstance, model_uid_str),
+            .offset_int_value = 0 },
+        { .name = "bitrate",
+            .value = "1000000",
+            .offset_value = offsetof(ABCodecInstance, bitrate_str),
+            .offset_int_value = 0 },
+        { .name = "fd_bitrate",
+            .value = "5000000",
+            .offset_value = offsetof(ABCodecInstance, fd_bitrate_str),
+            .offset_int_value = 0 },
+        { .name = "tp_segment_size",
+            .value = "1400",
+            .offset_value = offsetof(ABCodecInstance, tp_segment_size_str),
+            .offset_int_value = 0 },
+        { .name = "tp_slots",
+            .value = "4",
+            .offset_value = offsetof(ABCodecInstance, tp_slots_str),
+            .offset_int_value = 0 },
+        { .name = "tp_timeout",
+            .value = "5",
+            .offset_value = offsetof(ABCodecInstance, tp_timeout_str),
+            .offset_int_value = 0 },
         /* Bad integer values. */
         { .name = "bus_id",
             .value = "seven",
@@ -313,6 +349,16 @@ void test_codec_stat(void** state)
         { .index = 15, .name = "poca", .value = "4" },
         { .index = 16, .name = "pocb", .value = "2" },
         { .index = 17, .name = "loopback", .value = "1" },
+        { .index = 18, .name = "chunk_bytes", .value = "65536" },
+        { .index = 19, .name = "chunk_pdus", .value = "100" },
+        { .index = 20, .name = "networks", .value = "2,3" },
+        { .index = 21, .name = "model_uid", .value = "4242" },
+        { .index = 22, .name = "bitrate", .value = "1000000" },
+        { .index = 23, .name = "fd_bitrate", .value = "5000000" },
+        { .index = 24, .name = "tp_segment_size", .value = "1400" },
+        { .index = 25, .name = "cluster", .value = "fr1" },
+        { .index = 26, .name = "tp_slots", .value = "4" },
+        { .index = 27, .name = "tp_timeout", .value = "5" },
         { .index = -1, .name = "foo", .value = "bar" },
     };
 